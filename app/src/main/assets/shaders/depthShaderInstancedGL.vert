@@ -0,0 +1,34 @@
+#version 100
+precision mediump float;
+
+/**
+ * Copyright 2023 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+uniform mat4 model;
+uniform mat4 projView;
+
+attribute vec3 inPosition;
+
+/* per instance attributes */
+attribute mat4 inModel;
+
+void main() {
+    gl_Position = projView * model * inModel * vec4(inPosition, 1.0);
+}
@@ -0,0 +1,57 @@
+#version 100
+precision mediump float;
+
+/**
+ * Copyright 2022 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+uniform mat4 model;
+uniform mat4 projView;
+uniform mat4 normalMatrix;
+uniform mat4 projViewLight;
+
+attribute vec3 inPosition;
+attribute vec3 inColor;
+attribute vec2 inTexCoord;
+attribute vec3 inNormal;
+
+/* per instance attributes */
+attribute mat4 inModel;
+attribute mat4 inNormalMatrix;
+
+varying vec3 fragColor;
+varying vec2 fragTexCoord;
+varying vec3 fragNormal;
+varying vec3 fragPosition;
+varying vec4 fragPosLightSpace;
+
+void main() {
+    fragColor = inColor;
+    fragTexCoord = inTexCoord;
+
+    /* The transpose and inverse functions are not available
+       in GLSL 100, so the normal matrix for each instance is
+       passed in with the instance. */
+    fragNormal = normalize(mat3(normalMatrix) * mat3(inNormalMatrix) * inNormal);
+
+    mat4 instanceModel = model * inModel;
+    fragPosition = vec3(instanceModel * vec4(inPosition, 1.0));
+    fragPosLightSpace = projViewLight * vec4(fragPosition, 1.0);
+    gl_Position = projView * instanceModel * vec4(inPosition, 1.0);
+}
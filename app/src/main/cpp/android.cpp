@@ -18,6 +18,8 @@
  *
  */
 #include "android_native_app_glue.h"
+#include <android/log.h>
+#include <algorithm>
 #include <string>
 #include <asm/fcntl.h>
 #include <istream>
@@ -84,7 +86,7 @@ ASensorEventQueue *Sensors::initializeSensor(ASensor const *sensor, int eventTyp
         throw std::runtime_error("Could not enable sensor");
     }
     int minDelay = ASensor_getMinDelay(sensor);
-    minDelay = std::max(minDelay, MAX_EVENT_REPORT_TIME);
+    minDelay = std::max(minDelay, m_samplingPeriod);
 
     rc = ASensorEventQueue_setEventRate(eventQueue, sensor, minDelay);
     if (rc < 0) {
@@ -97,6 +99,42 @@ ASensorEventQueue *Sensors::initializeSensor(ASensor const *sensor, int eventTyp
     return eventQueue;
 }
 
+size_t Sensors::drainAccelerometerEvents(AccelerationFilter &filter) {
+    size_t nbrEventsTotal = 0;
+    while (true) {
+        ssize_t nbrEvents = ASensorEventQueue_getEvents(m_eventQueueAccelerometer, m_events.data(),
+                                                        m_events.size());
+        if (nbrEvents < 0) {
+            throw std::runtime_error("Error on retrieving sensor events.");
+        }
+
+        for (ssize_t i = 0; i < nbrEvents; i++) {
+            ASensorEvent const &event = m_events[i];
+            filter.add(event.acceleration.x, event.acceleration.y, event.acceleration.z,
+                       event.timestamp);
+        }
+        nbrEventsTotal += static_cast<size_t>(nbrEvents);
+
+        // a partly filled buffer means the queue is empty.
+        if (static_cast<size_t>(nbrEvents) < m_events.size()) {
+            return nbrEventsTotal;
+        }
+    }
+}
+
+void logFrameStatistics(FrameStatistics const &statistics) {
+    auto total = statistics.busy + statistics.idle;
+    double busyPercent = total.count() > 0 ? 100.0 * statistics.busy.count() / total.count() : 0.0;
+    __android_log_print(ANDROID_LOG_INFO, "AmazingLabyrinth",
+            "drawing thread busy %.1f%% (%lld ms of %lld ms), %u wake ups, %u updates, "
+            "%u frames drawn, aiming for %.1f frames per second",
+            busyPercent,
+            static_cast<long long>(statistics.busy.count() / 1000),
+            static_cast<long long>(total.count() / 1000),
+            statistics.nbrWakeUps, statistics.nbrUpdates, statistics.nbrFramesDrawn,
+            statistics.frameRate);
+}
+
 std::unique_ptr<AAsset> AssetManagerWrapper::getAsset(std::string const &path) {
     AAsset *asset = AAssetManager_open(manager, path.c_str(), O_RDONLY);
     if (asset == nullptr) {
@@ -115,6 +153,25 @@ AssetStreambuf::int_type AssetStreambuf::underflow() {
     return traits_type::to_int_type(buffer[0]);
 }
 
+// Large reads (e.g. the arrays in a modelbin file) go straight from the asset to the caller
+// instead of through the buffer.
+std::streamsize AssetStreambuf::xsgetn(char *s, std::streamsize n) {
+    std::streamsize nbrBuffered = std::min<std::streamsize>(n, egptr() - gptr());
+    std::copy(gptr(), gptr() + nbrBuffered, s);
+    gbump(static_cast<int>(nbrBuffered));
+
+    std::streamsize nbrRead = nbrBuffered;
+    while (nbrRead < n) {
+        int bytesRead = AAsset_read(asset.get(), s + nbrRead, static_cast<size_t>(n - nbrRead));
+        if (bytesRead <= 0) {
+            break;
+        }
+        nbrRead += bytesRead;
+    }
+
+    return nbrRead;
+}
+
 std::streampos AssetStreambuf::seekoff(std::streamoff off, std::ios_base::seekdir way, std::ios_base::openmode which) {
     if (which != std::ios_base::in) {
         return -1;
@@ -126,6 +183,8 @@ std::streampos AssetStreambuf::seekoff(std::streamoff off, std::ios_base::seekdi
             whence = SEEK_SET;
             break;
         case std::ios_base::cur :
+            // the asset is ahead of the reader by what is left in the buffer.
+            offset -= egptr() - gptr();
             whence = SEEK_CUR;
             break;
         case std::ios_base::end :
@@ -135,6 +194,7 @@ std::streampos AssetStreambuf::seekoff(std::streamoff off, std::ios_base::seekdi
             return -1;
     }
     offset = AAsset_seek64(asset.get(), offset, whence);
+    setg(buffer, buffer, buffer);
 
     return offset;
 }
@@ -25,12 +25,15 @@
 #include <android/asset_manager_jni.h>
 #include <android/looper.h>
 #include <android/sensor.h>
+#include <array>
 #include <memory>
 #include <streambuf>
 #include <bitset>
 #include <vector>
 
 #include "common.hpp"
+#include "frameScheduler.hpp"
+#include "sensorFilter.hpp"
 
 typedef ANativeWindow WindowType;
 
@@ -87,23 +90,25 @@ public:
         return std::move(getEvents(m_eventQueueGravity));
     }
 
-    inline std::vector<AccelerationEvent> getAccelerometerEvents() {
-        return std::move(getEvents(m_eventQueueAccelerometer));
-    }
+    // Feed all the pending accelerometer events to the filter.  Returns the number of events.
+    size_t drainAccelerometerEvents(AccelerationFilter &filter);
 
     ~Sensors() {
         destroyResources();
     }
 
-    explicit Sensors(std::bitset<3> inWhichSensors)
-            : m_sensorManager{nullptr},
+    // samplingPeriod: the period in microseconds to ask the sensors to report events at.
+    explicit Sensors(std::bitset<3> inWhichSensors, int32_t samplingPeriod = MAX_EVENT_REPORT_TIME)
+            : m_samplingPeriod{samplingPeriod},
+              m_sensorManager{nullptr},
               m_sensorLinearAcceleration{nullptr},
               m_sensorGravity{nullptr},
               m_sensorAccelerometer{nullptr},
               m_eventQueueLinearAcceleration{nullptr},
               m_eventQueueGravity{nullptr},
               m_eventQueueAccelerometer{nullptr},
-              m_looper{nullptr}
+              m_looper{nullptr},
+              m_events{}
     {
         initSensors(inWhichSensors);
     }
@@ -118,6 +123,7 @@ private:
     static constexpr int EVENT_TYPE_GRAVITY = 461;
     static constexpr int EVENT_TYPE_ACCELEROMETER = 462;
 
+    int32_t m_samplingPeriod;
     ASensorManager *m_sensorManager;
     ASensor const *m_sensorLinearAcceleration;
     ASensor const *m_sensorGravity;
@@ -127,6 +133,9 @@ private:
     ASensorEventQueue *m_eventQueueAccelerometer;
     ALooper *m_looper;
 
+    // the events are read into this buffer so that reading them does not allocate.
+    std::array<ASensorEvent, 64> m_events;
+
     void initSensors(std::bitset<3> inWhichSensors);
     ASensorEventQueue *initializeSensor(ASensor const *sensor, int eventType);
 
@@ -177,6 +186,9 @@ private:
     }
 };
 
+// writes the drawing thread's busy and idle time to the Android log.
+void logFrameStatistics(FrameStatistics const &statistics);
+
 namespace std {
     template<> class default_delete<AAsset> {
     public:
@@ -193,6 +205,7 @@ private:
 public:
     explicit AssetStreambuf(std::unique_ptr<AAsset> &&inAsset) : asset(std::move(inAsset)) {}
     int underflow() override;
+    std::streamsize xsgetn(char *s, std::streamsize n) override;
     std::streampos seekoff(std::streamoff off, std::ios_base::seekdir way, std::ios_base::openmode which) override;
     std::streampos seekpos(std::streampos pos, std::ios_base::openmode which) override;
 };
@@ -80,5 +80,13 @@ public:
 };
 
 std::vector<char> readFile(std::shared_ptr<FileRequester> const &requester, std::string const &filename);
+
+/* glGetError waits for the GL driver to catch up with the commands issued so far, which costs a
+ * lot of CPU time on the weaker devices.  Only check for GL errors in debug builds.
+ */
+#ifdef DEBUG
 void checkGraphicsError();
+#else
+inline void checkGraphicsError() {}
+#endif
 #endif // AMAZING_LABYRINTH_COMMON_HPP
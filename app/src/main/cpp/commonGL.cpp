@@ -23,6 +23,7 @@
 #include <GLES3/gl3.h>
 #include <GLES3/gl3ext.h>
 
+#ifdef DEBUG
 void checkGraphicsError() {
     GLenum rc = glGetError();
     if (rc != GL_NO_ERROR) {
@@ -49,3 +50,4 @@ void checkGraphicsError() {
         throw std::runtime_error(std::string("A graphics error occurred: ") + c);
     }
 }
+#endif
@@ -24,69 +24,33 @@
 
 #include "mazeVulkan.hpp"
 
-std::shared_ptr<DrawEvent> GameSendChannel::getEventNoWait() {
-    // critical section
-    std::unique_lock<std::mutex> lock(m_eventLock);
-
-    if (m_stopDrawing) {
-        m_stopDrawing = false;
-        return std::make_shared<StopDrawingEvent>(StopDrawingEvent{});
-    }
-
-    if (m_drawEventQueue.empty()) {
-        return std::shared_ptr<DrawEvent>();
+boost::optional<GameEvent> GameSendChannel::getEventNoWait() {
+    if (m_stopDrawing.exchange(false)) {
+        return GameEvent{StopDrawingEvent{}};
     }
 
-    std::shared_ptr<DrawEvent> event = m_drawEventQueue.front();
-    m_drawEventQueue.pop();
-    return event;
+    return m_channel.tryReceive([](GameEvent &event, GameEvent const &next) -> bool {
+        auto drag = boost::get<DragEvent>(&event);
+        auto nextDrag = boost::get<DragEvent>(&next);
+        return drag != nullptr && nextDrag != nullptr && drag->merge(*nextDrag);
+    });
 }
 
-// blocks waiting for the next event.
-std::shared_ptr<DrawEvent> GameSendChannel::getEvent() {
-    // critical section
-    std::unique_lock<std::mutex> lock(m_eventLock);
-
-    if (m_stopDrawing) {
-        m_stopDrawing = false;
-        return std::make_shared<StopDrawingEvent>(StopDrawingEvent{});
-    }
-
-    if (m_drawEventQueue.empty()) {
-        m_eventConditionVariable.wait(lock);
+void GameSendChannel::waitForEvent(std::chrono::microseconds timeout) {
+    if (m_stopDrawing.load()) {
+        return;
     }
 
-    if (m_stopDrawing) {
-        m_stopDrawing = false;
-        return std::make_shared<StopDrawingEvent>(StopDrawingEvent{});
-    }
-
-    std::shared_ptr<DrawEvent> event = m_drawEventQueue.front();
-    m_drawEventQueue.pop();
-    return event;
+    m_channel.waitForData(timeout);
 }
 
-void GameSendChannel::sendEvent(std::shared_ptr<DrawEvent> const &event) {
-    std::unique_lock<std::mutex> lock(m_eventLock);
-
-    m_drawEventQueue.push(event);
-    m_eventConditionVariable.notify_one();
+void GameSendChannel::sendEvent(GameEvent event) {
+    m_channel.send(std::move(event));
 }
 
 void GameSendChannel::sendStopDrawingEvent() {
-    std::unique_lock<std::mutex> lock(m_eventLock);
-
-    m_stopDrawing = true;
-    m_eventConditionVariable.notify_one();
-}
-
-void GameSendChannel::clearQueue() {
-    std::unique_lock<std::mutex> lock(m_eventLock);
-    m_stopDrawing = false;
-
-    while (!m_drawEventQueue.empty()) {
-        m_drawEventQueue.pop();
-    }
+    m_stopDrawing.store(true);
+    m_channel.wakeConsumer();
 }
 
 GameSendChannel &gameFromGuiChannel() {
@@ -119,38 +83,54 @@ std::string GameWorker::initGraphics(std::shared_ptr<WindowType> surface,
 }
 
 void GameWorker::drawingLoop() {
+    using Clock = FrameScheduler::Clock;
+
     std::unique_ptr<Sensors> sensor;
     if (m_whichSensors.any()) {
-        sensor = std::make_unique<Sensors>(m_whichSensors);
+        sensor = std::make_unique<Sensors>(m_whichSensors, m_sensorTuning.samplingPeriod);
     }
+    AccelerationFilter accelerationFilter{m_sensorTuning};
+    FrameScheduler scheduler{m_frameTuning, Clock::now()};
 
-    uint32_t nbrIterationsIdle = 0;
+    bool redrawRequired = false;
     bool keepAliveEnabled = true;
     while (true) {
-        if (sensor != nullptr && sensor->hasAccelerometerEvents()) {
-            std::vector<Sensors::AccelerationEvent> events = sensor->getAccelerometerEvents();
-            for (auto const &event : events) {
-                m_graphics->updateAcceleration(event.x, event.y, event.z);
-            }
+        auto wakeTime = Clock::now();
+        scheduler.wokeUp(wakeTime);
+
+        // the sensor can report several events per frame.  They all go through the filter, but
+        // the level only gets the filtered acceleration once per iteration.
+        glm::vec3 acceleration;
+        if (sensor != nullptr && sensor->drainAccelerometerEvents(accelerationFilter) > 0 &&
+            accelerationFilter.take(acceleration))
+        {
+            m_graphics->updateAcceleration(acceleration);
         }
 
         // Some events are a lot cheaper than a redraw, so process several of them.
         uint32_t nbrRequireRedraw = 0;
         while (nbrRequireRedraw < m_maxEventsBeforeRedraw) {
             auto event = gameFromGuiChannel().getEventNoWait();
-            if (event != nullptr) {
-                switch (event->type()) {
+            if (event != boost::none) {
+                DrawEvent &currentEvent = drawEvent(event.get());
+                switch (currentEvent.type()) {
                     case DrawEvent::stopDrawing:
-                        // The main thread requested that we exit.  Run the event and then exit.
-                        (*event)(m_graphics);
+                        // The main thread requested that we exit.  Run the event, make sure
+                        // the save data is on storage and then exit.
+                        currentEvent(m_graphics);
+                        m_graphics->flushSaveData();
                         return;
+                    case DrawEvent::thermalStatusChanged:
+                        scheduler.setThermalStatus(
+                                boost::get<ThermalStatusChangedEvent>(event.get()).status());
+                        break;
                     case DrawEvent::surfaceChanged:
                     case DrawEvent::saveLevelData:
                     case DrawEvent::levelChanged:
                     case DrawEvent::tap:
                     case DrawEvent::drag:
                     case DrawEvent::dragEnded:
-                        if ((*event)(m_graphics)) {
+                        if (currentEvent(m_graphics)) {
                             nbrRequireRedraw++;
                         }
                         break;
@@ -160,26 +140,43 @@ void GameWorker::drawingLoop() {
             }
         }
 
-        bool needsRedraw = m_graphics->updateData(nbrRequireRedraw > 0);
-        if (needsRedraw || nbrRequireRedraw > 0) {
-            m_graphics->drawFrame();
-            timeval tv = {0, 100};
-            select(0, nullptr, nullptr, nullptr, &tv);
-            nbrIterationsIdle = 0;
-        } else {
-            timeval tv = {0, 1000};
-            select(0, nullptr, nullptr, nullptr, &tv);
-            if (nbrIterationsIdle <= m_maxIterationsIdle) {
-                nbrIterationsIdle++;
+        if (nbrRequireRedraw > 0) {
+            redrawRequired = true;
+            scheduler.activity(wakeTime);
+        }
+
+        // GUI events wake this thread up between frames, the redraws they need wait for the
+        // next frame.
+        if (scheduler.frameDue(Clock::now())) {
+            bool drewFrame = m_graphics->updateData(redrawRequired) || redrawRequired;
+            if (drewFrame) {
+                m_graphics->drawFrame();
             }
+            redrawRequired = false;
+            scheduler.frameDone(wakeTime, Clock::now(), drewFrame);
+        }
+
+        auto now = Clock::now();
+        FrameStatistics statistics{};
+        if (scheduler.takeStatistics(now, statistics)) {
+            logFrameStatistics(statistics);
         }
 
-        if (keepAliveEnabled && nbrIterationsIdle > m_maxIterationsIdle) {
+        bool idle = scheduler.timeSinceActivity(now) > m_keepAliveTimeout;
+        if (keepAliveEnabled && idle) {
             m_graphics->sendKeepAliveEnabled(false);
             keepAliveEnabled = false;
-        } else if (!keepAliveEnabled && nbrIterationsIdle == 0) {
+        } else if (!keepAliveEnabled && !idle) {
             m_graphics->sendKeepAliveEnabled(true);
             keepAliveEnabled = true;
         }
+
+        // sleep until the next frame or the next GUI event.  Sensor events wait in their queue
+        // until then.
+        scheduler.sleeping(now);
+        auto timeout = std::chrono::duration_cast<std::chrono::microseconds>(scheduler.nextFrame() - now);
+        if (timeout.count() > 0) {
+            gameFromGuiChannel().waitForEvent(timeout);
+        }
     }
 }
@@ -21,13 +21,15 @@
 #define AMAZING_LABYRINTH_DRAWER_HPP
 
 #include <atomic>
-#include <mutex>
-#include <queue>
+#include <chrono>
 #include <vector>
 #include <bitset>
 #include <boost/optional.hpp>
+#include <boost/variant.hpp>
 #include "mazeGraphics.hpp"
+#include "spscChannel.hpp"
 #include "common.hpp"
+#include "frameScheduler.hpp"
 #include "android.hpp"
 
 class DrawEvent {
@@ -39,7 +41,8 @@ public:
         saveLevelData,
         drag,
         dragEnded,
-        tap
+        tap,
+        thermalStatusChanged
     };
 
     // returns true if the surface needs redrawing after this event.
@@ -119,7 +122,18 @@ public:
         return graphics->drag(m_startX, m_startY, m_distanceX, m_distanceY);
     }
 
-    evtype type() override { return levelChanged; }
+    evtype type() override { return drag; }
+
+    // Drags from the same starting point carry the distance moved since the last drag event, so
+    // they can be combined by adding the distances.  Returns true if next was merged into this.
+    bool merge(DragEvent const &next) {
+        if (next.m_startX != m_startX || next.m_startY != m_startY) {
+            return false;
+        }
+        m_distanceX += next.m_distanceX;
+        m_distanceY += next.m_distanceY;
+        return true;
+    }
 
     DragEvent(float startX, float startY, float distanceX, float distanceY)
             : m_startX{startX},
@@ -143,7 +157,7 @@ public:
         return graphics->dragEnded(m_x, m_y);
     }
 
-    evtype type() override { return levelChanged; }
+    evtype type() override { return dragEnded; }
 
     DragEndedEvent(float x, float y)
             : m_x{x},
@@ -163,7 +177,7 @@ public:
         return graphics->tap(m_x, m_y);
     }
 
-    evtype type() override { return levelChanged; }
+    evtype type() override { return tap; }
 
     TapEvent(float x, float y)
             : m_x{x},
@@ -192,28 +206,74 @@ public:
     ~SaveLevelDataEvent() override = default;
 };
 
-/* Used to communicate between the gui thread and the drawing thread.
+/* Handled by the drawing loop, which slows down the frame rate when the device is hot. */
+class ThermalStatusChangedEvent : public DrawEvent {
+public:
+    bool operator() (std::unique_ptr<Graphics> &) override {
+        return false;
+    }
+
+    evtype type() override { return thermalStatusChanged; }
+
+    ThermalStatus status() const { return m_status; }
+
+    explicit ThermalStatusChangedEvent(ThermalStatus status)
+            : m_status{status}
+    {
+    }
+
+    ~ThermalStatusChangedEvent() override = default;
+private:
+    ThermalStatus m_status;
+};
+
+/* The events are passed by value so that sending one does not allocate. */
+using GameEvent = boost::variant<
+        StopDrawingEvent,
+        SurfaceChangedEvent,
+        LevelChangedEvent,
+        SaveLevelDataEvent,
+        DragEvent,
+        DragEndedEvent,
+        TapEvent,
+        ThermalStatusChangedEvent>;
+
+inline DrawEvent &drawEvent(GameEvent &event) {
+    struct Visitor : public boost::static_visitor<DrawEvent &> {
+        DrawEvent &operator()(DrawEvent &e) const { return e; }
+    };
+    return boost::apply_visitor(Visitor{}, event);
+}
+
+/* Used to communicate between the gui thread and the drawing thread.  All events except for stop
+ * drawing are sent from the gui thread, so the events go through a single producer, single
+ * consumer ring.  Stop drawing is a flag so that it can be sent from any thread, gets handled
+ * before any queued events and is never blocked by a full ring.
  */
 class GameSendChannel {
 private:
-    std::mutex m_eventLock;
-    std::condition_variable m_eventConditionVariable;
+    static size_t constexpr m_capacity = 256;
 
-    std::queue<std::shared_ptr<DrawEvent>> m_drawEventQueue;
-    bool m_stopDrawing;
+    SpscChannel<GameEvent, m_capacity> m_channel;
+    std::atomic<bool> m_stopDrawing;
 
 public:
     GameSendChannel()
-            : m_stopDrawing{false}
+            : m_channel{},
+              m_stopDrawing{false}
     {}
 
-    std::shared_ptr<DrawEvent> getEventNoWait();
-    std::shared_ptr<DrawEvent> getEvent();
+    // Returns boost::none if there are no events.  Consecutive drag events that can be combined
+    // are returned as one event so that the drawer never works on stale positions.
+    boost::optional<GameEvent> getEventNoWait();
+
+    // waits until there is an event or the timeout expires.
+    void waitForEvent(std::chrono::microseconds timeout);
+
+    // only call from the gui thread.  Blocks if the channel is full.
+    void sendEvent(GameEvent event);
 
-    // blocks on sending event
-    void sendEvent(std::shared_ptr<DrawEvent> const &event);
     void sendStopDrawingEvent();
-    void clearQueue();
 };
 
 GameSendChannel &gameFromGuiChannel();
@@ -225,8 +285,12 @@ public:
                bool inUseGravity,
                bool inTryVulkan,
                bool useShadows,
-               float rotationAngle)
+               float rotationAngle,
+               SensorTuning const &inSensorTuning = SensorTuning{},
+               FrameTuning const &inFrameTuning = FrameTuning{})
             : m_whichSensors{},
+              m_sensorTuning{inSensorTuning},
+              m_frameTuning{inFrameTuning},
               m_tryVulkan{inTryVulkan},
               m_graphics{}
     {
@@ -247,10 +311,18 @@ public:
 private:
     static constexpr uint32_t m_maxEventsBeforeRedraw = 128;
 
+    // the app stops keeping the screen on after this long without anything happening.
+    static constexpr std::chrono::seconds m_keepAliveTimeout{20};
+
     std::bitset<3> m_whichSensors;
+
+    // the accelerometer's sampling period and filter.
+    SensorTuning m_sensorTuning;
+
+    // the frame rate cap and when to slow down.
+    FrameTuning m_frameTuning;
     bool m_tryVulkan;
     std::unique_ptr<Graphics> m_graphics;
-    static uint32_t constexpr m_maxIterationsIdle = 20000;
 
     std::string initGraphics(
             std::shared_ptr<WindowType> surface,
@@ -0,0 +1,177 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <algorithm>
+#include <cmath>
+
+#include "frameScheduler.hpp"
+
+namespace {
+    // used if the display did not report its refresh rate.
+    float constexpr defaultRefreshRate = 60.0f;
+
+    std::chrono::microseconds toMicroseconds(FrameScheduler::Clock::duration duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration);
+    }
+}
+
+FrameScheduler::FrameScheduler(FrameTuning const &tuning, Clock::time_point now)
+        : m_tuning{tuning},
+          m_refreshPeriod{},
+          m_minRefreshesPerFrame{1},
+          m_refreshesPerFrame{1},
+          m_idleRefreshesPerFrame{1},
+          m_thermalStatus{ThermalStatus::none},
+          m_averageFrameTime{0},
+          m_nextFrame{now},
+          m_lastFrameStart{now},
+          m_lastFrameDrawn{false},
+          m_lastActivity{now},
+          m_lastStateChange{now},
+          m_lastReport{now},
+          m_sleeping{false},
+          m_statistics{}
+{
+    if (!(m_tuning.displayRefreshRate > 0.0f)) {
+        m_tuning.displayRefreshRate = defaultRefreshRate;
+    }
+    m_refreshPeriod = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / m_tuning.displayRefreshRate));
+
+    updateMinRefreshesPerFrame();
+}
+
+uint32_t FrameScheduler::refreshesFor(float frameRate) const {
+    if (frameRate <= 0.0f) {
+        return 1;
+    }
+
+    // round up so that the frame rate stays under frameRate.  The small tolerance is for displays
+    // that report something like 59.94 Hz.
+    auto refreshes = static_cast<uint32_t>(std::ceil(m_tuning.displayRefreshRate / frameRate - 0.01f));
+    return std::max(refreshes, 1u);
+}
+
+void FrameScheduler::updateMinRefreshesPerFrame() {
+    float maxFrameRate = static_cast<float>(m_tuning.maxFrameRate);
+    if (m_thermalStatus >= ThermalStatus::severe) {
+        maxFrameRate = std::min(maxFrameRate, 30.0f);
+    } else if (m_thermalStatus >= ThermalStatus::moderate) {
+        maxFrameRate = std::min(maxFrameRate, 60.0f);
+    }
+
+    m_minRefreshesPerFrame = refreshesFor(maxFrameRate);
+    m_refreshesPerFrame = m_minRefreshesPerFrame;
+    m_idleRefreshesPerFrame = std::max(m_minRefreshesPerFrame,
+            refreshesFor(static_cast<float>(m_tuning.idleUpdateRate)));
+}
+
+void FrameScheduler::setThermalStatus(ThermalStatus status) {
+    if (status != m_thermalStatus) {
+        m_thermalStatus = status;
+        updateMinRefreshesPerFrame();
+    }
+}
+
+float FrameScheduler::frameRate() const {
+    return m_tuning.displayRefreshRate / m_refreshesPerFrame;
+}
+
+void FrameScheduler::frameDone(Clock::time_point frameStart, Clock::time_point now, bool drewFrame) {
+    m_statistics.nbrUpdates++;
+    if (drewFrame) {
+        m_statistics.nbrFramesDrawn++;
+        m_lastActivity = now;
+
+        // if the frames take longer than the frame period, space them out by another refresh
+        // instead of having some frames shown for one refresh and others for two.
+        m_averageFrameTime += (now - frameStart - m_averageFrameTime) / 8;
+        if (m_averageFrameTime > m_refreshPeriod * m_refreshesPerFrame &&
+            m_refreshesPerFrame < m_minRefreshesPerFrame * m_maxLoadRefreshesPerFrame)
+        {
+            m_refreshesPerFrame++;
+        } else if (m_refreshesPerFrame > m_minRefreshesPerFrame &&
+                   m_averageFrameTime < m_refreshPeriod * (m_refreshesPerFrame - 1) * 3 / 4)
+        {
+            m_refreshesPerFrame--;
+        }
+    }
+
+    uint32_t refreshes = m_refreshesPerFrame;
+    if (now - m_lastActivity >= m_tuning.idleAfter) {
+        refreshes = m_idleRefreshesPerFrame;
+    }
+
+    // the frames stay on the schedule of the first frame, a frame that was late is not a reason
+    // to move all the frames after it.
+    m_lastFrameStart = m_nextFrame;
+    m_lastFrameDrawn = drewFrame;
+    m_nextFrame = m_lastFrameStart + m_refreshPeriod * refreshes;
+    if (m_nextFrame <= now) {
+        m_nextFrame += m_refreshPeriod * ((now - m_nextFrame) / m_refreshPeriod + 1);
+    }
+}
+
+void FrameScheduler::activity(Clock::time_point now) {
+    m_lastActivity = now;
+
+    // if nothing was drawn in the last frame, the next one can start right away.
+    Clock::time_point earliest = now;
+    if (m_lastFrameDrawn) {
+        earliest = std::max(now, m_lastFrameStart + m_refreshPeriod * m_refreshesPerFrame);
+    }
+    m_nextFrame = std::min(m_nextFrame, earliest);
+}
+
+void FrameScheduler::wokeUp(Clock::time_point now) {
+    if (m_sleeping) {
+        m_statistics.idle += toMicroseconds(now - m_lastStateChange);
+        m_statistics.nbrWakeUps++;
+        m_sleeping = false;
+        m_lastStateChange = now;
+    }
+}
+
+void FrameScheduler::sleeping(Clock::time_point now) {
+    if (!m_sleeping) {
+        m_statistics.busy += toMicroseconds(now - m_lastStateChange);
+        m_sleeping = true;
+        m_lastStateChange = now;
+    }
+}
+
+bool FrameScheduler::takeStatistics(Clock::time_point now, FrameStatistics &statistics) {
+    if (now - m_lastReport < m_tuning.statisticsPeriod) {
+        return false;
+    }
+
+    // the time up to now goes in this report.
+    if (m_sleeping) {
+        m_statistics.idle += toMicroseconds(now - m_lastStateChange);
+    } else {
+        m_statistics.busy += toMicroseconds(now - m_lastStateChange);
+    }
+    m_lastStateChange = now;
+
+    statistics = m_statistics;
+    statistics.frameRate = frameRate();
+    m_statistics = FrameStatistics{};
+    m_lastReport = now;
+    return true;
+}
@@ -0,0 +1,136 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_FRAME_SCHEDULER_HPP
+#define AMAZING_LABYRINTH_FRAME_SCHEDULER_HPP
+
+#include <chrono>
+#include <cstdint>
+
+// the same values as PowerManager.THERMAL_STATUS_*.
+enum class ThermalStatus : int32_t {
+    none = 0,
+    light = 1,
+    moderate = 2,
+    severe = 3,
+    critical = 4,
+    emergency = 5,
+    shutdown = 6
+};
+
+struct FrameTuning {
+    // the most frames drawn per second: 30, 60, 90 or 120.
+    uint32_t maxFrameRate = 60;
+
+    // the display's refresh rate in Hz.  Frames are started a whole number of refreshes apart.
+    float displayRefreshRate = 60.0f;
+
+    // when nothing was drawn and no GUI event came for idleAfter, the level is only updated
+    // idleUpdateRate times per second until it needs to be drawn again.
+    uint32_t idleUpdateRate = 20;
+    std::chrono::milliseconds idleAfter{500};
+
+    // how often the frame statistics are reported.
+    std::chrono::seconds statisticsPeriod{30};
+};
+
+// the time spent by the drawing thread since the last report.
+struct FrameStatistics {
+    std::chrono::microseconds busy;
+    std::chrono::microseconds idle;
+    uint32_t nbrWakeUps;
+    uint32_t nbrUpdates;
+    uint32_t nbrFramesDrawn;
+
+    // the frame rate the scheduler was aiming for at the time of the report.
+    float frameRate;
+};
+
+/* Decides when the drawing loop updates the level and draws the next frame.  In between, the
+ * drawing loop sleeps until nextFrame or until a GUI event comes.
+ *
+ * Frames are started a whole number of display refreshes apart, so when presenting waits for
+ * vsync each frame gets its own refresh.  The number of refreshes per frame goes up:
+ *   - to keep under maxFrameRate,
+ *   - when the thermal status is moderate (60 frames per second at most) or worse (30),
+ *   - when drawing takes longer than the frame period, so that the frames are paced evenly,
+ *   - when the level is static, down to idleUpdateRate.
+ */
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    bool frameDue(Clock::time_point now) const { return now >= m_nextFrame; }
+    Clock::time_point nextFrame() const { return m_nextFrame; }
+
+    // call after the level was updated (and maybe drawn).  frameStart is when the work on the
+    // frame started.
+    void frameDone(Clock::time_point frameStart, Clock::time_point now, bool drewFrame);
+
+    // a GUI event needs a redraw: leave the idle rate right away.
+    void activity(Clock::time_point now);
+
+    // the thread woke up or is about to sleep, for the statistics.
+    void wokeUp(Clock::time_point now);
+    void sleeping(Clock::time_point now);
+
+    void setThermalStatus(ThermalStatus status);
+
+    Clock::duration timeSinceActivity(Clock::time_point now) const { return now - m_lastActivity; }
+
+    // the frames per second aimed for when the level is not static.
+    float frameRate() const;
+
+    // Returns true and the statistics since the last report once per statistics period.
+    bool takeStatistics(Clock::time_point now, FrameStatistics &statistics);
+
+    FrameScheduler(FrameTuning const &tuning, Clock::time_point now);
+
+private:
+    FrameTuning m_tuning;
+    Clock::duration m_refreshPeriod;
+
+    // the fewest refreshes per frame allowed by the frame rate cap and the thermal status, and
+    // the refreshes per frame used when the level is not static.
+    uint32_t m_minRefreshesPerFrame;
+    uint32_t m_refreshesPerFrame;
+    uint32_t m_idleRefreshesPerFrame;
+    ThermalStatus m_thermalStatus;
+
+    // moving average of the time taken by the frames that were drawn.
+    Clock::duration m_averageFrameTime;
+
+    Clock::time_point m_nextFrame;
+    Clock::time_point m_lastFrameStart;
+    bool m_lastFrameDrawn;
+    Clock::time_point m_lastActivity;
+
+    Clock::time_point m_lastStateChange;
+    Clock::time_point m_lastReport;
+    bool m_sleeping;
+    FrameStatistics m_statistics;
+
+    // the load adaptation slows the frames down to this many times the fewest refreshes per frame.
+    static uint32_t constexpr m_maxLoadRefreshesPerFrame = 8;
+
+    uint32_t refreshesFor(float frameRate) const;
+    void updateMinRefreshesPerFrame();
+};
+
+#endif // AMAZING_LABYRINTH_FRAME_SCHEDULER_HPP
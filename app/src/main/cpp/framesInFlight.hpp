@@ -0,0 +1,227 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_FRAMES_IN_FLIGHT_HPP
+#define AMAZING_LABYRINTH_FRAMES_IN_FLIGHT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/* The bookkeeping for the frames the CPU records while the GPU is still working on earlier ones.
+ * None of it calls Vulkan, the caller waits on the frame's fence before telling these classes
+ * that the frame is done or reusing the frame's resources.
+ */
+namespace vulkan {
+    // the most frames that can be in flight at once.
+    uint32_t constexpr maxFramesInFlight = 3;
+
+    /* The objects that were removed or replaced while frames that use them were still on the GPU:
+     * draw objects, draw object data, descriptor sets, instance buffers and render details.  They
+     * are kept in a list for the last frame submitted when they were released, and the list is
+     * dropped when that frame's fence is signaled.  The frames after it were recorded without
+     * them.
+     */
+    class DeferredRelease {
+    public:
+        // keep resource alive until the frames submitted so far are done.
+        void release(std::shared_ptr<void> resource) {
+            // nothing was submitted yet, so nothing can be using it.
+            if (resource != nullptr && m_lastSubmittedFrame < m_released.size()) {
+                m_released[m_lastSubmittedFrame].push_back(std::move(resource));
+            }
+        }
+
+        // frame was submitted, the objects released from now on wait for its fence.
+        void frameSubmitted(size_t frame) { m_lastSubmittedFrame = frame; }
+
+        // the fence for frame was signaled, free the objects that were waiting for it.
+        void frameDone(size_t frame) { m_released[frame].clear(); }
+
+        explicit DeferredRelease(size_t framesInFlight)
+                : m_released(framesInFlight),
+                  m_lastSubmittedFrame{framesInFlight}
+        {}
+
+    private:
+        // indexed by frame in flight.
+        std::vector<std::vector<std::shared_ptr<void>>> m_released;
+        size_t m_lastSubmittedFrame;
+    };
+
+    /* The writes to the uniform buffers.  A uniform buffer is host visible and divided into
+     * slices of the same size: one for each frame in flight and one for the draws to buffer.  A
+     * frame only reads its own slice (the slice is selected with the dynamic offsets of the
+     * descriptor sets), so the slice can be written by the CPU as soon as the fence for the
+     * frame's last use of it is signaled, while the other frames are still on the GPU.
+     *
+     * The latest values of each buffer are kept here.  A write is copied into the slice of each
+     * frame when the frame is recorded, until all the frame slices in use have it.  The draw to
+     * buffer slice is written in full before each draw to buffer.
+     */
+    template <typename BufferHandle>
+    class SlicedUniformUpdates {
+    public:
+        static uint32_t constexpr drawToBufferSlice = maxFramesInFlight;
+        static uint32_t constexpr numberSlices = maxFramesInFlight + 1;
+
+        // buffer's memory is mapped at memory and holds numberSlices slices of sliceSize bytes.
+        void addBuffer(BufferHandle buffer, void *memory, size_t sliceSize) {
+            m_buffers[buffer] = SlicedBuffer{static_cast<unsigned char *>(memory), sliceSize,
+                                             std::vector<unsigned char>(sliceSize, 0)};
+        }
+
+        // the size of a slice of buffer, 0 if the buffer is not divided in slices.
+        size_t sliceSize(BufferHandle buffer) const {
+            auto it = m_buffers.find(buffer);
+            return it == m_buffers.end() ? 0 : it->second.sliceSize;
+        }
+
+        void update(BufferHandle buffer, void const *data, size_t size) { update(buffer, 0, data, size); }
+
+        // write the data at offset in each slice of the buffer.  Used for the slots of a UniformArena.
+        void update(BufferHandle buffer, size_t offset, void const *data, size_t size) {
+            auto it = m_buffers.find(buffer);
+            if (it == m_buffers.end()) {
+                throw std::runtime_error("Uniform update for a buffer that is not divided in slices.");
+            }
+            if (offset + size > it->second.sliceSize) {
+                throw std::runtime_error("Uniform update is past the end of the buffer's slice.");
+            }
+            memcpy(it->second.values.data() + offset, data, size);
+
+            /* if there is an update already outstanding at this offset, then the slices it was
+             * written to so far have old values now.  Keep any data past the end of this write
+             * from the previous update since it was not written to all the slices yet.
+             */
+            auto &pending = m_pending[std::make_pair(buffer, offset)];
+            pending.size = std::max(pending.size, size);
+            pending.slicesWritten = 0;
+        }
+
+        // the buffer is being destroyed, don't write to it.
+        void discard(BufferHandle buffer) {
+            auto it = m_pending.lower_bound(std::make_pair(buffer, size_t{0}));
+            while (it != m_pending.end() && it->first.first == buffer) {
+                it = m_pending.erase(it);
+            }
+            m_buffers.erase(buffer);
+        }
+
+        // the part of the buffer at offset is no longer used, don't write to it.
+        void discard(BufferHandle buffer, size_t offset) { m_pending.erase(std::make_pair(buffer, offset)); }
+
+        /* the number of frames in flight, the frame slices that are written.  All the values are
+         * written to the frame slices again in case a slice was not used before.
+         */
+        void setFramesInFlight(uint32_t framesInFlight) {
+            if (framesInFlight == 0 || framesInFlight > maxFramesInFlight) {
+                throw std::runtime_error("Invalid number of frames in flight for the uniform buffers.");
+            }
+            m_framesInFlight = framesInFlight;
+            for (auto const &buffer : m_buffers) {
+                m_pending[std::make_pair(buffer.first, size_t{0})] = Pending{buffer.second.sliceSize, 0};
+            }
+        }
+
+        /* copy the writes the slice for frame does not have yet into it.  The fence for the last
+         * frame that read the slice must be signaled.  The draws recorded from now on read this
+         * slice.
+         */
+        void writeSlice(uint32_t frame) {
+            if (frame >= m_framesInFlight) {
+                throw std::runtime_error("Uniform slice written for a frame that is not in flight.");
+            }
+
+            uint32_t const written = 1u << frame;
+            uint32_t const allFramesWritten = (1u << m_framesInFlight) - 1;
+            for (auto it = m_pending.begin(); it != m_pending.end(); ) {
+                if ((it->second.slicesWritten & written) == 0) {
+                    SlicedBuffer &buffer = m_buffers[it->first.first];
+                    memcpy(buffer.memory + frame * buffer.sliceSize + it->first.second,
+                           buffer.values.data() + it->first.second, it->second.size);
+                    it->second.slicesWritten |= written;
+                }
+
+                if (it->second.slicesWritten == allFramesWritten) {
+                    it = m_pending.erase(it);
+                } else {
+                    it++;
+                }
+            }
+
+            m_currentSlice = frame;
+        }
+
+        /* copy all the values into the draw to buffer slice.  The commands of the last draw to
+         * buffer must be done.  The draws recorded from now on read this slice.
+         */
+        void writeDrawToBufferSlice() {
+            for (auto &buffer : m_buffers) {
+                memcpy(buffer.second.memory + drawToBufferSlice * buffer.second.sliceSize,
+                       buffer.second.values.data(), buffer.second.sliceSize);
+            }
+
+            m_currentSlice = drawToBufferSlice;
+        }
+
+        // the slice read by the draws being recorded.
+        uint32_t currentSlice() const { return m_currentSlice; }
+
+        // the number of writes that are not in all the frame slices yet.
+        size_t pendingUpdates() const { return m_pending.size(); }
+
+        SlicedUniformUpdates()
+                : m_buffers{},
+                  m_pending{},
+                  m_framesInFlight{maxFramesInFlight},
+                  m_currentSlice{0}
+        {}
+
+    private:
+        struct SlicedBuffer {
+            unsigned char *memory;
+            size_t sliceSize;
+
+            // the latest values written to the buffer.
+            std::vector<unsigned char> values;
+        };
+
+        struct Pending {
+            size_t size;
+
+            // bit i is set if frame slice i has the latest values.
+            uint32_t slicesWritten;
+        };
+
+        std::map<BufferHandle, SlicedBuffer> m_buffers;
+
+        // indexed by buffer and offset in the slice.
+        std::map<std::pair<BufferHandle, size_t>, Pending> m_pending;
+        uint32_t m_framesInFlight;
+        uint32_t m_currentSlice;
+    };
+}
+
+#endif // AMAZING_LABYRINTH_FRAMES_IN_FLIGHT_HPP
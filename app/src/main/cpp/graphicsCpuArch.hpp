@@ -96,8 +96,10 @@ CQ_DEFINE_VULKAN_HANDLE(VkDescriptorPool)
 CQ_DEFINE_VULKAN_HANDLE(VkShaderModule)
 CQ_DEFINE_VULKAN_HANDLE(VkPipelineLayout)
 CQ_DEFINE_VULKAN_HANDLE(VkPipeline)
+CQ_DEFINE_VULKAN_HANDLE(VkPipelineCache)
 CQ_DEFINE_VULKAN_HANDLE(VkCommandPool)
 CQ_DEFINE_VULKAN_HANDLE(VkSemaphore)
+CQ_DEFINE_VULKAN_HANDLE(VkFence)
 CQ_DEFINE_VULKAN_HANDLE(VkImageView)
 CQ_DEFINE_VULKAN_HANDLE(VkSampler)
 CQ_DEFINE_VULKAN_HANDLE(VkFramebuffer)
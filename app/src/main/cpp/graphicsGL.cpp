@@ -168,6 +168,83 @@ namespace graphicsGL {
         }
     }
 
+    PixelPackBuffer::PixelPackBuffer(size_t size)
+            : m_buffer{0},
+              m_size{size},
+              m_fence{nullptr}
+    {
+        glGenBuffers(1, &m_buffer);
+        checkGraphicsError();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+        checkGraphicsError();
+        glBufferData(GL_PIXEL_PACK_BUFFER, m_size, nullptr, GL_STREAM_READ);
+        checkGraphicsError();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        checkGraphicsError();
+    }
+
+    void PixelPackBuffer::readPixels(uint32_t width, uint32_t height, GLenum format, GLenum type) {
+        if (m_fence != nullptr) {
+            // the pixels from the last read were never retrieved.  GL orders this read after
+            // that one so the old fence is no longer needed.
+            glDeleteSync(m_fence);
+            m_fence = nullptr;
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+        checkGraphicsError();
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        checkGraphicsError();
+
+        // with a pixel pack buffer bound, the last parameter is an offset into the buffer.
+        glReadPixels(0, 0, width, height, format, type, nullptr);
+        checkGraphicsError();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        checkGraphicsError();
+
+        m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        if (m_fence == nullptr) {
+            throw std::runtime_error("Could not create fence sync.");
+        }
+
+        // make sure the commands get to the GPU without waiting for them.
+        glFlush();
+        checkGraphicsError();
+    }
+
+    void PixelPackBuffer::copyTo(void *data, size_t size) {
+        if (m_fence == nullptr) {
+            throw std::runtime_error("Pixel pack buffer: no pixels were read.");
+        }
+
+        if (size > m_size) {
+            throw std::runtime_error("Pixel pack buffer is too small for the requested copy.");
+        }
+
+        GLenum result;
+        do {
+            result = glClientWaitSync(m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, m_waitTimeout);
+        } while (result == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(m_fence);
+        m_fence = nullptr;
+        if (result == GL_WAIT_FAILED) {
+            throw std::runtime_error("Failed to wait on the pixels to be read.");
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+        checkGraphicsError();
+        void *pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+        if (pixels == nullptr) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            throw std::runtime_error("Could not map the pixel pack buffer.");
+        }
+        memcpy(data, pixels, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        checkGraphicsError();
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        checkGraphicsError();
+    }
+
     Framebuffer::Framebuffer(uint32_t width, uint32_t height, std::vector<Framebuffer::ColorImageFormat> colorImageFormats)
             : m_depthMapFBO(GL_INVALID_VALUE),
               m_depthMap(GL_INVALID_VALUE),
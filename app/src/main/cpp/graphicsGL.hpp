@@ -136,10 +136,49 @@ namespace graphicsGL {
         std::vector<GLuint> m_colorImage;
     };
 
+    /* A buffer glReadPixels copies the bound framebuffer into without waiting for the draws to
+     * that framebuffer to finish.  A fence sync is inserted after the copy and waited on only
+     * when the pixels are needed on the CPU.  Needs OpenGL ES 3.
+     */
+    class PixelPackBuffer {
+    public:
+        explicit PixelPackBuffer(size_t size);
+
+        // start the copy of color attachment 0 of the bound framebuffer into this buffer.
+        void readPixels(uint32_t width, uint32_t height, GLenum format, GLenum type);
+
+        // wait for the copy started by readPixels to complete and copy the pixels into data.
+        void copyTo(void *data, size_t size);
+
+        ~PixelPackBuffer() {
+            if (m_fence != nullptr) {
+                glDeleteSync(m_fence);
+            }
+            glDeleteBuffers(1, &m_buffer);
+        }
+
+    private:
+        // how long to wait on the fence at a time (in ns).
+        static GLuint64 constexpr m_waitTimeout = 1000000000;
+
+        GLuint m_buffer;
+        size_t m_size;
+        GLsync m_fence;
+    };
+
     struct SurfaceDetails {
         uint32_t surfaceWidth;
         uint32_t surfaceHeight;
         bool useIntTexture;
+
+        // pixel pack buffers and fence syncs need OpenGL ES 3.
+        bool usePixelPackBuffers;
+
+        // instanced draws (glDrawElementsInstanced and glVertexAttribDivisor) need OpenGL ES 3.
+        bool useInstancing;
+
+        // glBlitFramebuffer needs OpenGL ES 3.
+        bool useBlitFramebuffer;
     };
 } /* namespace graphicsGL */
 
@@ -18,6 +18,8 @@
  *
  */
 
+#include <cstdio>
+
 #include "graphicsVulkan.hpp"
 
 namespace vulkan {
@@ -30,8 +32,10 @@ namespace vulkan {
     CQ_DEFINE_VULKAN_CREATOR(VkShaderModule)
     CQ_DEFINE_VULKAN_CREATOR(VkPipelineLayout)
     CQ_DEFINE_VULKAN_CREATOR(VkPipeline)
+    CQ_DEFINE_VULKAN_CREATOR(VkPipelineCache)
     CQ_DEFINE_VULKAN_CREATOR(VkCommandPool)
     CQ_DEFINE_VULKAN_CREATOR(VkSemaphore)
+    CQ_DEFINE_VULKAN_CREATOR(VkFence)
     CQ_DEFINE_VULKAN_CREATOR(VkImageView)
     CQ_DEFINE_VULKAN_CREATOR(VkSampler)
 
@@ -95,6 +99,12 @@ namespace vulkan {
         deleteIfNecessary(inSemaphore);
     }
 
+    // Fences
+    inline void deleteVkFence_CQ(std::shared_ptr<Device> const &inDevice, VkFence_CQ *inFence) {
+        vkDestroyFence(inDevice->logicalDevice().get(), getVkType<>(inFence), nullptr);
+        deleteIfNecessary(inFence);
+    }
+
     // Image View
     inline void deleteVkImageView_CQ(std::shared_ptr<Device> const &inDevice, VkImageView_CQ *imageView) {
         vkDestroyImageView(inDevice->logicalDevice().get(), getVkType<>(imageView), nullptr);
@@ -318,17 +328,23 @@ namespace vulkan {
     }
 
     /* find supported image formats for depth buffering */
+    bool Device::formatSupported(VkFormat format, VkImageTiling tiling, VkFormatFeatureFlags features) {
+        VkFormatProperties props;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice(), format, &props);
+
+        if (tiling == VK_IMAGE_TILING_LINEAR) {
+            return (props.linearTilingFeatures & features) == features;
+        } else if (tiling == VK_IMAGE_TILING_OPTIMAL) {
+            return (props.optimalTilingFeatures & features) == features;
+        }
+
+        return false;
+    }
+
     VkFormat Device::findSupportedFormat(const std::vector<VkFormat> &candidates,
                                          VkImageTiling tiling, VkFormatFeatureFlags features) {
         for (VkFormat format : candidates) {
-            VkFormatProperties props;
-            vkGetPhysicalDeviceFormatProperties(physicalDevice(), format, &props);
-
-            if (tiling == VK_IMAGE_TILING_LINEAR &&
-                (props.linearTilingFeatures & features) == features) {
-                return format;
-            } else if (tiling == VK_IMAGE_TILING_OPTIMAL &&
-                       (props.optimalTilingFeatures & features) == features) {
+            if (formatSupported(format, tiling, features)) {
                 return format;
             }
         }
@@ -457,6 +473,13 @@ namespace vulkan {
         return DeviceProperties(deviceProperties.deviceName, deviceProperties.apiVersion);
     }
 
+    VkDeviceSize Device::minUniformBufferOffsetAlignment() {
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(m_physicalDevice, &deviceProperties);
+
+        return deviceProperties.limits.minUniformBufferOffsetAlignment;
+    }
+
     void Device::createLogicalDevice() {
         QueueFamilyIndices indices = findQueueFamilies();
         std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
@@ -554,6 +577,177 @@ namespace vulkan {
         return requiredExtensions.empty();
     }
 
+    PipelineCache::PipelineCache(std::shared_ptr<VkDevice_T> inLogicalDevice,
+                                 VkPhysicalDevice physicalDevice,
+                                 std::string inFileName)
+            : m_logicalDevice{std::move(inLogicalDevice)},
+              m_properties{},
+              m_fileName{std::move(inFileName)},
+              m_savedDataSize{0},
+              m_pipelineCache{}
+    {
+        vkGetPhysicalDeviceProperties(physicalDevice, &m_properties);
+
+        std::vector<char> data = loadData();
+
+        VkPipelineCacheCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = data.size();
+        createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+        VkPipelineCache pipelineCacheRaw;
+        if (vkCreatePipelineCache(m_logicalDevice.get(), &createInfo, nullptr, &pipelineCacheRaw) != VK_SUCCESS) {
+            // the driver did not like the data for some reason.  Try again with an empty cache.
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            if (vkCreatePipelineCache(m_logicalDevice.get(), &createInfo, nullptr, &pipelineCacheRaw) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create pipeline cache!");
+            }
+        } else {
+            m_savedDataSize = data.size();
+        }
+
+        auto const &capDevice = m_logicalDevice;
+        auto deleter = [capDevice](VkPipelineCache_CQ *pipelineCache) {
+            vkDestroyPipelineCache(capDevice.get(), getVkType<>(pipelineCache), nullptr);
+            deleteIfNecessary(pipelineCache);
+        };
+
+        m_pipelineCache.reset(createVkPipelineCache_CQ(pipelineCacheRaw), deleter);
+    }
+
+    uint64_t PipelineCache::checksum(std::vector<char> const &data) {
+        // FNV-1a, just used to catch files that were truncated or corrupted.
+        uint64_t hash = 14695981039346656037ULL;
+        for (char c : data) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    PipelineCache::FileHeader PipelineCache::expectedHeader(uint64_t dataSize, uint64_t dataChecksum) {
+        FileHeader header = {};
+        header.magic = m_fileMagic;
+        header.version = m_fileVersion;
+        header.vendorID = m_properties.vendorID;
+        header.deviceID = m_properties.deviceID;
+        header.driverVersion = m_properties.driverVersion;
+        memcpy(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE);
+        header.reserved = 0;
+        header.dataSize = dataSize;
+        header.dataChecksum = dataChecksum;
+        return header;
+    }
+
+    bool PipelineCache::headerMatchesDevice(FileHeader const &header) {
+        return header.magic == m_fileMagic &&
+               header.version == m_fileVersion &&
+               header.vendorID == m_properties.vendorID &&
+               header.deviceID == m_properties.deviceID &&
+               header.driverVersion == m_properties.driverVersion &&
+               memcmp(header.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+    std::vector<char> PipelineCache::loadData() {
+        if (m_fileName.empty()) {
+            return std::vector<char>{};
+        }
+
+        std::ifstream file(m_fileName, std::ios::binary);
+        if (!file.is_open()) {
+            return std::vector<char>{};
+        }
+
+        FileHeader header = {};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof (header))) {
+            return std::vector<char>{};
+        }
+
+        /* the data is only valid on the same GPU and driver that created it.  Ignore the file
+         * (don't even read the data) if it was created somewhere else or by an older version of
+         * the app.
+         */
+        if (!headerMatchesDevice(header) || header.dataSize > m_maxDataSize) {
+            return std::vector<char>{};
+        }
+
+        std::vector<char> data(header.dataSize);
+        if (!file.read(data.data(), data.size()) || checksum(data) != header.dataChecksum) {
+            return std::vector<char>{};
+        }
+
+        /* Vulkan puts its own header at the start of the data.  Check it too since some drivers
+         * don't check it and crash on bad data.
+         */
+        VkPipelineCacheHeaderVersionOne vkHeader = {};
+        if (data.size() < sizeof (vkHeader)) {
+            return std::vector<char>{};
+        }
+        memcpy(&vkHeader, data.data(), sizeof (vkHeader));
+        if (vkHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+            vkHeader.vendorID != m_properties.vendorID ||
+            vkHeader.deviceID != m_properties.deviceID ||
+            memcmp(vkHeader.pipelineCacheUUID, m_properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+            return std::vector<char>{};
+        }
+
+        return data;
+    }
+
+    void PipelineCache::save() {
+        if (m_fileName.empty()) {
+            return;
+        }
+
+        size_t dataSize = 0;
+        if (vkGetPipelineCacheData(m_logicalDevice.get(), getVkType<>(m_pipelineCache.get()),
+                                   &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) {
+            return;
+        }
+
+        /* pipelines only get added to the cache, so if the size did not change, then there is
+         * nothing new to save.
+         */
+        if (dataSize == m_savedDataSize) {
+            return;
+        }
+
+        std::vector<char> data(dataSize);
+        if (vkGetPipelineCacheData(m_logicalDevice.get(), getVkType<>(m_pipelineCache.get()),
+                                   &dataSize, data.data()) != VK_SUCCESS) {
+            return;
+        }
+        data.resize(dataSize);
+
+        FileHeader header = expectedHeader(data.size(), checksum(data));
+
+        /* write to a temporary file and rename it so that we never leave a partially written cache
+         * file behind.  A failure to save the cache is not fatal, we will just recreate the
+         * pipelines next time.
+         */
+        std::string tmpFileName = m_fileName + ".tmp";
+        {
+            std::ofstream file(tmpFileName, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return;
+            }
+            file.write(reinterpret_cast<char const *>(&header), sizeof (header));
+            file.write(data.data(), data.size());
+            if (!file.good()) {
+                file.close();
+                std::remove(tmpFileName.c_str());
+                return;
+            }
+        }
+
+        if (std::rename(tmpFileName.c_str(), m_fileName.c_str()) == 0) {
+            m_savedDataSize = data.size();
+        } else {
+            std::remove(tmpFileName.c_str());
+        }
+    }
+
     void Device::createAllocator() {
         VmaAllocatorCreateInfo allocatorInfo = {};
         allocatorInfo.physicalDevice = m_physicalDevice;
@@ -819,16 +1013,22 @@ namespace vulkan {
         dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
         dependency.dstSubpass = 0;
 
-        /* wait for the VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT stage */
-        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        /* wait for the VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT stage.  There is only one
+         * depth image shared by all the frames in flight, so also wait for the previous frame to
+         * finish its depth tests before this frame clears and writes the depth image.
+         */
+        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
         dependency.srcAccessMask = 0;
 
         /* prevent the transition from happening until when we want to start writing colors to
-         * the color attachment.
+         * the color attachment or depth values to the depth attachment.
          */
-        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
         dependency.dstAccessMask =
-                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
         /* create the render pass */
         std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
@@ -950,16 +1150,23 @@ namespace vulkan {
         dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
         dependency.dstSubpass = 0;
 
-        /* wait for the VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT stage */
-        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        /* wait for the VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT stage.  The images rendered
+         * by these render passes are reused by every frame in flight and the previous frame may
+         * still be sampling them in its fragment shader, so wait for that too.
+         */
+        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
         dependency.srcAccessMask = 0;
 
         /* prevent the transition from happening until when we want to start writing colors to
-         * the color attachment.
+         * the color attachment or depth values to the depth attachment.
          */
-        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
         dependency.dstAccessMask =
-                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
         //std::array<VkAttachmentDescription, 2> attachments{ colorAttachment, depthAttachment };
 
@@ -1014,7 +1221,7 @@ namespace vulkan {
 
     void Pipeline::createGraphicsPipeline(
         std::shared_ptr<FileRequester> const &requester,
-        VkVertexInputBindingDescription const &bindingDescription,
+        std::vector<VkVertexInputBindingDescription> const &bindingDescriptions,
         std::vector<VkVertexInputAttributeDescription> const &attributeDescriptions,
         std::string const vertShader,
         std::string const fragShader,
@@ -1057,8 +1264,8 @@ namespace vulkan {
         VkPipelineVertexInputStateCreateInfo vertexInputInfo = {};
         vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
-        vertexInputInfo.vertexBindingDescriptionCount = 1;
-        vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+        vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
+        vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
         vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
         vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
@@ -1282,7 +1489,8 @@ namespace vulkan {
         pipelineInfo.basePipelineIndex = -1;
 
         VkPipeline pipelineRaw;
-        if (vkCreateGraphicsPipelines(m_device->logicalDevice().get(), VK_NULL_HANDLE/*pipeline cache*/, 1,
+        if (vkCreateGraphicsPipelines(m_device->logicalDevice().get(),
+                                      getVkType<>(m_device->pipelineCache()->pipelineCache().get()), 1,
                                       &pipelineInfo, nullptr, &pipelineRaw) != VK_SUCCESS) {
             throw std::runtime_error("failed to create graphics pipeline!");
         }
@@ -1332,7 +1540,7 @@ namespace vulkan {
     void CommandBuffer::create() {
         VkCommandBufferAllocateInfo allocInfo = {};
         allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.level = m_level;
         allocInfo.commandPool = getVkType<>(m_pool->commandPool().get());
         allocInfo.commandBufferCount = 1;
 
@@ -1361,6 +1569,29 @@ namespace vulkan {
         vkBeginCommandBuffer(m_commandBuffer.get(), &beginInfo);
     }
 
+    void CommandBuffer::begin(VkRenderPass renderPass) {
+        // the framebuffer is not known when the commands are recorded, they are executed in
+        // the render pass for every swap chain image.
+        VkCommandBufferInheritanceInfo inheritanceInfo = {};
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.renderPass = renderPass;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = m_usageFlag;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        vkBeginCommandBuffer(m_commandBuffer.get(), &beginInfo);
+    }
+
+    void CommandBuffer::endRecording() {
+        if (vkEndCommandBuffer(m_commandBuffer.get()) != VK_SUCCESS) {
+            throw std::runtime_error("failed to record command buffer!");
+        }
+    }
+
     void CommandBuffer::end(
         Semaphore &waitSemaphore,
         VkPipelineStageFlags pipelineStage,
@@ -1417,6 +1648,25 @@ namespace vulkan {
         }
     }
 
+    void CommandBuffer::end(Fence &fence) {
+        vkEndCommandBuffer(m_commandBuffer.get());
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+
+        // command is expecting an array of command buffers.  commandBufferRaw is passed in
+        // as const and will not be modified.
+        VkCommandBuffer commandBufferRaw = m_commandBuffer.get();
+        submitInfo.pCommandBuffers = &commandBufferRaw;
+
+        VkResult result = vkQueueSubmit(m_device->graphicsQueue(), 1, &submitInfo,
+                getVkType<>(fence.fence().get()));
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error("failed to submit command buffer!");
+        }
+    }
+
     void CommandBuffer::end() {
         vkEndCommandBuffer(m_commandBuffer.get());
 
@@ -1462,6 +1712,16 @@ namespace vulkan {
         }
     }
 
+    void Buffer::createSlicedBuffer(VkDeviceSize sliceSize, VkBufferUsageFlags usage,
+                                    VkMemoryPropertyFlags propertyFlags) {
+        // the slices are selected with dynamic offsets, so they have to be aligned like them.
+        VkDeviceSize alignment = std::max(m_device->minUniformBufferOffsetAlignment(), VkDeviceSize{1});
+        sliceSize = (sliceSize + alignment - 1) / alignment * alignment;
+
+        createBuffer(sliceSize * UniformUpdates::numberSlices, usage, propertyFlags);
+        m_device->uniformUpdates().addBuffer(m_buffer, mappedMemory(), static_cast<size_t>(sliceSize));
+    }
+
     /* copy the data from CPU readable memory in the graphics card to non-CPU readable memory */
     void Buffer::copyTo(std::shared_ptr<CommandPool> pool, Buffer const &srcBuffer,
                         VkDeviceSize size) {
@@ -1478,6 +1738,11 @@ namespace vulkan {
 
     /* copy data from CPU memory to graphics memory */
     void Buffer::copyRawTo(void const *dataRaw, size_t size) {
+        if (m_slicedPerFrame) {
+            m_device->uniformUpdates().update(m_buffer, dataRaw, size);
+            return;
+        }
+
         void *data;
         VkResult result = vmaMapMemory(m_device->allocator().get(), m_allocation, &data);
         if (result != VK_SUCCESS) {
@@ -1498,6 +1763,65 @@ namespace vulkan {
         vmaUnmapMemory(m_device->allocator().get(), m_allocation);
     }
 
+    void *Buffer::mappedMemory() {
+        if (m_mapped == nullptr) {
+            VkResult result = vmaMapMemory(m_device->allocator().get(), m_allocation, &m_mapped);
+            if (result != VK_SUCCESS) {
+                m_mapped = nullptr;
+                throw (std::runtime_error("Can't map memory."));
+            }
+        }
+        return m_mapped;
+    }
+
+    void DescriptorSet::updateDescriptors(uint32_t count, VkWriteDescriptorSet const *writes) {
+        auto const &device = m_descriptorPools->m_device;
+        for (uint32_t i = 0; i < count; i++) {
+            if (writes[i].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+                throw std::runtime_error("Uniform buffer descriptors must be dynamic to select the frame's slice.");
+            }
+        }
+
+        vkUpdateDescriptorSets(device->logicalDevice().get(), count, writes, 0, nullptr);
+
+        for (uint32_t i = 0; i < count; i++) {
+            if (writes[i].descriptorType != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+                continue;
+            }
+
+            for (uint32_t j = 0; j < writes[i].descriptorCount; j++) {
+                VkBuffer buffer = writes[i].pBufferInfo[j].buffer;
+                UniformDescriptor descriptor{writes[i].dstBinding, writes[i].dstArrayElement + j,
+                                             buffer, device->uniformUpdates().sliceSize(buffer)};
+
+                auto it = std::lower_bound(m_uniformDescriptors.begin(), m_uniformDescriptors.end(),
+                        descriptor, [](UniformDescriptor const &a, UniformDescriptor const &b) -> bool {
+                            return a.binding < b.binding ||
+                                   (a.binding == b.binding && a.arrayElement < b.arrayElement);
+                        });
+                if (it != m_uniformDescriptors.end() && it->binding == descriptor.binding &&
+                    it->arrayElement == descriptor.arrayElement)
+                {
+                    *it = descriptor;
+                } else {
+                    m_uniformDescriptors.insert(it, descriptor);
+                }
+            }
+        }
+    }
+
+    void DescriptorSet::dynamicOffsets(uint32_t perObjectOffset, std::vector<uint32_t> &offsets) {
+        uint32_t slice = m_descriptorPools->m_device->uniformUpdates().currentSlice();
+        offsets.clear();
+        for (auto const &descriptor : m_uniformDescriptors) {
+            VkDeviceSize offset = slice * descriptor.sliceSize;
+            if (descriptor.buffer == m_perObjectBuffer) {
+                offset += perObjectOffset;
+            }
+            offsets.push_back(static_cast<uint32_t>(offset));
+        }
+    }
+
     void Semaphore::createSemaphore() {
         VkSemaphoreCreateInfo semaphoreInfo = {};
         semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -1515,6 +1839,54 @@ namespace vulkan {
         m_semaphore.reset(createVkSemaphore_CQ(semaphoreRaw), deleter);
     }
 
+    void Fence::createFence(bool signaled) {
+        VkFenceCreateInfo fenceInfo = {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+        /* create the fence in the signaled state if requested so that the first wait on it
+         * returns right away (there is no prior submission to wait on).
+         */
+        fenceInfo.flags = signaled ? VK_FENCE_CREATE_SIGNALED_BIT : 0;
+        VkFence fenceRaw;
+        if (vkCreateFence(m_device->logicalDevice().get(), &fenceInfo, nullptr, &fenceRaw) !=
+            VK_SUCCESS) {
+            throw std::runtime_error("failed to create fence!");
+        }
+
+        auto const &capDevice = m_device;
+        auto deleter = [capDevice](VkFence_CQ *fenceRaw) {
+            deleteVkFence_CQ(capDevice, fenceRaw);
+        };
+
+        m_fence.reset(createVkFence_CQ(fenceRaw), deleter);
+    }
+
+    bool Fence::isSignaled() {
+        VkResult result = vkGetFenceStatus(m_device->logicalDevice().get(), getVkType<>(m_fence.get()));
+        if (result == VK_SUCCESS) {
+            return true;
+        } else if (result == VK_NOT_READY) {
+            return false;
+        }
+
+        throw std::runtime_error("failed to get fence status!");
+    }
+
+    void Fence::wait() {
+        VkFence fences[] = {getVkType<>(m_fence.get())};
+        if (vkWaitForFences(m_device->logicalDevice().get(), 1, fences, VK_TRUE,
+                std::numeric_limits<uint64_t>::max()) != VK_SUCCESS) {
+            throw std::runtime_error("failed to wait for fence!");
+        }
+    }
+
+    void Fence::reset() {
+        VkFence fences[] = {getVkType<>(m_fence.get())};
+        if (vkResetFences(m_device->logicalDevice().get(), 1, fences) != VK_SUCCESS) {
+            throw std::runtime_error("failed to reset fence!");
+        }
+    }
+
     void Image::createImage(VkFormat format, VkImageTiling tiling,
                             VkImageUsageFlags usage, VkMemoryPropertyFlags properties) {
 
@@ -1528,7 +1900,7 @@ namespace vulkan {
         imageInfo.extent.width = m_width;
         imageInfo.extent.height = m_height;
         imageInfo.extent.depth = 1;
-        imageInfo.mipLevels = 1;
+        imageInfo.mipLevels = m_mipLevels;
         imageInfo.arrayLayers = 1;
 
         /* must be the same format as the pixels in the buffer otherwise the copy will fail */
@@ -1577,7 +1949,12 @@ namespace vulkan {
                                       VkImageLayout newLayout, std::shared_ptr<CommandPool> const &pool) {
         CommandBuffer cmds{m_device, pool};
         cmds.begin();
+        addTransitionImageLayoutCmds(cmds.commandBuffer().get(), oldLayout, newLayout);
+        cmds.end();
+    }
 
+    void Image::addTransitionImageLayoutCmds(VkCommandBuffer commandBuffer, VkImageLayout oldLayout,
+                                             VkImageLayout newLayout) {
         /* use an image barrier to transition the layout */
         VkImageMemoryBarrier barrier = {};
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -1591,11 +1968,11 @@ namespace vulkan {
         barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 
         /* define the image that is affected and the part of the image.  our image is not an array
-         * and does not have mipmapping levels.  Only specify one level and layer.
+         * so only specify one layer, but transition all the mipmapping levels.
          */
         barrier.image = m_image;
         barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.levelCount = m_mipLevels;
         barrier.subresourceRange.baseArrayLayer = 0;
         barrier.subresourceRange.layerCount = 1;
 
@@ -1653,15 +2030,93 @@ namespace vulkan {
         }
 
         vkCmdPipelineBarrier(
-                cmds.commandBuffer().get(),
+                commandBuffer,
                 sourceStage, destinationStage,
                 0,
                 0, nullptr,
                 0, nullptr,
                 1, &barrier
         );
+    }
 
-        cmds.end();
+    void Image::addGenerateMipLevelsCmds(VkCommandBuffer commandBuffer, uint32_t nbrLoadedLevels) {
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+
+        // the loaded levels that are not blitted from are ready to be read by the shaders.
+        if (nbrLoadedLevels > 1) {
+            barrier.subresourceRange.baseMipLevel = 0;
+            barrier.subresourceRange.levelCount = nbrLoadedLevels - 1;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+                                 1, &barrier);
+        }
+
+        barrier.subresourceRange.levelCount = 1;
+        auto levelWidth = static_cast<int32_t>(std::max(m_width >> (nbrLoadedLevels - 1), 1u));
+        auto levelHeight = static_cast<int32_t>(std::max(m_height >> (nbrLoadedLevels - 1), 1u));
+        for (uint32_t level = nbrLoadedLevels; level < m_mipLevels; level++) {
+            /* the level before this one has to be written before it is read from. */
+            barrier.subresourceRange.baseMipLevel = level - 1;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                                 1, &barrier);
+
+            int32_t nextWidth = std::max(levelWidth / 2, 1);
+            int32_t nextHeight = std::max(levelHeight / 2, 1);
+
+            VkImageBlit blit = {};
+            blit.srcOffsets[0] = {0, 0, 0};
+            blit.srcOffsets[1] = {levelWidth, levelHeight, 1};
+            blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            blit.srcSubresource.mipLevel = level - 1;
+            blit.srcSubresource.baseArrayLayer = 0;
+            blit.srcSubresource.layerCount = 1;
+            blit.dstOffsets[0] = {0, 0, 0};
+            blit.dstOffsets[1] = {nextWidth, nextHeight, 1};
+            blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            blit.dstSubresource.mipLevel = level;
+            blit.dstSubresource.baseArrayLayer = 0;
+            blit.dstSubresource.layerCount = 1;
+            vkCmdBlitImage(commandBuffer, m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+            /* done with the level before this one. */
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+                                 1, &barrier);
+
+            levelWidth = nextWidth;
+            levelHeight = nextHeight;
+        }
+
+        /* the last level is only written to. */
+        barrier.subresourceRange.baseMipLevel = m_mipLevels - 1;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+                             1, &barrier);
     }
 
     void Image::copyBufferToImage(Buffer &buffer, std::shared_ptr<CommandPool> const &pool) {
@@ -1699,10 +2154,42 @@ namespace vulkan {
         cmds.end();
     }
 
+    void Image::addCopyLevelsFromBufferCmds(VkCommandBuffer commandBuffer, VkBuffer buffer,
+                                            VkDeviceSize bufferOffset,
+                                            std::vector<levelDrawer::TextureLevel> const &levels) {
+        std::vector<VkBufferImageCopy> regions;
+        for (size_t i = 0; i < levels.size(); i++) {
+            VkBufferImageCopy region = {};
+
+            /* offset in the buffer where the level starts.  The levels are tightly packed so
+             * bufferRowLength and bufferImageHeight are 0.
+             */
+            region.bufferOffset = bufferOffset + levels[i].offset;
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = static_cast<uint32_t>(i);
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+
+            region.imageOffset = {0, 0, 0};
+            region.imageExtent = {levels[i].width, levels[i].height, 1};
+            regions.push_back(region);
+        }
+
+        vkCmdCopyBufferToImage(commandBuffer, buffer, m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               static_cast<uint32_t>(regions.size()), regions.data());
+    }
+
     void Image::copyImageToBuffer(Buffer &buffer, std::shared_ptr<CommandPool> const &pool) {
         CommandBuffer cmds{m_device, pool};
         cmds.begin();
+        addCopyImageToBufferCmds(cmds.commandBuffer().get(), buffer);
+        cmds.end();
+    }
 
+    void Image::addCopyImageToBufferCmds(VkCommandBuffer commandBuffer, Buffer &buffer) {
         VkBufferImageCopy region = {};
 
         /* offset in the buffer where the image starts. */
@@ -1728,11 +2215,9 @@ namespace vulkan {
                 1
         };
 
-        vkCmdCopyImageToBuffer(cmds.commandBuffer().get(),
+        vkCmdCopyImageToBuffer(commandBuffer,
                                m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
                                buffer.buffer(), 1, &region);
-
-        cmds.end();
     }
 
     void ImageView::createImageView(VkFormat format, VkImageAspectFlags aspectFlags) {
@@ -1755,12 +2240,12 @@ namespace vulkan {
         createInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
 
         /* subresourcesRange describes the image's purpose and which part of the image
-         * should be accessed.  Use the images as color targets without any mimapping levels
-         * or multiple layers.
+         * should be accessed.  Use the images as color targets with all their mimapping levels
+         * and without multiple layers.
          */
         createInfo.subresourceRange.aspectMask = aspectFlags;
         createInfo.subresourceRange.baseMipLevel = 0;
-        createInfo.subresourceRange.levelCount = 1;
+        createInfo.subresourceRange.levelCount = m_image->mipLevels();
         createInfo.subresourceRange.baseArrayLayer = 0;
         createInfo.subresourceRange.layerCount = 1;
 
@@ -1803,22 +2288,243 @@ namespace vulkan {
                           VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
                           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-        /* transition the image to VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL. The image was created with
-         * layout: VK_IMAGE_LAYOUT_UNDEFINED, so we use that to specify the old layout.
+        /* record the layout transitions and the copy in one command buffer so that the upload
+         * only waits for the queue once.
          */
-        image->transitionImageLayout(VK_IMAGE_LAYOUT_UNDEFINED,
-                                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, cmdPool);
+        CommandBuffer cmds{device, cmdPool};
+        cmds.begin();
+        image->addTransitionImageLayoutCmds(cmds.commandBuffer().get(), VK_IMAGE_LAYOUT_UNDEFINED,
+                                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        image->addCopyLevelsFromBufferCmds(cmds.commandBuffer().get(), staging.buffer(), 0,
+                                           {levelDrawer::TextureLevel{texWidth, texHeight, 0, static_cast<size_t>(imageSize)}});
+        image->addTransitionImageLayoutCmds(cmds.commandBuffer().get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        cmds.end();
 
-        image->copyBufferToImage(staging, cmdPool);
+        return image;
+    }
+
+    std::shared_ptr<Image> ImageFactory::createTextureImage(std::shared_ptr<Device> const &device,
+                                                            StagingRing &stagingRing,
+                                                            levelDrawer::TextureImage const &textureImage,
+                                                            VkFormat format)
+    {
+        if (textureImage.levels.empty()) {
+            throw std::runtime_error("Texture has no mip levels.");
+        }
+
+        uint32_t width = textureImage.levels[0].width;
+        uint32_t height = textureImage.levels[0].height;
+        auto mipLevels = static_cast<uint32_t>(textureImage.levels.size());
+        VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        if (mipLevels == 1 && (width > 1 || height > 1) &&
+            device->formatSupported(format, VK_IMAGE_TILING_OPTIMAL,
+                    VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                    VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+        {
+            // no mip levels came with the texture, blit them from level 0 when it is uploaded.
+            uint32_t size = std::max(width, height);
+            while (size > 1) {
+                size /= 2;
+                mipLevels++;
+            }
+            usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        }
+
+        auto image = std::make_shared<Image>(device, width, height, format,
+                          VK_IMAGE_TILING_OPTIMAL, usage,
+                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, mipLevels);
+
+        stagingRing.uploadToImage(image, textureImage);
 
-        /* transition the image to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL so that the
-         * shader can read from it.
-         */
-        image->transitionImageLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, cmdPool);
         return image;
     }
 
+    std::shared_ptr<UniformSlot> UniformArena::allocate() {
+        // use the first buffer with a free slot so that the later buffers empty out.
+        size_t bufferIndex = 0;
+        while (bufferIndex < m_freeSlots.size() && m_freeSlots[bufferIndex].empty()) {
+            bufferIndex++;
+        }
+
+        if (bufferIndex == m_buffers.size()) {
+            // each frame in flight reads the slots in its own slice of the buffer, see UniformUpdates.
+            m_buffers.push_back(std::make_shared<Buffer>(m_device, m_slotSize * m_slotsPerBuffer,
+                    VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, true));
+
+            // hand the slots out from the start of the buffer.
+            std::vector<uint32_t> freeSlots;
+            for (uint32_t i = m_slotsPerBuffer; i > 0; i--) {
+                freeSlots.push_back(static_cast<uint32_t>(m_slotSize * (i - 1)));
+            }
+            m_freeSlots.push_back(std::move(freeSlots));
+        }
+
+        uint32_t offset = m_freeSlots[bufferIndex].back();
+        m_freeSlots[bufferIndex].pop_back();
+
+        return std::shared_ptr<UniformSlot>{new UniformSlot{shared_from_this(), m_buffers[bufferIndex],
+                                                            bufferIndex, offset}};
+    }
+
+    void UniformArena::free(size_t bufferIndex, uint32_t offset) {
+        // a frame still in flight might read the slot, but the next owner's writes only go into
+        // the slices of the frames recorded after it is done.
+        m_device->uniformUpdates().discard(m_buffers[bufferIndex]->buffer(), offset);
+        m_freeSlots[bufferIndex].push_back(offset);
+    }
+
+    void UniformSlot::copyRawTo(void const *dataRaw, size_t size) {
+        if (size > m_arena->m_dataSize) {
+            throw std::runtime_error("Uniform data is too big for its uniform arena slot.");
+        }
+        m_arena->m_device->uniformUpdates().update(m_buffer->buffer(), m_offset, dataRaw, size);
+    }
+
+    UniformSlot::~UniformSlot() {
+        m_arena->free(m_bufferIndex, m_offset);
+    }
+
+    void StagingRing::createRing(VkDeviceSize size) {
+        m_ring = std::make_shared<Buffer>(m_device, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                          VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        m_mapped = static_cast<char *>(m_ring->mappedMemory());
+        m_size = size;
+        m_head = 0;
+        m_tail = 0;
+    }
+
+    bool StagingRing::tryAllocate(VkDeviceSize size, VkDeviceSize &offset) {
+        bool empty = m_pending.ring != m_ring &&
+                std::none_of(m_inFlight.begin(), m_inFlight.end(),
+                             [this](Batch const &batch) -> bool { return batch.ring == m_ring; });
+        if (empty) {
+            m_head = 0;
+            m_tail = 0;
+        }
+
+        /* m_head never catches up to m_tail from behind, so m_head == m_tail only when the ring
+         * is empty.
+         */
+        offset = (m_head + m_alignment - 1) / m_alignment * m_alignment;
+        if (m_head >= m_tail) {
+            // the used part does not wrap: try after it, then at the start of the ring.
+            if (offset + size > m_size) {
+                if (size >= m_tail) {
+                    return false;
+                }
+                offset = 0;
+            }
+        } else if (offset + size >= m_tail) {
+            return false;
+        }
+
+        m_head = offset + size;
+        m_pending.ring = m_ring;
+        return true;
+    }
+
+    VkDeviceSize StagingRing::allocate(VkDeviceSize size) {
+        retireCompleted();
+
+        VkDeviceSize offset;
+        while (!tryAllocate(size, offset)) {
+            if (std::any_of(m_inFlight.begin(), m_inFlight.end(),
+                            [this](Batch const &batch) -> bool { return batch.ring == m_ring; })) {
+                // uploads from an earlier submission are still using the ring.
+                m_inFlight.front().fence->wait();
+                retireCompleted();
+                continue;
+            }
+
+            /* the uploads that are not submitted yet fill the ring.  Keep them all in one
+             * submission by moving to a bigger ring.  The pending copies keep the old ring alive.
+             */
+            if (m_pending.cmds) {
+                m_pending.resources.push_back(m_ring);
+            }
+            createRing(std::max(m_size * 2, (size + m_alignment - 1) / m_alignment * m_alignment));
+        }
+
+        return offset;
+    }
+
+    void StagingRing::retireCompleted() {
+        while (!m_inFlight.empty() && m_inFlight.front().fence->isSignaled()) {
+            auto const &batch = m_inFlight.front();
+            if (batch.ring == m_ring) {
+                m_tail = batch.end;
+            }
+            m_inFlight.pop_front();
+        }
+    }
+
+    VkCommandBuffer StagingRing::pendingCommandBuffer() {
+        if (!m_pending.cmds) {
+            m_pending.cmds = std::make_shared<CommandBuffer>(m_device, m_pool);
+            m_pending.cmds->begin();
+        }
+        return m_pending.cmds->commandBuffer().get();
+    }
+
+    void StagingRing::uploadToBuffer(std::shared_ptr<Buffer> const &buffer, void const *data,
+                                     VkDeviceSize size) {
+        VkDeviceSize offset = allocate(size);
+        memcpy(m_mapped + offset, data, size);
+
+        VkBufferCopy copyRegion = {};
+        copyRegion.srcOffset = offset;
+        copyRegion.dstOffset = 0;
+        copyRegion.size = size;
+        vkCmdCopyBuffer(pendingCommandBuffer(), m_ring->buffer(), buffer->buffer(), 1, &copyRegion);
+
+        m_pending.resources.push_back(buffer);
+    }
+
+    void StagingRing::uploadToImage(std::shared_ptr<Image> const &image,
+                                    levelDrawer::TextureImage const &textureImage) {
+        VkDeviceSize offset = allocate(textureImage.data.size());
+        memcpy(m_mapped + offset, textureImage.data.data(), textureImage.data.size());
+
+        VkCommandBuffer cmds = pendingCommandBuffer();
+        image->addTransitionImageLayoutCmds(cmds, VK_IMAGE_LAYOUT_UNDEFINED,
+                                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+        image->addCopyLevelsFromBufferCmds(cmds, m_ring->buffer(), offset, textureImage.levels);
+        if (image->mipLevels() > textureImage.levels.size()) {
+            image->addGenerateMipLevelsCmds(cmds, static_cast<uint32_t>(textureImage.levels.size()));
+        } else {
+            image->addTransitionImageLayoutCmds(cmds, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        }
+
+        m_pending.resources.push_back(image);
+    }
+
+    void StagingRing::submit() {
+        retireCompleted();
+        if (!m_pending.cmds) {
+            return;
+        }
+
+        /* the vertex, index and instance buffer copies have to be done before the draws submitted
+         * after this read them.  The images have their own barriers.
+         */
+        VkMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+        vkCmdPipelineBarrier(m_pending.cmds->commandBuffer().get(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        m_pending.end = m_head;
+        m_pending.fence = std::make_shared<Fence>(m_device, false);
+        m_pending.cmds->end(*m_pending.fence);
+        m_inFlight.push_back(std::move(m_pending));
+        m_pending = Batch{};
+    }
+
     void ImageSampler::createTextureSampler(
         VkSamplerAddressMode beyondBorderSampling,
         VkBorderColor borderColor)
@@ -1876,7 +2582,7 @@ namespace vulkan {
         samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
         samplerInfo.mipLodBias = 0.0f;
         samplerInfo.minLod = 0.0f;
-        samplerInfo.maxLod = 0.0f;
+        samplerInfo.maxLod = static_cast<float>(m_image->mipLevels() - 1);
 
         VkSampler textureSamplerRaw;
         if (vkCreateSampler(m_device->logicalDevice().get(), &samplerInfo, nullptr, &textureSamplerRaw) != VK_SUCCESS) {
@@ -1922,17 +2628,10 @@ namespace vulkan {
         }
     }
 
-    void copyIndicesToBuffer(std::shared_ptr<vulkan::CommandPool> const &cmdpool,
+    void copyIndicesToBuffer(StagingRing &stagingRing,
                              std::vector<uint32_t> const &indices,
-                             Buffer &buffer)
+                             std::shared_ptr<Buffer> const &buffer)
     {
-        VkDeviceSize bufferSize = sizeof(indices[0]) * indices.size();
-
-        vulkan::Buffer stagingBuffer(cmdpool->device(), bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        stagingBuffer.copyRawTo(indices.data(), bufferSize);
-
-        buffer.copyTo(cmdpool, stagingBuffer, bufferSize);
+        stagingRing.uploadToBuffer(buffer, indices.data(), sizeof(indices[0]) * indices.size());
     }
 } /* namespace vulkan */
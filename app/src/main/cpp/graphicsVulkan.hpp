@@ -38,6 +38,8 @@
 #include <set>
 #include <algorithm>
 #include <array>
+#include <deque>
+#include <limits>
 #include <fstream>
 #include <iostream>
 
@@ -45,10 +47,12 @@
 #include <map>
 
 #include "graphicsCpuArch.hpp"
+#include "framesInFlight.hpp"
 #include "android.hpp"
 #include "levels/finisher/types.hpp"
 #include "levelTracker/levelTracker.hpp"
 #include "levels/basic/level.hpp"
+#include "levelDrawer/textureTable/textureContainer.hpp"
 
 namespace vulkan {
 #ifdef DEBUG
@@ -140,6 +144,63 @@ namespace vulkan {
                                                   const VkAllocationCallbacks *pAllocator);
     };
 
+    /* the uniform buffers are divided into a slice for each frame in flight, see
+     * SlicedUniformUpdates.
+     */
+    using UniformUpdates = SlicedUniformUpdates<VkBuffer>;
+
+    /* Pipeline cache shared by all the pipelines created on the device.  Creating the graphics
+     * pipelines is expensive (the shaders get compiled for the GPU) and happens every time render
+     * details are loaded or the swap chain is recreated.  The cache lets the driver reuse the
+     * results from previous pipeline creations, and it is saved to a file so that the next run
+     * of the app can use it too.
+     */
+    class PipelineCache {
+    public:
+        PipelineCache(std::shared_ptr<VkDevice_T> inLogicalDevice,
+                      VkPhysicalDevice physicalDevice,
+                      std::string inFileName);
+
+        inline std::shared_ptr<VkPipelineCache_CQ> const &pipelineCache() { return m_pipelineCache; }
+
+        // write the cache to the file if it changed since it was loaded or last saved.
+        void save();
+
+    private:
+        static uint32_t constexpr m_fileMagic = 0x43515043; // "CQPC"
+        static uint32_t constexpr m_fileVersion = 1;
+
+        // don't trust files claiming to have more cache data than this.
+        static uint64_t constexpr m_maxDataSize = 64 * 1024 * 1024;
+
+        /* The header written before the data from vkGetPipelineCacheData.  The cache data is only
+         * usable on the same GPU with the same driver, so the file is ignored if any of these
+         * don't match.
+         */
+        struct FileHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint32_t driverVersion;
+            uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+            uint32_t reserved;
+            uint64_t dataSize;
+            uint64_t dataChecksum;
+        };
+
+        std::shared_ptr<VkDevice_T> m_logicalDevice;
+        VkPhysicalDeviceProperties m_properties;
+        std::string m_fileName;
+        size_t m_savedDataSize;
+        std::shared_ptr<VkPipelineCache_CQ> m_pipelineCache;
+
+        FileHeader expectedHeader(uint64_t dataSize, uint64_t dataChecksum);
+        bool headerMatchesDevice(FileHeader const &header);
+        std::vector<char> loadData();
+        static uint64_t checksum(std::vector<char> const &data);
+    };
+
     class Device {
     public:
         struct QueueFamilyIndices {
@@ -168,16 +229,24 @@ namespace vulkan {
             }
         };
 
-        Device(std::shared_ptr<Instance> const &inInstance)
+        /* pipelineCacheFileName is where the pipeline cache is saved between runs.  If it is
+         * empty, the pipeline cache is only kept in memory.
+         */
+        Device(std::shared_ptr<Instance> const &inInstance,
+               std::string const &pipelineCacheFileName = std::string{})
                 : m_instance (inInstance),
                   m_physicalDevice{},
                   m_logicalDevice{},
+                  m_pipelineCache{},
                   m_allocator{},
                   m_graphicsQueue{},
                   m_presentQueue{},
-                  m_depthFormat{} {
+                  m_depthFormat{},
+                  m_uniformUpdates{} {
             pickPhysicalDevice();
             createLogicalDevice();
+            m_pipelineCache = std::make_shared<PipelineCache>(m_logicalDevice, m_physicalDevice,
+                                                              pipelineCacheFileName);
             m_depthFormat = findSupportedFormat({VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT,
                                                  VK_FORMAT_D24_UNORM_S8_UINT},
                                                 VK_IMAGE_TILING_OPTIMAL,
@@ -188,6 +257,9 @@ namespace vulkan {
 
         DeviceProperties properties();
 
+        // dynamic uniform buffer offsets must be a multiple of this.
+        VkDeviceSize minUniformBufferOffsetAlignment();
+
         uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 
         QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device);
@@ -202,6 +274,9 @@ namespace vulkan {
 
         VkFormat depthFormat() { return m_depthFormat; }
 
+        // true if images with the format and tiling passed in have all the features passed in.
+        bool formatSupported(VkFormat format, VkImageTiling tiling, VkFormatFeatureFlags features);
+
         inline std::shared_ptr<VkDevice_T> const &logicalDevice() { return m_logicalDevice; }
 
         inline std::shared_ptr<VmaAllocator_T> const &allocator() { return m_allocator; }
@@ -214,6 +289,10 @@ namespace vulkan {
 
         inline std::shared_ptr<Instance> const &instance() { return m_instance; }
 
+        inline UniformUpdates &uniformUpdates() { return m_uniformUpdates; }
+
+        inline std::shared_ptr<PipelineCache> const &pipelineCache() { return m_pipelineCache; }
+
     private:
         /* ensure that the instance is not destroyed before the device by holding a shared
          * pointer to the instance here.
@@ -225,6 +304,9 @@ namespace vulkan {
 
         std::shared_ptr<VkDevice_T> m_logicalDevice;
 
+        // must be declared after the logical device so that it is destroyed first.
+        std::shared_ptr<PipelineCache> m_pipelineCache;
+
         // Vulkan Memory Allocator objects
         std::shared_ptr<VmaAllocator_T> m_allocator;
 
@@ -234,6 +316,8 @@ namespace vulkan {
 
         VkFormat m_depthFormat;
 
+        UniformUpdates m_uniformUpdates;
+
         const std::vector<const char *> deviceExtensions = {
                 VK_KHR_SWAPCHAIN_EXTENSION_NAME
         };
@@ -409,11 +493,39 @@ namespace vulkan {
         DescriptorSet(std::shared_ptr<DescriptorPools> inDescriptorPools,
                       std::shared_ptr<VkDescriptorSet_CQ> const &inDsc)
                 : m_descriptorPools{inDescriptorPools},
-                  m_descriptorSet{inDsc} {
+                  m_descriptorSet{inDsc},
+                  m_uniformDescriptors{},
+                  m_perObjectBuffer{VK_NULL_HANDLE} {
         }
 
     public:
         inline std::shared_ptr<VkDescriptorSet_CQ> const &descriptorSet() { return m_descriptorSet; }
+
+        /* write the descriptors with vkUpdateDescriptorSets.  The uniform buffers must be
+         * VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptors so that the dynamic offsets can
+         * select the slice for the frame (see UniformUpdates).
+         */
+        void updateDescriptors(uint32_t count, VkWriteDescriptorSet const *writes);
+
+        // the per object uniforms are in buffer, at the offset of the draw object's arena slot.
+        inline void setPerObjectBuffer(VkBuffer buffer) { m_perObjectBuffer = buffer; }
+
+        /* the dynamic offsets to bind the descriptor set with: the offsets of the slice that is
+         * being drawn, plus perObjectOffset for the per object uniforms.
+         */
+        void dynamicOffsets(uint32_t perObjectOffset, std::vector<uint32_t> &offsets);
+
+    private:
+        struct UniformDescriptor {
+            uint32_t binding;
+            uint32_t arrayElement;
+            VkBuffer buffer;
+            VkDeviceSize sliceSize;
+        };
+
+        // in binding order, the order of the dynamic offsets.
+        std::vector<UniformDescriptor> m_uniformDescriptors;
+        VkBuffer m_perObjectBuffer;
     };
 
     // Descriptor Set Layout creators and deleters used by render details files, so declare them here
@@ -596,7 +708,31 @@ namespace vulkan {
                   m_extent{extent},
                   m_pipelineLayout{},
                   m_pipeline{} {
-            createGraphicsPipeline(requester, bindingDescription, attributeDescription,
+            createGraphicsPipeline(requester,
+                    std::vector<VkVertexInputBindingDescription>{bindingDescription},
+                    attributeDescription, vertShader, fragShader, derivedPipeline, cullMode);
+        }
+
+        // For pipelines with more than one vertex input binding, e.g. per vertex data at binding 0
+        // and per instance data at binding 1.
+        Pipeline(std::shared_ptr<FileRequester> const &requester,
+                 std::shared_ptr<Device> const &inDevice,
+                 VkExtent2D const &extent,
+                 std::shared_ptr<RenderPass> const &inRenderPass,
+                 std::shared_ptr<DescriptorPools> const &inDescriptorPools,
+                 std::vector<VkVertexInputBindingDescription> const &bindingDescriptions,
+                 std::vector<VkVertexInputAttributeDescription> const &attributeDescription,
+                 std::string const &vertShader,
+                 std::string const &fragShader,
+                 std::shared_ptr<Pipeline> const &derivedPipeline,
+                 VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT)
+                : m_device{inDevice},
+                  m_renderPass{inRenderPass},
+                  m_descriptorPools{inDescriptorPools},
+                  m_extent{extent},
+                  m_pipelineLayout{},
+                  m_pipeline{} {
+            createGraphicsPipeline(requester, bindingDescriptions, attributeDescription,
                     vertShader, fragShader, derivedPipeline, cullMode);
         }
 
@@ -621,7 +757,7 @@ namespace vulkan {
         std::shared_ptr<VkPipeline_CQ> m_pipeline;
 
         void createGraphicsPipeline(std::shared_ptr<FileRequester> const &requester,
-                VkVertexInputBindingDescription const &bindingDescription,
+                std::vector<VkVertexInputBindingDescription> const &bindingDescriptions,
                 std::vector<VkVertexInputAttributeDescription> const &attributeDescriptions,
                 std::string const vertShader,
                 std::string const fragShader,
@@ -664,41 +800,89 @@ namespace vulkan {
         inline std::shared_ptr<VkSemaphore_CQ> const &semaphore() { return m_semaphore; }
     };
 
+    /* Fences are used to coordinate between the GPU and our program.  The GPU signals the fence
+     * when the work submitted with it completes and we wait on it on the CPU before reusing any
+     * resources that submission was using.
+     */
+    class Fence {
+        std::shared_ptr<Device> m_device;
+
+        std::shared_ptr<VkFence_CQ> m_fence;
+
+        void createFence(bool signaled);
+
+    public:
+        Fence(std::shared_ptr<Device> const &inDevice, bool signaled = true)
+                : m_device{inDevice},
+                  m_fence{} {
+            createFence(signaled);
+        }
+
+        bool isSignaled();
+        void wait();
+        void reset();
+
+        inline std::shared_ptr<VkFence_CQ> const &fence() { return m_fence; }
+    };
+
     class CommandBuffer {
     public:
         CommandBuffer(std::shared_ptr<Device> inDevice,
                       std::shared_ptr<CommandPool> commandPool,
-                      VkCommandBufferUsageFlags usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT)
+                      VkCommandBufferUsageFlags usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+                      VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY)
                 : m_device{inDevice},
                   m_pool{commandPool},
                   m_commandBuffer{},
-                  m_usageFlag{usage}
+                  m_usageFlag{usage},
+                  m_level{level}
         {
             create();
         }
 
         void create();
         void begin();
+
+        // begin a secondary command buffer that is executed in the first subpass of renderPass.
+        void begin(VkRenderPass renderPass);
+
+        // finish recording without submitting the commands.  For secondary command buffers.
+        void endRecording();
+
         void end();
         void end(Semaphore &waitSemaphore, VkPipelineStageFlags pipelineStage, Semaphore &signalSemaphore);
         void end(Semaphore &signalSemaphore);
 
+        // submit the commands without waiting for them.  The fence is signaled when they complete.
+        void end(Fence &fence);
+
         inline std::shared_ptr<VkCommandBuffer_T> commandBuffer() { return m_commandBuffer; }
     private:
         std::shared_ptr<Device> m_device;
         std::shared_ptr<CommandPool> m_pool;
         std::shared_ptr<VkCommandBuffer_T> m_commandBuffer;
         VkCommandBufferUsageFlags m_usageFlag;
+        VkCommandBufferLevel m_level;
     };
 
     class Buffer {
     public:
+        /* if slicedPerFrame is true, then the buffer holds a slice of size bytes for each frame in
+         * flight and copyRawTo writes the slices as the frames that use them are recorded (see
+         * UniformUpdates).  The memory must be host visible and coherent in this case.
+         */
         Buffer(std::shared_ptr<Device> inDevice, VkDeviceSize size, VkBufferUsageFlags usage,
-               VkMemoryPropertyFlags properties)
+               VkMemoryPropertyFlags properties, bool slicedPerFrame = false)
                 : m_device{inDevice},
                   m_buffer{},
-                  m_allocation{} {
-            createBuffer(size, usage, properties);
+                  m_allocation{},
+                  m_mapped{nullptr},
+                  m_slicedPerFrame{slicedPerFrame} {
+            if (m_slicedPerFrame) {
+                createSlicedBuffer(size, usage, properties);
+            } else {
+                createBuffer(size, usage, properties);
+            }
         }
 
         void copyTo(std::shared_ptr<CommandPool> cmds, std::shared_ptr<Buffer> const &srcBuffer,
@@ -711,6 +895,11 @@ namespace vulkan {
         void copyRawTo(void const *dataRaw, size_t size);
         void copyRawFrom(void *dataRaw, size_t size) const;
 
+        /* the buffer's memory mapped into our address space.  It stays mapped until the buffer is
+         * destroyed.  The buffer must be host visible.
+         */
+        void *mappedMemory();
+
         inline VkBuffer &buffer() { return m_buffer; }
         inline VkBuffer const &cbuffer() const { return m_buffer; }
 
@@ -719,6 +908,12 @@ namespace vulkan {
              * free the memory after the buffer has been destroyed because the buffer is bound to
              * the memory, so the buffer is still using the memory until the buffer is destroyed.
              */
+            if (m_slicedPerFrame) {
+                m_device->uniformUpdates().discard(m_buffer);
+            }
+            if (m_mapped != nullptr) {
+                vmaUnmapMemory(m_device->allocator().get(), m_allocation);
+            }
             vmaDestroyBuffer(m_device->allocator().get(), m_buffer, m_allocation);
         }
 
@@ -727,8 +922,11 @@ namespace vulkan {
 
         VkBuffer m_buffer;
         VmaAllocation m_allocation;
+        void *m_mapped;
+        bool m_slicedPerFrame;
 
         void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+        void createSlicedBuffer(VkDeviceSize sliceSize, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
     };
 
     class Image {
@@ -736,13 +934,14 @@ namespace vulkan {
         Image(std::shared_ptr<Device> const &inDevice, uint32_t inWidth,
               uint32_t inHeight, VkFormat inFormat,
               VkImageTiling tiling, VkImageUsageFlags usage,
-              VkMemoryPropertyFlags properties)
+              VkMemoryPropertyFlags properties, uint32_t inMipLevels = 1)
                 : m_device{inDevice},
                   m_image{},
                   m_allocation{},
                   m_format{inFormat},
                   m_width{inWidth},
                   m_height{inHeight},
+                  m_mipLevels{inMipLevels},
                   m_needsFree{true} {
             createImage(inFormat, tiling, usage, properties);
         }
@@ -756,6 +955,7 @@ namespace vulkan {
                   m_format{inFormat},
                   m_width{inWidth},
                   m_height{inHeight},
+                  m_mipLevels{1},
                   m_needsFree{false} {
         }
 
@@ -763,9 +963,30 @@ namespace vulkan {
 
         void copyImageToBuffer(Buffer &buffer, std::shared_ptr<CommandPool> const &pool);
 
+        // record the commands to copy the image into buffer in the command buffer passed in.
+        void addCopyImageToBufferCmds(VkCommandBuffer commandBuffer, Buffer &buffer);
+
         void transitionImageLayout(VkImageLayout oldLayout,
                                    VkImageLayout newLayout, std::shared_ptr<CommandPool> const &pool);
 
+        /* record the commands to copy the levels from buffer into the mip levels of the image.  The
+         * level offsets are relative to bufferOffset.  The image must be in the transfer
+         * destination layout.
+         */
+        void addCopyLevelsFromBufferCmds(VkCommandBuffer commandBuffer, VkBuffer buffer,
+                                         VkDeviceSize bufferOffset,
+                                         std::vector<levelDrawer::TextureLevel> const &levels);
+
+        // record the commands to transition all the mip levels of the image in commandBuffer.
+        void addTransitionImageLayoutCmds(VkCommandBuffer commandBuffer, VkImageLayout oldLayout,
+                                          VkImageLayout newLayout);
+
+        /* record the commands to fill the mip levels from nbrLoadedLevels on by blitting each level
+         * from the one before it.  All the levels must be in the transfer destination layout, they
+         * are left in the shader read only layout.  The image needs VK_IMAGE_USAGE_TRANSFER_SRC_BIT.
+         */
+        void addGenerateMipLevelsCmds(VkCommandBuffer commandBuffer, uint32_t nbrLoadedLevels);
+
         virtual ~Image() {
             if (m_needsFree) {
                 vmaDestroyImage(m_device->allocator().get(), m_image, m_allocation);
@@ -777,6 +998,7 @@ namespace vulkan {
         inline VkImage &image() { return m_image; }
         inline uint32_t width() { return m_width; }
         inline uint32_t height() { return m_height; }
+        inline uint32_t mipLevels() { return m_mipLevels; }
     protected:
         std::shared_ptr<Device> m_device;
 
@@ -785,6 +1007,7 @@ namespace vulkan {
         VkFormat m_format;
         uint32_t m_width;
         uint32_t m_height;
+        uint32_t m_mipLevels;
         bool m_needsFree;
 
         void createImage(VkFormat format, VkImageTiling tiling,
@@ -844,6 +1067,180 @@ namespace vulkan {
         void createImageView(VkFormat format, VkImageAspectFlags aspectFlags);
     };
 
+    /* A persistently mapped, host visible staging buffer that vertices, indices, instances and
+     * textures are uploaded through.  The buffer is used as a ring: each upload takes the next
+     * free part of it.  The copies are recorded in one command buffer that is only submitted when
+     * submit is called, so that all the uploads for a level load go to the GPU in one submission
+     * instead of each waiting for the queue to go idle.  Each submission has a fence, the part of
+     * the ring it used is reused once the fence is signaled.  When the uploads waiting to be
+     * submitted fill the ring, it is replaced with a bigger one.
+     *
+     * submit must be called before submitting any commands that use the uploaded buffers or images.
+     * The uploads are done on the graphics queue, so the draws submitted after them see the data.
+     */
+    class StagingRing {
+    public:
+        static VkDeviceSize constexpr m_defaultSize = 4 * 1024 * 1024;
+
+        StagingRing(std::shared_ptr<Device> inDevice,
+                    std::shared_ptr<CommandPool> inPool,
+                    VkDeviceSize initialSize = m_defaultSize)
+                : m_device{std::move(inDevice)},
+                  m_pool{std::move(inPool)},
+                  m_ring{},
+                  m_mapped{nullptr},
+                  m_size{0},
+                  m_head{0},
+                  m_tail{0},
+                  m_pending{},
+                  m_inFlight{}
+        {
+            createRing(initialSize);
+        }
+
+        // copy data into buffer.  buffer needs VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+        void uploadToBuffer(std::shared_ptr<Buffer> const &buffer, void const *data, VkDeviceSize size);
+
+        /* copy all the levels of textureImage into image and leave it in the shader read only
+         * layout.  image needs VK_IMAGE_USAGE_TRANSFER_DST_BIT.  If image has more mip levels than
+         * textureImage, the rest are generated from the last level copied (see
+         * Image::addGenerateMipLevelsCmds).
+         */
+        void uploadToImage(std::shared_ptr<Image> const &image, levelDrawer::TextureImage const &textureImage);
+
+        // submit the uploads recorded since the last submit without waiting for them.
+        void submit();
+
+        inline VkDeviceSize size() { return m_size; }
+
+        ~StagingRing() {
+            for (auto &batch : m_inFlight) {
+                VkFence fence = getVkType<>(batch.fence->fence().get());
+                vkWaitForFences(m_device->logicalDevice().get(), 1, &fence, VK_TRUE,
+                                std::numeric_limits<uint64_t>::max());
+            }
+        }
+
+    private:
+        static VkDeviceSize constexpr m_alignment = 16;
+
+        // uploads that are submitted together.
+        struct Batch {
+            // the ring the last upload in the batch used and where that upload ended.
+            std::shared_ptr<Buffer> ring;
+            VkDeviceSize end;
+
+            std::shared_ptr<CommandBuffer> cmds;
+            std::shared_ptr<Fence> fence;
+
+            // the buffers and images written (and any rings replaced) stay alive until the
+            // batch is done.
+            std::vector<std::shared_ptr<void>> resources;
+        };
+
+        std::shared_ptr<Device> m_device;
+        std::shared_ptr<CommandPool> m_pool;
+
+        std::shared_ptr<Buffer> m_ring;
+        char *m_mapped;
+        VkDeviceSize m_size;
+
+        // the part of the ring in use is from m_tail up to m_head, wrapping at the end of the ring.
+        VkDeviceSize m_head;
+        VkDeviceSize m_tail;
+
+        Batch m_pending;
+        std::deque<Batch> m_inFlight;
+
+        void createRing(VkDeviceSize size);
+
+        // the offset in the ring of size bytes that can be written.
+        VkDeviceSize allocate(VkDeviceSize size);
+        bool tryAllocate(VkDeviceSize size, VkDeviceSize &offset);
+
+        // forget the submitted batches that are done.
+        void retireCompleted();
+
+        VkCommandBuffer pendingCommandBuffer();
+    };
+
+    class UniformArena;
+
+    /* A slot in a UniformArena: the part of one of the arena's buffers at offset.  The slot is
+     * given back to the arena when it is destroyed.
+     */
+    class UniformSlot {
+        friend UniformArena;
+    public:
+        inline std::shared_ptr<Buffer> const &buffer() { return m_buffer; }
+
+        // the offset of the slot in buffer, a valid dynamic offset.
+        inline uint32_t offset() const { return m_offset; }
+
+        // written to the slot's slice of each frame like the other uniform buffers.
+        void copyRawTo(void const *dataRaw, size_t size);
+
+        ~UniformSlot();
+
+    private:
+        std::shared_ptr<UniformArena> m_arena;
+        std::shared_ptr<Buffer> m_buffer;
+        size_t m_bufferIndex;
+        uint32_t m_offset;
+
+        UniformSlot(std::shared_ptr<UniformArena> inArena, std::shared_ptr<Buffer> inBuffer,
+                    size_t inBufferIndex, uint32_t inOffset)
+                : m_arena{std::move(inArena)},
+                  m_buffer{std::move(inBuffer)},
+                  m_bufferIndex{inBufferIndex},
+                  m_offset{inOffset}
+        {}
+    };
+
+    /* The per object uniforms (the model matrices) of a render details.  Instead of one small
+     * uniform buffer (and memory allocation) for each draw object, the uniforms are kept in a few
+     * large buffers divided into slots of the same size.  A slot's offset is a multiple of
+     * minUniformBufferOffsetAlignment so that it can be passed as the dynamic offset of a
+     * VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC descriptor.  Then all the draw objects with their
+     * uniforms in the same buffer can share a descriptor set.
+     *
+     * Slots are reused after they are freed and a slot's offset never changes, so the recorded
+     * draw commands stay valid.  When all the slots are in use, another buffer is added.
+     */
+    class UniformArena : public std::enable_shared_from_this<UniformArena> {
+        friend UniformSlot;
+    public:
+        static uint32_t constexpr m_slotsPerBuffer = 256;
+
+        // dataSize: the size of the uniforms in a slot.
+        UniformArena(std::shared_ptr<Device> inDevice, size_t dataSize)
+                : m_device{std::move(inDevice)},
+                  m_dataSize{dataSize},
+                  m_slotSize{},
+                  m_buffers{},
+                  m_freeSlots{}
+        {
+            VkDeviceSize alignment = std::max(m_device->minUniformBufferOffsetAlignment(), VkDeviceSize{1});
+            m_slotSize = (dataSize + alignment - 1) / alignment * alignment;
+        }
+
+        std::shared_ptr<UniformSlot> allocate();
+
+        // the range of the descriptors for the slots.
+        inline size_t dataSize() const { return m_dataSize; }
+
+    private:
+        std::shared_ptr<Device> m_device;
+        size_t m_dataSize;
+        VkDeviceSize m_slotSize;
+        std::vector<std::shared_ptr<Buffer>> m_buffers;
+
+        // for each buffer, the offsets of the slots that are not in use.
+        std::vector<std::vector<uint32_t>> m_freeSlots;
+
+        void free(size_t bufferIndex, uint32_t offset);
+    };
+
     class ImageFactory {
     public:
         static std::shared_ptr<Image> createTextureImage(
@@ -854,6 +1251,16 @@ namespace vulkan {
                 uint32_t texHeight,
                 uint32_t texChannels);
 
+        /* upload all the mip levels of the texture through the staging ring.  format must be the
+         * VkFormat of textureImage.format.  The image can be used once the staging ring is
+         * submitted.
+         */
+        static std::shared_ptr<Image> createTextureImage(
+                std::shared_ptr<Device> const &inDevice,
+                StagingRing &stagingRing,
+                levelDrawer::TextureImage const &textureImage,
+                VkFormat format);
+
         static std::shared_ptr<Image> createDepthImage(std::shared_ptr<SwapChain> const &inSwapChain) {
             return createDepthImage(inSwapChain->device(), VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
                     inSwapChain->extent());
@@ -906,6 +1313,24 @@ namespace vulkan {
                                  borderColor);
         }
 
+        ImageSampler(std::shared_ptr<Device> const &inDevice,
+                     StagingRing &stagingRing,
+                     levelDrawer::TextureImage const &textureImage,
+                     VkFormat format,
+                     VkSamplerAddressMode beyondBorderSampling = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+                     VkBorderColor borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK)
+                : m_device{inDevice},
+                  m_image{},
+                  m_imageView{},
+                  m_sampler{} {
+            m_image = ImageFactory::createTextureImage(m_device, stagingRing, textureImage, format);
+
+            m_imageView.reset(new ImageView(m_image, VK_IMAGE_ASPECT_COLOR_BIT));
+
+            createTextureSampler(beyondBorderSampling,
+                                 borderColor);
+        }
+
         ImageSampler(std::shared_ptr<Device> const &inDevice,
             std::shared_ptr<ImageView> const &inImageView,
             VkSamplerAddressMode beyondBorderSampling = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
@@ -1081,26 +1506,19 @@ namespace vulkan {
     };
 
     template <typename VertexType>
-    void copyVerticesToBuffer(std::shared_ptr<vulkan::CommandPool> const &cmdpool,
+    void copyVerticesToBuffer(StagingRing &stagingRing,
                               std::vector<VertexType> const &vertices,
-                              Buffer &buffer)
+                              std::shared_ptr<Buffer> const &buffer)
     {
-        VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
-
-        /* use a staging buffer in the CPU accessable memory to copy the data into graphics card
-         * memory.  Then use a copy command to copy the data into fast graphics card only memory.
+        /* copy the data through the staging ring in the CPU accessable memory into fast graphics
+         * card only memory.
          */
-        vulkan::Buffer stagingBuffer(cmdpool->device(), bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-        stagingBuffer.copyRawTo(vertices.data(), bufferSize);
-
-        buffer.copyTo(cmdpool, stagingBuffer, bufferSize);
+        stagingRing.uploadToBuffer(buffer, vertices.data(), sizeof(vertices[0]) * vertices.size());
     }
 
-    void copyIndicesToBuffer(std::shared_ptr<vulkan::CommandPool> const &cmdpool,
+    void copyIndicesToBuffer(StagingRing &stagingRing,
                              std::vector<uint32_t> const &indices,
-                             Buffer &buffer);
+                             std::shared_ptr<Buffer> const &buffer);
 
     struct SurfaceDetails {
         std::shared_ptr<vulkan::RenderPass> renderPass;
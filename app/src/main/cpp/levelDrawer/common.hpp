@@ -26,6 +26,7 @@
 #include <glm/glm.hpp>
 
 #include "../common.hpp"
+#include "zValueIndex.hpp"
 
 namespace levelTracker {
     static float constexpr m_maxZLevel = -1.0f;
@@ -207,9 +208,6 @@ namespace levelDrawer {
         FINISHER
     };
 
-    using DrawObjReference = uint64_t;
-    using DrawObjDataReference = uint64_t;
-
     static size_t constexpr const nbrDrawObjectTables = 3;
 
     using CommonObjectDataList = std::array<std::shared_ptr<renderDetails::CommonObjectData>, nbrDrawObjectTables>;
@@ -223,47 +221,5 @@ namespace levelDrawer {
     struct DrawObjectGLTraits;
     using DrawObjectTableGL = DrawObjectTable<DrawObjectGLTraits>;
     using DrawObjectTableGList = std::array<std::shared_ptr<DrawObjectTableGL>, nbrDrawObjectTables>;
-
-    struct ZValueReference {
-        static float constexpr errVal = 0.000001f;
-        boost::optional<float> z;
-        DrawObjReference drawObjectReference;
-        boost::optional<DrawObjDataReference>  drawObjectDataReference;
-
-        ZValueReference(
-                boost::optional<float> inZ,
-                DrawObjReference inDrawObjectReference,
-                boost::optional<DrawObjDataReference> inDrawObjectDataReference)
-                : z{inZ},
-                drawObjectReference{inDrawObjectReference},
-                drawObjectDataReference{inDrawObjectDataReference}
-        {}
-
-        ZValueReference(ZValueReference const &other) = default;
-        ZValueReference(ZValueReference &&other) = default;
-        ZValueReference &operator=(ZValueReference &other) = default;
-
-        bool operator ==(ZValueReference const &other) const {
-            return !(*this < other) && !(other < *this);
-        }
-
-        bool operator <(ZValueReference const &other) const {
-            if (z != boost::none && other.z != boost::none &&
-               (z.get() > other.z.get() + errVal || z.get() < other.z.get() - errVal))
-            {
-                return z.get() < other.z.get();
-            }
-
-            if (drawObjectReference != other.drawObjectReference) {
-                return drawObjectReference < other.drawObjectReference;
-            }
-
-            if (drawObjectDataReference != boost::none && other.drawObjectDataReference != boost::none) {
-                return drawObjectDataReference.get() < other.drawObjectDataReference.get();
-            }
-
-            return false;
-        }
-    };
 }
 #endif // AMAZING_LABYRINTH_LEVEL_DRAWER_COMMON_HPP
\ No newline at end of file
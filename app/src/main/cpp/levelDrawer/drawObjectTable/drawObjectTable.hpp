@@ -29,6 +29,7 @@
 #include <boost/optional.hpp>
 
 #include "../../renderDetails/renderDetails.hpp"
+#include "../modelTable/modelLoader.hpp"
 
 namespace levelDrawer {
     template <typename traits>
@@ -51,6 +52,10 @@ namespace levelDrawer {
         std::shared_ptr<typename traits::TextureDataType> const &textureData() { return m_textureData; }
 
         std::vector<DrawObjDataReference> drawObjDataRefs() {
+            if (m_instancedObjData) {
+                return m_instanceRefs;
+            }
+
             std::vector<DrawObjDataReference> ret;
             for (auto const &objData : m_objsData) {
                 ret.push_back(objData.first);
@@ -58,7 +63,15 @@ namespace levelDrawer {
             return std::move(ret);
         }
 
+        // For instanced draw objects, all instances share one draw object data.
         std::shared_ptr<typename traits::DrawObjectDataType> const &objData(DrawObjDataReference objDataRef) {
+            if (m_instancedObjData) {
+                if (m_instanceIndices.find(objDataRef) == m_instanceIndices.end()) {
+                    throw std::runtime_error("Invalid draw object data reference on retrieve.");
+                }
+                return m_instancedObjData;
+            }
+
             auto it = m_objsData.find(objDataRef);
             if (it == m_objsData.end()) {
                 throw std::runtime_error("Invalid draw object data reference on retrieve.");
@@ -68,9 +81,40 @@ namespace levelDrawer {
         }
 
         size_t numberObjectsData() const {
+            if (m_instancedObjData) {
+                return m_instanceData.size();
+            }
             return m_objsData.size();
         }
 
+        /* Instanced draw objects are drawn with one draw call for all of their model matrices.
+         * The model matrices are kept packed in m_instanceData and copied to the instance buffer
+         * (the second vertex binding in the instanced shaders) when they change.  The model
+         * matrix in the shared draw object data is applied to all instances.
+         */
+        bool isInstanced() const { return m_instancedObjData != nullptr; }
+
+        std::shared_ptr<typename traits::DrawObjectDataType> const &instancedObjData() {
+            return m_instancedObjData;
+        }
+
+        std::vector<InstanceData> const &instanceData() const { return m_instanceData; }
+
+        glm::mat4 const &instanceModelMatrix(DrawObjDataReference objDataRef) {
+            return m_instanceData[instanceIndex(objDataRef)].model;
+        }
+
+        bool instanceBufferNeedsUpdate() const { return m_instanceBufferNeedsUpdate; }
+
+        std::shared_ptr<typename traits::InstanceBufferType> const &instanceBuffer() {
+            return m_instanceBuffer;
+        }
+
+        void setInstanceBuffer(std::shared_ptr<typename traits::InstanceBufferType> instanceBuffer) {
+            m_instanceBuffer = std::move(instanceBuffer);
+            m_instanceBufferNeedsUpdate = false;
+        }
+
         DrawObject(
                 typename traits::RenderDetailsReferenceType renderDetailsReference_,
                 std::shared_ptr<typename traits::ModelDataType> modelData_,
@@ -78,17 +122,60 @@ namespace levelDrawer {
                 : m_nextDrawObjDataReference{0},
                   m_renderDetailsReference{std::move(renderDetailsReference_)},
                   m_modelData{std::move(modelData_)},
-                  m_textureData{textureData_} {}
+                  m_textureData{textureData_},
+                  m_instanceBufferNeedsUpdate{false},
+                  m_instancesZValue{0.0f} {}
 
         DrawObject(
                 std::shared_ptr<typename traits::ModelDataType> modelData_,
-                std::shared_ptr<typename traits::TextureDataType> textureData_)
+                std::shared_ptr<typename traits::TextureDataType> textureData_,
+                std::shared_ptr<typename traits::DrawObjectDataType> instancedObjData_ = nullptr)
                 : m_nextDrawObjDataReference{0},
                   m_renderDetailsReference{},
                   m_modelData{modelData_},
-                  m_textureData{textureData_} {}
+                  m_textureData{textureData_},
+                  m_instancedObjData{std::move(instancedObjData_)},
+                  m_instanceBufferNeedsUpdate{false},
+                  m_instancesZValue{0.0f} {}
 
     private:
+        DrawObjDataReference addInstance(glm::mat4 const &modelMatrix) {
+            DrawObjDataReference objDataRef = m_nextDrawObjDataReference++;
+            m_instanceIndices.emplace(objDataRef, m_instanceData.size());
+            m_instanceRefs.push_back(objDataRef);
+            m_instanceData.emplace_back(modelMatrix);
+            m_instanceBufferNeedsUpdate = true;
+            return objDataRef;
+        }
+
+        void updateInstance(DrawObjDataReference objDataRef, glm::mat4 const &modelMatrix) {
+            m_instanceData[instanceIndex(objDataRef)] = InstanceData{modelMatrix};
+            m_instanceBufferNeedsUpdate = true;
+        }
+
+        // keep the instances packed by moving the last instance into the removed one's spot.
+        void removeInstance(DrawObjDataReference objDataRef) {
+            size_t index = instanceIndex(objDataRef);
+            size_t last = m_instanceData.size() - 1;
+            if (index != last) {
+                m_instanceData[index] = m_instanceData[last];
+                m_instanceRefs[index] = m_instanceRefs[last];
+                m_instanceIndices[m_instanceRefs[index]] = index;
+            }
+            m_instanceData.pop_back();
+            m_instanceRefs.pop_back();
+            m_instanceIndices.erase(objDataRef);
+            m_instanceBufferNeedsUpdate = true;
+        }
+
+        size_t instanceIndex(DrawObjDataReference objDataRef) {
+            auto it = m_instanceIndices.find(objDataRef);
+            if (it == m_instanceIndices.end()) {
+                throw std::runtime_error("Invalid draw object data reference for instanced draw object.");
+            }
+            return it->second;
+        }
+
         DrawObjDataReference addObjectData(std::shared_ptr<typename traits::DrawObjectDataType> objectData) {
             DrawObjDataReference objDataRef = m_nextDrawObjDataReference++;
             m_objsData.emplace(objDataRef, objectData);
@@ -103,8 +190,15 @@ namespace levelDrawer {
             it->second->update(modelMatrix);
         }
 
-        void removeObjectData(DrawObjDataReference objDataRef) {
-            m_objsData.erase(objDataRef);
+        // returns the object data removed, nullptr if there was none.
+        std::shared_ptr<typename traits::DrawObjectDataType> removeObjectData(DrawObjDataReference objDataRef) {
+            std::shared_ptr<typename traits::DrawObjectDataType> objData;
+            auto it = m_objsData.find(objDataRef);
+            if (it != m_objsData.end()) {
+                objData = std::move(it->second);
+                m_objsData.erase(it);
+            }
+            return objData;
         }
 
         DrawObjReference m_nextDrawObjDataReference;
@@ -112,6 +206,18 @@ namespace levelDrawer {
         std::shared_ptr<typename traits::ModelDataType> m_modelData;
         std::shared_ptr<typename traits::TextureDataType> m_textureData;
         std::unordered_map<DrawObjDataReference, std::shared_ptr<typename traits::DrawObjectDataType>> m_objsData;
+
+        // only used for instanced draw objects
+        std::shared_ptr<typename traits::DrawObjectDataType> m_instancedObjData;
+        std::vector<InstanceData> m_instanceData;
+        std::vector<DrawObjDataReference> m_instanceRefs;
+        std::unordered_map<DrawObjDataReference, size_t> m_instanceIndices;
+        std::shared_ptr<typename traits::InstanceBufferType> m_instanceBuffer;
+        bool m_instanceBufferNeedsUpdate;
+
+        // the z value the instances are sorted by in the draw object table.  They are drawn
+        // together, so they only get one entry in the Z value references.
+        float m_instancesZValue;
     };
 
     template <typename traits>
@@ -132,8 +238,10 @@ namespace levelDrawer {
             m_drawObjects.clear();
             m_objsIndicesWithOverridingRenderDetails.clear();
             m_objsIndicesWithGlobalRenderDetails.clear();
-            m_zValueReferernces.clear();
+            m_objsIndicesInstanced.clear();
+            m_zValueIndex.clear();
             m_nextDrawObjReference = 0;
+            m_revision++;
         }
 
         // returns index of added object.
@@ -149,6 +257,27 @@ namespace levelDrawer {
                     std::move(modelData), std::move(textureData)));
 
             m_objsIndicesWithGlobalRenderDetails.insert(objRef);
+            m_revision++;
+            return objRef;
+        }
+
+        // returns index of added object.  The object uses the default render details and all of
+        // its instances share instancedObjData.
+        DrawObjReference addInstancedObject(
+                std::shared_ptr<typename traits::ModelDataType> modelData,
+                std::shared_ptr<typename traits::TextureDataType> textureData,
+                std::shared_ptr<typename traits::DrawObjectDataType> instancedObjData)
+        {
+            if (m_renderDetailsReference.renderDetails == nullptr) {
+                throw std::runtime_error("Default render details must be requested before adding a draw object that uses the default render details.");
+            }
+            DrawObjReference objRef = m_nextDrawObjReference++;
+            m_drawObjects.emplace(objRef, std::make_shared<DrawObject<traits>>(
+                    std::move(modelData), std::move(textureData), std::move(instancedObjData)));
+
+            m_objsIndicesWithGlobalRenderDetails.insert(objRef);
+            m_objsIndicesInstanced.insert(objRef);
+            m_revision++;
             return objRef;
         }
 
@@ -177,15 +306,15 @@ namespace levelDrawer {
                 throw std::runtime_error("Default render details must be requested before adding a draw object that uses the default render details.");
             }
 
-
-
+            m_revision++;
             return objRef;
         }
 
-        void removeObject(DrawObjReference objReference) {
+        // returns the draw object removed, nullptr if there was none.
+        std::shared_ptr<DrawObject<traits>> removeObject(DrawObjReference objReference) {
             auto itObjRef = m_drawObjects.find(objReference);
             if (itObjRef == m_drawObjects.end()) {
-                return;
+                return nullptr;
             }
 
             if (itObjRef->second->hasOverridingRenderDetailsReference()) {
@@ -193,23 +322,37 @@ namespace levelDrawer {
             } else {
                 m_objsIndicesWithGlobalRenderDetails.erase(objReference);
             }
+            m_objsIndicesInstanced.erase(objReference);
 
-            ZValueReference zRefToFind(boost::none, objReference, boost::none);
-            for (auto it = m_zValueReferernces.begin(); it != m_zValueReferernces.end(); ) {
-                if (*it == zRefToFind) {
-                    it = m_zValueReferernces.erase(it);
-                } else {
-                    it++;
+            if (itObjRef->second->isInstanced()) {
+                m_zValueIndex.remove(objReference, boost::none);
+            } else {
+                for (auto objDataRef : itObjRef->second->drawObjDataRefs()) {
+                    m_zValueIndex.remove(objReference, objDataRef);
                 }
             }
+            std::shared_ptr<DrawObject<traits>> drawObj = std::move(itObjRef->second);
             m_drawObjects.erase(itObjRef);
+            m_revision++;
+            return drawObj;
         }
 
-        std::set<ZValueReference> const &zValueReferences() { return m_zValueReferernces; }
+        // the Z value references in draw order.  Call once per frame before drawing, the
+        // references are sorted here if any z value changes since the last call changed the order.
+        ZValueReferences const &zValueReferences() { return m_zValueIndex.sorted(); }
+
+        /* changes every time the commands that draw the table would change: draw objects, draw
+         * object data or instances are added, removed or moved, an instance changes (its instance
+         * buffer is replaced), the render details change or the draw order changes.  A model
+         * matrix update that keeps the draw order only changes uniforms and does not change it.
+         */
+        uint64_t revision() { return m_revision + m_zValueIndex.revision(); }
+
+        // the commands recorded to draw this table, if the graphics API keeps them between frames.
+        typename traits::DrawCommandsType &drawCommands() { return m_drawCommands; }
 
-        std::vector<DrawObjReference> objsIndicesWithOverridingRenderDetails() {
-            return std::vector<DrawObjReference>(m_objsIndicesWithOverridingRenderDetails.begin(),
-                    m_objsIndicesWithOverridingRenderDetails.end());
+        std::unordered_set<DrawObjReference> const &objsIndicesWithOverridingRenderDetails() {
+            return m_objsIndicesWithOverridingRenderDetails;
         }
 
         std::vector<DrawObjReference> objsIndicesWithGlobalRenderDetails() {
@@ -217,6 +360,11 @@ namespace levelDrawer {
                     m_objsIndicesWithGlobalRenderDetails.end());
         }
 
+        std::vector<DrawObjReference> objsIndicesInstanced() {
+            return std::vector<DrawObjReference>(m_objsIndicesInstanced.begin(),
+                    m_objsIndicesInstanced.end());
+        }
+
         typename traits::RenderDetailsReferenceType const &renderDetailsReference() {
             return m_renderDetailsReference;
         }
@@ -262,15 +410,32 @@ namespace levelDrawer {
 
             float zVal = zValue(objData);
             auto objDataRef = it->second->addObjectData(std::move(objData));
-            auto ret = m_zValueReferernces.emplace(zVal, drawObjRef, objDataRef);
+            m_revision++;
 
-            if (!ret.second) {
+            if (!m_zValueIndex.add(zVal, drawObjRef, objDataRef)) {
                 throw std::runtime_error("draw object data already in the Z value reference table!");
             }
 
             return objDataRef;
         }
 
+        DrawObjDataReference addInstance(DrawObjReference drawObjRef, glm::mat4 const &modelMatrix) {
+            auto it = m_drawObjects.find(drawObjRef);
+            if (it == m_drawObjects.end()) {
+                throw std::runtime_error("Invalid draw object reference on add instance");
+            }
+
+            // all the instances are drawn in the same draw call so the object only needs one
+            // entry in the Z value references.  Add it with the first instance.
+            if (it->second->instanceData().empty()) {
+                it->second->m_instancesZValue = zValue(modelMatrix);
+                m_zValueIndex.add(it->second->m_instancesZValue, drawObjRef, boost::none);
+            }
+
+            m_revision++;
+            return it->second->addInstance(modelMatrix);
+        }
+
         // returns boost::none if it failed.
         boost::optional<DrawObjDataReference> transferObject(DrawObjReference objRef1, DrawObjDataReference objDataRef, DrawObjReference objRef2) {
             auto it1 = m_drawObjects.find(objRef1);
@@ -279,12 +444,17 @@ namespace levelDrawer {
                 throw std::runtime_error("Invalid draw object reference on transfer");
             }
 
+            // instances don't have their own draw object data to move.
+            if (it1->second->isInstanced() || it2->second->isInstanced()) {
+                return boost::none;
+            }
+
             if ((!it1->second->hasOverridingRenderDetailsReference() &&
                  !it2->second->hasOverridingRenderDetailsReference()) ||
                 (it1->second->hasOverridingRenderDetailsReference() &&
                  it2->second->hasOverridingRenderDetailsReference() &&
-                 it1->second->renderDetailsReference().renderDetails->nameString() ==
-                 it2->second->renderDetailsReference().renderDetails->nameString()))
+                 it1->second->renderDetailsReference().renderDetails->id() ==
+                 it2->second->renderDetailsReference().renderDetails->id()))
             {
                 // object is of the same render details, it is ok to move.
                 std::shared_ptr<typename traits::DrawObjectDataType> objData = it1->second->objData(objDataRef);
@@ -299,13 +469,15 @@ namespace levelDrawer {
                             it2->second->textureData());
                 }
 
+                // the object data may now use another descriptor set even if the transfer failed.
+                m_revision++;
+
                 if (succeeded) {
                     it1->second->removeObjectData(objDataRef);
 
                     auto objDataRefNew = it2->second->addObjectData(objData);
-                    float oldZ = zValue(objData);
-                    m_zValueReferernces.erase(ZValueReference(oldZ, objRef1, objDataRef));
-                    m_zValueReferernces.emplace(oldZ, objRef2, objDataRefNew);
+                    m_zValueIndex.remove(objRef1, objDataRef);
+                    m_zValueIndex.add(zValue(objData), objRef2, objDataRefNew);
                     return boost::optional<DrawObjDataReference>(objDataRefNew);
                 }
             }
@@ -318,36 +490,52 @@ namespace levelDrawer {
             if (it == m_drawObjects.end()) {
                 throw std::runtime_error("Invalid draw object reference on update");
             }
-            float oldZ = zValue(it->second->objData(objDataRef)->modelMatrix(0));
-            it->second->updateObjectData(objDataRef, modelMatrix);
 
-            size_t nbrRemoved = m_zValueReferernces.erase(ZValueReference(oldZ, objRef, objDataRef));
-            if (nbrRemoved != 1) {
-                throw std::runtime_error("Unexpected number of items removed!");
+            if (it->second->isInstanced()) {
+                it->second->updateInstance(objDataRef, modelMatrix);
+                m_revision++;
+                return;
             }
 
-            m_zValueReferernces.emplace(zValue(modelMatrix), objRef, objDataRef);
+            it->second->updateObjectData(objDataRef, modelMatrix);
+
+            if (!m_zValueIndex.update(zValue(modelMatrix), objRef, objDataRef)) {
+                throw std::runtime_error("Draw object data missing from the Z value references on update.");
+            }
         }
 
-        void removeObjectData(DrawObjReference objRef, DrawObjDataReference objDataRef) {
+        // returns the draw object data removed, nullptr for an instance (they have none).
+        std::shared_ptr<typename traits::DrawObjectDataType> removeObjectData(DrawObjReference objRef, DrawObjDataReference objDataRef) {
             auto it = m_drawObjects.find(objRef);
             if (it == m_drawObjects.end()) {
                 throw std::runtime_error("Invalid draw object reference on remove");
             }
-            float oldZ = zValue(it->second->objData(objDataRef)->modelMatrix(0));
-            it->second->removeObjectData(objDataRef);
-            size_t nbrRemoved = m_zValueReferernces.erase(ZValueReference(oldZ, objRef, objDataRef));
-            if (nbrRemoved != 1) {
-                throw std::runtime_error("Unexpected number of items removed!");
+
+            if (it->second->isInstanced()) {
+                it->second->removeInstance(objDataRef);
+                if (it->second->instanceData().empty()) {
+                    m_zValueIndex.remove(objRef, boost::none);
+                }
+                m_revision++;
+                return nullptr;
+            }
+
+            auto objData = it->second->removeObjectData(objDataRef);
+            m_revision++;
+            if (!m_zValueIndex.remove(objRef, objDataRef)) {
+                throw std::runtime_error("Draw object data missing from the Z value references on remove.");
             }
+            return objData;
         }
 
         void loadRenderDetails(typename traits::RenderDetailsReferenceType ref) {
             m_renderDetailsReference = std::move(ref);
+            m_revision++;
         }
 
         DrawObjectTable()
-                : m_nextDrawObjReference{0}
+                : m_nextDrawObjReference{0},
+                  m_revision{0}
         {}
 
     private:
@@ -366,7 +554,10 @@ namespace levelDrawer {
         std::unordered_map<DrawObjReference, std::shared_ptr<DrawObject<traits>>> m_drawObjects;
         std::unordered_set<DrawObjReference> m_objsIndicesWithOverridingRenderDetails;
         std::unordered_set<DrawObjReference> m_objsIndicesWithGlobalRenderDetails;
-        std::set<ZValueReference> m_zValueReferernces;
+        std::unordered_set<DrawObjReference> m_objsIndicesInstanced;
+        ZValueIndex m_zValueIndex;
+        uint64_t m_revision;
+        typename traits::DrawCommandsType m_drawCommands;
     };
 }
 #endif // AMAZING_LABYRINTH_DRAW_OBJECT_TABLE_HPP
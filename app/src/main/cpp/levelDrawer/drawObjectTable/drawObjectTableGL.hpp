@@ -31,6 +31,37 @@ namespace renderDetails {
     class DrawObjectDataGL;
 }
 namespace levelDrawer {
+    // the per instance vertex buffer for instanced draw objects.
+    class InstanceBufferGL {
+    public:
+        inline GLuint buffer() const { return m_buffer; }
+        inline uint32_t numberInstances() const { return m_numberInstances; }
+
+        InstanceBufferGL(std::vector<InstanceData> const &instanceData)
+                : m_buffer{0},
+                  m_numberInstances{static_cast<uint32_t>(instanceData.size())}
+        {
+            glGenBuffers(1, &m_buffer);
+            checkGraphicsError();
+            glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+            checkGraphicsError();
+            glBufferData(GL_ARRAY_BUFFER, sizeof (InstanceData) * instanceData.size(),
+                         instanceData.data(), GL_STATIC_DRAW);
+            checkGraphicsError();
+        }
+
+        ~InstanceBufferGL() {
+            glDeleteBuffers(1, &m_buffer);
+        }
+
+    private:
+        GLuint m_buffer;
+        uint32_t m_numberInstances;
+    };
+
+    // GL draws the tables again every frame, there are no recorded commands to keep.
+    struct DrawCommandsGL {};
+
     struct DrawObjectGLTraits {
         using RenderDetailsParametersType = renderDetails::ParametersGL;
         using RenderDetailsType = renderDetails::RenderDetailsGL;
@@ -39,6 +70,8 @@ namespace levelDrawer {
         using ModelDataType = ModelDataGL;
         using TextureDataType = TextureDataGL;
         using DrawObjectDataType = renderDetails::DrawObjectDataGL;
+        using InstanceBufferType = InstanceBufferGL;
+        using DrawCommandsType = DrawCommandsGL;
     };
 }
 
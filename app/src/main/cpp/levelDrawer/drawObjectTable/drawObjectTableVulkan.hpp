@@ -20,6 +20,11 @@
 #ifndef AMAZING_LABYRINTH_DRAW_OBJECT_TABLE_VULKAN_HPP
 #define AMAZING_LABYRINTH_DRAW_OBJECT_TABLE_VULKAN_HPP
 
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "../modelTable/modelTableVulkan.hpp"
 #include "../textureTable/textureTableVulkan.hpp"
 #include "../../renderDetails/renderDetails.hpp"
@@ -33,6 +38,103 @@ namespace renderDetails {
 }
 
 namespace levelDrawer {
+    // the per instance vertex buffer for instanced draw objects.
+    class InstanceBufferVulkan {
+    public:
+        inline std::shared_ptr<vulkan::Buffer> const &buffer() { return m_buffer; }
+        inline uint32_t numberInstances() const { return m_numberInstances; }
+
+        InstanceBufferVulkan(std::shared_ptr<vulkan::Device> const &inDevice,
+                             vulkan::StagingRing &stagingRing,
+                             std::vector<InstanceData> const &instanceData)
+                : m_buffer{},
+                  m_numberInstances{static_cast<uint32_t>(instanceData.size())}
+        {
+            VkDeviceSize bufferSize = sizeof (InstanceData) * instanceData.size();
+
+            m_buffer = std::make_shared<vulkan::Buffer>(inDevice, bufferSize,
+                                                        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                                                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+            stagingRing.uploadToBuffer(m_buffer, instanceData.data(), bufferSize);
+        }
+
+    private:
+        std::shared_ptr<vulkan::Buffer> m_buffer;
+        uint32_t m_numberInstances;
+    };
+
+    /* The secondary command buffers with the commands that draw a draw object table in the main
+     * render pass.  The commands are only recorded again when the table's revision or the main
+     * render pass changes.  Otherwise the frame just executes the commands recorded for an
+     * earlier frame, only the uniforms changed.
+     *
+     * Each frame in flight reads its own slice of the uniform buffers (see
+     * vulkan::UniformUpdates) and the slice is part of the dynamic offsets recorded in the
+     * commands, so there is a recording for each slice.  A slice's recording is only executed by
+     * the frame that uses the slice, and the fence for that frame's last submission was waited
+     * on before the slice is written, so the recording can be done again then.
+     */
+    class DrawCommandsVulkan {
+    public:
+        // true if the commands for slice were recorded for this revision of the table and this
+        // render pass.
+        bool upToDate(uint32_t slice, uint64_t tableRevision,
+                      std::shared_ptr<vulkan::RenderPass> const &renderPass) const
+        {
+            auto const &recording = m_recordings[slice];
+            return recording.cmds != nullptr && recording.tableRevision == tableRevision &&
+                   recording.renderPass == renderPass;
+        }
+
+        /* start recording the commands for the table into the command buffer for slice.  Call end
+         * when done.
+         */
+        VkCommandBuffer begin(std::shared_ptr<vulkan::Device> const &device,
+                              std::shared_ptr<vulkan::CommandPool> const &commandPool,
+                              uint32_t slice,
+                              uint64_t tableRevision,
+                              std::shared_ptr<vulkan::RenderPass> const &renderPass)
+        {
+            auto &recording = m_recordings[slice];
+            if (recording.cmds == nullptr) {
+                recording.cmds = std::make_shared<vulkan::CommandBuffer>(
+                        device, commandPool,
+                        VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT,
+                        VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+            }
+
+            recording.cmds->begin(getVkType<>(renderPass->renderPass().get()));
+            recording.tableRevision = tableRevision;
+            recording.renderPass = renderPass;
+            return recording.cmds->commandBuffer().get();
+        }
+
+        void end(uint32_t slice) {
+            m_recordings[slice].cmds->endRecording();
+        }
+
+        // the commands to execute for the frame reading slice.
+        VkCommandBuffer commandBuffer(uint32_t slice) {
+            return m_recordings[slice].cmds->commandBuffer().get();
+        }
+
+        DrawCommandsVulkan()
+                : m_recordings{}
+        {}
+
+    private:
+        struct Recording {
+            std::shared_ptr<vulkan::CommandBuffer> cmds;
+            uint64_t tableRevision;
+            std::shared_ptr<vulkan::RenderPass> renderPass;
+        };
+
+        // indexed by slice of the uniform buffers.
+        std::array<Recording, vulkan::UniformUpdates::numberSlices> m_recordings;
+    };
+
     struct DrawObjectVulkanTraits {
         using RenderDetailsParametersType = renderDetails::ParametersVulkan;
         using RenderDetailsType = renderDetails::RenderDetailsVulkan;
@@ -41,6 +143,8 @@ namespace levelDrawer {
         using ModelDataType = ModelDataVulkan;
         using TextureDataType = TextureDataVulkan;
         using DrawObjectDataType = renderDetails::DrawObjectDataVulkan;
+        using InstanceBufferType = InstanceBufferVulkan;
+        using DrawCommandsType = DrawCommandsVulkan;
     };
 }
 
@@ -20,13 +20,23 @@
 #ifndef AMAZING_LABYRINTH_LEVEL_DRAWER_HPP
 #define AMAZING_LABYRINTH_LEVEL_DRAWER_HPP
 
+#include <future>
 #include <memory>
+#include <streambuf>
 #include <string>
+#include <vector>
 #include <boost/optional.hpp>
 
 #include "common.hpp"
 
 namespace levelDrawer {
+    // what draws the images for drawToBuffer.  The CPU rasterizer only supports some render
+    // details, the rest are always drawn on the GPU.  See SoftwareRasterizer.
+    enum DrawToBufferRasterizer {
+        GPU_RASTERIZER,
+        CPU_RASTERIZER
+    };
+
     class LevelDrawer {
     public:
         virtual void setClearColor(ObjectType type, glm::vec4 const &clearColor) = 0;
@@ -51,6 +61,13 @@ namespace levelDrawer {
                 std::string const &renderDetailsName,
                 std::shared_ptr<renderDetails::Parameters> const &parameters) = 0;
 
+        // returns index of new object.  The object uses the default render details and all of
+        // its model matrices are drawn with one draw call if the render details supports it.
+        virtual DrawObjReference addInstancedObject(
+                ObjectType type,
+                std::shared_ptr <ModelDescription> const &modelDescription,
+                std::shared_ptr <TextureDescription> const &textureDescription) = 0;
+
         virtual void removeObject(
                 ObjectType type,
                 DrawObjReference objIndex) = 0;
@@ -87,7 +104,25 @@ namespace levelDrawer {
         virtual std::pair<glm::mat4, glm::mat4> getProjectionView(ObjectType type) = 0;
 
         virtual char const *getDefaultRenderDetailsName() = 0;
-        virtual void drawToBuffer(
+
+        /* Draw the models offscreen with the render details requested and read back the image.
+         * The draw and the copy of the image into CPU accessible memory are submitted to the GPU
+         * before this function returns, but it does not wait for them.  Waiting on the future
+         * waits for the GPU and then post processes the image with the render details.  So
+         * several images can be requested before waiting on any of them.  The future has to be
+         * waited on by the thread that requested the draw (the thread that owns the graphics
+         * context).
+         */
+        virtual std::future<std::vector<float>> drawToBufferAsync(
+                std::string const &renderDetailsName,
+                ModelsTextures const &modelsTextures,
+                std::vector<glm::mat4> const &modelMatrix,
+                float width,
+                float height,
+                uint32_t nbrSamplesForWidth,
+                std::shared_ptr<renderDetails::Parameters> const &parameters) = 0;
+
+        void drawToBuffer(
                 std::string const &renderDetailsName,
                 ModelsTextures const &modelsTextures,
                 std::vector<glm::mat4> const &modelMatrix,
@@ -95,7 +130,17 @@ namespace levelDrawer {
                 float height,
                 uint32_t nbrSamplesForWidth,
                 std::shared_ptr<renderDetails::Parameters> const &parameters,
-                std::vector<float> &results) = 0;
+                std::vector<float> &results)
+        {
+            results = drawToBufferAsync(renderDetailsName, modelsTextures, modelMatrix, width,
+                    height, nbrSamplesForWidth, parameters).get();
+        }
+
+        virtual void setDrawToBufferRasterizer(DrawToBufferRasterizer rasterizer) = 0;
+
+        // Open a level asset that the level reads itself (the models and textures are read by
+        // the level drawer).
+        virtual std::unique_ptr<std::streambuf> getAssetStream(std::string const &file) = 0;
 
         virtual void updateCommonObjectData(ObjectType type,
                                             DrawObjReference const &objRef,
@@ -139,6 +184,15 @@ namespace levelDrawer {
             return m_levelDrawer->addObject(m_type, modelDescription, textureDescription, renderDetailsName, parameters);
         }
 
+        // returns index of new object.  Use for objects with many model matrices that don't
+        // need to be sorted by z value with respect to each other (e.g. maze walls).  The model
+        // matrices can't be transferred to another object.
+        DrawObjReference addInstancedObject(
+                std::shared_ptr <ModelDescription> const &modelDescription,
+                std::shared_ptr <TextureDescription> const &textureDescription) {
+            return m_levelDrawer->addInstancedObject(m_type, modelDescription, textureDescription);
+        }
+
         boost::optional<DrawObjDataReference> transferObject(
                 DrawObjReference fromObjRef,
                 DrawObjDataReference objDataRef,
@@ -204,11 +258,28 @@ namespace levelDrawer {
                     nbrSamplesForWidth, parameters, results);
         }
 
+        std::future<std::vector<float>> drawToBufferAsync(
+                std::string const &renderDetailsName,
+                ModelsTextures const &modelsTextures,
+                std::vector<glm::mat4> const &modelMatrix,
+                float width,
+                float height,
+                uint32_t nbrSamplesForWidth,
+                std::shared_ptr<renderDetails::Parameters> const &parameters)
+        {
+            return m_levelDrawer->drawToBufferAsync(renderDetailsName, modelsTextures, modelMatrix,
+                    width, height, nbrSamplesForWidth, parameters);
+        }
+
         void updateCommonObjectData(DrawObjReference const &drawObjRef,
                                     renderDetails::Parameters const &parameters) {
             return m_levelDrawer->updateCommonObjectData(m_type, drawObjRef, parameters);
         }
 
+        std::unique_ptr<std::streambuf> getAssetStream(std::string const &file) {
+            return m_levelDrawer->getAssetStream(file);
+        }
+
     private:
         ObjectType m_type;
         std::shared_ptr<LevelDrawer> m_levelDrawer;
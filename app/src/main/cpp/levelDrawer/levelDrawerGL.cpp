@@ -28,12 +28,15 @@ namespace levelDrawer {
     void LevelDrawerGraphics<LevelDrawerGLTraits>::draw(
             LevelDrawerGLTraits::DrawArgumentType const &info)
     {
-        auto rdAndCodList = getRenderDetailsAndCODList();
+        for (auto const &drawObjTable : m_drawObjectTableList) {
+            updateInstanceBuffers(drawObjTable);
+        }
 
         // execute the pre main draw commands.
-        for (auto const &rdAndCod : rdAndCodList) {
-            rdAndCod.second.first->preMainDraw(
-                    0, rdAndCod.second.second, m_drawObjectTableList,
+        for (auto id : getRenderDetailsAndCODList()) {
+            auto const &rdAndCod = m_renderDetailsAndCODList[id];
+            rdAndCod.renderDetails->preMainDraw(
+                    0, rdAndCod.commonObjectDataList, m_drawObjectTableList,
                     m_drawObjectTableList[0]->zValueReferences(),
                     m_drawObjectTableList[1]->zValueReferences(),
                     m_drawObjectTableList[2]->zValueReferences());
@@ -58,37 +61,92 @@ namespace levelDrawer {
             [] (std::shared_ptr<LevelDrawerGLTraits::RenderDetailsType> const &rd,
                     std::shared_ptr<renderDetails::CommonObjectData> const &cod,
                     std::shared_ptr<LevelDrawerGLTraits::DrawObjectTableType> const &drawObjTable,
-                    std::set<ZValueReference>::iterator zValRefBegin,
-                    std::set<ZValueReference>::iterator zValRefEnd) -> void {
+                    ZValueReferences::const_iterator zValRefBegin,
+                    ZValueReferences::const_iterator zValRefEnd) -> void {
                 rd->draw(0, cod, drawObjTable, zValRefBegin, zValRefEnd);
             }
         });
     }
 
+    OffscreenTargetGL::OffscreenTargetGL(
+            uint32_t width,
+            uint32_t height,
+            graphicsGL::Framebuffer::ColorImageFormat const &colorImageFormat,
+            bool usePixelPackBuffer)
+            : m_width{width},
+              m_height{height},
+              m_colorImageFormat{colorImageFormat},
+              m_imageSize{m_width * m_height * 4 *
+                      (colorImageFormat.type == GL_UNSIGNED_SHORT ? sizeof (uint16_t) : sizeof (uint8_t))},
+              m_framebuffer{width, height, std::vector<graphicsGL::Framebuffer::ColorImageFormat>{colorImageFormat}},
+              m_pixelPackBuffer{usePixelPackBuffer ? std::make_unique<graphicsGL::PixelPackBuffer>(m_imageSize) : nullptr},
+              m_pixels{},
+              m_drawObjTable{std::make_shared<DrawObjectTableGL>()}
+    {
+    }
+
+    void OffscreenTargetGL::readPixels() {
+        if (m_pixelPackBuffer) {
+            m_pixelPackBuffer->readPixels(m_width, m_height, m_colorImageFormat.format,
+                    m_colorImageFormat.type);
+            return;
+        }
+
+        // no pixel pack buffers (OpenGL ES 2): glReadPixels waits for the draw to complete.
+        m_pixels.resize(m_imageSize);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        checkGraphicsError();
+        glReadPixels(0, 0, m_width, m_height, m_colorImageFormat.format, m_colorImageFormat.type,
+                m_pixels.data());
+        checkGraphicsError();
+    }
+
     template <>
-    void LevelDrawerGraphics<LevelDrawerGLTraits>::drawToBuffer(
+    std::future<std::vector<float>> LevelDrawerGraphics<LevelDrawerGLTraits>::drawToBufferOnGPU(
             std::string const &renderDetailsName,
             ModelsTextures const &modelsTextures,
             std::vector<glm::mat4> const &modelMatrix,
             float width,
             float height,
             uint32_t nbrSamplesForWidth,
-            std::shared_ptr<renderDetails::Parameters> const &parameters,
-            std::vector<float> &results)
+            std::shared_ptr<renderDetails::Parameters> const &parameters)
     {
         if (modelsTextures.size() != modelMatrix.size()) {
             throw std::runtime_error("the number of models must match the number of model matrices");
         }
 
-        auto drawObjTable = std::make_shared<DrawObjectTableGL>();
-
         uint32_t imageWidth = nbrSamplesForWidth;
         uint32_t imageHeight = static_cast<uint32_t>(std::floor((imageWidth * height)/width));
 
+        //graphicsGL::Framebuffer::ColorImageFormat colorImageFormat{GL_RGBA32UI, GL_RGBA_INTEGER,
+        //                                                           GL_UNSIGNED_INT};
+        graphicsGL::Framebuffer::ColorImageFormat colorImageFormat{GL_RGBA16UI, GL_RGBA_INTEGER,
+                                                                   GL_UNSIGNED_SHORT};
+        if (!m_surfaceDetails->useIntTexture) {
+            colorImageFormat = {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE};
+            //graphicsGL::Framebuffer::ColorImageFormat colorImageFormat{GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE};
+
+        }
+
+        bool usePixelPackBuffers = m_surfaceDetails->usePixelPackBuffers;
+        auto target = m_offscreenTargets.acquire(
+                {imageWidth, imageHeight, static_cast<uint32_t>(colorImageFormat.internalFormat)},
+                [&]() -> std::shared_ptr<OffscreenTargetGL> {
+                    return std::make_shared<OffscreenTargetGL>(
+                            imageWidth, imageHeight, colorImageFormat, usePixelPackBuffers);
+                });
+
+        // the objects from the last draw to buffer that used this target are no longer needed.
+        auto const &drawObjTable = target->drawObjTable();
+        drawObjTable->clear();
+
         graphicsGL::SurfaceDetails surfaceDetails{};
         surfaceDetails.surfaceWidth = imageWidth;
         surfaceDetails.surfaceHeight = imageHeight;
         surfaceDetails.useIntTexture = m_surfaceDetails->useIntTexture;
+        surfaceDetails.usePixelPackBuffers = usePixelPackBuffers;
+        surfaceDetails.useInstancing = m_surfaceDetails->useInstancing;
+        surfaceDetails.useBlitFramebuffer = m_surfaceDetails->useBlitFramebuffer;
 
         // load the render details.
         auto ref = m_renderLoader->load(m_gameRequester, renderDetailsName,
@@ -97,38 +155,16 @@ namespace levelDrawer {
         drawObjTable->loadRenderDetails(ref);
 
         // add the draw objects
-        size_t i = 0;
-        for (auto const &modelTexture : modelsTextures) {
-            auto modelData = m_modelTable.addModel(m_gameRequester, modelTexture.first);
-            std::shared_ptr<LevelDrawerGLTraits::TextureDataType> textureData{};
-            if (modelTexture.second) {
-                textureData = m_textureTable.addTexture(m_gameRequester, modelTexture.second);
-            }
-            auto objIndex = drawObjTable->addObject(modelData, textureData);
-            addModelMatrixToDrawObjTable(drawObjTable, objIndex, modelMatrix[i++]);
-        }
+        addObjectsForDrawToBuffer(drawObjTable, modelsTextures, modelMatrix);
 
         // perform the commands to be executed before the main draw.
         DrawObjectTableList drawObjTableList = {nullptr, drawObjTable, nullptr};
         CommonObjectDataList commonObjectDataList = {nullptr, ref.commonObjectData, nullptr};
         ref.renderDetails->preMainDraw(
-                0, commonObjectDataList, drawObjTableList, std::set<ZValueReference>{},
-                drawObjTable->zValueReferences(), std::set<ZValueReference>{});
-
-        //graphicsGL::Framebuffer::ColorImageFormat colorImageFormat{GL_RGBA32UI, GL_RGBA_INTEGER,
-        //                                                           GL_UNSIGNED_INT};
-        graphicsGL::Framebuffer::ColorImageFormat colorImageFormat{GL_RGBA16UI, GL_RGBA_INTEGER,
-                                                                   GL_UNSIGNED_SHORT};
-        if (!m_surfaceDetails->useIntTexture) {
-            colorImageFormat = {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE};
-            //graphicsGL::Framebuffer::ColorImageFormat colorImageFormat{GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE};
-
-        }
-
-        std::vector<graphicsGL::Framebuffer::ColorImageFormat> colorImageFormats{colorImageFormat};
-        graphicsGL::Framebuffer fb(imageWidth, imageHeight, colorImageFormats);
+                0, commonObjectDataList, drawObjTableList, ZValueReferences{},
+                drawObjTable->zValueReferences(), ZValueReferences{});
 
-        glBindFramebuffer(GL_FRAMEBUFFER, fb.fbo());
+        glBindFramebuffer(GL_FRAMEBUFFER, target->fbo());
         checkGraphicsError();
 
         // set the viewport
@@ -157,31 +193,48 @@ namespace levelDrawer {
         ref.renderDetails->draw(0, ref.commonObjectData, drawObjTable,
                 drawObjTable->zValueReferences().begin(), drawObjTable->zValueReferences().end());
 
-        glFinish();
-        checkGraphicsError();
-
-        renderDetails::PostprocessingDataInputGL dataVariant;
-        if (m_surfaceDetails->useIntTexture) {
-            /* width * height * 4 color values each a uint16_t in size. */
-            std::vector<uint16_t> data(static_cast<size_t>(imageWidth * imageHeight * 4), 0.0f);
-            glReadBuffer(GL_COLOR_ATTACHMENT0);
-            checkGraphicsError();
-            glReadPixels(0, 0, imageWidth, imageHeight, colorImageFormat.format, colorImageFormat.type, data.data());
-            checkGraphicsError();
-            dataVariant = std::move(data);
-        } else {
-            /* width * height * 4 color values each a char in size. */
-            std::vector<uint8_t> data(static_cast<size_t>(imageWidth * imageHeight * 4), 0);
-            glReadBuffer(GL_COLOR_ATTACHMENT0);
-            checkGraphicsError();
-            glReadPixels(0, 0, imageWidth, imageHeight, colorImageFormat.format, colorImageFormat.type, data.data());
-            checkGraphicsError();
-            dataVariant = std::move(data);
-        }
-        ref.renderDetails->postProcessImageBuffer(ref.commonObjectData, dataVariant, results);
+        target->readPixels();
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
         checkGraphicsError();
+
+        /* The readback waits for the copy into the pixel pack buffer and makes GL calls, so it
+         * has to run on this thread.  Defer it to when the caller asks for the results.  The
+         * lambda holds on to the target so that it isn't reused until then.
+         */
+        bool useIntTexture = m_surfaceDetails->useIntTexture;
+        return std::async(std::launch::deferred, [target, ref, useIntTexture]() -> std::vector<float> {
+            renderDetails::PostprocessingDataInputGL dataVariant;
+            if (useIntTexture) {
+                /* width * height * 4 color values each a uint16_t in size. */
+                dataVariant = target->pixels<uint16_t>();
+            } else {
+                /* width * height * 4 color values each a char in size. */
+                dataVariant = target->pixels<uint8_t>();
+            }
+
+            std::vector<float> results;
+            ref.renderDetails->postProcessImageBuffer(ref.commonObjectData, dataVariant, results);
+            return results;
+        });
+    }
+
+    template <>
+    void LevelDrawerGraphics<LevelDrawerGLTraits>::releaseAfterDrawsInFlight(std::shared_ptr<void>) {
+        // GL synchronizes the use of its objects with the draws that use them for us.
+    }
+
+    template <>
+    void LevelDrawerGraphics<LevelDrawerGLTraits>::releaseObjectDataResourcesAfterDrawsInFlight(
+            std::shared_ptr<LevelDrawerGLTraits::DrawObjectDataType> const &)
+    {
+    }
+
+    template <>
+    std::shared_ptr<LevelDrawerGLTraits::InstanceBufferType> LevelDrawerGraphics<LevelDrawerGLTraits>::createInstanceBuffer(
+            std::vector<InstanceData> const &instanceData)
+    {
+        return std::make_shared<InstanceBufferGL>(instanceData);
     }
 
     template <>
@@ -192,7 +245,7 @@ namespace levelDrawer {
             char const *defaultRenderDetailsName,
             std::shared_ptr<GameRequester> inGameRequester)
             : m_modelTable{},
-            m_textureTable{},
+            m_textureTable{neededForDrawing.glVersion},
             m_drawObjectTableList{
                 std::make_shared<LevelDrawerGLTraits::DrawObjectTableType>(),
                 std::make_shared<LevelDrawerGLTraits::DrawObjectTableType>(),
@@ -202,6 +255,7 @@ namespace levelDrawer {
             m_neededForDrawing{neededForDrawing},
             m_surfaceDetails{std::move(inSurfaceDetails)},
             m_bgColor{0.0f, 0.0f, 0.0f, 1.0f},
-            m_defaultRenderDetailsName{defaultRenderDetailsName}
+            m_defaultRenderDetailsName{defaultRenderDetailsName},
+            m_drawToBufferRasterizer{GPU_RASTERIZER}
     {}
 }
\ No newline at end of file
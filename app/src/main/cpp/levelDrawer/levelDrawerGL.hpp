@@ -20,8 +20,12 @@
 #ifndef AMAZING_LABYRINTH_LEVEL_DRAWER_GL_HPP
 #define AMAZING_LABYRINTH_LEVEL_DRAWER_GL_HPP
 
+#include <cstring>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
+#include "../graphicsGL.hpp"
 #include "textureTable/textureTableGL.hpp"
 #include "modelTable/modelTableGL.hpp"
 #include "levelDrawerGraphics.hpp"
@@ -40,6 +44,8 @@ namespace renderDetails {
 class RenderLoaderGL;
 namespace levelDrawer {
     struct NeededForDrawingGL {
+        // graphicsGL::Surface::glVersion() of the context the level is drawn with.
+        int glVersion;
     };
 
     struct DrawArgumentGL {
@@ -50,6 +56,55 @@ namespace levelDrawer {
 
     using DrawObjectTableGL = DrawObjectTable<DrawObjectGLTraits>;
 
+    /* The framebuffer drawToBuffer draws into, the buffer the image is read back into and the
+     * draw object table for the objects drawn.  These are kept in an OffscreenTargetPool so that
+     * they are reused by the next draw to buffer of the same size and format.
+     */
+    class OffscreenTargetGL {
+    public:
+        std::shared_ptr<DrawObjectTableGL> const &drawObjTable() { return m_drawObjTable; }
+        GLuint fbo() { return m_framebuffer.fbo(); }
+
+        // start copying the image drawn into the framebuffer to CPU accessible memory.
+        void readPixels();
+
+        // wait for the copy started by readPixels and return the image.
+        template <typename PixelComponentType>
+        std::vector<PixelComponentType> pixels() {
+            if (m_imageSize != m_width * m_height * 4 * sizeof (PixelComponentType)) {
+                throw std::runtime_error("Offscreen target: invalid pixel type requested.");
+            }
+
+            std::vector<PixelComponentType> data(m_width * m_height * 4);
+            if (m_pixelPackBuffer) {
+                m_pixelPackBuffer->copyTo(data.data(), m_imageSize);
+            } else {
+                memcpy(data.data(), m_pixels.data(), m_imageSize);
+            }
+            return data;
+        }
+
+        OffscreenTargetGL(
+                uint32_t width,
+                uint32_t height,
+                graphicsGL::Framebuffer::ColorImageFormat const &colorImageFormat,
+                bool usePixelPackBuffer);
+
+    private:
+        size_t m_width;
+        size_t m_height;
+        graphicsGL::Framebuffer::ColorImageFormat m_colorImageFormat;
+        size_t m_imageSize;
+        graphicsGL::Framebuffer m_framebuffer;
+
+        // nullptr if pixel pack buffers are not supported.  Then the pixels are read into
+        // m_pixels right away.
+        std::unique_ptr<graphicsGL::PixelPackBuffer> m_pixelPackBuffer;
+        std::vector<uint8_t> m_pixels;
+
+        std::shared_ptr<DrawObjectTableGL> m_drawObjTable;
+    };
+
     struct LevelDrawerGLTraits {
         using DrawRuleType = DrawObjectTableGL::DrawRule;
         using RenderLoaderType = RenderLoaderGL;
@@ -62,10 +117,12 @@ namespace levelDrawer {
         using TextureTableType = TextureTableGL;
         using DrawObjectType = DrawObject<DrawObjectGLTraits>;
         using DrawObjectDataType = renderDetails::DrawObjectDataGL;
+        using InstanceBufferType = InstanceBufferGL;
         using DrawObjectTableType = DrawObjectTableGL;
         using NeededForDrawingType = NeededForDrawingGL;
         using DrawArgumentType = DrawArgumentGL;
         using SurfaceDetailsType = graphicsGL::SurfaceDetails;
+        using OffscreenTargetType = OffscreenTargetGL;
     };
 
     using LevelDrawerGL = LevelDrawerGraphics<LevelDrawerGLTraits>;
@@ -75,15 +132,25 @@ namespace levelDrawer {
             LevelDrawerGLTraits::DrawArgumentType const &info);
 
     template <>
-    void LevelDrawerGraphics<LevelDrawerGLTraits>::drawToBuffer(
+    std::future<std::vector<float>> LevelDrawerGraphics<LevelDrawerGLTraits>::drawToBufferOnGPU(
             std::string const &renderDetailsName,
             ModelsTextures const &modelsTextures,
             std::vector<glm::mat4> const &modelMatrix,
             float width,
             float height,
             uint32_t nbrSamplesForWidth,
-            std::shared_ptr<renderDetails::Parameters> const &parameters,
-            std::vector<float> &results);
+            std::shared_ptr<renderDetails::Parameters> const &parameters);
+
+    template <>
+    void LevelDrawerGraphics<LevelDrawerGLTraits>::releaseAfterDrawsInFlight(std::shared_ptr<void> resource);
+
+    template <>
+    void LevelDrawerGraphics<LevelDrawerGLTraits>::releaseObjectDataResourcesAfterDrawsInFlight(
+            std::shared_ptr<LevelDrawerGLTraits::DrawObjectDataType> const &objData);
+
+    template <>
+    std::shared_ptr<LevelDrawerGLTraits::InstanceBufferType> LevelDrawerGraphics<LevelDrawerGLTraits>::createInstanceBuffer(
+            std::vector<InstanceData> const &instanceData);
 
     template <>
     LevelDrawerGraphics<LevelDrawerGLTraits>::LevelDrawerGraphics(
@@ -20,10 +20,13 @@
 #ifndef AMAZING_LABYRINTH_LEVEL_DRAWER_GRAPHICS_HPP
 #define AMAZING_LABYRINTH_LEVEL_DRAWER_GRAPHICS_HPP
 
+#include <future>
 #include <memory>
 #include <string>
 #include <array>
 #include <stdexcept>
+#include <map>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -31,6 +34,8 @@
 #include "textureTable/textureLoader.hpp"
 #include "../renderDetails/renderDetails.hpp"
 #include "drawObjectTable/drawObjectTable.hpp"
+#include "offscreenTargetPool.hpp"
+#include "softwareRasterizer/softwareRasterizer.hpp"
 
 #include "levelDrawer.hpp"
 
@@ -55,7 +60,10 @@ namespace levelDrawer {
         }
 
         void clearDrawObjectTable(ObjectType type) override {
-            m_drawObjectTableList[type]->clear();
+            // the draws in flight might still use the objects in the table and its recorded draw
+            // commands, so start a new table and keep the old one until they are done.
+            releaseAfterDrawsInFlight(std::move(m_drawObjectTableList[type]));
+            m_drawObjectTableList[type] = std::make_shared<typename traits::DrawObjectTableType>();
 
             // We don't need to clear empty model and texture references out more than once during
             // the level cycle, they don't reference much data once they become empty.  Just clear
@@ -103,11 +111,35 @@ namespace levelDrawer {
                 textureData);
         }
 
+        DrawObjReference addInstancedObject(
+                ObjectType type,
+                std::shared_ptr<ModelDescription> const &modelDescription,
+                std::shared_ptr<TextureDescription> const &textureDescription) override
+        {
+            auto const &ref = m_drawObjectTableList[type]->renderDetailsReference();
+            if (ref.renderDetails == nullptr) {
+                throw std::runtime_error("Default render details must be requested before adding a draw object that uses the default render details.");
+            }
+
+            // fall back to drawing each model matrix on its own if the render details can't
+            // do instanced draws.
+            if (!ref.renderDetails->supportsInstancing()) {
+                return addObject(type, modelDescription, textureDescription);
+            }
+
+            return addInstancedObjectToDrawObjTable(
+                    m_drawObjectTableList[type],
+                    m_modelTable.addModel(m_gameRequester, modelDescription),
+                    textureDescription ?
+                        m_textureTable.addTexture(m_gameRequester, textureDescription) :
+                        std::shared_ptr<typename traits::TextureDataType>{});
+        }
+
         void removeObject(
                 ObjectType type,
                 DrawObjReference drawObjReference) override
         {
-            m_drawObjectTableList[type]->removeObject(drawObjReference);
+            releaseAfterDrawsInFlight(m_drawObjectTableList[type]->removeObject(drawObjReference));
         }
 
         DrawObjDataReference addModelMatrixForObject(
@@ -134,6 +166,11 @@ namespace levelDrawer {
                 DrawObjDataReference objDataRef,
                 DrawObjReference toObjRef) override
         {
+            // transferring an object might switch it to another descriptor set.
+            auto const &drawObj = m_drawObjectTableList[type]->drawObject(fromObjRef);
+            if (!drawObj->isInstanced()) {
+                releaseObjectDataResourcesAfterDrawsInFlight(drawObj->objData(objDataRef));
+            }
             return m_drawObjectTableList[type]->transferObject(fromObjRef, objDataRef, toObjRef);
         }
 
@@ -142,7 +179,7 @@ namespace levelDrawer {
                 DrawObjReference objRef,
                 DrawObjDataReference objDataRef) override
         {
-            m_drawObjectTableList[type]->removeObjectData(objRef, objDataRef);
+            releaseAfterDrawsInFlight(m_drawObjectTableList[type]->removeObjectData(objRef, objDataRef));
         }
 
         size_t numberObjectsDataForObject(ObjectType type, DrawObjReference drawObjReference) override {
@@ -150,6 +187,10 @@ namespace levelDrawer {
         }
 
         void requestRenderDetails(ObjectType type, std::string const &name, std::shared_ptr<renderDetails::Parameters> const &parameters) override {
+            // the render details and common object data being replaced might still be in use.
+            auto const &oldRef = m_drawObjectTableList[type]->renderDetailsReference();
+            releaseAfterDrawsInFlight(oldRef.renderDetails);
+            releaseAfterDrawsInFlight(oldRef.commonObjectData);
             m_drawObjectTableList[type]->loadRenderDetails(
                     m_renderLoader->load(m_gameRequester, name, m_surfaceDetails, parameters));
         }
@@ -182,15 +223,31 @@ namespace levelDrawer {
 
         char const *getDefaultRenderDetailsName() override { return m_defaultRenderDetailsName; }
 
-        void drawToBuffer(
+        std::future<std::vector<float>> drawToBufferAsync(
             std::string const &renderDetailsName,
             ModelsTextures const &modelsTextures,
             std::vector<glm::mat4> const &modelMatrix,
             float width,
             float height,
             uint32_t nbrSamplesForWidth,
-            std::shared_ptr<renderDetails::Parameters> const &parameters,
-            std::vector<float> &results) override;
+            std::shared_ptr<renderDetails::Parameters> const &parameters) override
+        {
+            if (m_drawToBufferRasterizer == CPU_RASTERIZER && SoftwareRasterizer::supports(renderDetailsName)) {
+                return m_softwareRasterizer.drawToBufferAsync(m_gameRequester, renderDetailsName,
+                        modelsTextures, modelMatrix, width, height, nbrSamplesForWidth, parameters);
+            }
+
+            return drawToBufferOnGPU(renderDetailsName, modelsTextures, modelMatrix, width, height,
+                    nbrSamplesForWidth, parameters);
+        }
+
+        void setDrawToBufferRasterizer(DrawToBufferRasterizer rasterizer) override {
+            m_drawToBufferRasterizer = rasterizer;
+        }
+
+        std::unique_ptr<std::streambuf> getAssetStream(std::string const &file) override {
+            return m_gameRequester->getAssetStream(file);
+        }
 
         LevelDrawerGraphics(typename traits::NeededForDrawingType neededForDrawing,
                             std::shared_ptr<typename traits::SurfaceDetailsType> inSurfaceDetails,
@@ -204,8 +261,8 @@ namespace levelDrawer {
                 std::shared_ptr<typename traits::RenderDetailsType> const &,
                 std::shared_ptr<renderDetails::CommonObjectData> const &,
                 std::shared_ptr<typename traits::DrawObjectTableType> const &,
-                std::set<ZValueReference>::iterator,
-                std::set<ZValueReference>::iterator)>;
+                ZValueReferences::const_iterator,
+                ZValueReferences::const_iterator)>;
 
         typename traits::ModelTableType m_modelTable;
         typename traits::TextureTableType m_textureTable;
@@ -216,6 +273,108 @@ namespace levelDrawer {
         std::shared_ptr<typename traits::SurfaceDetailsType> m_surfaceDetails;
         glm::vec4 m_bgColor;
         char const *m_defaultRenderDetailsName;
+        OffscreenTargetPool<typename traits::OffscreenTargetType> m_offscreenTargets;
+        DrawToBufferRasterizer m_drawToBufferRasterizer;
+        SoftwareRasterizer m_softwareRasterizer;
+
+        struct RenderDetailsAndCOD {
+            std::shared_ptr<typename traits::RenderDetailsType> renderDetails;
+            CommonObjectDataList commonObjectDataList;
+        };
+
+        // indexed by render details ID.
+        std::vector<RenderDetailsAndCOD> m_renderDetailsAndCODList;
+        std::vector<renderDetails::RenderDetailsID> m_renderDetailsIDsInUse;
+
+        // keep resource until the GPU is done with the draws submitted so far, they might use it.
+        void releaseAfterDrawsInFlight(std::shared_ptr<void> resource);
+
+        // objData is about to switch to other GPU resources, keep the ones it uses now until the
+        // draws submitted so far are done.
+        void releaseObjectDataResourcesAfterDrawsInFlight(
+                std::shared_ptr<typename traits::DrawObjectDataType> const &objData);
+
+        std::future<std::vector<float>> drawToBufferOnGPU(
+                std::string const &renderDetailsName,
+                ModelsTextures const &modelsTextures,
+                std::vector<glm::mat4> const &modelMatrix,
+                float width,
+                float height,
+                uint32_t nbrSamplesForWidth,
+                std::shared_ptr<renderDetails::Parameters> const &parameters);
+
+        std::shared_ptr<typename traits::InstanceBufferType> createInstanceBuffer(
+                std::vector<InstanceData> const &instanceData);
+
+        // copy the instances that changed since the last draw to the GPU.
+        void updateInstanceBuffers(std::shared_ptr<typename traits::DrawObjectTableType> const &drawObjTable) {
+            for (auto const &objRef : drawObjTable->objsIndicesInstanced()) {
+                auto const &drawObj = drawObjTable->drawObject(objRef);
+                if (!drawObj->instanceBufferNeedsUpdate()) {
+                    continue;
+                }
+
+                // the old instance buffer might still be in use by a draw in flight.
+                releaseAfterDrawsInFlight(drawObj->instanceBuffer());
+
+                if (drawObj->instanceData().empty()) {
+                    drawObj->setInstanceBuffer(nullptr);
+                } else {
+                    drawObj->setInstanceBuffer(createInstanceBuffer(drawObj->instanceData()));
+                }
+            }
+        }
+
+        DrawObjReference addInstancedObjectToDrawObjTable(
+                std::shared_ptr<typename traits::DrawObjectTableType> const &drawObjTable,
+                std::shared_ptr<typename traits::ModelDataType> modelData,
+                std::shared_ptr<typename traits::TextureDataType> textureData)
+        {
+            // The instances all use this draw object data for their uniforms.  Its model matrix
+            // is applied on top of the instance model matrices.
+            auto objData = drawObjTable->renderDetailsReference().createDrawObjectData(
+                    nullptr, textureData, glm::mat4(1.0f));
+
+            return drawObjTable->addInstancedObject(
+                    std::move(modelData), std::move(textureData), std::move(objData));
+        }
+
+        // add the objects for drawToBuffer.  Objects using the same model and texture are drawn
+        // with one instanced draw call if the render details supports it.
+        void addObjectsForDrawToBuffer(
+                std::shared_ptr<typename traits::DrawObjectTableType> const &drawObjTable,
+                ModelsTextures const &modelsTextures,
+                std::vector<glm::mat4> const &modelMatrix)
+        {
+            bool useInstancing = drawObjTable->renderDetailsReference().renderDetails->supportsInstancing();
+            std::map<std::pair<typename traits::ModelDataType *, typename traits::TextureDataType *>,
+                    DrawObjReference> instancedObjs;
+            size_t i = 0;
+            for (auto const &modelTexture : modelsTextures) {
+                auto modelData = m_modelTable.addModel(m_gameRequester, modelTexture.first);
+                std::shared_ptr<typename traits::TextureDataType> textureData{};
+                if (modelTexture.second) {
+                    textureData = m_textureTable.addTexture(m_gameRequester, modelTexture.second);
+                }
+
+                DrawObjReference objIndex;
+                if (useInstancing) {
+                    auto key = std::make_pair(modelData.get(), textureData.get());
+                    auto it = instancedObjs.find(key);
+                    if (it == instancedObjs.end()) {
+                        objIndex = addInstancedObjectToDrawObjTable(drawObjTable, modelData, textureData);
+                        instancedObjs.emplace(key, objIndex);
+                    } else {
+                        objIndex = it->second;
+                    }
+                } else {
+                    objIndex = drawObjTable->addObject(modelData, textureData);
+                }
+                addModelMatrixToDrawObjTable(drawObjTable, objIndex, modelMatrix[i++]);
+            }
+
+            updateInstanceBuffers(drawObjTable);
+        }
 
         DrawObjReference addModelMatrixToDrawObjTable(
                 std::shared_ptr<typename traits::DrawObjectTableType> const &drawObjTable,
@@ -224,6 +383,11 @@ namespace levelDrawer {
         {
             auto drawObj = drawObjTable->drawObject(objReference);
 
+            if (drawObj->isInstanced()) {
+                // instances only need their model matrix, the uniforms are shared.
+                return drawObjTable->addInstance(objReference, modelMatrix);
+            }
+
             auto renderDetailsRef = drawObj->renderDetailsReference();
 
             std::shared_ptr<typename traits::TextureDataType> textureData = drawObj->textureData();
@@ -245,88 +409,113 @@ namespace levelDrawer {
             return drawObjTable->addDrawObjData(objReference, objData);
         }
 
-        auto getRenderDetailsAndCODList()
+        /* Fill in the render details and common object data used by each draw object table
+         * for this frame and return the IDs of the render details that are used.  The lists are
+         * kept between frames and indexed by render details ID so that nothing is allocated
+         * and no names are compared once the level is running.
+         */
+        std::vector<renderDetails::RenderDetailsID> const &getRenderDetailsAndCODList()
         {
-            std::unordered_map<std::string, std::pair<std::shared_ptr<typename traits::RenderDetailsType>, std::array<std::shared_ptr<renderDetails::CommonObjectData>, nbrDrawObjectTables>>> ret;
-            std::pair<std::shared_ptr<typename traits::RenderDetailsType>, std::array<std::shared_ptr<renderDetails::CommonObjectData>, nbrDrawObjectTables>> value;
+            for (auto id : m_renderDetailsIDsInUse) {
+                m_renderDetailsAndCODList[id] = RenderDetailsAndCOD{};
+            }
+            m_renderDetailsIDsInUse.clear();
+
             for (size_t i = 0; i < nbrDrawObjectTables; i++) {
                 if (m_drawObjectTableList[i]->emptyOfDrawObjects()) {
                     continue;
                 }
-                auto &ref = m_drawObjectTableList[i]->renderDetailsReference();
-                auto result = ret.emplace(ref.renderDetails->nameString(), value);
-                if (result.second) {
-                    result.first->second.first = ref.renderDetails;
-                }
-                result.first->second.second[i] = ref.commonObjectData;
+                addRenderDetailsAndCOD(i, m_drawObjectTableList[i]->renderDetailsReference());
 
                 for (auto const &index : m_drawObjectTableList[i]->objsIndicesWithOverridingRenderDetails()) {
-                    auto &ref2 = m_drawObjectTableList[i]->renderDetailsReference(index);
-                    auto result2 = ret.emplace(ref.renderDetails->nameString(), value);
-                    if (result2.second) {
-                        result2.first->second.first = ref.renderDetails;
-                    }
-                    result2.first->second.second[i] = ref.commonObjectData;
+                    addRenderDetailsAndCOD(i, m_drawObjectTableList[i]->renderDetailsReference(index));
                 }
             }
 
-            return ret;
+            return m_renderDetailsIDsInUse;
         }
 
-        void performDraw(ExecuteDraw executeDraw)
+        void addRenderDetailsAndCOD(
+                size_t drawObjTableIndex,
+                typename traits::RenderDetailsReferenceType const &ref)
         {
-            for (auto table : std::vector<ObjectType>{LEVEL, STARTER, FINISHER}) {
-                if (m_drawObjectTableList[table]->emptyOfDrawObjects()) {
-                    continue;
-                }
-                typename traits::RenderDetailsReferenceType currentRenderDetails =
-                        m_drawObjectTableList[table]->renderDetailsReference();
-                std::string defaultRenderDetailsName = currentRenderDetails.renderDetails->nameString();
-                bool isDefaultRenderDetailsReference = true;
-                auto tableEnd = m_drawObjectTableList[table]->zValueReferences().end();
-                auto itBegin = m_drawObjectTableList[table]->zValueReferences().begin();
-                auto itEnd = itBegin;
-                // find a continuous set of draw objects that use the same render details and call
-                // execute draw on them.  Also, draw back to front.
-                while (true) {
-                    if (itEnd == tableEnd) {
-                        if (itBegin != itEnd) {
-                            executeDraw(
-                                    currentRenderDetails.renderDetails,
-                                    currentRenderDetails.commonObjectData,
-                                    m_drawObjectTableList[table], itBegin, itEnd);
-                        }
-                        break;
-                    }
+            auto id = ref.renderDetails->id();
+            if (id >= m_renderDetailsAndCODList.size()) {
+                m_renderDetailsAndCODList.resize(id + 1);
+            }
 
-                    auto const &drawObj = m_drawObjectTableList[table]->drawObject(itEnd->drawObjectReference);
-                    if (isDefaultRenderDetailsReference && !drawObj->hasOverridingRenderDetailsReference()) {
-                        itEnd++;
-                        continue;
-                    }
+            auto &rdAndCod = m_renderDetailsAndCODList[id];
+            if (rdAndCod.renderDetails == nullptr) {
+                rdAndCod.renderDetails = ref.renderDetails;
+                m_renderDetailsIDsInUse.push_back(id);
+            }
+            rdAndCod.commonObjectDataList[drawObjTableIndex] = ref.commonObjectData;
+        }
 
-                    auto renderDetailsRef = m_drawObjectTableList[table]->renderDetailsReference(itEnd->drawObjectReference);
-                    if (renderDetailsRef.renderDetails->nameString() == currentRenderDetails.renderDetails->nameString()) {
-                        itEnd++;
-                        continue;
-                    }
+        // the order the tables are drawn in.
+        static std::array<ObjectType, 3> drawOrder() {
+            return std::array<ObjectType, 3>{LEVEL, STARTER, FINISHER};
+        }
+
+        void performDraw(ExecuteDraw executeDraw)
+        {
+            for (auto table : drawOrder()) {
+                performDraw(table, executeDraw);
+            }
+        }
 
+        void performDraw(ObjectType table, ExecuteDraw const &executeDraw)
+        {
+            if (m_drawObjectTableList[table]->emptyOfDrawObjects()) {
+                return;
+            }
+            typename traits::RenderDetailsReferenceType currentRenderDetails =
+                    m_drawObjectTableList[table]->renderDetailsReference();
+            renderDetails::RenderDetailsID defaultRenderDetailsID = currentRenderDetails.renderDetails->id();
+            bool isDefaultRenderDetailsReference = true;
+            auto tableEnd = m_drawObjectTableList[table]->zValueReferences().end();
+            auto itBegin = m_drawObjectTableList[table]->zValueReferences().begin();
+            auto itEnd = itBegin;
+            // find a continuous set of draw objects that use the same render details and call
+            // execute draw on them.  Also, draw back to front.
+            while (true) {
+                if (itEnd == tableEnd) {
                     if (itBegin != itEnd) {
                         executeDraw(
                                 currentRenderDetails.renderDetails,
                                 currentRenderDetails.commonObjectData,
                                 m_drawObjectTableList[table], itBegin, itEnd);
                     }
+                    break;
+                }
 
-                    if (isDefaultRenderDetailsReference) {
-                        isDefaultRenderDetailsReference = false;
-                    } else {
-                        isDefaultRenderDetailsReference = (renderDetailsRef.renderDetails->nameString() == defaultRenderDetailsName);
-                    }
-                    currentRenderDetails = renderDetailsRef;
-                    itBegin = itEnd;
+                auto const &drawObj = m_drawObjectTableList[table]->drawObject(itEnd->drawObjectReference);
+                if (isDefaultRenderDetailsReference && !drawObj->hasOverridingRenderDetailsReference()) {
+                    itEnd++;
+                    continue;
+                }
+
+                auto renderDetailsRef = m_drawObjectTableList[table]->renderDetailsReference(itEnd->drawObjectReference);
+                if (renderDetailsRef.renderDetails->id() == currentRenderDetails.renderDetails->id()) {
                     itEnd++;
+                    continue;
+                }
+
+                if (itBegin != itEnd) {
+                    executeDraw(
+                            currentRenderDetails.renderDetails,
+                            currentRenderDetails.commonObjectData,
+                            m_drawObjectTableList[table], itBegin, itEnd);
+                }
+
+                if (isDefaultRenderDetailsReference) {
+                    isDefaultRenderDetailsReference = false;
+                } else {
+                    isDefaultRenderDetailsReference = (renderDetailsRef.renderDetails->id() == defaultRenderDetailsID);
                 }
+                currentRenderDetails = renderDetailsRef;
+                itBegin = itEnd;
+                itEnd++;
             }
         }
     };
@@ -18,6 +18,7 @@
  *
  */
 #include <memory>
+#include <vector>
 
 #include "../graphicsVulkan.hpp"
 #include "levelDrawerVulkan.hpp"
@@ -30,6 +31,52 @@ namespace levelDrawer {
     void LevelDrawerGraphics<LevelDrawerVulkanTraits>::draw(
             LevelDrawerVulkanTraits::DrawArgumentType const &info)
     {
+        // copy the instances that changed to the GPU before we start recording, the copy uses
+        // its own command buffer.
+        for (auto const &drawObjTable : m_drawObjectTableList) {
+            updateInstanceBuffers(drawObjTable);
+        }
+
+        // send the models, textures and instances loaded since the last draw to the GPU.  This is
+        // submitted before the frame so the frame sees them.
+        m_neededForDrawing.stagingRing->submit();
+
+        // write the uniform values that changed into this frame's slice of the uniform buffers.
+        // The fence for the last frame that read the slice was already waited on.
+        m_neededForDrawing.device->uniformUpdates().writeSlice(info.frameIndex);
+
+        // record the draw commands again for the tables that changed since they were last
+        // recorded for this frame.  The other tables just execute the commands recorded for an
+        // earlier frame.
+        auto const &renderPass = m_surfaceDetails->renderPass;
+        for (auto table : drawOrder()) {
+            auto const &drawObjTable = m_drawObjectTableList[table];
+            if (drawObjTable->emptyOfDrawObjects()) {
+                continue;
+            }
+
+            uint64_t revision = drawObjTable->revision();
+            auto &drawCommands = drawObjTable->drawCommands();
+            if (drawCommands.upToDate(info.frameIndex, revision, renderPass)) {
+                continue;
+            }
+
+            VkCommandBuffer cmdBuffer = drawCommands.begin(m_neededForDrawing.device,
+                    m_neededForDrawing.commandPool, info.frameIndex, revision, renderPass);
+            performDraw(table, ExecuteDraw{
+                [cmdBuffer] (
+                        std::shared_ptr<typename LevelDrawerVulkanTraits::RenderDetailsType> const &rd,
+                        std::shared_ptr<renderDetails::CommonObjectData> const &cod,
+                        std::shared_ptr<typename LevelDrawerVulkanTraits::DrawObjectTableType> const &drawObjTable,
+                        ZValueReferences::const_iterator zValRefBegin,
+                        ZValueReferences::const_iterator zValRefEnd) -> void {
+                    rd->addDrawCmdsToCommandBuffer(
+                            cmdBuffer, 0, cod, drawObjTable, zValRefBegin, zValRefEnd);
+                }
+            });
+            drawCommands.end(info.frameIndex);
+        }
+
         VkCommandBufferBeginInfo beginInfo = {};
         beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
         beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
@@ -45,12 +92,11 @@ namespace levelDrawer {
          */
         vkBeginCommandBuffer(info.cmdBuffer, &beginInfo);
 
-        auto rdAndCodList = getRenderDetailsAndCODList();
-
         // add the pre main draw commands to the command buffer.
-        for (auto const &rdAndCod : rdAndCodList) {
-            rdAndCod.second.first->addPreRenderPassCmdsToCommandBuffer(
-                    info.cmdBuffer, 0, rdAndCod.second.second, m_drawObjectTableList,
+        for (auto id : getRenderDetailsAndCODList()) {
+            auto const &rdAndCod = m_renderDetailsAndCODList[id];
+            rdAndCod.renderDetails->addPreRenderPassCmdsToCommandBuffer(
+                    info.cmdBuffer, 0, rdAndCod.commonObjectDataList, m_drawObjectTableList,
                     m_drawObjectTableList[0]->zValueReferences(),
                     m_drawObjectTableList[1]->zValueReferences(),
                     m_drawObjectTableList[2]->zValueReferences());
@@ -59,7 +105,7 @@ namespace levelDrawer {
         // begin the main render pass
         VkRenderPassBeginInfo renderPassInfo = {};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = getVkType<>(m_surfaceDetails->renderPass->renderPass().get());
+        renderPassInfo.renderPass = getVkType<>(renderPass->renderPass().get());
         renderPassInfo.framebuffer = info.framebuffer;
         /* size of the render area */
         renderPassInfo.renderArea.offset = {0, 0};
@@ -76,20 +122,20 @@ namespace levelDrawer {
          * none of these functions returns an error (they return void).  There will be no error
          * handling until recording is done.
          */
-        vkCmdBeginRenderPass(info.cmdBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-        // add the commands to the command buffer for the main draw.
-        performDraw(ExecuteDraw{
-            [cmdBuffer(info.cmdBuffer)] (
-                    std::shared_ptr<typename LevelDrawerVulkanTraits::RenderDetailsType> const &rd,
-                    std::shared_ptr<renderDetails::CommonObjectData> const &cod,
-                    std::shared_ptr<typename LevelDrawerVulkanTraits::DrawObjectTableType> const &drawObjTable,
-                    std::set<ZValueReference>::iterator zValRefBegin,
-                    std::set<ZValueReference>::iterator zValRefEnd) -> void {
-                rd->addDrawCmdsToCommandBuffer(
-                        cmdBuffer, 0, cod, drawObjTable, zValRefBegin, zValRefEnd);
+        vkCmdBeginRenderPass(info.cmdBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+        // the main draw is the tables' recorded draw commands, in draw order.
+        std::vector<VkCommandBuffer> drawCmdBuffers;
+        for (auto table : drawOrder()) {
+            if (!m_drawObjectTableList[table]->emptyOfDrawObjects()) {
+                drawCmdBuffers.push_back(
+                        m_drawObjectTableList[table]->drawCommands().commandBuffer(info.frameIndex));
             }
-        });
+        }
+        if (!drawCmdBuffers.empty()) {
+            vkCmdExecuteCommands(info.cmdBuffer, static_cast<uint32_t>(drawCmdBuffers.size()),
+                                 drawCmdBuffers.data());
+        }
 
         // end the main render pass
         vkCmdEndRenderPass(info.cmdBuffer);
@@ -100,57 +146,134 @@ namespace levelDrawer {
         }
     }
 
+    OffscreenTargetVulkan::OffscreenTargetVulkan(
+            std::shared_ptr<vulkan::Device> const &device,
+            std::shared_ptr<vulkan::CommandPool> const &commandPool,
+            uint32_t width,
+            uint32_t height)
+            : m_width{width},
+              m_height{height},
+              m_depthView{std::make_shared<vulkan::ImageView>(
+                      vulkan::ImageFactory::createDepthImage(device, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+                                                             width, height),
+                      VK_IMAGE_ASPECT_DEPTH_BIT)},
+              m_colorImage{vulkan::ImageView::createImageViewAndImage(
+                      device,
+                      width,
+                      height,
+                      colorImageFormat,
+                      VK_IMAGE_TILING_OPTIMAL,
+                      VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                      VK_IMAGE_ASPECT_COLOR_BIT)},
+              m_renderPass{},
+              m_framebuffer{},
+              m_buffer{device,
+                       width * height * sizeof (float) * 4,
+                       VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT},
+              m_commandBuffer{device, commandPool},
+              m_fence{device, false},
+              m_submitted{false},
+              m_drawObjTable{std::make_shared<DrawObjectTableVulkan>()}
+    {
+        m_depthView->image()->transitionImageLayout(VK_IMAGE_LAYOUT_UNDEFINED,
+                                                    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                                                    commandPool);
+
+        std::vector<vulkan::RenderPass::ImageAttachmentInfo> infos{};
+        infos.emplace_back(VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_STORE,
+                           m_colorImage->image()->format(),
+                           VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        auto depthInfo = std::make_shared<vulkan::RenderPass::ImageAttachmentInfo>(
+                VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                m_depthView->image()->format(),
+                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+        m_renderPass = vulkan::RenderPass::createDepthTextureRenderPass(device, infos, depthInfo);
+
+        std::vector<std::shared_ptr<vulkan::ImageView>> attachments = {m_colorImage, m_depthView};
+        m_framebuffer = std::make_shared<vulkan::Framebuffer>(
+                device, m_renderPass, attachments, width, height);
+    }
+
+    void OffscreenTargetVulkan::addReadPixelsCmds() {
+        VkCommandBuffer cmdBuffer = m_commandBuffer.commandBuffer().get();
+
+        /* the render pass leaves the color image in the transfer source layout.  Make sure the
+         * draws into it are done before copying it.
+         */
+        VkMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        m_colorImage->image()->addCopyImageToBufferCmds(cmdBuffer, m_buffer);
+
+        /* and the copy has to be visible to the host once the fence is signaled. */
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void OffscreenTargetVulkan::submit() {
+        m_fence.reset();
+        m_commandBuffer.end(m_fence);
+        m_submitted = true;
+    }
+
+    void OffscreenTargetVulkan::waitForSubmittedCmds() {
+        if (m_submitted) {
+            m_fence.wait();
+            m_submitted = false;
+        }
+    }
+
+    std::vector<float> OffscreenTargetVulkan::pixels() {
+        waitForSubmittedCmds();
+
+        std::vector<float> imageData{};
+        imageData.resize(m_width * m_height * 4);
+        m_buffer.copyRawFrom(imageData.data(), imageData.size() * sizeof (float));
+        return imageData;
+    }
+
     template <>
-    void LevelDrawerGraphics<LevelDrawerVulkanTraits>::drawToBuffer(
+    std::future<std::vector<float>> LevelDrawerGraphics<LevelDrawerVulkanTraits>::drawToBufferOnGPU(
             std::string const &renderDetailsName,
             ModelsTextures const &modelsTextures,
             std::vector<glm::mat4> const &modelMatrix,
             float width,
             float height,
             uint32_t nbrSamplesForWidth,
-            std::shared_ptr<renderDetails::Parameters> const &parameters,
-            std::vector<float> &results)
+            std::shared_ptr<renderDetails::Parameters> const &parameters)
     {
-        auto drawObjTable = std::make_shared<DrawObjectTableVulkan>();
+        if (modelsTextures.size() != modelMatrix.size()) {
+            throw std::runtime_error("the number of models must match the number of model matrices");
+        }
 
         uint32_t imageWidth = nbrSamplesForWidth;
         uint32_t imageHeight = static_cast<uint32_t>(std::floor((imageWidth * height)/width));
-        auto depthView = std::make_shared<vulkan::ImageView>(
-                vulkan::ImageFactory::createDepthImage(m_neededForDrawing.device, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-                                                       imageWidth, imageHeight),
-                VK_IMAGE_ASPECT_DEPTH_BIT);
-        depthView->image()->transitionImageLayout(VK_IMAGE_LAYOUT_UNDEFINED,
-                                                  VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
-                                                  m_neededForDrawing.commandPool);
-
-        auto colorImage = vulkan::ImageView::createImageViewAndImage(
-                m_neededForDrawing.device,
-                imageWidth,
-                imageHeight,
-                VK_FORMAT_R32G32B32A32_SFLOAT,
-                VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
-                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                VK_IMAGE_ASPECT_COLOR_BIT);
 
-        std::vector<vulkan::RenderPass::ImageAttachmentInfo> infos{};
-        infos.emplace_back(VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_STORE,
-                           colorImage->image()->format(),
-                           VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-        auto depthInfo = std::make_shared<vulkan::RenderPass::ImageAttachmentInfo>(
-                VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE,
-                depthView->image()->format(),
-                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-        auto renderPass = vulkan::RenderPass::createDepthTextureRenderPass(
-                m_neededForDrawing.device, infos, depthInfo);
+        auto target = m_offscreenTargets.acquire(
+                {imageWidth, imageHeight, static_cast<uint32_t>(OffscreenTargetVulkan::colorImageFormat)},
+                [&]() -> std::shared_ptr<OffscreenTargetVulkan> {
+                    return std::make_shared<OffscreenTargetVulkan>(
+                            m_neededForDrawing.device, m_neededForDrawing.commandPool,
+                            imageWidth, imageHeight);
+                });
 
-        std::vector<std::shared_ptr<vulkan::ImageView>> attachments = {colorImage, depthView};
-        auto frameBuffer = std::make_shared<vulkan::Framebuffer>(
-                m_neededForDrawing.device, renderPass, attachments, imageWidth, imageHeight);
+        // the objects from the last draw to buffer that used this target are no longer needed
+        // once its commands are done.
+        target->waitForSubmittedCmds();
+        auto const &drawObjTable = target->drawObjTable();
+        drawObjTable->clear();
 
         // parameters
         vulkan::SurfaceDetails surfaceDetails{};
-        surfaceDetails.renderPass = renderPass;
+        surfaceDetails.renderPass = target->renderPass();
         surfaceDetails.surfaceWidth = imageWidth;
         surfaceDetails.surfaceHeight = imageHeight;
         surfaceDetails.preTransform = glm::mat4(1.0f);
@@ -162,19 +285,21 @@ namespace levelDrawer {
         drawObjTable->loadRenderDetails(ref);
 
         // add the draw objects
-        size_t i = 0;
-        for (auto const &modelTexture : modelsTextures) {
-            auto modelData = m_modelTable.addModel(m_gameRequester, modelTexture.first);
-            std::shared_ptr<LevelDrawerVulkanTraits::TextureDataType> textureData{};
-            if (modelTexture.second) {
-                textureData = m_textureTable.addTexture(m_gameRequester, modelTexture.second);
-            }
-            auto objIndex = drawObjTable->addObject(modelData, textureData);
-            addModelMatrixToDrawObjTable(drawObjTable, objIndex, modelMatrix[i++]);
-        }
+        addObjectsForDrawToBuffer(drawObjTable, modelsTextures, modelMatrix);
+
+        // the uploads for the objects just added have to be submitted before the draw.
+        m_neededForDrawing.stagingRing->submit();
+
+        /* the draws to buffer share one slice of the uniform buffers.  Wait for the ones still
+         * on the GPU before writing the uniform values for the objects just added into it.
+         */
+        m_offscreenTargets.forEachTarget([](std::shared_ptr<OffscreenTargetVulkan> const &other) {
+            other->waitForSubmittedCmds();
+        });
+        m_neededForDrawing.device->uniformUpdates().writeDrawToBufferSlice();
 
         // start recording commands
-        vulkan::CommandBuffer cmds{m_neededForDrawing.device, m_neededForDrawing.commandPool};
+        auto &cmds = target->commandBuffer();
         cmds.begin();
 
         // add any pre main render pass commands
@@ -182,14 +307,14 @@ namespace levelDrawer {
         CommonObjectDataList commonObjectDataList = {nullptr, ref.commonObjectData, nullptr};
         ref.renderDetails->addPreRenderPassCmdsToCommandBuffer(
                 cmds.commandBuffer().get(), 0, commonObjectDataList, drawObjTableList,
-                std::set<ZValueReference>{}, drawObjTable->zValueReferences(),
-                std::set<ZValueReference>{});
+                ZValueReferences{}, drawObjTable->zValueReferences(),
+                ZValueReferences{});
 
         /* begin the render pass: drawing starts here*/
         VkRenderPassBeginInfo renderPassInfo = {};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = getVkType<>(renderPass->renderPass().get());
-        renderPassInfo.framebuffer = getVkType<>(frameBuffer->framebuffer().get());
+        renderPassInfo.renderPass = getVkType<>(target->renderPass()->renderPass().get());
+        renderPassInfo.framebuffer = getVkType<>(target->framebuffer()->framebuffer().get());
         /* size of the render area */
         renderPassInfo.renderArea.offset = {0, 0};
         renderPassInfo.renderArea.extent = {imageWidth, imageHeight};
@@ -219,21 +344,46 @@ namespace levelDrawer {
         // end the main render pass
         vkCmdEndRenderPass(cmds.commandBuffer().get());
 
-        // end the command buffer
-        cmds.end();
+        // copy the image data into a buffer accessible to the CPU in the same submission.
+        target->addReadPixelsCmds();
 
-        // copy the image data into a buffer accessible to the CPU
-        std::vector<float> imageData{};
-        imageData.resize(imageWidth * imageHeight * 4);
+        // end the command buffer and submit it without waiting on it.
+        target->submit();
 
-        vulkan::Buffer buffer{m_neededForDrawing.device,
-                              imageWidth * imageHeight * sizeof (float) * 4,
-                              VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
-        colorImage->image()->copyImageToBuffer(buffer, m_neededForDrawing.commandPool);
-        buffer.copyRawFrom(imageData.data(), imageData.size() * sizeof (float));
+        // the lambda holds on to the target so that it isn't reused until the results are retrieved.
+        return std::async(std::launch::deferred, [target, ref]() -> std::vector<float> {
+            std::vector<float> imageData = target->pixels();
 
-        ref.renderDetails->postProcessImageBuffer(ref.commonObjectData, imageData, results);
+            std::vector<float> results;
+            ref.renderDetails->postProcessImageBuffer(ref.commonObjectData, imageData, results);
+            return results;
+        });
+    }
+
+    template <>
+    void LevelDrawerGraphics<LevelDrawerVulkanTraits>::releaseAfterDrawsInFlight(std::shared_ptr<void> resource) {
+        /* The frames that were submitted but not finished yet might be using the data we are
+         * about to free.  Objects are removed often (the finisher every few frames, the movable
+         * passage tiles while they are dragged), so instead of waiting for the graphics queue to
+         * drain, the data waits for the fence of the last frame submitted.
+         */
+        m_neededForDrawing.deferredRelease->release(std::move(resource));
+    }
+
+    template <>
+    void LevelDrawerGraphics<LevelDrawerVulkanTraits>::releaseObjectDataResourcesAfterDrawsInFlight(
+            std::shared_ptr<LevelDrawerVulkanTraits::DrawObjectDataType> const &objData)
+    {
+        // changing the texture of the object data only replaces its main descriptor set.
+        releaseAfterDrawsInFlight(objData->descriptorSet(renderDetails::MODEL_MATRIX_ID_MAIN));
+    }
+
+    template <>
+    std::shared_ptr<LevelDrawerVulkanTraits::InstanceBufferType> LevelDrawerGraphics<LevelDrawerVulkanTraits>::createInstanceBuffer(
+            std::vector<InstanceData> const &instanceData)
+    {
+        return std::make_shared<InstanceBufferVulkan>(
+                m_neededForDrawing.device, *m_neededForDrawing.stagingRing, instanceData);
     }
 
     template <>
@@ -243,8 +393,8 @@ namespace levelDrawer {
             std::shared_ptr<LevelDrawerVulkanTraits::RenderLoaderType> inRenderLoader,
             char const *defaultRenderDetailsName,
             std::shared_ptr<GameRequester> inGameRequester)
-            : m_modelTable(neededForDrawing.device, neededForDrawing.commandPool),
-            m_textureTable(neededForDrawing.device, neededForDrawing.commandPool),
+            : m_modelTable(neededForDrawing.device, neededForDrawing.stagingRing),
+            m_textureTable(neededForDrawing.device, neededForDrawing.stagingRing),
             m_drawObjectTableList{
                 std::make_shared<LevelDrawerVulkanTraits::DrawObjectTableType>(),
                 std::make_shared<LevelDrawerVulkanTraits::DrawObjectTableType>(),
@@ -254,6 +404,7 @@ namespace levelDrawer {
             m_neededForDrawing{std::move(neededForDrawing)},
             m_surfaceDetails{std::move(inSurfaceDetails)},
             m_bgColor{0.0f, 0.0f, 0.0f, 1.0f},
-            m_defaultRenderDetailsName{defaultRenderDetailsName}
+            m_defaultRenderDetailsName{defaultRenderDetailsName},
+            m_drawToBufferRasterizer{GPU_RASTERIZER}
     {}
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include <memory>
 #include <string>
 #include <array>
+#include <vector>
 
 #include "levelDrawerGraphics.hpp"
 #include "../graphicsVulkan.hpp"
@@ -44,6 +45,12 @@ namespace levelDrawer {
     struct NeededForDrawingVulkan {
         std::shared_ptr<vulkan::Device> device;
         std::shared_ptr<vulkan::CommandPool> commandPool;
+
+        // the vertices, indices, instances and textures are uploaded through this.
+        std::shared_ptr<vulkan::StagingRing> stagingRing;
+
+        // the objects removed while the frames that use them are on the GPU wait in here.
+        std::shared_ptr<vulkan::DeferredRelease> deferredRelease;
     };
 
     struct DrawArgumentVulkan {
@@ -52,9 +59,60 @@ namespace levelDrawer {
 
         // todo: can remove extent? it is in surface details
         VkExtent2D extent;
+
+        // the frame in flight, the slice of the uniform buffers the frame reads.
+        uint32_t frameIndex;
     };
 
     using DrawObjectTableVulkan = DrawObjectTable<DrawObjectVulkanTraits>;
+
+    /* The images, render pass and framebuffer drawToBuffer draws into, the host visible buffer the
+     * image is copied into, the command buffer and fence for the draw and the draw object table for
+     * the objects drawn.  These are kept in an OffscreenTargetPool so that they are reused by the
+     * next draw to buffer of the same size.
+     */
+    class OffscreenTargetVulkan {
+    public:
+        static VkFormat constexpr colorImageFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
+
+        std::shared_ptr<DrawObjectTableVulkan> const &drawObjTable() { return m_drawObjTable; }
+        std::shared_ptr<vulkan::RenderPass> const &renderPass() { return m_renderPass; }
+        std::shared_ptr<vulkan::Framebuffer> const &framebuffer() { return m_framebuffer; }
+        vulkan::CommandBuffer &commandBuffer() { return m_commandBuffer; }
+
+        // record the commands to copy the image drawn into the host visible buffer.
+        void addReadPixelsCmds();
+
+        // submit the command buffer without waiting for it to complete.
+        void submit();
+
+        /* wait for the commands submitted to complete.  This has to be done before the target is
+         * reused in case the results of the last draw to buffer were never retrieved.
+         */
+        void waitForSubmittedCmds();
+
+        // wait for the commands submitted to complete and return the image.
+        std::vector<float> pixels();
+
+        OffscreenTargetVulkan(
+                std::shared_ptr<vulkan::Device> const &device,
+                std::shared_ptr<vulkan::CommandPool> const &commandPool,
+                uint32_t width,
+                uint32_t height);
+
+    private:
+        uint32_t m_width;
+        uint32_t m_height;
+        std::shared_ptr<vulkan::ImageView> m_depthView;
+        std::shared_ptr<vulkan::ImageView> m_colorImage;
+        std::shared_ptr<vulkan::RenderPass> m_renderPass;
+        std::shared_ptr<vulkan::Framebuffer> m_framebuffer;
+        vulkan::Buffer m_buffer;
+        vulkan::CommandBuffer m_commandBuffer;
+        vulkan::Fence m_fence;
+        bool m_submitted;
+        std::shared_ptr<DrawObjectTableVulkan> m_drawObjTable;
+    };
     struct LevelDrawerVulkanTraits {
         using DrawRuleType = DrawObjectTableVulkan::DrawRule;
         using RenderLoaderType = RenderLoaderVulkan;
@@ -67,10 +125,12 @@ namespace levelDrawer {
         using TextureTableType = TextureTableVulkan;
         using DrawObjectType = DrawObject<DrawObjectVulkanTraits>;
         using DrawObjectDataType = renderDetails::DrawObjectDataVulkan;
+        using InstanceBufferType = InstanceBufferVulkan;
         using DrawObjectTableType = DrawObjectTableVulkan;
         using DrawArgumentType = DrawArgumentVulkan;
         using NeededForDrawingType = NeededForDrawingVulkan;
         using SurfaceDetailsType = vulkan::SurfaceDetails;
+        using OffscreenTargetType = OffscreenTargetVulkan;
     };
 
     using LevelDrawerVulkan = LevelDrawerGraphics<LevelDrawerVulkanTraits>;
@@ -80,15 +140,25 @@ namespace levelDrawer {
             LevelDrawerVulkanTraits::DrawArgumentType const &info);
 
     template <>
-    void LevelDrawerGraphics<LevelDrawerVulkanTraits>::drawToBuffer(
+    std::future<std::vector<float>> LevelDrawerGraphics<LevelDrawerVulkanTraits>::drawToBufferOnGPU(
             std::string const &renderDetailsName,
             ModelsTextures const &modelsTextures,
             std::vector<glm::mat4> const &modelMatrix,
             float width,
             float height,
             uint32_t nbrSamplesForWidth,
-            std::shared_ptr<renderDetails::Parameters> const &parameters,
-            std::vector<float> &results);
+            std::shared_ptr<renderDetails::Parameters> const &parameters);
+
+    template <>
+    void LevelDrawerGraphics<LevelDrawerVulkanTraits>::releaseAfterDrawsInFlight(std::shared_ptr<void> resource);
+
+    template <>
+    void LevelDrawerGraphics<LevelDrawerVulkanTraits>::releaseObjectDataResourcesAfterDrawsInFlight(
+            std::shared_ptr<LevelDrawerVulkanTraits::DrawObjectDataType> const &objData);
+
+    template <>
+    std::shared_ptr<LevelDrawerVulkanTraits::InstanceBufferType> LevelDrawerGraphics<LevelDrawerVulkanTraits>::createInstanceBuffer(
+            std::vector<InstanceData> const &instanceData);
 
     template <>
     LevelDrawerGraphics<LevelDrawerVulkanTraits>::LevelDrawerGraphics(
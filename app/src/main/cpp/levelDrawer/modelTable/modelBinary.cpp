@@ -0,0 +1,240 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <boost/endian/conversion.hpp>
+
+#include "modelBinary.hpp"
+
+namespace levelDrawer {
+    namespace {
+        char constexpr const magic[4] = {'A', 'L', 'M', 'B'};
+        uint32_t constexpr version = 1;
+        uint32_t constexpr flagNoColors = 0x1;
+        uint32_t constexpr flagIndices16 = 0x2;
+        size_t constexpr vertexSetHeaderSize = 4 * 4;
+        size_t constexpr headerSize = sizeof (magic) + 3 * 4 + 2 * vertexSetHeaderSize;
+        size_t constexpr alignment = 16;
+
+        char const *modelExtension = ".modelcbor";
+        char const *modelBinaryExtension = ".modelbin";
+
+        // the vertices and indices are copied to and from the file as they are in memory.
+        static_assert(std::is_trivially_copyable<Vertex>::value, "Vertex must be trivially copyable");
+        bool constexpr nativeLittleEndian = boost::endian::order::native == boost::endian::order::little;
+
+        struct VertexSetHeader {
+            uint32_t nbrVertices;
+            uint32_t nbrIndices;
+            uint32_t verticesOffset;
+            uint32_t indicesOffset;
+        };
+
+        template <typename UintType>
+        void put(std::vector<uint8_t> &data, UintType value) {
+            for (size_t i = 0; i < sizeof (UintType); i++) {
+                data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        template <typename UintType>
+        UintType get(uint8_t const *&data) {
+            UintType value = 0;
+            for (size_t i = 0; i < sizeof (UintType); i++) {
+                value |= static_cast<UintType>(data[i]) << (8 * i);
+            }
+            data += sizeof (UintType);
+            return value;
+        }
+
+        void putBytes(std::vector<uint8_t> &data, void const *bytes, size_t size) {
+            auto begin = reinterpret_cast<uint8_t const *>(bytes);
+            data.insert(data.end(), begin, begin + size);
+        }
+
+        void pad(std::vector<uint8_t> &data) {
+            data.resize((data.size() + alignment - 1) / alignment * alignment, 0);
+        }
+
+        void readBytes(std::streambuf *in, size_t offset, void *data, size_t size) {
+            auto pos = static_cast<std::streamoff>(offset);
+            if (in->pubseekpos(pos, std::ios_base::in) != pos ||
+                static_cast<size_t>(in->sgetn(reinterpret_cast<char *>(data),
+                        static_cast<std::streamsize>(size))) != size)
+            {
+                throw std::runtime_error("Model binary file is truncated.");
+            }
+        }
+
+        void readVertexSet(std::streambuf *in, VertexSetHeader const &setHeader, bool indices16,
+                           ModelVertices &vertices)
+        {
+            vertices.first.resize(setHeader.nbrVertices);
+            readBytes(in, setHeader.verticesOffset, vertices.first.data(),
+                      vertices.first.size() * sizeof (Vertex));
+
+            vertices.second.resize(setHeader.nbrIndices);
+            if (indices16) {
+                std::vector<uint16_t> indices(setHeader.nbrIndices);
+                readBytes(in, setHeader.indicesOffset, indices.data(), indices.size() * sizeof (uint16_t));
+                std::copy(indices.begin(), indices.end(), vertices.second.begin());
+            } else {
+                readBytes(in, setHeader.indicesOffset, vertices.second.data(),
+                          vertices.second.size() * sizeof (uint32_t));
+            }
+
+            for (auto index : vertices.second) {
+                if (index >= setHeader.nbrVertices) {
+                    throw std::runtime_error("Model binary file index out of range.");
+                }
+            }
+        }
+    }
+
+    std::string modelBinaryFileName(std::string const &modelFileName) {
+        std::string fileName = modelFileName;
+        size_t extensionLength = std::strlen(modelExtension);
+        if (fileName.size() >= extensionLength &&
+            fileName.compare(fileName.size() - extensionLength, extensionLength, modelExtension) == 0)
+        {
+            fileName.resize(fileName.size() - extensionLength);
+        }
+        return fileName + modelBinaryExtension;
+    }
+
+    void writeModelBinary(std::ostream &out, std::pair<ModelVertices, ModelVertices> const &vertices,
+                          bool usingDefaultColor)
+    {
+        if (!nativeLittleEndian) {
+            throw std::runtime_error("Model binary files can only be written on little endian machines.");
+        }
+
+        std::array<ModelVertices const *, 2> sets = {&vertices.first, &vertices.second};
+        bool indices16 = true;
+        for (auto set : sets) {
+            if (set->first.size() > std::numeric_limits<uint16_t>::max() + size_t{1}) {
+                indices16 = false;
+            }
+        }
+        size_t indexSize = indices16 ? sizeof (uint16_t) : sizeof (uint32_t);
+
+        // lay out the arrays after the header.
+        std::array<VertexSetHeader, 2> setHeaders{};
+        size_t offset = headerSize;
+        for (size_t i = 0; i < sets.size(); i++) {
+            offset = (offset + alignment - 1) / alignment * alignment;
+            setHeaders[i].nbrVertices = static_cast<uint32_t>(sets[i]->first.size());
+            setHeaders[i].verticesOffset = static_cast<uint32_t>(offset);
+            offset += sets[i]->first.size() * sizeof (Vertex);
+
+            offset = (offset + alignment - 1) / alignment * alignment;
+            setHeaders[i].nbrIndices = static_cast<uint32_t>(sets[i]->second.size());
+            setHeaders[i].indicesOffset = static_cast<uint32_t>(offset);
+            offset += sets[i]->second.size() * indexSize;
+        }
+        if (offset > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Model too big for a model binary file.");
+        }
+
+        std::vector<uint8_t> data(magic, magic + sizeof (magic));
+        data.reserve(offset);
+        put<uint32_t>(data, version);
+        put<uint32_t>(data, (usingDefaultColor ? flagNoColors : 0) | (indices16 ? flagIndices16 : 0));
+        put<uint32_t>(data, sizeof (Vertex));
+        for (auto const &setHeader : setHeaders) {
+            put<uint32_t>(data, setHeader.nbrVertices);
+            put<uint32_t>(data, setHeader.nbrIndices);
+            put<uint32_t>(data, setHeader.verticesOffset);
+            put<uint32_t>(data, setHeader.indicesOffset);
+        }
+
+        for (auto set : sets) {
+            pad(data);
+            putBytes(data, set->first.data(), set->first.size() * sizeof (Vertex));
+            pad(data);
+            if (indices16) {
+                for (auto index : set->second) {
+                    put<uint16_t>(data, static_cast<uint16_t>(index));
+                }
+            } else {
+                putBytes(data, set->second.data(), set->second.size() * sizeof (uint32_t));
+            }
+        }
+
+        out.write(reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out.good()) {
+            throw std::runtime_error("Unable to write the model binary file.");
+        }
+    }
+
+    bool readModelBinary(std::streambuf *modelFile, uint8_t normalsToLoad, glm::vec3 const &defaultColor,
+                         std::pair<ModelVertices, ModelVertices> &vertices, bool &usingDefaultColor)
+    {
+        std::array<uint8_t, headerSize> header{};
+        readBytes(modelFile, 0, header.data(), header.size());
+        if (std::memcmp(header.data(), magic, sizeof (magic)) != 0) {
+            throw std::runtime_error("Not a model binary file.");
+        }
+
+        uint8_t const *data = header.data() + sizeof (magic);
+        if (get<uint32_t>(data) != version) {
+            return false;
+        }
+        uint32_t flags = get<uint32_t>(data);
+        if (get<uint32_t>(data) != sizeof (Vertex) || !nativeLittleEndian) {
+            return false;
+        }
+
+        std::array<VertexSetHeader, 2> setHeaders{};
+        for (auto &setHeader : setHeaders) {
+            setHeader.nbrVertices = get<uint32_t>(data);
+            setHeader.nbrIndices = get<uint32_t>(data);
+            setHeader.verticesOffset = get<uint32_t>(data);
+            setHeader.indicesOffset = get<uint32_t>(data);
+        }
+
+        std::pair<ModelVertices, ModelVertices> result;
+        bool indices16 = (flags & flagIndices16) != 0;
+        if (normalsToLoad & ModelDescription::LOAD_FACE_NORMALS) {
+            readVertexSet(modelFile, setHeaders[0], indices16, result.first);
+        }
+        if (normalsToLoad & ModelDescription::LOAD_VERTEX_NORMALS) {
+            readVertexSet(modelFile, setHeaders[1], indices16, result.second);
+        }
+
+        usingDefaultColor = (flags & flagNoColors) != 0;
+        if (usingDefaultColor) {
+            for (auto set : {&result.first, &result.second}) {
+                for (auto &vertex : set->first) {
+                    vertex.color = defaultColor;
+                }
+            }
+        }
+
+        vertices = std::move(result);
+        return true;
+    }
+}
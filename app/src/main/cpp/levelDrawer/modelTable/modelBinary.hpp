@@ -0,0 +1,70 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_MODEL_BINARY_HPP
+#define AMAZING_LABYRINTH_MODEL_BINARY_HPP
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+#include "modelLoader.hpp"
+
+namespace levelDrawer {
+    /* The modelbin format: a model that was already decoded from its modelcbor file, stored the
+     * way the model tables upload it.  The vertices are deduplicated and indexed, and are stored
+     * as an array of Vertex, so loading a model is a few bulk reads instead of parsing the CBOR
+     * and hashing every vertex.  model2cbor writes a modelbin file next to every modelcbor file.
+     * If the modelbin file is missing (or in another version), the model is loaded from the
+     * modelcbor file instead.
+     *
+     * File format (version 1, all values little endian):
+     *     char[4]  "ALMB"
+     *     uint32   version
+     *     uint32   flags: bit 0 is set if the model has no colors.  The colors in the vertices
+     *              are then replaced with the color of the model description.  Bit 1 is set if
+     *              the indices are 16 bits wide instead of 32 bits.
+     *     uint32   the size of a vertex (sizeof (Vertex))
+     *     the face normal vertex set, then the vertex normal vertex set:
+     *         uint32  the number of vertices
+     *         uint32  the number of indices
+     *         uint32  the offset in the file of the vertices
+     *         uint32  the offset in the file of the indices
+     *     then the vertices and indices of the face normal set followed by those of the vertex
+     *     normal set.  Every array starts at a multiple of 16 bytes.
+     */
+
+    // the modelbin file for a model file.
+    std::string modelBinaryFileName(std::string const &modelFileName);
+
+    void writeModelBinary(std::ostream &out, std::pair<ModelVertices, ModelVertices> const &vertices,
+                          bool usingDefaultColor);
+
+    /* Read the vertex sets requested by normalsToLoad (see ModelDescription) from a modelbin
+     * file.  Returns false if the file is another version or was written on a machine with a
+     * different vertex layout.  Throws if the file is not a modelbin file or is truncated.
+     */
+    bool readModelBinary(std::streambuf *modelFile, uint8_t normalsToLoad, glm::vec3 const &defaultColor,
+                         std::pair<ModelVertices, ModelVertices> &vertices, bool &usingDefaultColor);
+}
+
+#endif // AMAZING_LABYRINTH_MODEL_BINARY_HPP
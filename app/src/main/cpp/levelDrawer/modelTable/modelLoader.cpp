@@ -19,12 +19,16 @@
  */
 
 #include <streambuf>
+#include <mutex>
+#include <map>
+#include <tuple>
 #include <boost/endian/conversion.hpp>
 #include <boost/noncopyable.hpp>
 #include <json.hpp>
 
 #include "../../common.hpp"
 #include "modelLoader.hpp"
+#include "modelBinary.hpp"
 
 namespace levelDrawer {
     bool Vertex::operator==(const Vertex &other) const {
@@ -334,10 +338,78 @@ namespace levelDrawer {
         std::vector<float> m_colors;
     };
 
+    namespace {
+        struct PreloadedModel {
+            std::pair<ModelVertices, ModelVertices> vertices;
+            bool usingDefaultColor;
+        };
+
+        // path, normals to load and color identify the decoded data.
+        using PreloadedModelKey = std::tuple<std::string, uint8_t, float, float, float>;
+
+        struct PreloadedModels {
+            std::mutex lock;
+            std::map<PreloadedModelKey, PreloadedModel> models;
+        };
+
+        PreloadedModels &preloadedModels() {
+            static PreloadedModels preloaded;
+            return preloaded;
+        }
+    }
+
+    void ModelDescriptionPath::clearPreloaded() {
+        auto &preloaded = preloadedModels();
+        std::lock_guard<std::mutex> lock(preloaded.lock);
+        preloaded.models.clear();
+    }
+
+    void ModelDescriptionPath::preload(std::shared_ptr<GameRequester> const &gameRequester) {
+        PreloadedModel model{};
+        model.vertices = loadData(gameRequester, model.usingDefaultColor);
+
+        auto &preloaded = preloadedModels();
+        std::lock_guard<std::mutex> lock(preloaded.lock);
+        preloaded.models[PreloadedModelKey{m_path, m_normalsToLoad, m_color.x, m_color.y, m_color.z}] =
+                std::move(model);
+    }
+
     std::pair<ModelVertices, ModelVertices> ModelDescriptionPath::getData(
             const std::shared_ptr<GameRequester> &gameRequester)
+    {
+        {
+            auto &preloaded = preloadedModels();
+            std::lock_guard<std::mutex> lock(preloaded.lock);
+            auto it = preloaded.models.find(
+                    PreloadedModelKey{m_path, m_normalsToLoad, m_color.x, m_color.y, m_color.z});
+            if (it != preloaded.models.end()) {
+                auto vertices = std::move(it->second.vertices);
+                m_usingDefaultColor = it->second.usingDefaultColor;
+                preloaded.models.erase(it);
+                return vertices;
+            }
+        }
+
+        return loadData(gameRequester, m_usingDefaultColor);
+    }
+
+    std::pair<ModelVertices, ModelVertices> ModelDescriptionPath::loadData(
+            std::shared_ptr<GameRequester> const &gameRequester,
+            bool &usingDefaultColor)
     {
         std::pair<ModelVertices, ModelVertices> vertices;
+
+        // use the already decoded model if model2cbor wrote one.
+        try {
+            if (readModelBinary(gameRequester->getAssetStream(modelBinaryFileName(m_path)).get(),
+                                m_normalsToLoad, m_color, vertices, usingDefaultColor))
+            {
+                return vertices;
+            }
+        } catch (std::runtime_error &) {
+            // missing or damaged, decode the modelcbor file instead.
+        }
+
         ModelVertices *verticesWithFaceNormals = nullptr;
         ModelVertices *verticesWithVertexNormals = nullptr;
         if (m_normalsToLoad & LOAD_FACE_NORMALS) {
@@ -346,24 +418,27 @@ namespace levelDrawer {
         if (m_normalsToLoad & LOAD_VERTEX_NORMALS) {
             verticesWithVertexNormals = &vertices.second;
         }
-        loadModel(gameRequester->getAssetStream(m_path), verticesWithFaceNormals, verticesWithVertexNormals);
+        loadModelCbor(gameRequester->getAssetStream(m_path).get(), m_color, verticesWithFaceNormals,
+                      verticesWithVertexNormals, usingDefaultColor);
         return vertices;
     }
 
-    bool ModelDescriptionPath::loadModel(
-            std::unique_ptr<std::streambuf> const &modelStreamBuf,
+    bool loadModelCbor(
+            std::streambuf *modelStreamBuf,
+            glm::vec3 const &color,
             ModelVertices *verticesWithFaceNormals,
-            ModelVertices *verticesWithVertexNormals) {
+            ModelVertices *verticesWithVertexNormals,
+            bool &usingDefaultColor) {
 
         try {
-            std::istream assetIstream(modelStreamBuf.get());
+            std::istream assetIstream(modelStreamBuf);
 
-            LoadModelSaxClass sax{m_color};
+            LoadModelSaxClass sax{color};
 
             nlohmann::json j = nlohmann::json::sax_parse(assetIstream, &sax,
                                                          nlohmann::json::input_format_t::cbor);
             sax.getVertices(verticesWithFaceNormals, verticesWithVertexNormals);
-            m_usingDefaultColor = sax.usingDefaultColor();
+            usingDefaultColor = sax.usingDefaultColor();
         } catch (...) {
             return false;
         }
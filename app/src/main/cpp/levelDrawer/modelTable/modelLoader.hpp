@@ -49,6 +49,19 @@ namespace levelDrawer {
             normal = {0.0f, 0.0f, 0.0f};
         }
     };
+
+    /* The per instance vertex input for instanced draw objects.  The normal matrix is computed
+     * when the instance is added or updated so that the shaders don't have to invert the model
+     * matrix for every vertex (GLSL 100 has no inverse function anyways).
+     */
+    struct InstanceData {
+        glm::mat4 model;
+        glm::mat4 normalMatrix;
+
+        InstanceData(glm::mat4 const &inModel)
+                : model(inModel),
+                  normalMatrix(glm::transpose(glm::inverse(inModel))) {}
+    };
 } // namespace levelDrawer
 
 namespace std {
@@ -110,6 +123,16 @@ namespace levelDrawer {
 
     bool compareLessVec3(glm::vec3 const &vec1, glm::vec3 const &vec2);
 
+    /* Decode a modelcbor file.  Vertices without a color get the color passed in.  Either of the
+     * vertex sets may be null if it is not needed.  Returns false if the file could not be decoded.
+     */
+    bool loadModelCbor(
+            std::streambuf *modelStreamBuf,
+            glm::vec3 const &color,
+            ModelVertices *verticesWithFaceNormals,
+            ModelVertices *verticesWithVertexNormals,
+            bool &usingDefaultColor);
+
     class ModelDescription {
         friend BaseClassPtrLess<ModelDescription>;
     public:
@@ -121,6 +144,14 @@ namespace levelDrawer {
         virtual std::pair<ModelVertices, ModelVertices> getData(
                 std::shared_ptr<GameRequester> const &) = 0;
 
+        /* Decode the model ahead of time so that the next call to getData for an equal model
+         * description is fast.  Safe to call from a thread other than the draw thread.  Models
+         * that are cheap to generate do nothing here.
+         */
+        virtual void preload(std::shared_ptr<GameRequester> const &) {}
+
+        virtual ~ModelDescription() = default;
+
     protected:
         // returns true if this < other.
         virtual bool compareLess(ModelDescription *) = 0;
@@ -130,6 +161,12 @@ namespace levelDrawer {
     public:
         uint8_t normalsToLoad() override { return m_normalsToLoad; }
         std::pair<ModelVertices, ModelVertices> getData(std::shared_ptr<GameRequester> const &gameRequester) override;
+        void preload(std::shared_ptr<GameRequester> const &gameRequester) override;
+
+        // Drop any preloaded models that were never used.
+        static void clearPreloaded();
+
+        std::string const &path() const { return m_path; }
 
         ModelDescriptionPath(std::string path, glm::vec3 color = glm::vec3{0.2f, 0.2f, 0.2f}, uint8_t normalsToLoad = LOAD_FACE_NORMALS)
                 : m_path{std::move(path)},
@@ -167,10 +204,9 @@ namespace levelDrawer {
         glm::vec3 m_color;
         uint8_t m_normalsToLoad;
 
-        bool loadModel(
-                std::unique_ptr<std::streambuf> const &modelStreamBuf,
-                ModelVertices *verticesWithFaceNormals,
-                ModelVertices *verticesWithVertexNormals = nullptr);
+        std::pair<ModelVertices, ModelVertices> loadData(
+                std::shared_ptr<GameRequester> const &gameRequester,
+                bool &usingDefaultColor);
     };
 
 // creates a quad with each side length 2.0f and center at specified location.
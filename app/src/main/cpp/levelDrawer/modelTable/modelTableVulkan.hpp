@@ -56,7 +56,7 @@ namespace levelDrawer {
 
         ModelDataVulkan(std::shared_ptr<GameRequester> const &gameRequester,
                         std::shared_ptr<vulkan::Device> const &inDevice,
-                        std::shared_ptr<vulkan::CommandPool> const &inPool,
+                        vulkan::StagingRing &stagingRing,
                         std::shared_ptr<ModelDescription> const &model)
                         : m_numberIndices{},
                         m_indexBufferWithVertexNormals{}
@@ -96,8 +96,8 @@ namespace levelDrawer {
                                                              VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                                                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-            copyVerticesToBuffer<Vertex>(inPool, firstVerticesToLoad->first, *m_vertexBuffer);
-            vulkan::copyIndicesToBuffer(inPool, firstVerticesToLoad->second, *m_indexBuffer);
+            vulkan::copyVerticesToBuffer<Vertex>(stagingRing, firstVerticesToLoad->first, m_vertexBuffer);
+            vulkan::copyIndicesToBuffer(stagingRing, firstVerticesToLoad->second, m_indexBuffer);
 
             if (secondVerticesToLoad) {
                 m_numberIndicesWithVertexNormals = modelData.second.second.size();
@@ -114,10 +114,10 @@ namespace levelDrawer {
                                                                                   VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                                                                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-                copyVerticesToBuffer<Vertex>(inPool, secondVerticesToLoad->first,
-                                             *m_vertexBufferWithVertexNormals);
-                vulkan::copyIndicesToBuffer(inPool, secondVerticesToLoad->second,
-                                            *m_indexBufferWithVertexNormals);
+                vulkan::copyVerticesToBuffer<Vertex>(stagingRing, secondVerticesToLoad->first,
+                                                     m_vertexBufferWithVertexNormals);
+                vulkan::copyIndicesToBuffer(stagingRing, secondVerticesToLoad->second,
+                                            m_indexBufferWithVertexNormals);
             }
         }
 
@@ -135,34 +135,16 @@ namespace levelDrawer {
         std::shared_ptr<vulkan::Buffer> m_vertexBufferWithVertexNormals;
         std::shared_ptr<vulkan::Buffer> m_indexBufferWithVertexNormals;
         uint32_t m_numberIndicesWithVertexNormals;
-
-        template <typename VertexType>
-        static void copyVerticesToBuffer(std::shared_ptr<vulkan::CommandPool> const &cmdpool,
-                                         std::vector<VertexType> const &vertices,
-                                         vulkan::Buffer &buffer)
-        {
-            VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
-
-            /* use a staging buffer in the CPU accessible memory to copy the data into graphics card
-             * memory.  Then use a copy command to copy the data into fast graphics card only memory.
-             */
-            vulkan::Buffer stagingBuffer(cmdpool->device(), bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-            stagingBuffer.copyRawTo(vertices.data(), bufferSize);
-
-            buffer.copyTo(cmdpool, stagingBuffer, bufferSize);
-        }
     };
 
     class ModelTableVulkan : public ModelTable<ModelDataVulkan> {
     public:
         ModelTableVulkan(
                 std::shared_ptr<vulkan::Device> inDevice,
-                std::shared_ptr<vulkan::CommandPool> inCommandPool)
+                std::shared_ptr<vulkan::StagingRing> inStagingRing)
                 : ModelTable<ModelDataVulkan>{},
                   m_device{inDevice},
-                  m_commandPool{inCommandPool} {}
+                  m_stagingRing{inStagingRing} {}
 
         ~ModelTableVulkan() override = default;
 
@@ -170,13 +152,13 @@ namespace levelDrawer {
         std::shared_ptr<ModelDataVulkan>
         getModelData(std::shared_ptr<GameRequester> const &gameRequester,
                      std::shared_ptr<ModelDescription> const &modelDescription) override {
-            return std::make_shared<ModelDataVulkan>(gameRequester, m_device, m_commandPool,
+            return std::make_shared<ModelDataVulkan>(gameRequester, m_device, *m_stagingRing,
                                                      modelDescription);
         }
 
     private:
         std::shared_ptr<vulkan::Device> m_device;
-        std::shared_ptr<vulkan::CommandPool> m_commandPool;
+        std::shared_ptr<vulkan::StagingRing> m_stagingRing;
     };
 }
 
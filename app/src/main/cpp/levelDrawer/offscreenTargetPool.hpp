@@ -0,0 +1,110 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_OFFSCREEN_TARGET_POOL_HPP
+#define AMAZING_LABYRINTH_OFFSCREEN_TARGET_POOL_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace levelDrawer {
+    /* Keeps the offscreen render targets (images, framebuffer, readback buffer, etc) drawToBuffer
+     * uses so that they are created once per image size and format instead of once per call.
+     *
+     * A target is in use as long as anything other than the pool holds a reference to it: the
+     * readback for a draw to buffer holds one until its result is retrieved.  A draw to buffer
+     * requested while another one of the same size and format is still in flight gets its own
+     * target.  Only the most recently used m_maxIdleTargets targets that are not in use are kept.
+     */
+    template <typename TargetType>
+    class OffscreenTargetPool {
+    public:
+        struct Key {
+            uint32_t width;
+            uint32_t height;
+            uint32_t format;
+
+            bool operator==(Key const &other) const {
+                return width == other.width && height == other.height && format == other.format;
+            }
+        };
+
+        /* returns a target for key that is not in use.  createTarget is called to create one if
+         * there isn't one.
+         */
+        template <typename CreateTargetFcn>
+        std::shared_ptr<TargetType> acquire(Key const &key, CreateTargetFcn &&createTarget) {
+            // the most recently used targets are at the back.
+            for (auto it = m_targets.rbegin(); it != m_targets.rend(); it++) {
+                if (it->key == key && it->target.use_count() == 1) {
+                    Entry entry = std::move(*it);
+                    m_targets.erase(std::next(it).base());
+                    m_targets.push_back(std::move(entry));
+                    return m_targets.back().target;
+                }
+            }
+
+            evictIdleTargets(m_maxIdleTargets - 1);
+            m_targets.push_back(Entry{key, createTarget()});
+            return m_targets.back().target;
+        }
+
+        // call fcn on each target, in use or not.
+        template <typename Fcn>
+        void forEachTarget(Fcn &&fcn) {
+            for (auto const &entry : m_targets) {
+                fcn(entry.target);
+            }
+        }
+
+    private:
+        static size_t constexpr m_maxIdleTargets = 4;
+
+        struct Entry {
+            Key key;
+            std::shared_ptr<TargetType> target;
+        };
+
+        std::vector<Entry> m_targets;
+
+        // free the least recently used targets that are not in use until there are at most
+        // maxIdle of them left.
+        void evictIdleTargets(size_t maxIdle) {
+            size_t nbrIdle = 0;
+            for (auto const &entry : m_targets) {
+                if (entry.target.use_count() == 1) {
+                    nbrIdle++;
+                }
+            }
+
+            for (auto it = m_targets.begin(); it != m_targets.end() && nbrIdle > maxIdle; ) {
+                if (it->target.use_count() == 1) {
+                    it = m_targets.erase(it);
+                    nbrIdle--;
+                } else {
+                    it++;
+                }
+            }
+        }
+    };
+}
+
+#endif // AMAZING_LABYRINTH_OFFSCREEN_TARGET_POOL_HPP
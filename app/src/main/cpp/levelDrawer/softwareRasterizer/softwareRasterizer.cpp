@@ -0,0 +1,585 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../../mathGraphics.hpp"
+#include "softwareRasterizer.hpp"
+
+namespace levelDrawer {
+    namespace {
+        // The window coordinates are snapped to 1/256th of a pixel like a GPU does, and the edge
+        // functions are computed exactly with these integers.  So two triangles sharing an edge
+        // never both cover or both miss a pixel on the edge.
+        int64_t constexpr subpixelScale = 256;
+        int64_t constexpr halfPixel = subpixelScale / 2;
+
+        // the number of rows of pixels in a tile.
+        uint32_t constexpr tileHeight = 16;
+
+        // a triangle clipped against the six clip planes has at most one more vertex per plane.
+        size_t constexpr maxClippedVertices = 9;
+
+        // a vertex after the vertex shader.
+        struct ShadedVertex {
+            glm::vec4 position;
+            glm::vec3 color;
+        };
+
+        // a triangle ready to be rasterized.  Edge i is the edge from vertex i+1 to vertex i+2 so
+        // that its edge function is the barycentric weight of vertex i times area.
+        struct Triangle {
+            // window coordinates in subpixels.
+            int64_t x[3];
+            int64_t y[3];
+            // twice the area in subpixels squared.
+            int64_t area;
+            // 0 for the edges that cover the pixels on them (top and left edges), -1 otherwise.
+            int64_t bias[3];
+            float z[3];
+            float invW[3];
+            glm::vec3 colorOverW[3];
+            uint32_t rowBegin;
+            uint32_t rowEnd;
+        };
+
+        // the depth map vertex shader (linearDepthGL.vert).
+        class DepthMapShader {
+        public:
+            void setModelMatrix(glm::mat4 const &model) {
+                m_model = model;
+                m_projViewModel = m_projView * model;
+            }
+
+            ShadedVertex shade(Vertex const &vertex) const {
+                glm::vec4 position = m_projViewModel * glm::vec4(vertex.pos, 1.0f);
+                position.z = -position.z;
+                glm::vec4 pos = m_model * glm::vec4(vertex.pos, 1.0f);
+                float z = (pos.z/pos.w - m_farthestDepth)/(m_nearestDepth - m_farthestDepth);
+                if (z > 1.0f) {
+                    z = 1.0f;
+                } else if (z < 0.0f) {
+                    z = 0.0f;
+                }
+                return ShadedVertex{position, glm::vec3{z, z, z}};
+            }
+
+            explicit DepthMapShader(renderDetails::ParametersDepthMap const &parameters)
+                : m_projView{projView(parameters.toOrtho())},
+                  m_nearestDepth{parameters.nearestDepth},
+                  m_farthestDepth{parameters.farthestDepth}
+            {}
+
+        private:
+            glm::mat4 m_projView;
+            glm::mat4 m_model;
+            glm::mat4 m_projViewModel;
+            float m_nearestDepth;
+            float m_farthestDepth;
+
+            static glm::mat4 projView(renderDetails::ParametersOrtho const &ortho) {
+                return getOrthoMatrix(ortho.minusX, ortho.plusX, ortho.minusY, ortho.plusY,
+                                      ortho.nearPlane, ortho.farPlane, false, false) *
+                       glm::lookAt(ortho.viewPoint, ortho.lookAt, ortho.up);
+            }
+        };
+
+        // the normal map vertex shader (normalGL.vert).
+        class NormalMapShader {
+        public:
+            void setModelMatrix(glm::mat4 const &model) {
+                m_projViewModel = m_projView * model;
+                m_normalMatrix = glm::transpose(glm::inverse(model));
+            }
+
+            ShadedVertex shade(Vertex const &vertex) const {
+                glm::vec4 pos = m_projViewModel * glm::vec4(vertex.pos, 1.0f);
+                glm::vec4 normalVec = m_normalMatrix * glm::vec4(glm::normalize(vertex.normal), 1.0f);
+                glm::vec4 position;
+                if (normalVec.z/normalVec.w < 0.0f) {
+                    // facing away: put it at the far plane so that the depth test discards it.
+                    position = glm::vec4{pos.x, pos.y, pos.w, pos.w};
+                } else {
+                    position = glm::vec4{pos.x * normalVec.w, pos.y * normalVec.w,
+                                         normalVec.z * pos.w, normalVec.w * pos.w};
+                }
+                glm::vec3 color = glm::normalize(glm::vec3{normalVec}/normalVec.w) * 0.5f +
+                        glm::vec3{0.5f, 0.5f, 0.5f};
+                return ShadedVertex{position, color};
+            }
+
+            explicit NormalMapShader(renderDetails::ParametersNormalMap const &parameters) {
+                renderDetails::ParametersOrtho ortho = parameters.toOrtho();
+                m_projView = getOrthoMatrix(ortho.minusX, ortho.plusX, ortho.minusY, ortho.plusY,
+                                            ortho.nearPlane, ortho.farPlane, false, false) *
+                             glm::lookAt(ortho.viewPoint, ortho.lookAt, ortho.up);
+            }
+
+        private:
+            glm::mat4 m_projView;
+            glm::mat4 m_projViewModel;
+            glm::mat4 m_normalMatrix;
+        };
+
+        int64_t floorDiv(int64_t numerator, int64_t denominator) {
+            // denominator is always positive.
+            int64_t quotient = numerator / denominator;
+            if (numerator % denominator != 0 && numerator < 0) {
+                quotient--;
+            }
+            return quotient;
+        }
+
+        int64_t ceilDiv(int64_t numerator, int64_t denominator) {
+            return -floorDiv(-numerator, denominator);
+        }
+
+        // the signed distance from the clip plane: the vertex is inside if it is not negative.
+        float clipDistance(glm::vec4 const &position, size_t plane) {
+            switch (plane) {
+                case 0:
+                    return position.w + position.x;
+                case 1:
+                    return position.w - position.x;
+                case 2:
+                    return position.w + position.y;
+                case 3:
+                    return position.w - position.y;
+                case 4:
+                    return position.w + position.z;
+                default:
+                    return position.w - position.z;
+            }
+        }
+
+        bool insideAllPlanes(ShadedVertex const &vertex) {
+            for (size_t plane = 0; plane < 6; plane++) {
+                if (clipDistance(vertex.position, plane) < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /* Clip the triangle in clip space (Sutherland-Hodgman).  The new vertices are always
+         * computed going from the vertex inside the plane to the vertex outside of it so that
+         * two triangles sharing an edge get exactly the same vertex.  Returns the number of
+         * vertices in the clipped polygon.
+         */
+        size_t clipTriangle(ShadedVertex const (&triangle)[3], ShadedVertex (&polygon)[maxClippedVertices]) {
+            ShadedVertex buffer[maxClippedVertices];
+            ShadedVertex *src = polygon;
+            ShadedVertex *dst = buffer;
+            std::copy(triangle, triangle + 3, src);
+            size_t nbrVertices = 3;
+            for (size_t plane = 0; plane < 6; plane++) {
+                size_t nbrClipped = 0;
+                for (size_t i = 0; i < nbrVertices; i++) {
+                    ShadedVertex const &a = src[i];
+                    ShadedVertex const &b = src[(i + 1) % nbrVertices];
+                    float da = clipDistance(a.position, plane);
+                    float db = clipDistance(b.position, plane);
+                    if (da >= 0.0f) {
+                        dst[nbrClipped++] = a;
+                    }
+                    if ((da >= 0.0f) != (db >= 0.0f)) {
+                        ShadedVertex const &in = da >= 0.0f ? a : b;
+                        ShadedVertex const &out = da >= 0.0f ? b : a;
+                        float dIn = da >= 0.0f ? da : db;
+                        float dOut = da >= 0.0f ? db : da;
+                        float t = dIn / (dIn - dOut);
+                        dst[nbrClipped++] = ShadedVertex{
+                                in.position + t * (out.position - in.position),
+                                in.color + t * (out.color - in.color)};
+                    }
+                }
+                nbrVertices = nbrClipped;
+                if (nbrVertices < 3) {
+                    return 0;
+                }
+                std::swap(src, dst);
+            }
+
+            // an even number of planes: the result is back in polygon.
+            return nbrVertices;
+        }
+
+        class TriangleSetup {
+        public:
+            // convert to window coordinates, cull back faces and set up the triangle for
+            // rasterization.  Returns false if there is nothing to draw.
+            bool setup(ShadedVertex const &v0, ShadedVertex const &v1, ShadedVertex const &v2, Triangle &triangle) const {
+                ShadedVertex const *vertices[3] = {&v0, &v1, &v2};
+                for (size_t i = 0; i < 3; i++) {
+                    glm::vec4 const &position = vertices[i]->position;
+                    float invW = 1.0f / position.w;
+                    float xWindow = (position.x * invW + 1.0f) * m_halfWidth;
+                    float yWindow = (position.y * invW + 1.0f) * m_halfHeight;
+                    triangle.x[i] = std::llround(xWindow * subpixelScale);
+                    triangle.y[i] = std::llround(yWindow * subpixelScale);
+                    triangle.z[i] = position.z * invW * 0.5f + 0.5f;
+                    triangle.invW[i] = invW;
+                    triangle.colorOverW[i] = vertices[i]->color * invW;
+                }
+
+                // counter clockwise is the front face.
+                triangle.area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+                                (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+                if (triangle.area <= 0) {
+                    return false;
+                }
+
+                for (size_t i = 0; i < 3; i++) {
+                    size_t a = (i + 1) % 3;
+                    size_t b = (i + 2) % 3;
+                    int64_t dx = triangle.x[b] - triangle.x[a];
+                    int64_t dy = triangle.y[b] - triangle.y[a];
+                    // y points up and the inside is to the left of each edge.
+                    bool leftEdge = dy < 0;
+                    bool topEdge = dy == 0 && dx < 0;
+                    triangle.bias[i] = leftEdge || topEdge ? 0 : -1;
+                }
+
+                int64_t minY = std::min({triangle.y[0], triangle.y[1], triangle.y[2]});
+                int64_t maxY = std::max({triangle.y[0], triangle.y[1], triangle.y[2]});
+                int64_t rowBegin = std::max<int64_t>(0, ceilDiv(minY - halfPixel, subpixelScale));
+                int64_t rowEnd = std::min<int64_t>(m_height, floorDiv(maxY - halfPixel, subpixelScale) + 1);
+                if (rowBegin >= rowEnd) {
+                    return false;
+                }
+                triangle.rowBegin = static_cast<uint32_t>(rowBegin);
+                triangle.rowEnd = static_cast<uint32_t>(rowEnd);
+                return true;
+            }
+
+            TriangleSetup(uint32_t width, uint32_t height)
+                : m_height{height},
+                  m_halfWidth{width * 0.5f},
+                  m_halfHeight{height * 0.5f}
+            {}
+
+        private:
+            uint32_t m_height;
+            float m_halfWidth;
+            float m_halfHeight;
+        };
+
+        class Image {
+        public:
+            static size_t constexpr nbrComponents = 4;
+
+            std::vector<float> const &colors() const { return m_colors; }
+
+            /* Rasterize the rows of the triangle in [rowBegin, rowEnd).  Per row, the range of
+             * pixels inside all three edges is computed up front so that the loop over the
+             * pixels only interpolates and depth tests.
+             */
+            void rasterize(Triangle const &triangle, uint32_t rowBegin, uint32_t rowEnd) {
+                float invArea = 1.0f / static_cast<float>(triangle.area);
+                int64_t dx[3];
+                int64_t dy[3];
+                for (size_t i = 0; i < 3; i++) {
+                    size_t a = (i + 1) % 3;
+                    size_t b = (i + 2) % 3;
+                    dx[i] = triangle.x[b] - triangle.x[a];
+                    dy[i] = triangle.y[b] - triangle.y[a];
+                }
+
+                for (uint32_t row = rowBegin; row < rowEnd; row++) {
+                    int64_t pixelY = static_cast<int64_t>(row) * subpixelScale + halfPixel;
+
+                    // the edge function of edge i at column c is e[i] - step[i] * c.
+                    int64_t e[3];
+                    int64_t step[3];
+                    int64_t columnBegin = 0;
+                    int64_t columnEnd = m_width;
+                    for (size_t i = 0; i < 3; i++) {
+                        size_t a = (i + 1) % 3;
+                        e[i] = dx[i] * (pixelY - triangle.y[a]) - dy[i] * (halfPixel - triangle.x[a]);
+                        step[i] = dy[i] * subpixelScale;
+                        int64_t biased = e[i] + triangle.bias[i];
+                        if (step[i] == 0) {
+                            if (biased < 0) {
+                                columnEnd = 0;
+                            }
+                        } else if (step[i] < 0) {
+                            columnBegin = std::max(columnBegin, ceilDiv(-biased, -step[i]));
+                        } else {
+                            columnEnd = std::min(columnEnd, floorDiv(biased, step[i]) + 1);
+                        }
+                    }
+
+                    float *depthRow = m_depth.data() + static_cast<size_t>(row) * m_width;
+                    float *colorRow = m_colors.data() + static_cast<size_t>(row) * m_width * nbrComponents;
+                    for (int64_t column = columnBegin; column < columnEnd; column++) {
+                        float b0 = static_cast<float>(e[0] - step[0] * column) * invArea;
+                        float b1 = static_cast<float>(e[1] - step[1] * column) * invArea;
+                        float b2 = static_cast<float>(e[2] - step[2] * column) * invArea;
+                        float z = b0 * triangle.z[0] + b1 * triangle.z[1] + b2 * triangle.z[2];
+                        if (!(z < depthRow[column])) {
+                            continue;
+                        }
+                        depthRow[column] = z;
+
+                        float invW = b0 * triangle.invW[0] + b1 * triangle.invW[1] + b2 * triangle.invW[2];
+                        glm::vec3 color = (b0 * triangle.colorOverW[0] + b1 * triangle.colorOverW[1] +
+                                           b2 * triangle.colorOverW[2]) / invW;
+                        float *pixel = colorRow + column * nbrComponents;
+                        pixel[0] = color.r;
+                        pixel[1] = color.g;
+                        pixel[2] = color.b;
+                        pixel[3] = 1.0f;
+                    }
+                }
+            }
+
+            Image(uint32_t width, uint32_t height, glm::vec4 const &clearColor)
+                : m_width{width},
+                  m_depth(static_cast<size_t>(width) * height, 1.0f),
+                  m_colors(static_cast<size_t>(width) * height * nbrComponents)
+            {
+                for (size_t i = 0; i < m_colors.size(); i += nbrComponents) {
+                    m_colors[i] = clearColor.r;
+                    m_colors[i + 1] = clearColor.g;
+                    m_colors[i + 2] = clearColor.b;
+                    m_colors[i + 3] = clearColor.a;
+                }
+            }
+
+        private:
+            uint32_t m_width;
+            std::vector<float> m_depth;
+            std::vector<float> m_colors;
+        };
+
+        // returns the RGBA image with the bottom row first, like glReadPixels does.
+        template <typename ShaderType>
+        std::vector<float> rasterize(
+                ShaderType &shader,
+                std::vector<SoftwareRasterizer::Object> const &objects,
+                uint32_t imageWidth,
+                uint32_t imageHeight,
+                glm::vec4 const &clearColor,
+                uint32_t nbrThreads)
+        {
+            // Run the vertex shader, assemble, clip and set up the triangles in draw order and
+            // bin them into the tiles they cover.
+            TriangleSetup triangleSetup(imageWidth, imageHeight);
+            std::vector<Triangle> triangles;
+            uint32_t nbrTiles = (imageHeight + tileHeight - 1) / tileHeight;
+            std::vector<std::vector<uint32_t>> tiles(nbrTiles);
+            std::vector<ShadedVertex> shadedVertices;
+            auto addTriangle = [&](ShadedVertex const &v0, ShadedVertex const &v1, ShadedVertex const &v2) {
+                Triangle triangle{};
+                if (!triangleSetup.setup(v0, v1, v2, triangle)) {
+                    return;
+                }
+                auto index = static_cast<uint32_t>(triangles.size());
+                triangles.push_back(triangle);
+                for (uint32_t tile = triangle.rowBegin / tileHeight; tile <= (triangle.rowEnd - 1) / tileHeight; tile++) {
+                    tiles[tile].push_back(index);
+                }
+            };
+
+            for (auto const &object : objects) {
+                shader.setModelMatrix(object.modelMatrix);
+                auto const &vertices = object.vertices->first;
+                auto const &indices = object.vertices->second;
+
+                shadedVertices.clear();
+                shadedVertices.reserve(vertices.size());
+                for (auto const &vertex : vertices) {
+                    shadedVertices.push_back(shader.shade(vertex));
+                }
+
+                for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                    ShadedVertex const triangle[3] = {
+                            shadedVertices[indices[i]],
+                            shadedVertices[indices[i + 1]],
+                            shadedVertices[indices[i + 2]]};
+                    if (insideAllPlanes(triangle[0]) && insideAllPlanes(triangle[1]) &&
+                        insideAllPlanes(triangle[2]))
+                    {
+                        addTriangle(triangle[0], triangle[1], triangle[2]);
+                        continue;
+                    }
+
+                    ShadedVertex polygon[maxClippedVertices];
+                    size_t nbrVertices = clipTriangle(triangle, polygon);
+                    for (size_t j = 1; j + 1 < nbrVertices; j++) {
+                        addTriangle(polygon[0], polygon[j], polygon[j + 1]);
+                    }
+                }
+            }
+
+            // Rasterize the tiles in parallel.  The tiles don't share any pixels.
+            Image image(imageWidth, imageHeight, clearColor);
+            std::atomic<uint32_t> nextTile{0};
+            auto drawTiles = [&]() {
+                for (uint32_t tile = nextTile++; tile < nbrTiles; tile = nextTile++) {
+                    uint32_t tileBegin = tile * tileHeight;
+                    uint32_t tileEnd = std::min(tileBegin + tileHeight, imageHeight);
+                    for (uint32_t index : tiles[tile]) {
+                        Triangle const &triangle = triangles[index];
+                        image.rasterize(triangle, std::max(tileBegin, triangle.rowBegin),
+                                        std::min(tileEnd, triangle.rowEnd));
+                    }
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (uint32_t i = 1; i < std::min(nbrThreads, nbrTiles); i++) {
+                threads.emplace_back(drawTiles);
+            }
+            drawTiles();
+            for (auto &thread : threads) {
+                thread.join();
+            }
+
+            return image.colors();
+        }
+
+        std::shared_ptr<ModelVertices const> verticesToDraw(
+                ModelDescription &modelDescription,
+                std::pair<ModelVertices, ModelVertices> &&vertices,
+                bool useVertexNormals)
+        {
+            // pick the vertices the GPU would draw with.  See ModelDataGL.
+            uint8_t normalsToLoad = modelDescription.normalsToLoad();
+            if (normalsToLoad == 0) {
+                throw std::runtime_error("ModelDescription is not loading any vertices.");
+            }
+
+            if (useVertexNormals) {
+                if ((normalsToLoad & ModelDescription::LOAD_VERTEX_NORMALS) == 0) {
+                    throw std::runtime_error("Vertex normals not requested at model creation, but requested at model usage.");
+                }
+                return std::make_shared<ModelVertices const>(std::move(vertices.second));
+            }
+
+            if (normalsToLoad == ModelDescription::LOAD_VERTEX_NORMALS) {
+                return std::make_shared<ModelVertices const>(std::move(vertices.second));
+            }
+            return std::make_shared<ModelVertices const>(std::move(vertices.first));
+        }
+    }
+
+    bool SoftwareRasterizer::supports(std::string const &renderDetailsName) {
+        return renderDetailsName == depthMapRenderDetailsName ||
+               renderDetailsName == normalMapRenderDetailsName;
+    }
+
+    std::future<std::vector<float>> SoftwareRasterizer::drawToBufferAsync(
+            std::shared_ptr<GameRequester> const &gameRequester,
+            std::string const &renderDetailsName,
+            ModelsTextures const &modelsTextures,
+            std::vector<glm::mat4> const &modelMatrix,
+            float width,
+            float height,
+            uint32_t nbrSamplesForWidth,
+            std::shared_ptr<renderDetails::Parameters> const &parameters) const
+    {
+        if (modelsTextures.size() != modelMatrix.size()) {
+            throw std::runtime_error("the number of models must match the number of model matrices");
+        }
+
+        if (!supports(renderDetailsName)) {
+            throw std::runtime_error("The software rasterizer does not support render details: " + renderDetailsName);
+        }
+
+        uint32_t imageWidth = nbrSamplesForWidth;
+        uint32_t imageHeight = static_cast<uint32_t>(std::floor((imageWidth * height)/width));
+
+        // decode each model once.
+        bool useVertexNormals = renderDetailsName == normalMapRenderDetailsName;
+        std::map<std::shared_ptr<ModelDescription>, std::shared_ptr<ModelVertices const>,
+                BaseClassPtrLess<ModelDescription>> models;
+        std::vector<Object> objects;
+        objects.reserve(modelsTextures.size());
+        size_t i = 0;
+        for (auto const &modelTexture : modelsTextures) {
+            auto it = models.find(modelTexture.first);
+            if (it == models.end()) {
+                auto vertices = verticesToDraw(*modelTexture.first,
+                        modelTexture.first->getData(gameRequester), useVertexNormals);
+                it = models.emplace(modelTexture.first, std::move(vertices)).first;
+            }
+            objects.push_back(Object{it->second, modelMatrix[i++]});
+        }
+
+        SoftwareRasterizer rasterizer = *this;
+        return std::async(std::launch::async,
+                [rasterizer, renderDetailsName, objects, imageWidth, imageHeight, parameters]() -> std::vector<float> {
+                    return rasterizer.drawToBuffer(renderDetailsName, objects, imageWidth,
+                            imageHeight, *parameters);
+                });
+    }
+
+    std::vector<float> SoftwareRasterizer::drawToBuffer(
+            std::string const &renderDetailsName,
+            std::vector<Object> const &objects,
+            uint32_t imageWidth,
+            uint32_t imageHeight,
+            renderDetails::Parameters const &parameters) const
+    {
+        std::vector<float> results;
+        if (renderDetailsName == depthMapRenderDetailsName) {
+            auto depthParameters = dynamic_cast<renderDetails::ParametersDepthMap const *>(&parameters);
+            if (depthParameters == nullptr) {
+                throw std::runtime_error("Invalid parameters for the depth map.");
+            }
+
+            DepthMapShader shader(*depthParameters);
+            auto image = rasterize(shader, objects, imageWidth, imageHeight,
+                    glm::vec4{0.0f, 0.0f, 0.0f, 1.0f}, m_nbrThreads);
+            bitmapToDepthMap(image, depthParameters->farthestDepth, depthParameters->nearestDepth,
+                    imageWidth, imageHeight, Image::nbrComponents, false, results);
+        } else if (renderDetailsName == normalMapRenderDetailsName) {
+            auto normalParameters = dynamic_cast<renderDetails::ParametersNormalMap const *>(&parameters);
+            if (normalParameters == nullptr) {
+                throw std::runtime_error("Invalid parameters for the normal map.");
+            }
+
+            NormalMapShader shader(*normalParameters);
+            auto image = rasterize(shader, objects, imageWidth, imageHeight,
+                    glm::vec4{0.5f, 0.5f, 1.0f, 1.0f}, m_nbrThreads);
+            bitmapToNormals(image, imageWidth, imageHeight, Image::nbrComponents, false, results);
+        } else {
+            throw std::runtime_error("The software rasterizer does not support render details: " + renderDetailsName);
+        }
+
+        return results;
+    }
+
+    SoftwareRasterizer::SoftwareRasterizer(uint32_t nbrThreads)
+        : m_nbrThreads{nbrThreads}
+    {
+        if (m_nbrThreads == 0) {
+            m_nbrThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+}
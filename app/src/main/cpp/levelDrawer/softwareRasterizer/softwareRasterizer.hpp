@@ -0,0 +1,92 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_SOFTWARE_RASTERIZER_HPP
+#define AMAZING_LABYRINTH_SOFTWARE_RASTERIZER_HPP
+
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../../common.hpp"
+#include "../common.hpp"
+#include "../modelTable/modelLoader.hpp"
+
+namespace levelDrawer {
+    /* Draws the depth map and normal map render details on the CPU.  The result is the same as
+     * drawToBuffer with those render details: the vertex shaders are run as written (including
+     * the tricks they play with gl_Position), the triangles are clipped, back faces are culled
+     * (counter clockwise is the front face) and what is left is rasterized at the pixel centers
+     * with a top-left fill rule and a LESS depth test against a depth cleared to 1.0.  The
+     * colors are interpolated perspective correctly and kept as floats before they are post
+     * processed like the render details post process the image.
+     *
+     * The image is split into tiles of rows.  The triangles are binned into the tiles they
+     * touch and the tiles are rasterized in parallel.  Each pixel only depends on the triangles
+     * in its tile (in the order they were drawn in) so the result does not depend on the number
+     * of threads.
+     */
+    class SoftwareRasterizer {
+    public:
+        // The vertices of a model (as returned by ModelDescription::getData) and the model
+        // matrices to draw them with.
+        struct Object {
+            std::shared_ptr<ModelVertices const> vertices;
+            glm::mat4 modelMatrix;
+        };
+
+        // true if drawToBuffer can be done with the render details on the CPU.
+        static bool supports(std::string const &renderDetailsName);
+
+        /* Same contract as LevelDrawer::drawToBufferAsync.  The models are loaded on the calling
+         * thread and then the draw is done on other threads.  Unlike the GPU version, the
+         * future can be waited on by any thread.
+         */
+        std::future<std::vector<float>> drawToBufferAsync(
+                std::shared_ptr<GameRequester> const &gameRequester,
+                std::string const &renderDetailsName,
+                ModelsTextures const &modelsTextures,
+                std::vector<glm::mat4> const &modelMatrix,
+                float width,
+                float height,
+                uint32_t nbrSamplesForWidth,
+                std::shared_ptr<renderDetails::Parameters> const &parameters) const;
+
+        // draw the objects on this thread and the rasterizer's worker threads.
+        std::vector<float> drawToBuffer(
+                std::string const &renderDetailsName,
+                std::vector<Object> const &objects,
+                uint32_t imageWidth,
+                uint32_t imageHeight,
+                renderDetails::Parameters const &parameters) const;
+
+        // nbrThreads is the number of threads drawing the tiles.  If it is 0, one thread per
+        // core is used.
+        explicit SoftwareRasterizer(uint32_t nbrThreads = 0);
+
+    private:
+        uint32_t m_nbrThreads;
+    };
+}
+
+#endif // AMAZING_LABYRINTH_SOFTWARE_RASTERIZER_HPP
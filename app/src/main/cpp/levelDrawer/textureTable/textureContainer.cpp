@@ -0,0 +1,266 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "textureContainer.hpp"
+
+namespace levelDrawer {
+    namespace {
+        char constexpr const magic[4] = {'A', 'L', 'T', 'X'};
+        uint32_t constexpr version = 1;
+        size_t constexpr headerSize = sizeof (magic) + 2 * 4;
+        size_t constexpr imageHeaderSize = 4 * 4;
+        size_t constexpr levelHeaderSize = 4 * 4;
+        size_t constexpr alignment = 16;
+
+        // more levels than this is a texture wider than 2^16 pixels.
+        uint32_t constexpr maxLevels = 17;
+
+        char const *imageExtension = ".png";
+        char const *textureContainerExtension = ".texmip";
+
+        template <typename UintType>
+        void put(std::vector<uint8_t> &data, UintType value) {
+            for (size_t i = 0; i < sizeof (UintType); i++) {
+                data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        template <typename UintType>
+        UintType get(uint8_t const *&data) {
+            UintType value = 0;
+            for (size_t i = 0; i < sizeof (UintType); i++) {
+                value |= static_cast<UintType>(data[i]) << (8 * i);
+            }
+            data += sizeof (UintType);
+            return value;
+        }
+
+        size_t align(size_t offset) {
+            return (offset + alignment - 1) / alignment * alignment;
+        }
+
+        void readBytes(std::streambuf *in, void *data, size_t size) {
+            if (static_cast<size_t>(in->sgetn(reinterpret_cast<char *>(data),
+                    static_cast<std::streamsize>(size))) != size)
+            {
+                throw std::runtime_error("Texture container file is truncated.");
+            }
+        }
+
+        // the size in bytes of a level of a texture.
+        size_t levelSize(TextureFormat format, uint32_t width, uint32_t height) {
+            switch (format) {
+            case TextureFormat::rgba8:
+                return size_t{4} * width * height;
+            case TextureFormat::etc2Rgba8:
+            case TextureFormat::astc4x4Rgba:
+                return size_t{16} * ((width + 3) / 4) * ((height + 3) / 4);
+            default:
+                throw std::runtime_error("Unknown texture format.");
+            }
+        }
+    }
+
+    std::string textureContainerFileName(std::string const &imageFileName) {
+        std::string fileName = imageFileName;
+        size_t extensionLength = std::strlen(imageExtension);
+        if (fileName.size() >= extensionLength &&
+            fileName.compare(fileName.size() - extensionLength, extensionLength, imageExtension) == 0)
+        {
+            fileName.resize(fileName.size() - extensionLength);
+        }
+        return fileName + textureContainerExtension;
+    }
+
+    void writeTextureContainer(std::ostream &out, std::vector<TextureImage> const &images) {
+        std::vector<uint8_t> data(magic, magic + sizeof (magic));
+        put<uint32_t>(data, version);
+        put<uint32_t>(data, static_cast<uint32_t>(images.size()));
+
+        size_t offset = headerSize + images.size() * imageHeaderSize;
+        for (auto const &image : images) {
+            offset += image.levels.size() * levelHeaderSize;
+        }
+
+        std::vector<size_t> imageOffsets;
+        for (auto const &image : images) {
+            offset = align(offset);
+            imageOffsets.push_back(offset);
+            put<uint32_t>(data, static_cast<uint32_t>(image.format));
+            put<uint32_t>(data, static_cast<uint32_t>(image.levels.size()));
+            put<uint32_t>(data, static_cast<uint32_t>(offset));
+            put<uint32_t>(data, static_cast<uint32_t>(image.data.size()));
+            offset += image.data.size();
+        }
+        if (offset > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Texture too big for a texture container.");
+        }
+
+        for (auto const &image : images) {
+            for (auto const &level : image.levels) {
+                if (level.offset % alignment != 0 || level.offset + level.size > image.data.size()) {
+                    throw std::runtime_error("Texture level is not aligned or is not in the texture.");
+                }
+                put<uint32_t>(data, level.width);
+                put<uint32_t>(data, level.height);
+                put<uint32_t>(data, static_cast<uint32_t>(level.offset));
+                put<uint32_t>(data, static_cast<uint32_t>(level.size));
+            }
+        }
+
+        for (size_t i = 0; i < images.size(); i++) {
+            data.resize(imageOffsets[i], 0);
+            data.insert(data.end(), images[i].data.begin(), images[i].data.end());
+        }
+
+        out.write(reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out.good()) {
+            throw std::runtime_error("Unable to write the texture container.");
+        }
+    }
+
+    bool readTextureContainer(std::streambuf *in, std::vector<TextureImage> &images) {
+        std::array<uint8_t, headerSize> header{};
+        readBytes(in, header.data(), header.size());
+        if (std::memcmp(header.data(), magic, sizeof (magic)) != 0) {
+            throw std::runtime_error("Not a texture container file.");
+        }
+
+        uint8_t const *data = header.data() + sizeof (magic);
+        if (get<uint32_t>(data) != version) {
+            return false;
+        }
+        uint32_t nbrImages = get<uint32_t>(data);
+
+        std::vector<uint8_t> imageHeaders(nbrImages * imageHeaderSize);
+        readBytes(in, imageHeaders.data(), imageHeaders.size());
+
+        std::vector<TextureImage> result(nbrImages);
+        std::vector<uint32_t> offsets;
+        data = imageHeaders.data();
+        size_t nbrLevels = 0;
+        for (auto &image : result) {
+            image.format = static_cast<TextureFormat>(get<uint32_t>(data));
+            image.levels.resize(get<uint32_t>(data));
+            offsets.push_back(get<uint32_t>(data));
+            image.data.resize(get<uint32_t>(data));
+            if (image.levels.empty() || image.levels.size() > maxLevels) {
+                throw std::runtime_error("Texture container has a bad number of mip levels.");
+            }
+            nbrLevels += image.levels.size();
+        }
+
+        std::vector<uint8_t> levelHeaders(nbrLevels * levelHeaderSize);
+        readBytes(in, levelHeaders.data(), levelHeaders.size());
+        data = levelHeaders.data();
+        for (auto &image : result) {
+            for (size_t i = 0; i < image.levels.size(); i++) {
+                auto &level = image.levels[i];
+                level.width = get<uint32_t>(data);
+                level.height = get<uint32_t>(data);
+                level.offset = get<uint32_t>(data);
+                level.size = get<uint32_t>(data);
+
+                // each level is half the size of the one before, the GPU will read exactly
+                // level.size bytes.
+                if ((i > 0 && (level.width != std::max(1u, image.levels[i-1].width / 2) ||
+                               level.height != std::max(1u, image.levels[i-1].height / 2))) ||
+                    level.size != levelSize(image.format, level.width, level.height) ||
+                    level.offset % alignment != 0 || level.offset + level.size > image.data.size())
+                {
+                    throw std::runtime_error("Texture container has a bad mip level.");
+                }
+            }
+        }
+
+        // the image data is in the same order as the images.
+        size_t position = headerSize + imageHeaders.size() + levelHeaders.size();
+        for (size_t i = 0; i < result.size(); i++) {
+            if (offsets[i] < position) {
+                throw std::runtime_error("Texture container images overlap.");
+            }
+            std::vector<char> padding(offsets[i] - position);
+            readBytes(in, padding.data(), padding.size());
+            readBytes(in, result[i].data.data(), result[i].data.size());
+            position = offsets[i] + result[i].data.size();
+        }
+
+        images = std::move(result);
+        return true;
+    }
+
+    TextureImage const *chooseTextureImage(std::vector<TextureImage> const &images,
+                                           std::vector<TextureFormat> const &supportedFormats)
+    {
+        for (auto const &image : images) {
+            if (std::find(supportedFormats.begin(), supportedFormats.end(), image.format) !=
+                supportedFormats.end())
+            {
+                return &image;
+            }
+        }
+
+        return nullptr;
+    }
+
+    TextureImage makeMipChain(std::vector<char> const &pixels, uint32_t width, uint32_t height) {
+        TextureImage image{};
+        image.format = TextureFormat::rgba8;
+        image.levels.push_back(TextureLevel{width, height, 0, levelSize(image.format, width, height)});
+        image.data.assign(pixels.begin(), pixels.begin() + image.levels[0].size);
+
+        while (width > 1 || height > 1) {
+            uint32_t nextWidth = std::max(1u, width / 2);
+            uint32_t nextHeight = std::max(1u, height / 2);
+            size_t prevOffset = image.levels.back().offset;
+            TextureLevel level{nextWidth, nextHeight, align(image.data.size()),
+                               levelSize(image.format, nextWidth, nextHeight)};
+            image.data.resize(level.offset + level.size, 0);
+
+            auto src = reinterpret_cast<uint8_t const *>(image.data.data() + prevOffset);
+            auto dst = reinterpret_cast<uint8_t *>(image.data.data() + level.offset);
+            for (uint32_t y = 0; y < nextHeight; y++) {
+                // odd sizes: the last row or column is averaged with itself.
+                uint32_t y0 = std::min(2 * y, height - 1);
+                uint32_t y1 = std::min(2 * y + 1, height - 1);
+                for (uint32_t x = 0; x < nextWidth; x++) {
+                    uint32_t x0 = std::min(2 * x, width - 1);
+                    uint32_t x1 = std::min(2 * x + 1, width - 1);
+                    for (uint32_t c = 0; c < 4; c++) {
+                        uint32_t sum = src[(y0 * width + x0) * 4 + c] + src[(y0 * width + x1) * 4 + c] +
+                                       src[(y1 * width + x0) * 4 + c] + src[(y1 * width + x1) * 4 + c];
+                        dst[(y * nextWidth + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+                    }
+                }
+            }
+
+            image.levels.push_back(level);
+            width = nextWidth;
+            height = nextHeight;
+        }
+
+        return image;
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_TEXTURE_CONTAINER_HPP
+#define AMAZING_LABYRINTH_TEXTURE_CONTAINER_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace levelDrawer {
+    // the pixel formats a texture can be stored in.
+    enum class TextureFormat : uint32_t {
+        rgba8 = 0,          // 4 bytes per pixel, r, g, b, a
+        etc2Rgba8 = 1,      // ETC2 with EAC alpha, 16 bytes per 4x4 block
+        astc4x4Rgba = 2     // ASTC LDR, 16 bytes per 4x4 block
+    };
+
+    struct TextureLevel {
+        uint32_t width;
+        uint32_t height;
+        size_t offset;      // where the level starts in TextureImage::data
+        size_t size;
+    };
+
+    // A texture with its mip levels (level 0 first) in one format.
+    struct TextureImage {
+        TextureFormat format;
+        std::vector<TextureLevel> levels;
+        std::vector<char> data;
+    };
+
+    /* The texture container: the same texture in one or more formats, each with its mip chain.
+     * The texturemip tool (in modelobj2cbor) writes a texture container next to each texture PNG.
+     * The runtime uses the first image in the container that the graphics API supports.  An rgba8
+     * image is always present.  If there is no container, the PNG is decoded instead.
+     *
+     * File format (version 1, all values little endian):
+     *     char[4]  "ALTX"
+     *     uint32   version
+     *     uint32   number of images, in the order they should be preferred
+     *     for each image:
+     *         uint32  format (TextureFormat)
+     *         uint32  number of mip levels
+     *         uint32  offset in the file of the image data
+     *         uint32  size of the image data
+     *     for each image, for each level:
+     *         uint32  width, height
+     *         uint32  offset of the level in the image data, size of the level
+     *     then the image data.  Every image and every level starts at a multiple of 16 bytes so
+     *     that the offsets are valid buffer to image copy offsets for all the formats.
+     */
+
+    // the texture container file for a texture image file.
+    std::string textureContainerFileName(std::string const &imageFileName);
+
+    void writeTextureContainer(std::ostream &out, std::vector<TextureImage> const &images);
+
+    /* Read all the images in a texture container.  Returns false if the container is another
+     * version.  Throws if the file is not a texture container or is damaged.
+     */
+    bool readTextureContainer(std::streambuf *in, std::vector<TextureImage> &images);
+
+    // The first image whose format is in supportedFormats, nullptr if there is none.
+    TextureImage const *chooseTextureImage(std::vector<TextureImage> const &images,
+                                           std::vector<TextureFormat> const &supportedFormats);
+
+    /* An rgba8 texture with its full mip chain, down to 1x1, made by averaging 2x2 blocks of the
+     * level above.  The texture is in pixels, 4 bytes per pixel.
+     */
+    TextureImage makeMipChain(std::vector<char> const &pixels, uint32_t width, uint32_t height);
+}
+
+#endif // AMAZING_LABYRINTH_TEXTURE_CONTAINER_HPP
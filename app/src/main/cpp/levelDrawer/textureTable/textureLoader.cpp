@@ -23,6 +23,8 @@
 #include <array>
 #include <unordered_map>
 #include <list>
+#include <map>
+#include <mutex>
 
 #include <glm/glm.hpp>
 
@@ -51,10 +53,104 @@ namespace levelDrawer {
         return stream->eof();
     }
 
+    namespace {
+        struct PreloadedTextures {
+            std::mutex lock;
+            std::map<std::string, std::vector<TextureImage>> textures;
+        };
+
+        PreloadedTextures &preloadedTextures() {
+            static PreloadedTextures preloaded;
+            return preloaded;
+        }
+    }
+
+    TextureImage TextureDescription::getImage(std::shared_ptr<GameRequester> const &gameRequester,
+                                              std::vector<TextureFormat> const &) {
+        TextureImage image{};
+        uint32_t texWidth{};
+        uint32_t texHeight{};
+        uint32_t texChannels{};
+        image.data = getData(gameRequester, texWidth, texHeight, texChannels);
+        image.format = TextureFormat::rgba8;
+        image.levels.push_back(TextureLevel{texWidth, texHeight, 0, image.data.size()});
+        return image;
+    }
+
+    void TextureDescriptionPath::clearPreloaded() {
+        auto &preloaded = preloadedTextures();
+        std::lock_guard<std::mutex> lock(preloaded.lock);
+        preloaded.textures.clear();
+    }
+
+    void TextureDescriptionPath::preload(std::shared_ptr<GameRequester> const &gameRequester) {
+        std::vector<TextureImage> images = loadImages(gameRequester);
+
+        auto &preloaded = preloadedTextures();
+        std::lock_guard<std::mutex> lock(preloaded.lock);
+        preloaded.textures[imagePath] = std::move(images);
+    }
+
     std::vector<char>
     TextureDescriptionPath::getData(std::shared_ptr<GameRequester> const &gameRequester,
                                     uint32_t &texWidth, uint32_t &texHeight,
                                     uint32_t &texChannels) {
+        std::vector<TextureImage> images = getImages(gameRequester);
+        TextureImage const *image = chooseTextureImage(images, {TextureFormat::rgba8});
+        if (image == nullptr) {
+            throw std::runtime_error("Texture has no uncompressed image: " + imagePath);
+        }
+
+        TextureLevel const &level = image->levels[0];
+        texWidth = level.width;
+        texHeight = level.height;
+        texChannels = 4;
+        return std::vector<char>(image->data.begin() + level.offset,
+                                 image->data.begin() + level.offset + level.size);
+    }
+
+    TextureImage
+    TextureDescriptionPath::getImage(std::shared_ptr<GameRequester> const &gameRequester,
+                                     std::vector<TextureFormat> const &supportedFormats) {
+        std::vector<TextureImage> images = getImages(gameRequester);
+        TextureImage const *image = chooseTextureImage(images, supportedFormats);
+        if (image == nullptr) {
+            throw std::runtime_error("Texture has no image in a supported format: " + imagePath);
+        }
+
+        return std::move(images[image - images.data()]);
+    }
+
+    std::vector<TextureImage>
+    TextureDescriptionPath::getImages(std::shared_ptr<GameRequester> const &gameRequester) {
+        {
+            auto &preloaded = preloadedTextures();
+            std::lock_guard<std::mutex> lock(preloaded.lock);
+            auto it = preloaded.textures.find(imagePath);
+            if (it != preloaded.textures.end()) {
+                std::vector<TextureImage> images = std::move(it->second);
+                preloaded.textures.erase(it);
+                return images;
+            }
+        }
+
+        return loadImages(gameRequester);
+    }
+
+    std::vector<TextureImage>
+    TextureDescriptionPath::loadImages(std::shared_ptr<GameRequester> const &gameRequester) {
+        // use the texture container if the asset pipeline made one.
+        try {
+            std::vector<TextureImage> images;
+            if (readTextureContainer(gameRequester->getAssetStream(
+                    textureContainerFileName(imagePath)).get(), images))
+            {
+                return images;
+            }
+        } catch (std::runtime_error &) {
+            // missing or damaged, decode the PNG instead.
+        }
+
         std::unique_ptr<std::streambuf> assetbuf = gameRequester->getAssetStream(imagePath);
         std::istream imageStream(assetbuf.get());
 
@@ -66,19 +162,25 @@ namespace levelDrawer {
         clbk.eof = istreamEof;
 
         stbi_uc *pixels = stbi_load_from_callbacks(&clbk, &imageStream, &w, &h, &c, STBI_rgb_alpha);
-        texWidth = static_cast<uint32_t> (w);
-        texHeight = static_cast<uint32_t> (h);
-        texChannels = 4;
+        if (pixels == nullptr) {
+            throw std::runtime_error("Unable to decode texture: " + imagePath);
+        }
 
-        std::vector<char> data{};
-        unsigned int size = texWidth * texHeight * texChannels;
-        data.resize(size);
-        memcpy(data.data(), pixels, size);
+        TextureImage image{};
+        image.format = TextureFormat::rgba8;
+        auto texWidth = static_cast<uint32_t> (w);
+        auto texHeight = static_cast<uint32_t> (h);
+        size_t size = size_t{4} * texWidth * texHeight;
+        image.levels.push_back(TextureLevel{texWidth, texHeight, 0, size});
+        image.data.resize(size);
+        memcpy(image.data.data(), pixels, size);
 
         /* free the CPU memory for the image */
         stbi_image_free(pixels);
 
-        return data;
+        std::vector<TextureImage> images;
+        images.push_back(std::move(image));
+        return images;
     }
 
     std::vector<char>
@@ -24,6 +24,7 @@
 #include <map>
 #include <string>
 #include "../common.hpp"
+#include "textureContainer.hpp"
 
 class GameRequester;
 
@@ -43,6 +44,18 @@ namespace levelDrawer {
                                           uint32_t &texWidth, uint32_t &texHeight,
                                           uint32_t &texChannels) = 0;
 
+        /* The texture in the first of supportedFormats that it is available in, with all the mip
+         * levels it has.  rgba8 must be in supportedFormats.  Textures that are only available
+         * as pixels (see getData) have one level.
+         */
+        virtual TextureImage getImage(std::shared_ptr<GameRequester> const &gameRequester,
+                                      std::vector<TextureFormat> const &supportedFormats);
+
+        /* Decode the texture ahead of time so that the next call to getData for an equal texture
+         * description is fast.  Safe to call from a thread other than the draw thread.
+         */
+        virtual void preload(std::shared_ptr<GameRequester> const &) {}
+
         virtual ~TextureDescription() = default;
     };
 
@@ -56,6 +69,9 @@ namespace levelDrawer {
         }
 
     public:
+        // Drop any preloaded textures that were never used.
+        static void clearPreloaded();
+
         TextureDescriptionPath(std::string const &inImagePath)
                 : TextureDescription{},
                   imagePath{inImagePath} {}
@@ -63,6 +79,17 @@ namespace levelDrawer {
         std::vector<char> getData(std::shared_ptr<GameRequester> const &gameRequester,
                                   uint32_t &texWidth, uint32_t &texHeight,
                                   uint32_t &texChannels) override;
+
+        TextureImage getImage(std::shared_ptr<GameRequester> const &gameRequester,
+                              std::vector<TextureFormat> const &supportedFormats) override;
+
+        void preload(std::shared_ptr<GameRequester> const &gameRequester) override;
+
+    private:
+        // the images in the texture container, or the decoded PNG if there is no container.
+        std::vector<TextureImage> getImages(std::shared_ptr<GameRequester> const &gameRequester);
+
+        std::vector<TextureImage> loadImages(std::shared_ptr<GameRequester> const &gameRequester);
     };
 
     class TextureDescriptionText : public TextureDescription {
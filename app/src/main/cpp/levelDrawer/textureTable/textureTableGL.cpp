@@ -18,12 +18,59 @@
  *
  */
 
+#include <cstring>
+
 #include "textureTableGL.hpp"
+#include "../../graphicsGL.hpp"
+
+// not in the GLES 3.0 headers, from KHR_texture_compression_astc_ldr.
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
 
 namespace levelDrawer {
+    std::vector<TextureFormat> supportedTextureFormatsGL(int glVersion) {
+        // the preferred formats first.  ETC2 is part of GLES 3.0, GLES 2.0 only gets rgba8.
+        std::vector<TextureFormat> formats;
+        if (glVersion != graphicsGL::Surface::GL_GRAPHICS_VERSION_3) {
+            formats.push_back(TextureFormat::rgba8);
+            return formats;
+        }
+
+        GLint nbrExtensions = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &nbrExtensions);
+        for (GLint i = 0; i < nbrExtensions; i++) {
+            auto extension = reinterpret_cast<char const *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (extension != nullptr && std::strcmp(extension, "GL_KHR_texture_compression_astc_ldr") == 0) {
+                formats.push_back(TextureFormat::astc4x4Rgba);
+            }
+        }
+
+        formats.push_back(TextureFormat::etc2Rgba8);
+        formats.push_back(TextureFormat::rgba8);
+        return formats;
+    }
+
     void TextureDataGL::createTexture(
             std::shared_ptr<GameRequester> const &gameRequester,
-            std::shared_ptr<TextureDescription> const &textureDescription) {
+            std::shared_ptr<TextureDescription> const &textureDescription,
+            std::vector<TextureFormat> const &supportedFormats,
+            int glVersion) {
+
+        TextureImage image = textureDescription->getImage(gameRequester, supportedFormats);
+        auto const &firstLevel = image.levels.front();
+        auto const &lastLevel = image.levels.back();
+        auto isPowerOf2 = [](uint32_t n) -> bool { return n != 0 && (n & (n - 1)) == 0; };
+
+        // GLES 2.0 can't mipmap a texture that is not a power of 2 wide and high, sampling it with
+        // a mipmap filter returns black.  It also can't limit sampling to the levels there are, so
+        // a partial mip chain is generated again from level 0.
+        bool es3 = glVersion == graphicsGL::Surface::GL_GRAPHICS_VERSION_3;
+        bool useMipmaps = es3 || (isPowerOf2(firstLevel.width) && isPowerOf2(firstLevel.height));
+        size_t nbrLevels = image.levels.size();
+        if (!es3 && (!useMipmaps || lastLevel.width != 1 || lastLevel.height != 1)) {
+            nbrLevels = 1;
+        }
 
         glGenTextures(1, &m_handle);
         checkGraphicsError();
@@ -37,25 +84,46 @@ namespace levelDrawer {
         checkGraphicsError();
 
         // when the texture is scaled up or down
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, /*GL_LINEAR_MIPMAP_LINEAR*/
-                        GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                        useMipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
         checkGraphicsError();
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, /*GL_LINEAR*/ GL_NEAREST);
         checkGraphicsError();
 
-        uint32_t texHeight{};
-        uint32_t texWidth{};
-        uint32_t texChannels{};
-        std::vector<char> pixels = textureDescription->getData(gameRequester,
-                                                               texWidth, texHeight, texChannels);
+        for (size_t i = 0; i < nbrLevels; i++) {
+            auto const &level = image.levels[i];
+            auto levelNbr = static_cast<GLint>(i);
+            auto width = static_cast<GLsizei>(level.width);
+            auto height = static_cast<GLsizei>(level.height);
+            char const *pixels = image.data.data() + level.offset;
+            switch (image.format) {
+            case TextureFormat::rgba8:
+                glTexImage2D(GL_TEXTURE_2D, levelNbr, GL_RGBA, width, height, 0, GL_RGBA,
+                             GL_UNSIGNED_BYTE, pixels);
+                break;
+            case TextureFormat::etc2Rgba8:
+                glCompressedTexImage2D(GL_TEXTURE_2D, levelNbr, GL_COMPRESSED_RGBA8_ETC2_EAC, width,
+                                       height, 0, static_cast<GLsizei>(level.size), pixels);
+                break;
+            case TextureFormat::astc4x4Rgba:
+                glCompressedTexImage2D(GL_TEXTURE_2D, levelNbr, GL_COMPRESSED_RGBA_ASTC_4x4_KHR, width,
+                                       height, 0, static_cast<GLsizei>(level.size), pixels);
+                break;
+            }
+            checkGraphicsError();
+        }
 
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texWidth, texHeight, 0, GL_RGBA,
-                     GL_UNSIGNED_BYTE, pixels.data());
-        checkGraphicsError();
+        if (useMipmaps && nbrLevels == 1 && image.format == TextureFormat::rgba8) {
+            // no mip levels came with the texture.
+            glGenerateMipmap(GL_TEXTURE_2D);
+            checkGraphicsError();
+        } else if (useMipmaps && (lastLevel.width != 1 || lastLevel.height != 1)) {
+            // only sample from the levels we have (compressed textures have no generated levels).
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(nbrLevels - 1));
+            checkGraphicsError();
+        }
 
-        glGenerateMipmap(GL_TEXTURE_2D);
-        checkGraphicsError();
         glBindTexture(GL_TEXTURE_2D, 0);
         checkGraphicsError();
     }
-}
\ No newline at end of file
+}
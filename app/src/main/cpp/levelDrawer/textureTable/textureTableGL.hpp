@@ -22,6 +22,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <GLES3/gl3.h>
 #include <GLES3/gl3ext.h>
@@ -31,8 +32,10 @@ namespace levelDrawer {
     class TextureDataGL : public TextureData {
     public:
         TextureDataGL(std::shared_ptr<GameRequester> const &gameRequester,
-                      std::shared_ptr<TextureDescription> const &textureDescription) {
-            createTexture(gameRequester, textureDescription);
+                      std::shared_ptr<TextureDescription> const &textureDescription,
+                      std::vector<TextureFormat> const &supportedFormats,
+                      int glVersion) {
+            createTexture(gameRequester, textureDescription, supportedFormats, glVersion);
         }
 
         ~TextureDataGL() override {
@@ -45,20 +48,37 @@ namespace levelDrawer {
         GLuint m_handle;
 
         void createTexture(std::shared_ptr<GameRequester> const &gameRequester,
-                           std::shared_ptr<TextureDescription> const &textureDescription);
+                           std::shared_ptr<TextureDescription> const &textureDescription,
+                           std::vector<TextureFormat> const &supportedFormats,
+                           int glVersion);
     };
 
+    // the texture formats the GL context can sample from.  Must be called with the context current.
+    std::vector<TextureFormat> supportedTextureFormatsGL(int glVersion);
+
     class TextureTableGL : public TextureTable<TextureDataGL> {
     public:
+        explicit TextureTableGL(int glVersion)
+                : m_glVersion{glVersion}
+        {}
+
         ~TextureTableGL() override = default;
 
     protected:
         std::shared_ptr<TextureDataGL>
         getTextureData(std::shared_ptr<GameRequester> const &gameRequester,
                        std::shared_ptr<TextureDescription> const &textureDescription) override {
-            return std::make_shared<TextureDataGL>(gameRequester, textureDescription);
+            if (m_supportedFormats.empty()) {
+                m_supportedFormats = supportedTextureFormatsGL(m_glVersion);
+            }
+            return std::make_shared<TextureDataGL>(gameRequester, textureDescription,
+                                                   m_supportedFormats, m_glVersion);
         }
 
+    private:
+        int m_glVersion;
+        std::vector<TextureFormat> m_supportedFormats;
+
     };
 }
 #endif // AMAZING_LABYRINTH_TEXTURE_TABLE_GL_HPP
@@ -29,22 +29,45 @@
 #include "textureTable.hpp"
 
 namespace levelDrawer {
+    // the Vulkan format for a texture format.
+    inline VkFormat vulkanTextureFormat(TextureFormat format) {
+        switch (format) {
+        case TextureFormat::etc2Rgba8:
+            return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+        case TextureFormat::astc4x4Rgba:
+            return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+        case TextureFormat::rgba8:
+        default:
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        }
+    }
+
+    // the texture formats the device can sample from with linear filtering, preferred formats first.
+    inline std::vector<TextureFormat> supportedTextureFormatsVulkan(std::shared_ptr<vulkan::Device> const &device) {
+        std::vector<TextureFormat> formats;
+        for (auto format : {TextureFormat::astc4x4Rgba, TextureFormat::etc2Rgba8, TextureFormat::rgba8}) {
+            if (format == TextureFormat::rgba8 ||
+                device->formatSupported(vulkanTextureFormat(format), VK_IMAGE_TILING_OPTIMAL,
+                        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+            {
+                formats.push_back(format);
+            }
+        }
+        return formats;
+    }
+
     class TextureDataVulkan : public TextureData {
     public:
         TextureDataVulkan(
                 std::shared_ptr<GameRequester> const &gameRequester,
                 std::shared_ptr<vulkan::Device> const &inDevice,
-                std::shared_ptr<vulkan::CommandPool> const &inCommandPool,
-                std::shared_ptr<TextureDescription> const &inTextureDescription) {
-            uint32_t texWidth{};
-            uint32_t texHeight{};
-            uint32_t texChannels{};
-
-            std::vector<char> pixels = inTextureDescription->getData(gameRequester, texWidth,
-                                                                     texHeight, texChannels);
+                vulkan::StagingRing &stagingRing,
+                std::shared_ptr<TextureDescription> const &inTextureDescription,
+                std::vector<TextureFormat> const &supportedFormats) {
+            TextureImage image = inTextureDescription->getImage(gameRequester, supportedFormats);
 
-            m_sampler = std::make_shared<vulkan::ImageSampler>(inDevice, inCommandPool, pixels,
-                                                               texWidth, texHeight, texChannels);
+            m_sampler = std::make_shared<vulkan::ImageSampler>(inDevice, stagingRing, image,
+                                                               vulkanTextureFormat(image.format));
         }
 
         inline std::shared_ptr<vulkan::ImageSampler> const &sampler() { return m_sampler; }
@@ -57,10 +80,11 @@ namespace levelDrawer {
     public:
         TextureTableVulkan(
                 std::shared_ptr<vulkan::Device> inDevice,
-                std::shared_ptr<vulkan::CommandPool> inCommandPool)
+                std::shared_ptr<vulkan::StagingRing> inStagingRing)
                 : TextureTable{},
                   m_device{inDevice},
-                  m_commandPool{inCommandPool} {}
+                  m_stagingRing{inStagingRing},
+                  m_supportedFormats{supportedTextureFormatsVulkan(m_device)} {}
 
         ~TextureTableVulkan() override = default;
 
@@ -68,13 +92,14 @@ namespace levelDrawer {
         std::shared_ptr<TextureDataVulkan> getTextureData(
                 std::shared_ptr<GameRequester> const &gameRequester,
                 std::shared_ptr<TextureDescription> const &textureDescription) override {
-            return std::make_shared<TextureDataVulkan>(gameRequester, m_device, m_commandPool,
-                                                       textureDescription);
+            return std::make_shared<TextureDataVulkan>(gameRequester, m_device, *m_stagingRing,
+                                                       textureDescription, m_supportedFormats);
         }
 
     private:
         std::shared_ptr<vulkan::Device> m_device;
-        std::shared_ptr<vulkan::CommandPool> m_commandPool;
+        std::shared_ptr<vulkan::StagingRing> m_stagingRing;
+        std::vector<TextureFormat> m_supportedFormats;
     };
 }
 
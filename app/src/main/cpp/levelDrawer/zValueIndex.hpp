@@ -0,0 +1,284 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_Z_VALUE_INDEX_HPP
+#define AMAZING_LABYRINTH_Z_VALUE_INDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/optional.hpp>
+
+namespace levelDrawer {
+    using DrawObjReference = uint64_t;
+    using DrawObjDataReference = uint64_t;
+
+    struct ZValueReference {
+        static float constexpr errVal = 0.000001f;
+        boost::optional<float> z;
+        DrawObjReference drawObjectReference;
+        boost::optional<DrawObjDataReference>  drawObjectDataReference;
+
+        ZValueReference(
+                boost::optional<float> inZ,
+                DrawObjReference inDrawObjectReference,
+                boost::optional<DrawObjDataReference> inDrawObjectDataReference)
+                : z{inZ},
+                drawObjectReference{inDrawObjectReference},
+                drawObjectDataReference{inDrawObjectDataReference}
+        {}
+
+        ZValueReference(ZValueReference const &other) = default;
+        ZValueReference(ZValueReference &&other) = default;
+        ZValueReference &operator=(ZValueReference const &other) = default;
+        ZValueReference &operator=(ZValueReference &&other) = default;
+
+        bool operator ==(ZValueReference const &other) const {
+            return !(*this < other) && !(other < *this);
+        }
+
+        bool operator <(ZValueReference const &other) const {
+            if (z != boost::none && other.z != boost::none &&
+               (z.get() > other.z.get() + errVal || z.get() < other.z.get() - errVal))
+            {
+                return z.get() < other.z.get();
+            }
+
+            if (drawObjectReference != other.drawObjectReference) {
+                return drawObjectReference < other.drawObjectReference;
+            }
+
+            if (drawObjectDataReference != boost::none && other.drawObjectDataReference != boost::none) {
+                return drawObjectDataReference.get() < other.drawObjectDataReference.get();
+            }
+
+            return false;
+        }
+    };
+
+    // The Z value references of a draw object table in the order they are drawn in.
+    using ZValueReferences = std::vector<ZValueReference>;
+
+    /* Keeps the Z value references of a draw object table in draw order (back to front).
+     *
+     * The references are stored in a vector along with a map from the draw object and draw
+     * object data reference to the reference's position in the vector so that an update or
+     * removal goes straight to the entry.  Updating a z value that doesn't change the draw order
+     * (the common case: a ball rolling on a flat floor) just overwrites the z value.  Otherwise
+     * the vector is only marked out of order and it is sorted once the next time the draw order
+     * is needed, which is once per frame.  Removal moves the last entry into the removed entry's
+     * spot and marks the vector out of order.
+     *
+     * The vector is almost always nearly sorted when it is sorted: only a few objects move in
+     * front of or behind another one between frames.  So only the references that are out of
+     * order are sorted and then they are merged back in with the rest.
+     */
+    class ZValueIndex {
+    public:
+        // the references in draw order.
+        ZValueReferences const &sorted() {
+            if (m_needsSort) {
+                sort();
+            }
+            return m_references;
+        }
+
+        /* changes every time a reference is added or removed or the references are put back in
+         * draw order.  A z value update that keeps the draw order does not change it.
+         */
+        uint64_t revision() {
+            if (m_needsSort) {
+                sort();
+            }
+            return m_revision;
+        }
+
+        size_t size() const { return m_references.size(); }
+
+        bool empty() const { return m_references.empty(); }
+
+        // returns false if the reference is already in the index.
+        bool add(float z, DrawObjReference objRef, boost::optional<DrawObjDataReference> objDataRef) {
+            auto ret = m_positions.emplace(Key{objRef, objDataRef}, m_references.size());
+            if (!ret.second) {
+                return false;
+            }
+
+            m_references.emplace_back(z, objRef, objDataRef);
+            m_revision++;
+            checkOrder(m_references.size() - 1);
+            return true;
+        }
+
+        // returns false if the reference is not in the index.
+        bool update(float z, DrawObjReference objRef, boost::optional<DrawObjDataReference> objDataRef) {
+            auto it = m_positions.find(Key{objRef, objDataRef});
+            if (it == m_positions.end()) {
+                return false;
+            }
+
+            m_references[it->second].z = z;
+            checkOrder(it->second);
+            return true;
+        }
+
+        // returns false if the reference is not in the index.
+        bool remove(DrawObjReference objRef, boost::optional<DrawObjDataReference> objDataRef) {
+            auto it = m_positions.find(Key{objRef, objDataRef});
+            if (it == m_positions.end()) {
+                return false;
+            }
+
+            size_t position = it->second;
+            size_t last = m_references.size() - 1;
+            m_positions.erase(it);
+            if (position != last) {
+                m_references[position] = std::move(m_references[last]);
+                m_positions[key(m_references[position])] = position;
+                m_needsSort = true;
+            }
+            m_references.pop_back();
+            m_revision++;
+            return true;
+        }
+
+        void clear() {
+            m_references.clear();
+            m_positions.clear();
+            m_needsSort = false;
+            m_revision++;
+        }
+
+        ZValueIndex()
+            : m_needsSort{false},
+              m_revision{0}
+        {}
+
+    private:
+        struct Key {
+            DrawObjReference objRef;
+            DrawObjDataReference objDataRef;
+
+            // instanced draw objects have one reference for all of their instances and it doesn't
+            // have a draw object data reference.
+            static DrawObjDataReference constexpr noObjDataRef = std::numeric_limits<DrawObjDataReference>::max();
+
+            Key(DrawObjReference inObjRef, boost::optional<DrawObjDataReference> const &inObjDataRef)
+                : objRef{inObjRef},
+                  objDataRef{inObjDataRef == boost::none ? noObjDataRef : inObjDataRef.get()}
+            {}
+
+            bool operator==(Key const &other) const {
+                return objRef == other.objRef && objDataRef == other.objDataRef;
+            }
+        };
+
+        struct KeyHash {
+            size_t operator()(Key const &k) const {
+                return std::hash<uint64_t>()(k.objRef * 0x9e3779b97f4a7c15ULL ^ k.objDataRef);
+            }
+        };
+
+        ZValueReferences m_references;
+        std::unordered_map<Key, size_t, KeyHash> m_positions;
+        bool m_needsSort;
+        uint64_t m_revision;
+
+        static Key key(ZValueReference const &ref) {
+            return Key{ref.drawObjectReference, ref.drawObjectDataReference};
+        }
+
+        // mark the references out of order if the entry at position is not in order with its
+        // neighbors.
+        void checkOrder(size_t position) {
+            if (m_needsSort) {
+                return;
+            }
+
+            if ((position > 0 && m_references[position] < m_references[position - 1]) ||
+                (position + 1 < m_references.size() && m_references[position + 1] < m_references[position]))
+            {
+                m_needsSort = true;
+            }
+        }
+
+        void sort() {
+            // Split the references into the ones that are still in order and the ones that moved.
+            // When a reference is out of order with the last one kept, both of them are moved
+            // out, so at most twice as many references are moved out as needed.
+            ZValueReferences inOrder;
+            ZValueReferences moved;
+            inOrder.reserve(m_references.size());
+            for (auto &ref : m_references) {
+                if (inOrder.empty() || !(ref < inOrder.back())) {
+                    inOrder.push_back(std::move(ref));
+                } else {
+                    moved.push_back(std::move(inOrder.back()));
+                    inOrder.pop_back();
+                    moved.push_back(std::move(ref));
+                }
+            }
+
+            mergeSort(moved.begin(), moved.end());
+
+            m_references.clear();
+            std::merge(std::make_move_iterator(inOrder.begin()), std::make_move_iterator(inOrder.end()),
+                       std::make_move_iterator(moved.begin()), std::make_move_iterator(moved.end()),
+                       std::back_inserter(m_references));
+
+            for (size_t i = 0; i < m_references.size(); i++) {
+                m_positions[key(m_references[i])] = i;
+            }
+            m_needsSort = false;
+            m_revision++;
+        }
+
+        /* std::sort and std::stable_sort require a strict weak ordering and can run off of the
+         * end of the range if they don't get one.  ZValueReference's comparison is not quite one
+         * (z values within errVal of each other are treated as equal) so use a merge sort which
+         * only ever compares elements within the range.
+         */
+        static void mergeSort(ZValueReferences::iterator begin, ZValueReferences::iterator end) {
+            auto size = end - begin;
+            if (size < 2) {
+                return;
+            }
+
+            auto middle = begin + size / 2;
+            mergeSort(begin, middle);
+            mergeSort(middle, end);
+            if (!(*middle < *(middle - 1))) {
+                return;
+            }
+
+            ZValueReferences merged;
+            merged.reserve(static_cast<size_t>(size));
+            std::merge(std::make_move_iterator(begin), std::make_move_iterator(middle),
+                       std::make_move_iterator(middle), std::make_move_iterator(end),
+                       std::back_inserter(merged));
+            std::move(merged.begin(), merged.end(), begin);
+        }
+    };
+}
+
+#endif // AMAZING_LABYRINTH_Z_VALUE_INDEX_HPP
@@ -21,9 +21,11 @@
 #include <functional>
 #include <boost/optional.hpp>
 #include <vector>
+#include <future>
 #include <boost/none.hpp>
 
 #include "../levels/basic/level.hpp"
+#include "../levels/basic/serializer.hpp"
 #include "types.hpp"
 #include "levelTracker.hpp"
 #include "internals.hpp"
@@ -132,7 +134,7 @@ namespace levelTracker {
     }
 
     void saveGameData(
-            std::shared_ptr<FileRequester> const &requester,
+            SaveDataWriter &writer,
             uint32_t screenWidth,
             uint32_t screenHeight,
             std::string const &levelName,
@@ -151,12 +153,7 @@ namespace levelTracker {
             vec = nlohmann::json::to_cbor(j);
         }
 
-        std::ofstream saveDataStream(requester->getSaveDataFileName());
-
-        if (!saveDataStream.fail()) {
-            saveDataStream.write(reinterpret_cast<char const *>(vec.data()), vec.size());
-            saveDataStream.close();
-        }
+        writer.save(std::move(vec));
     }
 
     void Loader::gotoNextLevel() {
@@ -167,7 +164,45 @@ namespace levelTracker {
         }
     }
 
+    void Loader::cancelPreload() {
+        m_preloadedLevel = boost::none;
+        if (m_preloadedGroup.valid()) {
+            m_preloadedGroup.wait();
+            m_preloadedGroup = std::future<LevelGroup>();
+        }
+    }
+
+    void Loader::preloadNextLevel() {
+        if (m_levelTable.empty()) {
+            return;
+        }
+
+        size_t nextLevel = 0;
+        if (m_currentLevel != boost::none) {
+            nextLevel = (m_currentLevel.get() + 1) % m_levelTable.size();
+        }
+
+        if (m_preloadedLevel == nextLevel && m_preloadedGroup.valid()) {
+            // already preloading it.
+            return;
+        }
+
+        cancelPreload();
+        m_preloadedLevel = nextLevel;
+        m_preloadedGroup = std::async(std::launch::async, [this, nextLevel]() -> LevelGroup {
+            return loadLevelGroup(nextLevel, nullptr, true, true);
+        });
+    }
+
     LevelGroup Loader::getLevelGroupFcns(uint32_t screenWidth, uint32_t screenHeight) {
+        if (m_currentLevel != boost::none && m_preloadedLevel == m_currentLevel &&
+            m_preloadedGroup.valid())
+        {
+            // get() rethrows any error that happened while preloading.
+            m_preloadedLevel = boost::none;
+            return m_preloadedGroup.get();
+        }
+
         nlohmann::json *pjsdLevel = nullptr;
         nlohmann::json jsdLevel;
         nlohmann::json jgb;
@@ -198,7 +233,32 @@ namespace levelTracker {
                 }
             }
         }
-        nlohmann::json j = nlohmann::json::from_cbor(getDataFromFile(m_gameRequester->getAssetStream(m_levelTable[m_currentLevel.get()].fileName)));
+
+        // The current level is loaded again when the surface changes, the preload for the level
+        // after it is still good, so leave it running.  Any other preload is for a level we are
+        // not going to.
+        if (m_levelTable.empty() ||
+            m_preloadedLevel != (m_currentLevel.get() + 1) % m_levelTable.size())
+        {
+            cancelPreload();
+        }
+
+        return loadLevelGroup(m_currentLevel.get(), pjsdLevel, needsLevelStarter, false);
+    }
+
+    LevelGroup Loader::loadLevelGroup(
+            size_t levelNumber,
+            nlohmann::json const *pjsdLevel,
+            bool needsLevelStarter,
+            bool preloadModels) const
+    {
+        if (preloadModels) {
+            // anything left over from the last preload is not going to be used.
+            levelDrawer::ModelDescriptionPath::clearPreloaded();
+            levelDrawer::TextureDescriptionPath::clearPreloaded();
+        }
+
+        nlohmann::json j = nlohmann::json::from_cbor(getDataFromFile(m_gameRequester->getAssetStream(m_levelTable[levelNumber].fileName)));
         auto components = j[DataVariables::Components].get<Components>();
 
         auto mergeJson = [gameRequester = m_gameRequester, loader = this](nlohmann::json &j, std::string const &filename) -> void {
@@ -251,6 +311,13 @@ namespace levelTracker {
             group.getLevelFcn = levelIt->second(j[DataVariables::Level], pjsdLevel, m_maxZLevel);
         }
 
+        if (preloadModels) {
+            if (needsLevelStarter) {
+                basic::preloadModels(m_gameRequester, j[DataVariables::Starter]);
+            }
+            basic::preloadModels(m_gameRequester, j[DataVariables::Level]);
+        }
+
         auto finisherIt = finisherTable().find(components.finisher.name);
         if (finisherIt == finisherTable().end()) {
             throw std::runtime_error("Invalid finisher");
@@ -269,7 +336,9 @@ namespace levelTracker {
     Loader::Loader(
         std::shared_ptr<GameRequester> inGameRequester)
         : m_gameRequester{std::move(inGameRequester)},
-          m_currentLevel{boost::none}
+          m_currentLevel{boost::none},
+          m_preloadedLevel{boost::none},
+          m_preloadedGroup{}
     {
         auto streambuf = m_gameRequester->getLevelTableAssetStream();
         std::istream stream(streambuf.get());
@@ -22,11 +22,14 @@
 #include <array>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <boost/optional.hpp>
+#include <json.hpp>
 #include "../levels/finisher/types.hpp"
 #include "../levels/basic/level.hpp"
 #include "../common.hpp"
 #include "../mathGraphics.hpp"
+#include "saveDataWriter.hpp"
 
 namespace levelTracker {
     using GenerateLevelFcn = std::function<std::shared_ptr<basic::Level>(levelDrawer::Adaptor)>;
@@ -57,8 +60,9 @@ namespace levelTracker {
         }
     };
 
+    // serializes the game save data and queues it on writer to be written to the save file.
     void saveGameData(
-            std::shared_ptr<FileRequester> const &requester,
+            SaveDataWriter &writer,
             uint32_t screenWidth,
             uint32_t screenHeight,
             std::string const &levelName,
@@ -106,6 +110,14 @@ namespace levelTracker {
 
         LevelGroup getLevelGroupFcns(uint32_t screenWidth, uint32_t screenHeight);
 
+        /* Start reading and parsing the configuration for the level after the current one and
+         * decoding its models and textures on a worker thread.  The next call to
+         * getLevelGroupFcns after gotoNextLevel will use the result instead of doing this work
+         * on the draw thread.  Creating the levels and the GPU objects they need still happens on
+         * the draw thread when the level group functions are called.
+         */
+        void preloadNextLevel();
+
         Loader(std::shared_ptr<GameRequester> inGameRequester);
 
     private:
@@ -113,19 +125,35 @@ namespace levelTracker {
         std::vector<LevelTableEntry> m_levelTable;
         boost::optional<size_t> m_currentLevel;
 
-        std::vector<uint8_t> getDataFromFile(std::string const &filename) {
+        // The level being preloaded and the future for the preload.  The future is declared last
+        // so that it is destroyed (and waited on) before the members the worker thread uses.
+        boost::optional<size_t> m_preloadedLevel;
+        std::future<LevelGroup> m_preloadedGroup;
+
+        // wait for any preload in progress and throw away the result.
+        void cancelPreload();
+
+        // Only uses m_gameRequester and m_levelTable, so it is safe to run on the preload worker
+        // thread.  pjsdLevel is the level save data, if any.
+        LevelGroup loadLevelGroup(
+                size_t levelNumber,
+                nlohmann::json const *pjsdLevel,
+                bool needsLevelStarter,
+                bool preloadModels) const;
+
+        std::vector<uint8_t> getDataFromFile(std::string const &filename) const {
             std::ifstream stream(filename, std::ifstream::binary);
             auto data = getDataFromFile(stream);
             stream.close();
             return data;
         }
 
-        std::vector<uint8_t> getDataFromFile(std::unique_ptr<std::streambuf> const &sb) {
+        std::vector<uint8_t> getDataFromFile(std::unique_ptr<std::streambuf> const &sb) const {
             std::istream stream(sb.get());
             return getDataFromFile(stream);
         }
 
-        std::vector<uint8_t> getDataFromFile(std::istream &stream) {
+        std::vector<uint8_t> getDataFromFile(std::istream &stream) const {
             if (stream.good()) {
                 stream.seekg(0, stream.end);
                 size_t i = static_cast<size_t >(stream.tellg());
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "saveDataWriter.hpp"
+
+namespace levelTracker {
+    namespace {
+        // the directory part of fileName, or "." if there is none.
+        std::string directoryOf(std::string const &fileName) {
+            auto pos = fileName.find_last_of('/');
+            if (pos == std::string::npos) {
+                return ".";
+            } else if (pos == 0) {
+                return "/";
+            }
+            return fileName.substr(0, pos);
+        }
+
+        void syncPath(std::string const &path, int flags) {
+            int fd = open(path.c_str(), flags);
+            if (fd != -1) {
+                fsync(fd);
+                close(fd);
+            }
+        }
+    }
+
+    void SaveDataWriter::save(std::vector<uint8_t> data) {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_pending = std::move(data);
+        m_cv.notify_all();
+    }
+
+    void SaveDataWriter::flush() {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_cv.wait(lock, [this]() -> bool { return !m_pending && !m_writing; });
+
+        if (m_fsyncPolicy == fsyncOnFlush && !m_lastWriteSynced) {
+            // the writer thread is idle and holding the lock keeps it that way.
+            syncSaveFile();
+            m_lastWriteSynced = true;
+        }
+    }
+
+    void SaveDataWriter::writerLoop() {
+        std::unique_lock<std::mutex> lock(m_lock);
+        while (true) {
+            m_cv.wait(lock, [this]() -> bool { return m_stop || m_pending; });
+            if (!m_pending) {
+                // stop was requested and everything is written.
+                return;
+            }
+
+            std::vector<uint8_t> data = std::move(m_pending.get());
+            m_pending = boost::none;
+            m_writing = true;
+            bool sync = m_fsyncPolicy == fsyncAlways;
+
+            lock.unlock();
+            bool written = writeFile(data, sync);
+            lock.lock();
+
+            m_writing = false;
+            if (written) {
+                m_lastWriteSynced = sync;
+            }
+            m_cv.notify_all();
+        }
+    }
+
+    bool SaveDataWriter::writeFile(std::vector<uint8_t> const &data, bool sync) {
+        int fd = open(m_tmpFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd == -1) {
+            return false;
+        }
+
+        size_t written = 0;
+        while (written < data.size()) {
+            ssize_t rc = write(fd, data.data() + written, data.size() - written);
+            if (rc < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                close(fd);
+                unlink(m_tmpFileName.c_str());
+                return false;
+            }
+            written += static_cast<size_t>(rc);
+        }
+
+        if (sync) {
+            fsync(fd);
+        }
+
+        if (close(fd) != 0 || rename(m_tmpFileName.c_str(), m_saveFileName.c_str()) != 0) {
+            unlink(m_tmpFileName.c_str());
+            return false;
+        }
+
+        if (sync) {
+            // make the rename itself durable.
+            syncPath(directoryOf(m_saveFileName), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        }
+
+        return true;
+    }
+
+    void SaveDataWriter::syncSaveFile() {
+        syncPath(m_saveFileName, O_RDONLY | O_CLOEXEC);
+        syncPath(directoryOf(m_saveFileName), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    }
+
+    SaveDataWriter::SaveDataWriter(std::string saveFileName, FsyncPolicy fsyncPolicy)
+            : m_saveFileName{std::move(saveFileName)},
+              m_tmpFileName{m_saveFileName + ".tmp"},
+              m_fsyncPolicy{fsyncPolicy},
+              m_pending{},
+              m_writing{false},
+              m_lastWriteSynced{true},
+              m_stop{false},
+              m_thread{&SaveDataWriter::writerLoop, this}
+    {}
+
+    SaveDataWriter::~SaveDataWriter() {
+        flush();
+
+        {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_stop = true;
+            m_cv.notify_all();
+        }
+        m_thread.join();
+    }
+}
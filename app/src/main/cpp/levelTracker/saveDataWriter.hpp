@@ -0,0 +1,87 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_SAVE_DATA_WRITER_HPP
+#define AMAZING_LABYRINTH_SAVE_DATA_WRITER_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/optional.hpp>
+
+namespace levelTracker {
+    /* Writes the save data file on a background thread so that the draw thread never waits on
+     * storage.  Only the latest snapshot matters, so if save is called again before the writer
+     * thread gets to the previous snapshot, the previous one is dropped.  Each write goes to a
+     * temporary file which is then renamed over the save file, so the save file is always either
+     * the old or the new contents, never a partially written file.
+     */
+    class SaveDataWriter {
+    public:
+        enum FsyncPolicy {
+            // never call fsync, leave it to the OS.
+            fsyncNever,
+
+            // only make sure the data is on storage when flush is called (i.e. at shutdown).
+            fsyncOnFlush,
+
+            // call fsync on every write.
+            fsyncAlways
+        };
+
+        // queue data to be written to the save file, replacing any data not written yet.
+        void save(std::vector<uint8_t> data);
+
+        // block until all queued data has been written (and synced if the policy says to).
+        void flush();
+
+        SaveDataWriter(std::string saveFileName, FsyncPolicy fsyncPolicy = fsyncOnFlush);
+
+        // flushes any data not written yet.
+        ~SaveDataWriter();
+
+    private:
+        std::string const m_saveFileName;
+        std::string const m_tmpFileName;
+        FsyncPolicy const m_fsyncPolicy;
+
+        std::mutex m_lock;
+        std::condition_variable m_cv;
+        boost::optional<std::vector<uint8_t>> m_pending;
+        bool m_writing;
+        bool m_lastWriteSynced;
+        bool m_stop;
+
+        // declared last so that everything it uses is initialized before it starts.
+        std::thread m_thread;
+
+        void writerLoop();
+
+        // returns false if the data could not be written.  Errors are not reported any further
+        // because the data will be saved again later anyways.
+        bool writeFile(std::vector<uint8_t> const &data, bool sync);
+
+        void syncSaveFile();
+    };
+}
+
+#endif // AMAZING_LABYRINTH_SAVE_DATA_WRITER_HPP
@@ -31,6 +31,8 @@ namespace avoidVortexMaze {
                 m_ballCell.row = m_mazeBoard.rowStart();
                 m_ballCell.col = m_mazeBoard.colStart();
                 m_ball.position = getCellCenterPosition(m_ballCell.row, m_ballCell.col);
+                m_ballTeleported = true;
+                break;
             }
         }
 
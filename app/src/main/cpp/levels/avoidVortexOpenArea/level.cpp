@@ -102,31 +102,33 @@ namespace avoidVortexOpenArea {
             return false;
         }
 
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float timeDiff = std::chrono::duration<float, std::chrono::seconds::period>(
-                currentTime - prevTime).count();
-        prevTime = currentTime;
+        advancePhysics([this](float timeDiff) -> bool {
+            m_ball.position = getUpdatedPosition(timeDiff);
+            m_ball.velocity = getUpdatedVelocity(m_ball.acceleration, timeDiff);
 
-        m_ball.position = getUpdatedPosition(timeDiff);
-        m_ball.velocity = getUpdatedVelocity(m_ball.acceleration, timeDiff);
+            if (ballProximity(holePosition)) {
+                m_finished = true;
+                return false;
+            }
 
-        if (ballProximity(holePosition)) {
-            m_finished = true;
+            for (auto &&vortexPosition : vortexPositions) {
+                if (ballProximity(vortexPosition)) {
+                    // stop stepping so that the ball is drawn at the start instead of on its
+                    // way there.
+                    m_ball.position = startPosition;
+                    return false;
+                }
+            }
+
+            checkBallBorders(m_ball.position, m_ball.velocity);
+            updateRotation(timeDiff);
             return true;
-        }
+        });
 
-        for (auto &&vortexPosition : vortexPositions) {
-            if (ballProximity(vortexPosition)) {
-                m_ball.position = startPosition;
-                return true;
-            }
+        if (m_finished) {
+            return true;
         }
 
-        checkBallBorders(m_ball.position, m_ball.velocity);
-        updateRotation(timeDiff);
-        modelMatrixBall = glm::translate(glm::mat4(1.0f), m_ball.position) *
-                          glm::mat4_cast(m_ball.totalRotated) * scale;
-
         return drawingNecessary();
     }
 
@@ -151,6 +153,7 @@ namespace avoidVortexOpenArea {
     }
 
     bool Level::updateDrawObjects() {
+        modelMatrixBall = interpolatedBallModelMatrix(scale);
         m_levelDrawer.updateModelMatrixForObject(m_objRefBall, m_objDataRefBall, modelMatrixBall);
         return true;
     }
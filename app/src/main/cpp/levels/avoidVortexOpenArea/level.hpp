@@ -44,7 +44,6 @@ namespace avoidVortexOpenArea {
         float const maxX;
         float const maxY;
         Random random;
-        std::chrono::high_resolution_clock::time_point prevTime;
 
         glm::vec3 holePosition;
 
@@ -87,7 +86,7 @@ namespace avoidVortexOpenArea {
         bool updateDrawObjects() override;
 
         void start() override {
-            prevTime = std::chrono::high_resolution_clock::now();
+            restartPhysicsClock();
         }
 
         void getLevelFinisherCenter(float &x, float &y, float &z) override {
@@ -107,8 +106,7 @@ namespace avoidVortexOpenArea {
                 float floorZ)
                 : basic::Level(std::move(inLevelDrawer), lcd, floorZ, true),
                   maxX(m_width / 2),
-                  maxY(m_height / 2),
-                  prevTime(std::chrono::high_resolution_clock::now())
+                  maxY(m_height / 2)
         {
             m_levelDrawer.setClearColor(glm::vec4{0.0f, 0.0f, 0.0f, 1.0f});
             preGenerate();
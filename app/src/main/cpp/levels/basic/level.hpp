@@ -21,10 +21,13 @@
 #ifndef AMAZING_LABYRINTH_BASIC_LEVEL_HPP
 #define AMAZING_LABYRINTH_BASIC_LEVEL_HPP
 
+#include <chrono>
+#include <cmath>
 #include <functional>
 #include <memory>
 
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 
 #include "../../common.hpp"
@@ -48,8 +51,37 @@ namespace basic {
 
         LoadedModelData m_modelData;
 
+    public:
+        /* Decode the model and texture files in configData ahead of time so that constructing a
+         * level using this configuration does not have to.  Called off of the draw thread.  Errors
+         * are ignored here, they will be reported when the level is constructed.
+         */
+        static void preloadModels(
+                std::shared_ptr<GameRequester> const &gameRequester,
+                std::vector<ModelConfigData> const &configData)
+        {
+            for (auto const &modelDatum : loadModels(configData)) {
+                auto preload = [&gameRequester](auto const &description) {
+                    try {
+                        description->preload(gameRequester);
+                    } catch (...) {
+                    }
+                };
+
+                for (auto const &model : modelDatum.second.models) {
+                    preload(model);
+                }
+                for (auto const &texture : modelDatum.second.textures) {
+                    preload(texture);
+                }
+                for (auto const &texture : modelDatum.second.alternateTextures) {
+                    preload(texture);
+                }
+            }
+        }
+
     private:
-        LoadedModelData loadModels(std::vector<ModelConfigData> const &configData) {
+        static LoadedModelData loadModels(std::vector<ModelConfigData> const &configData) {
             LoadedModelData finalData;
             for (auto const &configDatum : configData) {
                 ModelDatum modelDatum;
@@ -102,6 +134,8 @@ namespace basic {
         static float constexpr m_accelerationAdjustment = 0.1f;
         static float constexpr m_lengthTooSmallToNormalize = 0.001f;
         static float constexpr m_modelSize = 2.0f;
+        static float constexpr m_physicsStepsPerSecond = 120.0f;
+        static size_t constexpr m_maxPhysicsStepsPerUpdate = 8;
 
         levelDrawer::Adaptor m_levelDrawer;
         bool m_finished;
@@ -113,6 +147,17 @@ namespace basic {
         float m_scaleBall;
         bool m_bounce;
 
+        // the fixed timestep physics clock, see advancePhysics.
+        struct {
+            std::chrono::high_resolution_clock::time_point prevTime;
+            float timeStep;
+            size_t maxStepsPerUpdate;
+            float accumulator;
+            bool hasPrevStep;
+            glm::vec3 prevStepPosition;
+            glm::quat prevStepRotation;
+        } m_physics;
+
         // data on where the ball is, how fast it is moving, etc.
         struct {
             glm::vec3 prevPosition;
@@ -221,6 +266,79 @@ namespace basic {
         }
 
         bool checkBallBorders(glm::vec3 &position, glm::vec3 &velocity);
+
+        /* Fixed timestep physics.  The time since the last call is added to an accumulator and
+         * the physics is advanced in steps of exactly the time step, so the ball moves the same
+         * way whatever the frame rate is.  At most the maximum number of steps are done in one
+         * call.  If the game falls further behind than that, the extra time is dropped: the game
+         * slows down instead of spending more and more time catching up.  The time left in the
+         * accumulator is used to draw the ball between its last two steps (see
+         * interpolatedBallModelMatrix).
+         *
+         * step is called with the time step and returns false to stop stepping (e.g. when the
+         * level is finished).  Returns the number of steps done.
+         */
+        template <typename StepFcn>
+        size_t advancePhysics(StepFcn &&step) {
+            auto currentTime = std::chrono::high_resolution_clock::now();
+            m_physics.accumulator += std::chrono::duration<float, std::chrono::seconds::period>(
+                    currentTime - m_physics.prevTime).count();
+            m_physics.prevTime = currentTime;
+
+            size_t nbrSteps = 0;
+            while (m_physics.accumulator >= m_physics.timeStep) {
+                if (nbrSteps == m_physics.maxStepsPerUpdate) {
+                    m_physics.accumulator = std::fmod(m_physics.accumulator, m_physics.timeStep);
+                    break;
+                }
+
+                m_physics.hasPrevStep = true;
+                m_physics.prevStepPosition = m_ball.position;
+                m_physics.prevStepRotation = m_ball.totalRotated;
+                m_physics.accumulator -= m_physics.timeStep;
+                nbrSteps++;
+                if (!step(m_physics.timeStep)) {
+                    // draw the ball where the last step left it.
+                    m_physics.accumulator = 0.0f;
+                    m_physics.hasPrevStep = false;
+                    break;
+                }
+            }
+
+            return nbrSteps;
+        }
+
+        // Start timing the physics from now, the time that passed before now is not simulated.
+        void restartPhysicsClock() {
+            m_physics.prevTime = std::chrono::high_resolution_clock::now();
+            m_physics.accumulator = 0.0f;
+            m_physics.hasPrevStep = false;
+        }
+
+        void setPhysicsStepRate(float stepsPerSecond, size_t maxStepsPerUpdate) {
+            m_physics.timeStep = 1.0f / stepsPerSecond;
+            m_physics.maxStepsPerUpdate = maxStepsPerUpdate;
+        }
+
+        // where to draw the ball: between its last two physics steps, at the time now.
+        glm::vec3 interpolatedBallPosition() {
+            if (!m_physics.hasPrevStep) {
+                return m_ball.position;
+            }
+            return glm::mix(m_physics.prevStepPosition, m_ball.position,
+                            m_physics.accumulator / m_physics.timeStep);
+        }
+
+        glm::mat4 interpolatedBallModelMatrix(glm::mat4 const &scale) {
+            glm::quat rotation = m_ball.totalRotated;
+            if (m_physics.hasPrevStep) {
+                rotation = glm::slerp(m_physics.prevStepRotation, m_ball.totalRotated,
+                                      m_physics.accumulator / m_physics.timeStep);
+            }
+
+            return glm::translate(glm::mat4(1.0f), interpolatedBallPosition()) *
+                   glm::mat4_cast(rotation) * scale;
+        }
     public:
         static float constexpr m_floatErrorAmount = 0.0001f;
 
@@ -294,6 +412,9 @@ namespace basic {
 
             // the derived level will change this
             m_ball.position = {0.0f, 0.0f, 0.0f};
+
+            setPhysicsStepRate(m_physicsStepsPerSecond, m_maxPhysicsStepsPerUpdate);
+            restartPhysicsClock();
         }
 
         virtual ~Level() = default;
@@ -110,4 +110,11 @@ namespace basic {
         val.bounceEnabled = j[BounceEnabled].get<bool>();
         val.ballSizeDiagonalRatio = j[BallDiagonalRatio].get<float>();
     }
-} // namespace basic
\ No newline at end of file
+
+    void preloadModels(std::shared_ptr<GameRequester> const &gameRequester, nlohmann::json const &j) {
+        auto it = j.find(Models);
+        if (it != j.end()) {
+            Level::preloadModels(gameRequester, it->get<std::vector<ModelConfigData>>());
+        }
+    }
+} // namespace basic
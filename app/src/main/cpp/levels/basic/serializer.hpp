@@ -25,6 +25,7 @@
 #include <json.hpp>
 
 #include "loadData.hpp"
+#include "../../common.hpp"
 
 namespace basic {
     void to_json(nlohmann::json &j, LevelSaveData const &val);
@@ -32,6 +33,9 @@ namespace basic {
 
     void to_json(nlohmann::json &j, LevelConfigData const &val);
     void from_json(nlohmann::json const &j, LevelConfigData &val);
+
+    // decode the models and textures listed in the level configuration json ahead of time.
+    void preloadModels(std::shared_ptr<GameRequester> const &gameRequester, nlohmann::json const &j);
 } // namespace basic
 
 #endif // AMAZING_LABYRINTH_BASIC_SERIALIZER_HPP
@@ -23,7 +23,7 @@
 
 namespace darkMaze {
     bool Level::updateDrawObjects() {
-        m_parameters.lightingSources[0] = m_ball.position;
+        m_parameters.lightingSources[0] = interpolatedBallPosition();
         m_levelDrawer.updateCommonObjectData(m_objRefsWalls[0], m_parameters);
         return openAreaMaze::Level::updateDrawObjects();
     }
@@ -0,0 +1,280 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "collisionMap.hpp"
+
+namespace fixedMaze {
+    namespace {
+        char constexpr const magic[4] = {'A', 'L', 'C', 'M'};
+        uint32_t constexpr version = 1;
+        size_t constexpr headerSize = sizeof (magic) + 4 + 8 + 4 * 7;
+        float constexpr maxDepthValue = 65534.0f;
+        float constexpr maxNormalValue = 32767.0f;
+
+        // the floor size is computed from the perspective matrix on the device, allow for
+        // rounding differences.
+        float constexpr floorSizeTolerance = 0.0001f;
+
+        char const *modelExtension = ".modelcbor";
+        char const *collisionMapExtension = ".collisionmap";
+
+        // little endian reads and writes, independent of the byte order of the machine.
+        template <typename UintType>
+        void put(std::vector<uint8_t> &data, UintType value) {
+            for (size_t i = 0; i < sizeof (UintType); i++) {
+                data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        template <typename UintType>
+        UintType get(uint8_t const *&data) {
+            UintType value = 0;
+            for (size_t i = 0; i < sizeof (UintType); i++) {
+                value |= static_cast<UintType>(data[i]) << (8 * i);
+            }
+            data += sizeof (UintType);
+            return value;
+        }
+
+        void readBytes(std::istream &in, uint8_t *data, size_t size) {
+            in.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(size));
+            if (static_cast<size_t>(in.gcount()) != size) {
+                throw std::runtime_error("Collision map file is truncated.");
+            }
+        }
+
+        void putFloat(std::vector<uint8_t> &data, float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof (bits));
+            put<uint32_t>(data, bits);
+        }
+
+        float getFloat(uint8_t const *&data) {
+            uint32_t bits = get<uint32_t>(data);
+            float value;
+            std::memcpy(&value, &bits, sizeof (value));
+            return value;
+        }
+
+        float signNotZero(float value) {
+            return value >= 0.0f ? 1.0f : -1.0f;
+        }
+    }
+
+    std::string collisionMapFileName(std::string const &modelFileName) {
+        std::string fileName = modelFileName;
+        size_t extensionLength = std::strlen(modelExtension);
+        if (fileName.size() >= extensionLength &&
+            fileName.compare(fileName.size() - extensionLength, extensionLength, modelExtension) == 0)
+        {
+            fileName.resize(fileName.size() - extensionLength);
+        }
+        return fileName + collisionMapExtension;
+    }
+
+    uint64_t collisionMapModelHash(std::streambuf *modelFile) {
+        uint64_t hash = 14695981039346656037ULL;
+        std::array<char, 4096> buffer{};
+        std::streamsize nbrRead;
+        while ((nbrRead = modelFile->sgetn(buffer.data(), buffer.size())) > 0) {
+            for (std::streamsize i = 0; i < nbrRead; i++) {
+                hash ^= static_cast<uint8_t>(buffer[i]);
+                hash *= 1099511628211ULL;
+            }
+        }
+        return hash;
+    }
+
+    bool readCollisionMap(std::istream &in, CollisionMapParameters const &parameters,
+                          CollisionMap &collisionMap)
+    {
+        std::array<uint8_t, headerSize> header{};
+        readBytes(in, header.data(), header.size());
+        if (std::memcmp(header.data(), magic, sizeof (magic)) != 0) {
+            throw std::runtime_error("Not a collision map file.");
+        }
+
+        uint8_t const *data = header.data() + sizeof (magic);
+        if (get<uint32_t>(data) != version || get<uint64_t>(data) != parameters.modelHash) {
+            return false;
+        }
+
+        CollisionMap result{};
+        result.width = get<uint32_t>(data);
+        result.height = get<uint32_t>(data);
+        float floorZ = getFloat(data);
+        float floorSize = getFloat(data);
+        float depthRange = getFloat(data);
+        if (result.width != parameters.width || result.height != parameters.width ||
+            floorZ != parameters.floorZ || depthRange != parameters.depthRange ||
+            std::fabs(floorSize - parameters.floorSize) > floorSizeTolerance * parameters.floorSize)
+        {
+            return false;
+        }
+
+        result.holeColumn = get<uint32_t>(data);
+        result.holeRow = get<uint32_t>(data);
+        if (result.holeColumn >= result.width || result.holeRow >= result.height) {
+            throw std::runtime_error("Collision map finish hole is not in the map.");
+        }
+
+        size_t nbrSamples = static_cast<size_t>(result.width) * result.height;
+        std::vector<uint8_t> samples(nbrSamples * (2 + 2 * 2));
+        readBytes(in, samples.data(), samples.size());
+
+        data = samples.data();
+        result.depthMap.resize(nbrSamples);
+        for (auto &depth : result.depthMap) {
+            float value = get<uint16_t>(data) / maxDepthValue;
+            depth = parameters.floorZ + (2.0f * value - 1.0f) * parameters.depthRange;
+        }
+
+        result.normalMap.resize(nbrSamples);
+        for (auto &normal : result.normalMap) {
+            auto x = static_cast<int16_t>(get<uint16_t>(data));
+            auto y = static_cast<int16_t>(get<uint16_t>(data));
+            normal = octahedralDecode(glm::vec2{x / maxNormalValue, y / maxNormalValue});
+        }
+
+        collisionMap = std::move(result);
+        return true;
+    }
+
+    void writeCollisionMap(std::ostream &out, CollisionMapParameters const &parameters,
+                           CollisionMap const &collisionMap)
+    {
+        size_t nbrSamples = static_cast<size_t>(collisionMap.width) * collisionMap.height;
+        if (collisionMap.depthMap.size() != nbrSamples || collisionMap.normalMap.size() != nbrSamples) {
+            throw std::runtime_error("Collision map size does not match its width and height.");
+        }
+
+        std::vector<uint8_t> data(magic, magic + sizeof (magic));
+        data.reserve(headerSize + nbrSamples * (2 + 2 * 2));
+        put<uint32_t>(data, version);
+        put<uint64_t>(data, parameters.modelHash);
+        put<uint32_t>(data, collisionMap.width);
+        put<uint32_t>(data, collisionMap.height);
+        putFloat(data, parameters.floorZ);
+        putFloat(data, parameters.floorSize);
+        putFloat(data, parameters.depthRange);
+        put<uint32_t>(data, collisionMap.holeColumn);
+        put<uint32_t>(data, collisionMap.holeRow);
+
+        for (float depth : collisionMap.depthMap) {
+            float value = ((depth - parameters.floorZ) / parameters.depthRange + 1.0f) / 2.0f;
+            put<uint16_t>(data, static_cast<uint16_t>(
+                    std::round(std::clamp(value, 0.0f, 1.0f) * maxDepthValue)));
+        }
+
+        for (auto const &normal : collisionMap.normalMap) {
+            glm::vec2 encoded = octahedralEncode(normal);
+            for (float value : {encoded.x, encoded.y}) {
+                put<uint16_t>(data, static_cast<uint16_t>(static_cast<int16_t>(
+                        std::round(std::clamp(value, -1.0f, 1.0f) * maxNormalValue))));
+            }
+        }
+
+        out.write(reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!out.good()) {
+            throw std::runtime_error("Unable to write the collision map.");
+        }
+    }
+
+    bool findCollisionMapHole(std::vector<float> const &depthMap, uint32_t width, float holeDepth,
+                              uint32_t &holeColumn, uint32_t &holeRow)
+    {
+        for (size_t i = 0; i < depthMap.size(); i++) {
+            if (depthMap[i] < holeDepth) {
+                holeColumn = static_cast<uint32_t>(i % width);
+                holeRow = static_cast<uint32_t>(i / width);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    glm::mat4 collisionMapFloorMatrix(float floorZ, float floorSize, float modelSize) {
+        return glm::translate(glm::mat4(1.0f), glm::vec3{0.0f, 0.0f, floorZ}) *
+               glm::scale(glm::mat4(1.0f), glm::vec3{floorSize / modelSize, floorSize / modelSize, 1.0f}) *
+               glm::mat4_cast(glm::angleAxis(3.1415926f / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f)));
+    }
+
+    renderDetails::ParametersDepthMap collisionMapDepthParameters(float floorZ, float floorSize,
+                                                                  float depthRange)
+    {
+        renderDetails::ParametersDepthMap parameters{};
+        parameters.nearestDepth = floorZ + depthRange;
+        parameters.farthestDepth = floorZ - depthRange;
+        parameters.widthAtDepth = floorSize;
+        parameters.heightAtDepth = floorSize;
+        parameters.lookAt = levelDrawer::DefaultConfig::lookAt;
+        parameters.up = levelDrawer::DefaultConfig::up;
+        parameters.viewPoint = levelDrawer::DefaultConfig::viewPoint;
+        parameters.nearPlane = levelDrawer::DefaultConfig::nearPlane;
+        parameters.farPlane = levelDrawer::DefaultConfig::farPlane;
+        return parameters;
+    }
+
+    renderDetails::ParametersNormalMap collisionMapNormalParameters(float floorSize) {
+        renderDetails::ParametersNormalMap parameters{};
+        parameters.widthAtDepth = floorSize;
+        parameters.heightAtDepth = floorSize;
+        parameters.lookAt = levelDrawer::DefaultConfig::lookAt;
+        parameters.up = levelDrawer::DefaultConfig::up;
+        parameters.viewPoint = levelDrawer::DefaultConfig::viewPoint;
+        parameters.nearPlane = levelDrawer::DefaultConfig::nearPlane;
+        parameters.farPlane = levelDrawer::DefaultConfig::farPlane;
+        return parameters;
+    }
+
+    glm::vec2 octahedralEncode(glm::vec3 const &normal) {
+        float length = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+        if (length == 0.0f) {
+            // not a normal, it decodes as straight up.
+            return glm::vec2{0.0f, 0.0f};
+        }
+
+        glm::vec2 encoded{normal.x / length, normal.y / length};
+        if (normal.z < 0.0f) {
+            // fold the lower half of the octahedron over the upper half.
+            encoded = glm::vec2{(1.0f - std::fabs(encoded.y)) * signNotZero(encoded.x),
+                                (1.0f - std::fabs(encoded.x)) * signNotZero(encoded.y)};
+        }
+        return encoded;
+    }
+
+    glm::vec3 octahedralDecode(glm::vec2 const &encoded) {
+        glm::vec3 normal{encoded.x, encoded.y, 1.0f - std::fabs(encoded.x) - std::fabs(encoded.y)};
+        if (normal.z < 0.0f) {
+            normal.x = (1.0f - std::fabs(encoded.y)) * signNotZero(encoded.x);
+            normal.y = (1.0f - std::fabs(encoded.x)) * signNotZero(encoded.y);
+        }
+        return glm::normalize(normal);
+    }
+}
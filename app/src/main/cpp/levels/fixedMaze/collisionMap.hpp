@@ -0,0 +1,114 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_FIXED_MAZE_COLLISION_MAP_HPP
+#define AMAZING_LABYRINTH_FIXED_MAZE_COLLISION_MAP_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../../levelDrawer/common.hpp"
+
+namespace fixedMaze {
+    /* The depth map and normal map of the fixed maze floor model drawn from above, the whole
+     * model, before it is cut to fit the screen.  The fixed maze uses them to roll the ball on
+     * the floor.  Drawing them takes a while, so they are generated by the collisionmap tool
+     * (in modelobj2cbor) and stored next to the model.  The level only draws them if the stored
+     * maps are missing or were made from a different model.
+     *
+     * File format (version 1, all values little endian):
+     *     char[4]  "ALCM"
+     *     uint32   version
+     *     uint64   hash of the model file the maps were drawn from
+     *     uint32   width, height: the number of samples in a row and in a column
+     *     float32  floorZ, floorSize: where the floor was drawn and how big (the normals depend
+     *              on the scale of the floor)
+     *     float32  depthRange: the depths are relative to the floor and are in
+     *              [-depthRange, depthRange]
+     *     uint32   holeColumn, holeRow: the first sample in the finish hole.  The screen is
+     *              narrower than the floor, the level cuts the maps around this column.
+     *     uint16   depth[width * height]: 0 is -depthRange, 65534 is depthRange (so the floor
+     *              itself is exactly 32767)
+     *     int16    normal[width * height][2]: the octahedral encoding of the normals, -32767 is
+     *              -1 and 32767 is 1
+     */
+    struct CollisionMap {
+        uint32_t width;
+        uint32_t height;
+        uint32_t holeColumn;
+        uint32_t holeRow;
+        std::vector<float> depthMap;
+        std::vector<glm::vec3> normalMap;
+    };
+
+    // What a collision map is drawn from.  A stored collision map is only used if it was drawn
+    // from the same model with the same parameters.
+    struct CollisionMapParameters {
+        uint64_t modelHash;
+        uint32_t width;
+        float floorZ;
+        float floorSize;
+        float depthRange;
+    };
+
+    // the collision map file for a floor model file.
+    std::string collisionMapFileName(std::string const &modelFileName);
+
+    // FNV-1a of the model file.
+    uint64_t collisionMapModelHash(std::streambuf *modelFile);
+
+    /* Read a collision map of width x width samples.  Returns false if the file was drawn with
+     * different parameters or is in another version.  Throws if the file is not a collision map
+     * or is truncated.
+     */
+    bool readCollisionMap(std::istream &in, CollisionMapParameters const &parameters,
+                          CollisionMap &collisionMap);
+
+    void writeCollisionMap(std::ostream &out, CollisionMapParameters const &parameters,
+                           CollisionMap const &collisionMap);
+
+    // Find the first sample in the depth map deeper than holeDepth.  Returns false if there is
+    // no such sample.
+    bool findCollisionMapHole(std::vector<float> const &depthMap, uint32_t width, float holeDepth,
+                              uint32_t &holeColumn, uint32_t &holeRow);
+
+    /* How the floor model is drawn to get its collision map.  The floor model lies in the x-z
+     * plane and is modelSize wide, it is rotated to face the viewer, centered at floorZ and
+     * scaled to floorSize x floorSize.  The view is exactly floorSize x floorSize.
+     */
+    glm::mat4 collisionMapFloorMatrix(float floorZ, float floorSize, float modelSize);
+
+    renderDetails::ParametersDepthMap collisionMapDepthParameters(float floorZ, float floorSize,
+                                                                  float depthRange);
+
+    renderDetails::ParametersNormalMap collisionMapNormalParameters(float floorSize);
+
+    // octahedral encoding of a unit vector into two values in [-1, 1] and back.
+    glm::vec2 octahedralEncode(glm::vec3 const &normal);
+
+    glm::vec3 octahedralDecode(glm::vec2 const &encoded);
+}
+
+#endif // AMAZING_LABYRINTH_FIXED_MAZE_COLLISION_MAP_HPP
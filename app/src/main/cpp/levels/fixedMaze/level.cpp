@@ -411,14 +411,11 @@ namespace fixedMaze {
     }
 
     bool Level::updateData() {
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float timeDiff = std::chrono::duration<float, std::chrono::seconds::period>(
-                currentTime - m_prevTime).count();
-        m_prevTime = currentTime;
-
-        moveBall(timeDiff);
-
-        updateRotation(timeDiff);
+        advancePhysics([this](float timeDiff) -> bool {
+            moveBall(timeDiff);
+            updateRotation(timeDiff);
+            return !m_finished;
+        });
 
         return drawingNecessary();
     }
@@ -428,15 +425,13 @@ namespace fixedMaze {
         m_levelDrawer.updateModelMatrixForObject(
                 m_objRefBall,
                 m_objDataRefBall,
-                glm::translate(glm::mat4(1.0f), m_ball.position) *
-                glm::mat4_cast(m_ball.totalRotated) *
-                glm::scale(glm::mat4(1.0f), glm::vec3{m_scaleBall, m_scaleBall, m_scaleBall}));
+                interpolatedBallModelMatrix(ballScaleMatrix()));
 
         return true;
     }
 
     void Level::start() {
-        m_prevTime = std::chrono::high_resolution_clock::now();
+        restartPhysicsClock();
     }
 
 
@@ -462,30 +457,85 @@ namespace fixedMaze {
         init();
     }
 
+    bool Level::loadCollisionMap(
+            std::shared_ptr<levelDrawer::ModelDescription> const &floorModel,
+            CollisionMap &collisionMap)
+    {
+        auto floorModelPath = std::dynamic_pointer_cast<levelDrawer::ModelDescriptionPath>(floorModel);
+        if (floorModelPath == nullptr) {
+            return false;
+        }
+
+        try {
+            CollisionMapParameters parameters{};
+            parameters.modelHash = collisionMapModelHash(
+                    m_levelDrawer.getAssetStream(floorModelPath->path()).get());
+            parameters.width = static_cast<uint32_t>(m_rowHeight);
+            parameters.floorZ = m_mazeFloorZ;
+            parameters.floorSize = m_height;
+            parameters.depthRange = MODEL_MAXZ;
+
+            auto collisionMapBuf = m_levelDrawer.getAssetStream(
+                    collisionMapFileName(floorModelPath->path()));
+            std::istream collisionMapStream(collisionMapBuf.get());
+            return readCollisionMap(collisionMapStream, parameters, collisionMap);
+        } catch (std::runtime_error &) {
+            // the collision map is missing or damaged, draw it instead.
+            return false;
+        }
+    }
+
+    CollisionMap Level::drawCollisionMap(std::shared_ptr<levelDrawer::ModelDescription> const &floorModel) {
+        // The model is a square.  Get the whole depth and normal maps (without stretching), so
+        // pass in m_height for the width and height.
+        glm::mat4 floorModelMatrix = collisionMapFloorMatrix(m_mazeFloorZ, m_height, m_modelSize);
+        levelDrawer::ModelsTextures modelsTextures{std::make_pair(floorModel,
+                std::shared_ptr<levelDrawer::TextureDescription>())};
+
+        // request both maps before waiting on either so that the GPU draws them back to back.
+        auto depthMapFuture = m_levelDrawer.drawToBufferAsync(
+                depthMapRenderDetailsName,
+                modelsTextures,
+                std::vector<glm::mat4>{floorModelMatrix},
+                m_height, m_height, m_rowHeight,
+                std::make_shared<renderDetails::ParametersDepthMap>(
+                        collisionMapDepthParameters(m_mazeFloorZ, m_height, MODEL_MAXZ)));
+
+        auto normalMapFuture = m_levelDrawer.drawToBufferAsync(
+                normalMapRenderDetailsName,
+                modelsTextures,
+                std::vector<glm::mat4>{floorModelMatrix},
+                m_height, m_height, m_rowHeight,
+                std::make_shared<renderDetails::ParametersNormalMap>(
+                        collisionMapNormalParameters(m_height)));
+
+        CollisionMap collisionMap{};
+        collisionMap.width = static_cast<uint32_t>(m_rowHeight);
+        collisionMap.height = static_cast<uint32_t>(m_rowHeight);
+        collisionMap.depthMap = depthMapFuture.get();
+        unFlattenMap(normalMapFuture.get(), collisionMap.normalMap);
+
+        if (!findCollisionMapHole(collisionMap.depthMap, collisionMap.width,
+                m_mazeFloorZ - MODEL_MAXZ + m_floatErrorAmount,
+                collisionMap.holeColumn, collisionMap.holeRow))
+        {
+            // shouldn't happen
+            throw std::runtime_error("Model finish condition not found.");
+        }
+
+        return collisionMap;
+    }
+
     void Level::findModelViewPort(
             std::vector<float> const &depthMap,
             std::vector<glm::vec3> const &normalMap,
             size_t rowWidth,
+            size_t column,
             glm::mat4 &trans,
             std::vector<float> &outDepthMap,
             std::vector<glm::vec3> &outNormalMap,
             size_t &outRowWidth)
     {
-        size_t i = 0;
-        for (; i < depthMap.size(); i++) {
-            if (depthMap[i] < m_mazeFloorZ - MODEL_MAXZ + m_floatErrorAmount) {
-                break;
-            }
-        }
-
-        if (i >= depthMap.size()) {
-            // shouldn't happen
-            throw std::runtime_error("Model finish condition not found.");
-        }
-
-        size_t column = i % rowWidth;
-        size_t row = i / rowWidth;
-
         auto viewPortWidth = static_cast<size_t>(std::ceil(rowWidth / m_height * m_width));
         if (viewPortWidth > rowWidth) {
             viewPortWidth = rowWidth;
@@ -522,66 +572,23 @@ namespace fixedMaze {
 
     void Level::init() {
         m_levelDrawer.setClearColor(glm::vec4{0.0f, 0.0f, 0.0f, 0.0f});
-        m_prevTime = std::chrono::high_resolution_clock::now();
-
-        // Get the depth map and normal map
-        std::vector<float> depthMap;
-        std::vector<glm::vec3> normalMap;
-
-        glm::mat4 floorModelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3{0.0f, 0.0f, m_mazeFloorZ}) *
-            glm::scale(glm::mat4(1.0f),glm::vec3{m_height / m_modelSize, m_height / m_modelSize, 1.0f}) *
-            glm::mat4_cast(glm::angleAxis(3.1415926f / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f)));
+        restartPhysicsClock();
 
         auto const &floorDetails = findModelsAndTextures(ModelNameFloor);
 
-        // The model is a square.  Get the whole depth and normal maps (without stretching.  Then
-        // find the hole and cut the model so that the hole appears in the center if possible, otherwise
-        // on the side.  So we pass in m_height for the width and height.
-        renderDetails::ParametersDepthMap depthParameters{};
-        depthParameters.nearestDepth = m_mazeFloorZ + MODEL_MAXZ;
-        depthParameters.farthestDepth = m_mazeFloorZ - MODEL_MAXZ;
-        depthParameters.widthAtDepth = m_height;
-        depthParameters.heightAtDepth = m_height;
-        depthParameters.lookAt = levelDrawer::DefaultConfig::lookAt;
-        depthParameters.up = levelDrawer::DefaultConfig::up;
-        depthParameters.viewPoint = levelDrawer::DefaultConfig::viewPoint;
-        depthParameters.nearPlane = levelDrawer::DefaultConfig::nearPlane;
-        depthParameters.farPlane = levelDrawer::DefaultConfig::farPlane;
-
-        m_levelDrawer.drawToBuffer(
-                depthMapRenderDetailsName,
-                levelDrawer::ModelsTextures{std::make_pair(floorDetails.models[0],
-                        std::shared_ptr<levelDrawer::TextureDescription>())},
-                std::vector<glm::mat4>{floorModelMatrix},
-                m_height, m_height, m_rowHeight,
-                std::make_shared<renderDetails::ParametersDepthMap>(depthParameters),
-                depthMap);
-
-        renderDetails::ParametersNormalMap normalParameters{};
-        normalParameters.widthAtDepth = m_height;
-        normalParameters.heightAtDepth = m_height;
-        normalParameters.lookAt = levelDrawer::DefaultConfig::lookAt;
-        normalParameters.up = levelDrawer::DefaultConfig::up;
-        normalParameters.viewPoint = levelDrawer::DefaultConfig::viewPoint;
-        normalParameters.nearPlane = levelDrawer::DefaultConfig::nearPlane;
-        normalParameters.farPlane = levelDrawer::DefaultConfig::farPlane;
-        std::vector<float> normalMapFlat;
-        m_levelDrawer.drawToBuffer(
-                normalMapRenderDetailsName,
-                levelDrawer::ModelsTextures{std::make_pair(floorDetails.models[0],
-                        std::shared_ptr<levelDrawer::TextureDescription>())},
-                std::vector<glm::mat4>{floorModelMatrix},
-                m_height, m_height, m_rowHeight,
-                std::make_shared<renderDetails::ParametersNormalMap>(normalParameters),
-                normalMapFlat);
-        unFlattenMap(normalMapFlat, normalMap);
+        // The depth and normal maps of the whole floor model.  They are made by the collisionmap
+        // tool, only draw them if they are missing or are for a different model.
+        CollisionMap collisionMap{};
+        if (!loadCollisionMap(floorDetails.models[0], collisionMap)) {
+            collisionMap = drawCollisionMap(floorDetails.models[0]);
+        }
 
         // cut the model so that the hole appears in the center if possible.
         // note: the width and the height of the actual model are the same, so pass in m_rowHeight
         // for the actual model width.
         glm::mat4 trans;
-        findModelViewPort(depthMap, normalMap, m_rowHeight, trans, m_depthMap, m_normalMap,
-                          m_rowWidth);
+        findModelViewPort(collisionMap.depthMap, collisionMap.normalMap, m_rowHeight,
+                          collisionMap.holeColumn, trans, m_depthMap, m_normalMap, m_rowWidth);
 
         // search for a starting point in a row on the model floor (not a high up point).
         float x = -m_width / 2.0f + ballRadius();
@@ -615,7 +622,7 @@ namespace fixedMaze {
                 floorDetails.models[0],
                 getFirstTexture(floorDetails));
 
-        floorModelMatrix = trans *
+        glm::mat4 floorModelMatrix = trans *
                            glm::scale(glm::mat4(1.0f),glm::vec3{m_height / m_modelSize, m_height / m_modelSize, 1.0f}) *
                            glm::mat4_cast(glm::angleAxis(3.1415926f / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f)));
 
@@ -34,6 +34,7 @@
 #include "../../random.hpp"
 
 #include "loadData.hpp"
+#include "collisionMap.hpp"
 
 namespace fixedMaze {
     class Level : public basic::Level {
@@ -66,8 +67,6 @@ namespace fixedMaze {
     private:
         float const m_speedLimit;
 
-        std::chrono::high_resolution_clock::time_point m_prevTime;
-
         size_t m_rowWidth;
         size_t m_rowHeight;
         std::vector<float> m_depthMap;
@@ -105,10 +104,17 @@ namespace fixedMaze {
 
         void moveBall(float timeDiff);
 
+        bool loadCollisionMap(
+                std::shared_ptr<levelDrawer::ModelDescription> const &floorModel,
+                CollisionMap &collisionMap);
+
+        CollisionMap drawCollisionMap(std::shared_ptr<levelDrawer::ModelDescription> const &floorModel);
+
         void findModelViewPort(
                 std::vector<float> const &depthMap,
                 std::vector<glm::vec3> const &normalMap,
                 size_t rowWidth,
+                size_t holeColumn,
                 glm::mat4 &trans,
                 std::vector<float> &outDepthMap,
                 std::vector<glm::vec3> &outNormalMap,
@@ -51,87 +51,87 @@ namespace generatedMaze {
             return false;
         }
 
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float difftime = std::chrono::duration<float, std::chrono::seconds::period>(
-                currentTime - prevTime).count();
-        prevTime = currentTime;
-
-        m_ball.position = getUpdatedPosition(difftime);
-        m_ball.velocity = getUpdatedVelocity(difftime);
-
-        auto cell = m_mazeBoard.getCell(m_ballCell.row, m_ballCell.col);
-        float cellCenterX = getColumnCenterPosition(m_ballCell.col);
-        float cellCenterY = getRowCenterPosition(m_ballCell.row);
-
-        size_t numberRows = m_mazeBoard.numberRows();
-        size_t numberColumns = m_mazeBoard.numberColumns();
-
-        if (cell.isEnd() && ballInProximity(cellCenterX, cellCenterY)) {
-            m_finished = true;
-            m_ball.position.x = cellCenterX;
-            m_ball.position.y = cellCenterY;
-            m_ball.velocity = {0.0f, 0.0f, 0.0f};
-            return true;
-        }
-        if (cell.leftWallExists() && m_ball.position.x < cellCenterX) {
-            if (m_ball.velocity.x < 0.0f) {
-                m_ball.velocity.x = 0.0f;
+        advancePhysics([this](float difftime) -> bool {
+            m_ball.position = getUpdatedPosition(difftime);
+            m_ball.velocity = getUpdatedVelocity(difftime);
+
+            auto cell = m_mazeBoard.getCell(m_ballCell.row, m_ballCell.col);
+            float cellCenterX = getColumnCenterPosition(m_ballCell.col);
+            float cellCenterY = getRowCenterPosition(m_ballCell.row);
+
+            size_t numberRows = m_mazeBoard.numberRows();
+            size_t numberColumns = m_mazeBoard.numberColumns();
+
+            if (cell.isEnd() && ballInProximity(cellCenterX, cellCenterY)) {
+                m_finished = true;
+                m_ball.position.x = cellCenterX;
+                m_ball.position.y = cellCenterY;
+                m_ball.velocity = {0.0f, 0.0f, 0.0f};
+                return false;
             }
-            m_ball.position.x = cellCenterX;
-        }
-        if (cell.rightWallExists() && cellCenterX < m_ball.position.x) {
-            if (m_ball.velocity.x > 0.0f) {
-                m_ball.velocity.x = 0.0f;
+            if (cell.leftWallExists() && m_ball.position.x < cellCenterX) {
+                if (m_ball.velocity.x < 0.0f) {
+                    m_ball.velocity.x = 0.0f;
+                }
+                m_ball.position.x = cellCenterX;
             }
-            m_ball.position.x = cellCenterX;
-        }
-        if (cell.bottomWallExists() && cellCenterY < m_ball.position.y) {
-            if (m_ball.velocity.y > 0.0f) {
-                m_ball.velocity.y = 0.0f;
+            if (cell.rightWallExists() && cellCenterX < m_ball.position.x) {
+                if (m_ball.velocity.x > 0.0f) {
+                    m_ball.velocity.x = 0.0f;
+                }
+                m_ball.position.x = cellCenterX;
             }
-            m_ball.position.y = cellCenterY;
-        }
-        if (cell.topWallExists() && m_ball.position.y < cellCenterY) {
-            if (m_ball.velocity.y < 0.0f) {
-                m_ball.velocity.y = 0.0f;
+            if (cell.bottomWallExists() && cellCenterY < m_ball.position.y) {
+                if (m_ball.velocity.y > 0.0f) {
+                    m_ball.velocity.y = 0.0f;
+                }
+                m_ball.position.y = cellCenterY;
+            }
+            if (cell.topWallExists() && m_ball.position.y < cellCenterY) {
+                if (m_ball.velocity.y < 0.0f) {
+                    m_ball.velocity.y = 0.0f;
+                }
+                m_ball.position.y = cellCenterY;
             }
-            m_ball.position.y = cellCenterY;
-        }
 
-        float cellHeight = m_height / (numberRows * numberBlocksPerCell + 1) * numberBlocksPerCell;
-        float cellWidth = m_width / (numberColumns * numberBlocksPerCell + 1) * numberBlocksPerCell;
+            float cellHeight = m_height / (numberRows * numberBlocksPerCell + 1) * numberBlocksPerCell;
+            float cellWidth = m_width / (numberColumns * numberBlocksPerCell + 1) * numberBlocksPerCell;
 
-        float delta = cellWidth / 3.0f;
+            float delta = cellWidth / 3.0f;
 
-        if (m_ball.position.x > cellCenterX + delta || m_ball.position.x < cellCenterX - delta) {
-            m_ball.position.y = cellCenterY;
-            m_ball.velocity.y = 0.0f;
-        }
+            if (m_ball.position.x > cellCenterX + delta || m_ball.position.x < cellCenterX - delta) {
+                m_ball.position.y = cellCenterY;
+                m_ball.velocity.y = 0.0f;
+            }
 
-        delta = cellHeight / 3.0f;
-        if (m_ball.position.y > cellCenterY + delta || m_ball.position.y < cellCenterY - delta) {
-            m_ball.position.x = cellCenterX;
-            m_ball.velocity.x = 0.0f;
-        }
+            delta = cellHeight / 3.0f;
+            if (m_ball.position.y > cellCenterY + delta || m_ball.position.y < cellCenterY - delta) {
+                m_ball.position.x = cellCenterX;
+                m_ball.velocity.x = 0.0f;
+            }
 
-        float deltax = m_ball.position.x - cellCenterX;
-        float deltay = m_ball.position.y - cellCenterY;
+            float deltax = m_ball.position.x - cellCenterX;
+            float deltay = m_ball.position.y - cellCenterY;
 
-        if (deltay > cellHeight / 2.0f && m_ballCell.row != numberRows - 1) {
-            m_ballCell.row++;
-        } else if (deltay < -cellHeight / 2.0f && m_ballCell.row != 0) {
-            m_ballCell.row--;
-        }
+            if (deltay > cellHeight / 2.0f && m_ballCell.row != numberRows - 1) {
+                m_ballCell.row++;
+            } else if (deltay < -cellHeight / 2.0f && m_ballCell.row != 0) {
+                m_ballCell.row--;
+            }
 
-        if (deltax > cellWidth / 2.0f && m_ballCell.col != numberColumns - 1) {
-            m_ballCell.col++;
-        } else if (deltax < -cellWidth / 2.0f && m_ballCell.col != 0) {
-            m_ballCell.col--;
-        }
+            if (deltax > cellWidth / 2.0f && m_ballCell.col != numberColumns - 1) {
+                m_ballCell.col++;
+            } else if (deltax < -cellWidth / 2.0f && m_ballCell.col != 0) {
+                m_ballCell.col--;
+            }
 
-        updateRotation(difftime);
-        modelMatrixBall = glm::translate(glm::mat4(1.0f), m_ball.position) *
-                          glm::mat4_cast(m_ball.totalRotated) * scaleBall;
+            updateRotation(difftime);
+            return true;
+        });
+
+        if (m_finished) {
+            return true;
+        }
 
         return drawingNecessary();
     }
@@ -274,6 +274,7 @@ namespace generatedMaze {
     }
 
     bool Level::updateDrawObjects() {
+        modelMatrixBall = interpolatedBallModelMatrix(scaleBall);
         m_levelDrawer.updateModelMatrixForObject(m_objRefBall, m_objDataRefBall, modelMatrixBall);
         return true;
     }
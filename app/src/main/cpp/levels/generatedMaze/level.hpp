@@ -49,7 +49,6 @@ namespace generatedMaze {
         static constexpr float m_originalWallHeight = 3.0f;
         static constexpr unsigned int numberBlocksPerCell = 2;
         Random random;
-        std::chrono::high_resolution_clock::time_point prevTime;
         bool drawHole;
         float m_scaleWallZ;
 
@@ -105,6 +104,8 @@ namespace generatedMaze {
         {
             if (sd) {
                 return GeneratedMazeBoard::Mode::none;
+            } else if (!lcd->algorithm.empty()) {
+                return GeneratedMazeBoard::modeFromName(lcd->algorithm);
             } else if (lcd->dfsSearch) {
                 return GeneratedMazeBoard::Mode::DFS;
             } else {
@@ -208,10 +209,11 @@ namespace generatedMaze {
             m_objDataRefHole = m_levelDrawer.addModelMatrixForObject(m_objRefHole, modelMatrixHole);
 
             // the walls
-            // always use the default renderDetails.
+            // always use the default renderDetails.  There is one object per wall texture and
+            // all the walls with that texture are drawn together with one instanced draw call.
             m_objRefsWalls.reserve(modelWallData.textures.size());
             for (auto wallTexture : modelWallData.textures) {
-                auto objIndex = m_levelDrawer.addObject(
+                auto objIndex = m_levelDrawer.addInstancedObject(
                         modelWallData.models[0],
                         wallTexture);
                 m_objRefsWalls.push_back(objIndex);
@@ -244,7 +246,7 @@ namespace generatedMaze {
         void preGenerate() {
             m_scaleWallZ = ballDiameter();
 
-            prevTime = std::chrono::high_resolution_clock::now();
+            restartPhysicsClock();
             glm::vec3 xaxis{1.0f, 0.0f, 0.0f};
             m_ball.totalRotated = glm::angleAxis(glm::radians(270.0f), xaxis);
             m_ball.acceleration = {0.0f, 0.0f, 0.0f};
@@ -264,7 +266,7 @@ namespace generatedMaze {
         }
 
         void start() override {
-            prevTime = std::chrono::high_resolution_clock::now();
+            restartPhysicsClock();
         }
 
         char const *name() override { return m_name; }
@@ -22,6 +22,7 @@
 #define AMAZING_LABYRINTH_GENERATED_MAZE_LOAD_DATA_HPP
 
 #include <vector>
+#include <string>
 #include <boost/implicit_cast.hpp>
 
 #include "../basic/loadData.hpp"
@@ -77,10 +78,15 @@ namespace generatedMaze {
         uint32_t numberRows;
         bool dfsSearch;
 
+        // the name of the maze generation algorithm (see GeneratedMazeBoard::modeFromName).  If
+        // empty, dfsSearch selects between DFS and BFS.
+        std::string algorithm;
+
         LevelConfigData()
                 : basic::LevelConfigData{},
                   numberRows{0},
-                  dfsSearch{false}
+                  dfsSearch{false},
+                  algorithm{}
         {}
 
         LevelConfigData(LevelConfigData const &other) noexcept = default;
@@ -58,17 +58,24 @@ namespace generatedMaze {
 
     char constexpr const *NumberRows = "NumberRows";
     char constexpr const *DfsSearch = "DfsSearch";
+    char constexpr const *Algorithm = "Algorithm";
 
     void to_json(nlohmann::json &j, LevelConfigData const &val) {
         to_json(j, boost::implicit_cast<basic::LevelConfigData const &>(val));
         j[NumberRows] = val.numberRows;
         j[DfsSearch] = val.dfsSearch;
+        if (!val.algorithm.empty()) {
+            j[Algorithm] = val.algorithm;
+        }
     }
 
     void from_json(nlohmann::json const &j, LevelConfigData &val) {
         from_json(j, boost::implicit_cast<basic::LevelConfigData &>(val));
         val.numberRows = j[NumberRows].get<uint32_t>();
         val.dfsSearch = j[DfsSearch].get<bool>();
+        if (j.contains(Algorithm)) {
+            val.algorithm = j[Algorithm].get<std::string>();
+        }
     }
 
     uint8_t encodeCell(bool top, bool right, bool bottom, bool left) {
@@ -18,21 +18,38 @@
  *
  */
 
-#include <list>
-#include <deque>
 #include <vector>
+#include <numeric>
+#include <string>
+#include <stdexcept>
 
 #include "generatedMazeAlgorithms.hpp"
 
-void GeneratedMazeBoard::generateDFS() {
-    std::vector<std::pair<unsigned int, unsigned int> > path;
-    unsigned int rowStart, columnStart;
-    unsigned int rowEnd, columnEnd;
+GeneratedMazeBoard::Mode GeneratedMazeBoard::modeFromName(std::string const &name) {
+    if (name == "BFS") {
+        return BFS;
+    } else if (name == "DFS") {
+        return DFS;
+    } else if (name == "Wilson") {
+        return Wilson;
+    } else if (name == "Kruskal") {
+        return Kruskal;
+    } else if (name == "Eller") {
+        return Eller;
+    } else {
+        throw std::runtime_error("Unknown maze generation algorithm: " + name);
+    }
+}
+
+void GeneratedMazeBoard::chooseStartAndEnd() {
+    uint64_t rowStart, columnStart;
+    uint64_t rowEnd, columnEnd;
 
     // the desired distance that they are apart is the average of the number of rows and the number
-    // of columns divided by 2.
-    unsigned int desiredDistanceSquared = (numberRows()+numberColumns())*(numberRows()+numberColumns())/16;
-    unsigned int distanceSquared;
+    // of columns divided by 2.  Use 64 bit math so that very large mazes don't overflow.
+    uint64_t sum = numberRows() + numberColumns();
+    uint64_t desiredDistanceSquared = sum*sum/16;
+    uint64_t distanceSquared;
     do {
         rowStart = m_random.getUInt(0, numberRows()-1);
         columnStart = m_random.getUInt(0, numberColumns()-1);
@@ -42,145 +59,333 @@ void GeneratedMazeBoard::generateDFS() {
                           (columnEnd - columnStart)*(columnEnd - columnStart);
     } while (distanceSquared < desiredDistanceSquared);
 
-    m_cells[rowStart][columnStart].mIsStart = true;
-    m_cells[rowEnd][columnEnd].mIsEnd = true;
-    m_rowEnd = rowEnd;
-    m_colEnd = columnEnd;
-    m_rowStart = rowStart;
-    m_colStart = columnStart;
+    setStart(rowStart, columnStart);
+    setEnd(rowEnd, columnEnd);
+}
+
+void GeneratedMazeBoard::removeWallBetween(size_t cell, size_t neighbor) {
+    size_t row = cell / m_numberColumns;
+    size_t col = cell % m_numberColumns;
+    size_t neighborRow = neighbor / m_numberColumns;
+    size_t neighborCol = neighbor % m_numberColumns;
+
+    // compare the rows and columns, not the indices: with one column, the cell below is also at
+    // cell + 1.
+    if (neighborRow == row) {
+        if (neighborCol > col) {
+            setWall(row, col, rightWall, false);
+        } else {
+            // the new cell is on the left of the current one.
+            setWall(row, col, leftWall, false);
+        }
+    } else if (neighborRow < row) {
+        // the new cell is on the top of the current one.
+        setWall(row, col, topWall, false);
+    } else {
+        setWall(row, col, bottomWall, false);
+    }
+}
 
-    m_cells[rowStart][columnStart].mVisited = true;
-    path.push_back(std::make_pair(rowStart, columnStart));
+void GeneratedMazeBoard::addNeighbors(size_t cell, bool onlyUnvisited, std::vector<size_t> &neighbors) const {
+    size_t row = cell / m_numberColumns;
+    size_t col = cell % m_numberColumns;
+    auto add = [&](size_t neighbor) {
+        if (!onlyUnvisited || !visited(neighbor)) {
+            neighbors.push_back(neighbor);
+        }
+    };
+
+    if (row > 0) {
+        add(cell - m_numberColumns);
+    }
+    if (col > 0) {
+        add(cell - 1);
+    }
+    if (row + 1 < m_numberRows) {
+        add(cell + m_numberColumns);
+    }
+    if (col + 1 < m_numberColumns) {
+        add(cell + 1);
+    }
+}
+
+void GeneratedMazeBoard::generateDFS() {
+    std::vector<size_t> path;
+    std::vector<size_t> nextCellOptions;
+
+    chooseStartAndEnd();
+
+    size_t start = cellIndex(m_rowStart, m_colStart);
+    size_t end = cellIndex(m_rowEnd, m_colEnd);
+    setVisited(start);
+    path.push_back(start);
 
     while (!path.empty()) {
-        std::pair<unsigned int, unsigned int> current = path.back();
-        if (m_cells[current.first][current.second].isEnd()) {
+        size_t current = path.back();
+        if (current == end) {
             path.pop_back();
             continue;
         }
 
-        std::vector<std::pair<unsigned int, unsigned int> > nextCellOptions;
-        addCellOption(current.first-1, current.second, nextCellOptions);
-        addCellOption(current.first, current.second-1, nextCellOptions);
-        addCellOption(current.first+1, current.second, nextCellOptions);
-        addCellOption(current.first, current.second+1, nextCellOptions);
+        nextCellOptions.clear();
+        addNeighbors(current, true, nextCellOptions);
 
         if (nextCellOptions.empty()) {
             path.pop_back();
             continue;
         }
-        unsigned int i = m_random.getUInt(0, nextCellOptions.size() - 1);
+        size_t next = nextCellOptions[m_random.getBounded(nextCellOptions.size())];
 
-        std::pair<unsigned int, unsigned int> next = nextCellOptions[i];
+        removeWallBetween(current, next);
 
-        if (current.first == next.first) {
-            if (next.second < current.second) {
-                // the new cell is on the left of the current one.
-                m_cells[current.first][current.second].mLeftWallExists = false;
-                m_cells[next.first][next.second].mRightWallExists = false;
-            } else {
-                m_cells[current.first][current.second].mRightWallExists = false;
-                m_cells[next.first][next.second].mLeftWallExists = false;
-            }
-        } else {
-            if (next.first < current.first) {
-                // the new cell is on the top of the current one.
-                m_cells[current.first][current.second].mTopWallExists = false;
-                m_cells[next.first][next.second].mBottomWallExists = false;
-            } else {
-                m_cells[current.first][current.second].mBottomWallExists = false;
-                m_cells[next.first][next.second].mTopWallExists = false;
-            }
-        }
-
-        m_cells[next.first][next.second].mVisited = true;
+        setVisited(next);
         path.push_back(next);
     }
 }
 
+/* The frontier is a dense vector.  The next cell to expand is picked at random and removed by
+ * swapping it with the last element, so both adding and removing a cell is O(1).  Picking a random
+ * cell from the frontier gives the same kind of maze as the old implementation which inserted new
+ * cells at a random place in a list and always expanded the first cell.
+ */
 void GeneratedMazeBoard::generateBFS() {
-    std::list<std::pair<unsigned int, unsigned int> > path;
-    unsigned int rowStart, columnStart;
-    unsigned int rowEnd, columnEnd;
-
-    // the desired distance that they are apart is the average of the number of rows and the number
-    // of columns divided by 2.
-    unsigned int desiredDistanceSquared = (numberRows()+numberColumns())*(numberRows()+numberColumns())/16;
-    unsigned int distanceSquared;
-    do {
-        rowStart = m_random.getUInt(0, numberRows()-1);
-        columnStart = m_random.getUInt(0, numberColumns()-1);
-        rowEnd = m_random.getUInt(0, numberRows()-1);
-        columnEnd = m_random.getUInt(0, numberColumns()-1);
-        distanceSquared = (rowEnd - rowStart)*(rowEnd - rowStart) +
-                          (columnEnd - columnStart)*(columnEnd - columnStart);
-    } while (distanceSquared < desiredDistanceSquared);
+    std::vector<size_t> frontier;
+    std::vector<size_t> nextCellOptions;
 
-    m_cells[rowStart][columnStart].mIsStart = true;
-    m_cells[rowEnd][columnEnd].mIsEnd = true;
-    m_rowEnd = rowEnd;
-    m_colEnd = columnEnd;
-    m_rowStart = rowStart;
-    m_colStart = columnStart;
+    chooseStartAndEnd();
 
-    m_cells[rowStart][columnStart].mVisited = true;
-    path.push_back(std::make_pair(rowStart, columnStart));
+    size_t start = cellIndex(m_rowStart, m_colStart);
+    size_t end = cellIndex(m_rowEnd, m_colEnd);
+    setVisited(start);
+    frontier.push_back(start);
 
-    while (!path.empty()) {
-        std::pair<unsigned int, unsigned int> current = path.front();
-        path.pop_front();
-        if (m_cells[current.first][current.second].isEnd()) {
+    while (!frontier.empty()) {
+        size_t i = m_random.getBounded(frontier.size());
+        size_t current = frontier[i];
+        frontier[i] = frontier.back();
+        frontier.pop_back();
+        if (current == end) {
             continue;
         }
 
-        std::vector<std::pair<unsigned int, unsigned int> > nextCellOptions;
-        addCellOption(current.first - 1, current.second, nextCellOptions);
-        addCellOption(current.first, current.second - 1, nextCellOptions);
-        addCellOption(current.first + 1, current.second, nextCellOptions);
-        addCellOption(current.first, current.second + 1, nextCellOptions);
+        nextCellOptions.clear();
+        addNeighbors(current, true, nextCellOptions);
 
-        if (nextCellOptions.empty()) {
+        for (auto next : nextCellOptions) {
+            removeWallBetween(current, next);
+
+            setVisited(next);
+            frontier.push_back(next);
+        }
+    }
+}
+
+/* Wilson's algorithm: starting from each cell not in the maze yet, do a random walk until a cell
+ * in the maze is hit.  The walk remembers only the last direction it left each cell in, so when
+ * it is followed again from its start, any loops are erased.  The visited bits mark the cells
+ * that are in the maze.  The mazes are uniformly random, but the walks are slow to cross long
+ * narrow mazes, use Eller's algorithm for those.
+ */
+void GeneratedMazeBoard::generateWilson() {
+    size_t nbrCells = m_numberRows * m_numberColumns;
+    std::vector<size_t> nextInWalk(nbrCells);
+    std::vector<size_t> neighbors;
+
+    chooseStartAndEnd();
+
+    setVisited(cellIndex(m_rowStart, m_colStart));
+
+    for (size_t walkStart = 0; walkStart < nbrCells; walkStart++) {
+        if (visited(walkStart)) {
             continue;
         }
 
-        for (auto const &next : nextCellOptions) {
-            if (current.first == next.first) {
-                if (next.second < current.second) {
-                    // the new cell is on the left of the current one.
-                    m_cells[current.first][current.second].mLeftWallExists = false;
-                    m_cells[next.first][next.second].mRightWallExists = false;
-                } else {
-                    m_cells[current.first][current.second].mRightWallExists = false;
-                    m_cells[next.first][next.second].mLeftWallExists = false;
-                }
-            } else {
-                if (next.first < current.first) {
-                    // the new cell is on the top of the current one.
-                    m_cells[current.first][current.second].mTopWallExists = false;
-                    m_cells[next.first][next.second].mBottomWallExists = false;
-                } else {
-                    m_cells[current.first][current.second].mBottomWallExists = false;
-                    m_cells[next.first][next.second].mTopWallExists = false;
-                }
-            }
+        size_t current = walkStart;
+        while (!visited(current)) {
+            neighbors.clear();
+            addNeighbors(current, false, neighbors);
+            size_t next = neighbors[m_random.getBounded(neighbors.size())];
+            nextInWalk[current] = next;
+            current = next;
+        }
 
-            m_cells[next.first][next.second].mVisited = true;
-            size_t size = path.size();
-            unsigned int i = size == 0 ? 0 : m_random.getUInt(0, path.size());
-            auto it = path.begin();
-            for (unsigned int j = 0; j < i; j++, it++)
-                /* do nothing */;
-            path.insert(it, next);
+        // add the loop erased walk to the maze.
+        current = walkStart;
+        while (!visited(current)) {
+            size_t next = nextInWalk[current];
+            removeWallBetween(current, next);
+            setVisited(current);
+            current = next;
         }
     }
 }
 
-void GeneratedMazeBoard::addCellOption(unsigned int r, unsigned int c, std::vector<std::pair<unsigned int, unsigned int> > &options) {
-    if (r < numberRows() && c < numberColumns() && !m_cells[r][c].visited()) {
-        options.push_back(std::make_pair(r, c));
+namespace {
+    // union-find over cell indices with path halving and union by size.
+    class DisjointSets {
+    public:
+        explicit DisjointSets(size_t size)
+                : m_parents(size),
+                  m_sizes(size, 1)
+        {
+            reset();
+        }
+
+        // put every element back in a set by itself.
+        void reset() {
+            std::iota(m_parents.begin(), m_parents.end(), 0);
+            std::fill(m_sizes.begin(), m_sizes.end(), 1);
+        }
+
+        size_t find(size_t i) {
+            while (m_parents[i] != i) {
+                m_parents[i] = m_parents[m_parents[i]];
+                i = m_parents[i];
+            }
+            return i;
+        }
+
+        // returns false if i and j were already in the same set.
+        bool join(size_t i, size_t j) {
+            i = find(i);
+            j = find(j);
+            if (i == j) {
+                return false;
+            }
+            if (m_sizes[i] < m_sizes[j]) {
+                std::swap(i, j);
+            }
+            m_parents[j] = i;
+            m_sizes[i] += m_sizes[j];
+            return true;
+        }
+
+    private:
+        std::vector<size_t> m_parents;
+        std::vector<size_t> m_sizes;
+    };
+}
+
+/* Kruskal's algorithm: go through the inner walls in random order and remove each one that
+ * separates two cells that aren't connected yet.  The walls are encoded as cell * 2 for the wall to
+ * the right of the cell and cell * 2 + 1 for the wall below the cell.
+ */
+void GeneratedMazeBoard::generateKruskal() {
+    size_t nbrCells = m_numberRows * m_numberColumns;
+    std::vector<size_t> walls;
+    walls.reserve(2 * nbrCells);
+    for (size_t row = 0; row < m_numberRows; row++) {
+        for (size_t col = 0; col < m_numberColumns; col++) {
+            size_t cell = cellIndex(row, col);
+            if (col + 1 < m_numberColumns) {
+                walls.push_back(cell * 2);
+            }
+            if (row + 1 < m_numberRows) {
+                walls.push_back(cell * 2 + 1);
+            }
+        }
+    }
+
+    // Fisher-Yates shuffle
+    for (size_t i = walls.size(); i > 1; i--) {
+        std::swap(walls[i - 1], walls[m_random.getBounded(i)]);
+    }
+
+    chooseStartAndEnd();
+
+    DisjointSets sets(nbrCells);
+    size_t nbrPassages = 0;
+    for (auto wall : walls) {
+        size_t cell = wall / 2;
+        size_t neighbor = (wall & 0x1U) ? cell + m_numberColumns : cell + 1;
+        if (sets.join(cell, neighbor)) {
+            removeWallBetween(cell, neighbor);
+            if (++nbrPassages == nbrCells - 1) {
+                // all the cells are connected.
+                break;
+            }
+        }
     }
+
+    setAllVisited();
 }
 
-Cell const &GeneratedMazeBoard::getCell(unsigned int row, unsigned int column) {
-    return m_cells[row][column];
+/* Eller's algorithm: the maze is generated one row at a time keeping track only of which set each
+ * cell in the current row is in.  Neighboring cells in different sets are randomly joined, then
+ * each set gets at least one passage down to the next row.  The last row joins all the remaining
+ * sets.  Memory use other than the board itself only depends on the number of columns.
+ *
+ * Set ids are always less than the number of columns: they are renumbered at the start of each
+ * row.
+ */
+void GeneratedMazeBoard::generateEller() {
+    size_t const noSet = m_numberColumns;
+    std::vector<size_t> rowSets(m_numberColumns, noSet);
+    std::vector<size_t> nextRowSets(m_numberColumns);
+    std::vector<size_t> renumbered(m_numberColumns);
+    std::vector<size_t> cellsRemaining(m_numberColumns);
+    std::vector<bool> hasPassageDown(m_numberColumns);
+    DisjointSets sets(m_numberColumns);
+
+    chooseStartAndEnd();
+
+    for (size_t row = 0; row < m_numberRows; row++) {
+        bool lastRow = row + 1 == m_numberRows;
+
+        // renumber the sets carried down from the previous row and put the other cells in a set
+        // by themselves.
+        std::fill(renumbered.begin(), renumbered.end(), noSet);
+        size_t nextSet = 0;
+        for (auto &set : rowSets) {
+            if (set == noSet) {
+                set = nextSet++;
+            } else {
+                if (renumbered[set] == noSet) {
+                    renumbered[set] = nextSet++;
+                }
+                set = renumbered[set];
+            }
+        }
+
+        // join neighbors in different sets.
+        sets.reset();
+        for (size_t col = 0; col + 1 < m_numberColumns; col++) {
+            if (sets.find(rowSets[col]) == sets.find(rowSets[col + 1])) {
+                continue;
+            }
+            if (lastRow || (m_random.getBounded(2) == 0)) {
+                sets.join(rowSets[col], rowSets[col + 1]);
+                setWall(row, col, rightWall, false);
+            }
+        }
+
+        if (lastRow) {
+            break;
+        }
+
+        // each set needs at least one passage down.  The last cell of a set goes down if no other
+        // cell in the set did.
+        std::fill(cellsRemaining.begin(), cellsRemaining.end(), 0);
+        std::fill(hasPassageDown.begin(), hasPassageDown.end(), false);
+        for (auto &set : rowSets) {
+            set = sets.find(set);
+            cellsRemaining[set]++;
+        }
+
+        for (size_t col = 0; col < m_numberColumns; col++) {
+            size_t set = rowSets[col];
+            cellsRemaining[set]--;
+            if ((m_random.getBounded(2) == 0) || (cellsRemaining[set] == 0 && !hasPassageDown[set])) {
+                hasPassageDown[set] = true;
+                setWall(row, col, bottomWall, false);
+                nextRowSets[col] = set;
+            } else {
+                nextRowSets[col] = noSet;
+            }
+        }
+
+        std::swap(rowSets, nextRowSets);
+    }
+
+    setAllVisited();
 }
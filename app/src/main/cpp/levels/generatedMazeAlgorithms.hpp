@@ -21,34 +21,45 @@
 #define AMAZING_LABYRINTH_GENERATED_MAZE_ALGORITHMS_HPP
 
 #include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <string>
 #include "../random.hpp"
 
 class GeneratedMazeBoard;
 
+/* A lightweight view of one cell in the maze board.  The board does not store cells, it stores
+ * bits for each cell and wall, so this just refers back to the board.
+ */
 class Cell {
     friend GeneratedMazeBoard;
 private:
-    bool mVisited;
-    bool mIsStart;
-    bool mIsEnd;
-    bool mTopWallExists;
-    bool mBottomWallExists;
-    bool mLeftWallExists;
-    bool mRightWallExists;
+    GeneratedMazeBoard const *m_board;
+    size_t m_row;
+    size_t m_col;
+
+    Cell(GeneratedMazeBoard const *board, size_t row, size_t col)
+            : m_board{board}, m_row{row}, m_col{col} {}
 public:
-    Cell() : mVisited(false), mIsStart(false), mIsEnd(false), mTopWallExists(true),
-             mBottomWallExists(true), mLeftWallExists(true), mRightWallExists(true) {}
     ~Cell() = default;
 
-    bool visited() const { return mVisited; }
-    bool isStart() const { return mIsStart; }
-    bool isEnd() const { return mIsEnd; }
-    bool topWallExists() const { return mTopWallExists; }
-    bool bottomWallExists() const { return mBottomWallExists; }
-    bool leftWallExists() const { return mLeftWallExists; }
-    bool rightWallExists() const { return mRightWallExists; }
+    inline bool visited() const;
+    inline bool isStart() const;
+    inline bool isEnd() const;
+    inline bool topWallExists() const;
+    inline bool bottomWallExists() const;
+    inline bool leftWallExists() const;
+    inline bool rightWallExists() const;
 };
 
+/* The maze board is stored as bit sets in contiguous arrays:
+ *  - m_visited: one bit per cell.
+ *  - m_horizontalWalls: the walls above and below the cells.  There are numberRows + 1 rows of
+ *    horizontal walls with numberColumns walls in each row.  The wall at the bottom of a cell is
+ *    the same wall as the one at the top of the cell below it, so it is only stored once.
+ *  - m_verticalWalls: the walls to the left and right of the cells.  There are numberRows rows of
+ *    vertical walls with numberColumns + 1 walls in each row.
+ */
 class GeneratedMazeBoard {
 public:
     enum WallType {
@@ -58,95 +69,193 @@ public:
         bottomWall
     };
 
+    /* The algorithms available to generate the maze:
+     *  - BFS: grows the maze from a random cell on the frontier (similar to randomized Prim's).
+     *  - DFS: recursive backtracker, produces long winding passages.
+     *  - Wilson: loop-erased random walks, a uniformly random spanning tree of the cells.
+     *  - Kruskal: removes walls in random order, joining sets of cells tracked with union-find.
+     *  - Eller: generates one row at a time only tracking the sets of the current row, so it is
+     *    suitable for very tall mazes.
+     */
     enum Mode {
         none = 0,
         BFS = 1,
-        DFS = 2
+        DFS = 2,
+        Wilson = 3,
+        Kruskal = 4,
+        Eller = 5
     };
 
-    size_t rowEnd() { return m_rowEnd; }
-    size_t colEnd() { return m_colEnd; }
-    size_t rowStart() { return m_rowStart; }
-    size_t colStart() { return m_colStart; }
-    size_t numberRows() { return m_cells.size(); }
-    size_t numberColumns() { return m_cells.size() > 0 ? m_cells[0].size() : 0; }
-    Cell const &getCell(unsigned int row, unsigned int column);
+    // returns the mode with the same name as the enum value, throws if there is none.
+    static Mode modeFromName(std::string const &name);
+
+    size_t rowEnd() const { return m_rowEnd; }
+    size_t colEnd() const { return m_colEnd; }
+    size_t rowStart() const { return m_rowStart; }
+    size_t colStart() const { return m_colStart; }
+    size_t numberRows() const { return m_numberRows; }
+    size_t numberColumns() const { return m_numberColumns; }
+    Cell getCell(unsigned int row, unsigned int column) const { return Cell{this, row, column}; }
 
     void setEnd(size_t row, size_t col) {
-        m_cells[row][col].mIsEnd = true;
+        m_endSet = true;
         m_rowEnd = row;
         m_colEnd = col;
     }
 
     void setStart(size_t row, size_t col) {
-        m_cells[row][col].mIsStart = true;
+        m_startSet = true;
         m_rowStart = row;
         m_colStart = col;
     }
 
-    bool wallExists(size_t row, size_t col, WallType wall) {
-        switch (wall) {
-            case WallType::rightWall:
-                return m_cells[row][col].mRightWallExists;
-            case WallType::topWall:
-                return m_cells[row][col].mTopWallExists;
-            case WallType::leftWall:
-                return m_cells[row][col].mLeftWallExists;
-            case WallType::bottomWall:
-            default:
-                return m_cells[row][col].mBottomWallExists;
+    bool isStart(size_t row, size_t col) const {
+        return m_startSet && row == m_rowStart && col == m_colStart;
+    }
+
+    bool isEnd(size_t row, size_t col) const {
+        return m_endSet && row == m_rowEnd && col == m_colEnd;
+    }
+
+    bool visited(size_t row, size_t col) const {
+        return testBit(m_visited, cellIndex(row, col));
+    }
+
+    bool wallExists(size_t row, size_t col, WallType wall) const {
+        if (isHorizontal(wall)) {
+            return testBit(m_horizontalWalls, horizontalWallIndex(row, col, wall));
+        } else {
+            return testBit(m_verticalWalls, verticalWallIndex(row, col, wall));
         }
     }
 
+    // Note: the neighboring cell shares this wall, so it is also changed for that cell.
     void setWall(size_t row, size_t col, WallType wall, bool isSet) {
-        switch (wall) {
-            case WallType::rightWall:
-                m_cells[row][col].mRightWallExists = isSet;
-                break;
-            case WallType::topWall:
-                m_cells[row][col].mTopWallExists = isSet;
-                break;
-            case WallType::leftWall:
-                m_cells[row][col].mLeftWallExists = isSet;
-                break;
-            case WallType::bottomWall:
-            default:
-                m_cells[row][col].mBottomWallExists = isSet;
-                break;
+        if (isHorizontal(wall)) {
+            setBit(m_horizontalWalls, horizontalWallIndex(row, col, wall), isSet);
+        } else {
+            setBit(m_verticalWalls, verticalWallIndex(row, col, wall), isSet);
         }
     }
 
     GeneratedMazeBoard(size_t numberRows, size_t numberColumns, Mode mode)
-        : m_rowEnd{0},
+        : m_numberRows{numberRows},
+          m_numberColumns{numberColumns},
+          m_visited(numberWords(numberRows * numberColumns), 0),
+          m_horizontalWalls(numberWords((numberRows + 1) * numberColumns), ~static_cast<uint64_t>(0)),
+          m_verticalWalls(numberWords(numberRows * (numberColumns + 1)), ~static_cast<uint64_t>(0)),
+          m_rowEnd{0},
           m_colEnd{0},
           m_rowStart{0},
-          m_colStart{0}
+          m_colStart{0},
+          m_startSet{false},
+          m_endSet{false}
     {
-        m_cells.resize(numberRows);
-
-        for (unsigned int i = 0; i < numberRows; i++) {
-            m_cells[i].resize(numberColumns);
-        }
-
-        if (mode == BFS) {
+        switch (mode) {
+        case BFS:
             generateBFS();
-        } else if (mode == DFS){
+            break;
+        case DFS:
             generateDFS();
+            break;
+        case Wilson:
+            generateWilson();
+            break;
+        case Kruskal:
+            generateKruskal();
+            break;
+        case Eller:
+            generateEller();
+            break;
+        case none:
+        default:
+            break;
         }
-
     }
 private:
+    static size_t constexpr bitsPerWord = 64;
+
     Random m_random;
-    std::vector<std::vector<Cell>> m_cells;
+    size_t m_numberRows;
+    size_t m_numberColumns;
+
+    std::vector<uint64_t> m_visited;
+    std::vector<uint64_t> m_horizontalWalls;
+    std::vector<uint64_t> m_verticalWalls;
 
     size_t m_rowEnd;
     size_t m_colEnd;
     size_t m_rowStart;
     size_t m_colStart;
+    bool m_startSet;
+    bool m_endSet;
 
+    static size_t numberWords(size_t numberBits) {
+        return (numberBits + bitsPerWord - 1) / bitsPerWord;
+    }
+
+    static bool testBit(std::vector<uint64_t> const &bits, size_t i) {
+        return ((bits[i / bitsPerWord] >> (i % bitsPerWord)) & 0x1U) != 0;
+    }
+
+    static void setBit(std::vector<uint64_t> &bits, size_t i, bool isSet) {
+        uint64_t mask = static_cast<uint64_t>(1) << (i % bitsPerWord);
+        if (isSet) {
+            bits[i / bitsPerWord] |= mask;
+        } else {
+            bits[i / bitsPerWord] &= ~mask;
+        }
+    }
+
+    // topWall and bottomWall are odd, rightWall and leftWall are even.
+    static bool isHorizontal(WallType wall) { return (wall & 0x1U) != 0; }
+
+    size_t cellIndex(size_t row, size_t col) const { return row * m_numberColumns + col; }
+
+    // the bottom wall of a cell is the top wall of the next row.
+    size_t horizontalWallIndex(size_t row, size_t col, WallType wall) const {
+        return (row + (wall == bottomWall ? 1 : 0)) * m_numberColumns + col;
+    }
+
+    // the right wall of a cell is the left wall of the next column.
+    size_t verticalWallIndex(size_t row, size_t col, WallType wall) const {
+        return row * (m_numberColumns + 1) + col + (wall == rightWall ? 1 : 0);
+    }
+
+    void setVisited(size_t row, size_t col) { setBit(m_visited, cellIndex(row, col), true); }
+    void setVisited(size_t cell) { setBit(m_visited, cell, true); }
+    bool visited(size_t cell) const { return testBit(m_visited, cell); }
+    void setAllVisited() { std::fill(m_visited.begin(), m_visited.end(), ~static_cast<uint64_t>(0)); }
+
+    // remove the wall between two neighboring cells (given as cell indices).
+    void removeWallBetween(size_t cell, size_t neighbor);
+
+    // add the neighbors of cell that are inside the board to neighbors.  If onlyUnvisited is true,
+    // then neighbors that are already visited are skipped.
+    void addNeighbors(size_t cell, bool onlyUnvisited, std::vector<size_t> &neighbors) const;
+
+    void chooseStartAndEnd();
     void generateBFS();
     void generateDFS();
-    void addCellOption(unsigned int r, unsigned int c, std::vector<std::pair<unsigned int, unsigned int> > &options);
+    void generateWilson();
+    void generateKruskal();
+    void generateEller();
 };
 
+bool Cell::visited() const { return m_board->visited(m_row, m_col); }
+bool Cell::isStart() const { return m_board->isStart(m_row, m_col); }
+bool Cell::isEnd() const { return m_board->isEnd(m_row, m_col); }
+bool Cell::topWallExists() const {
+    return m_board->wallExists(m_row, m_col, GeneratedMazeBoard::WallType::topWall);
+}
+bool Cell::bottomWallExists() const {
+    return m_board->wallExists(m_row, m_col, GeneratedMazeBoard::WallType::bottomWall);
+}
+bool Cell::leftWallExists() const {
+    return m_board->wallExists(m_row, m_col, GeneratedMazeBoard::WallType::leftWall);
+}
+bool Cell::rightWallExists() const {
+    return m_board->wallExists(m_row, m_col, GeneratedMazeBoard::WallType::rightWall);
+}
+
 #endif // AMAZING_LABYRINTH_GENERATED_MAZE_ALGORITHMS_HPP
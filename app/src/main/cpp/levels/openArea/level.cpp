@@ -26,28 +26,27 @@ namespace openArea {
             return false;
         }
 
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float timeDiff = std::chrono::duration<float, std::chrono::seconds::period>(
-                currentTime - prevTime).count();
-        prevTime = currentTime;
+        advancePhysics([this](float timeDiff) -> bool {
+            m_ball.position = getUpdatedPosition(timeDiff);
+            m_ball.velocity = getUpdatedVelocity(m_ball.acceleration, timeDiff);
 
-        m_ball.position = getUpdatedPosition(timeDiff);
-        m_ball.velocity = getUpdatedVelocity(m_ball.acceleration, timeDiff);
-        //m_ball.position += m_ball.velocity * timeDiff;
+            float errDistance = ballDiameter();
+            if (glm::length(m_ball.position - holePosition) < errDistance) {
+                m_finished = true;
+                m_ball.position.x = holePosition.x;
+                m_ball.position.y = holePosition.y;
+                m_ball.velocity = {0.0f, 0.0f, 0.0f};
+                return false;
+            }
 
-        float errDistance = ballDiameter();
-        if (glm::length(m_ball.position - holePosition) < errDistance) {
-            m_finished = true;
-            m_ball.position.x = holePosition.x;
-            m_ball.position.y = holePosition.y;
-            m_ball.velocity = {0.0f, 0.0f, 0.0f};
+            checkBallBorders(m_ball.position, m_ball.velocity);
+            updateRotation(timeDiff);
             return true;
-        }
+        });
 
-        checkBallBorders(m_ball.position, m_ball.velocity);
-        updateRotation(timeDiff);
-        modelMatrixBall = glm::translate(glm::mat4(1.0f), m_ball.position) *
-                          glm::mat4_cast(m_ball.totalRotated) * scale;
+        if (m_finished) {
+            return true;
+        }
 
         return drawingNecessary();
     }
@@ -63,6 +62,7 @@ namespace openArea {
     }
 
     bool Level::updateDrawObjects() {
+        modelMatrixBall = interpolatedBallModelMatrix(scale);
         m_levelDrawer.updateModelMatrixForObject(m_objRefBall, m_objDataRefBall, modelMatrixBall);
         return true;
     }
@@ -34,7 +34,6 @@ namespace openArea {
     class Level : public basic::Level {
     private:
         Random random;
-        std::chrono::high_resolution_clock::time_point prevTime;
 
         glm::vec3 holePosition;
 
@@ -80,8 +79,7 @@ namespace openArea {
                 std::shared_ptr<basic::LevelConfigData> const &lcd,
                 std::shared_ptr <LevelSaveData> const &levelRestoreData,
                 float maxZ)
-                : basic::Level(std::move(inLevelDrawer), lcd, maxZ, true),
-                  prevTime(std::chrono::high_resolution_clock::now())
+                : basic::Level(std::move(inLevelDrawer), lcd, maxZ, true)
         {
             if (levelRestoreData == nullptr) {
                 generate();
@@ -118,7 +116,7 @@ namespace openArea {
         bool updateDrawObjects() override;
 
         void start() override {
-            prevTime = std::chrono::high_resolution_clock::now();
+            restartPhysicsClock();
         }
 
         void getLevelFinisherCenter(float &x, float &y, float &z) override {
@@ -28,89 +28,96 @@ namespace openAreaMaze {
             return false;
         }
 
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        float timeDiff = std::chrono::duration<float, std::chrono::seconds::period>(
-                currentTime - prevTime).count();
-        prevTime = currentTime;
-
-        m_ball.velocity = getUpdatedVelocity(m_ball.acceleration, timeDiff);
-        m_ball.position += m_ball.velocity * timeDiff;
-
-        size_t numberRows = m_mazeBoard.numberRows();
-        size_t numberColumns = m_mazeBoard.numberColumns();
-
-        float halfWallWidth = m_width / 2 / 3 / (numberColumns * numberBlocksPerCell + 1);
-        auto cell = m_mazeBoard.getCell(m_ballCell.row, m_ballCell.col);
-        if (cell.leftWallExists() &&
-            m_ball.position.x < leftWall(m_ballCell.col) + ballRadius() + halfWallWidth) {
-            if (m_ball.velocity.x < 0.0f) {
-                m_ball.velocity.x = 0.0f;
+        advancePhysics([this](float timeDiff) -> bool {
+            m_ball.velocity = getUpdatedVelocity(m_ball.acceleration, timeDiff);
+            m_ball.position += m_ball.velocity * timeDiff;
+
+            size_t numberRows = m_mazeBoard.numberRows();
+            size_t numberColumns = m_mazeBoard.numberColumns();
+
+            float halfWallWidth = m_width / 2 / 3 / (numberColumns * numberBlocksPerCell + 1);
+            auto cell = m_mazeBoard.getCell(m_ballCell.row, m_ballCell.col);
+            if (cell.leftWallExists() &&
+                m_ball.position.x < leftWall(m_ballCell.col) + ballRadius() + halfWallWidth) {
+                if (m_ball.velocity.x < 0.0f) {
+                    m_ball.velocity.x = 0.0f;
+                }
+                m_ball.position.x = leftWall(m_ballCell.col) + ballRadius() + halfWallWidth;
             }
-            m_ball.position.x = leftWall(m_ballCell.col) + ballRadius() + halfWallWidth;
-        }
-        if (cell.rightWallExists() &&
-            m_ball.position.x > rightWall(m_ballCell.col) - ballRadius() - halfWallWidth) {
-            if (m_ball.velocity.x > 0.0f) {
-                m_ball.velocity.x = 0.0f;
+            if (cell.rightWallExists() &&
+                m_ball.position.x > rightWall(m_ballCell.col) - ballRadius() - halfWallWidth) {
+                if (m_ball.velocity.x > 0.0f) {
+                    m_ball.velocity.x = 0.0f;
+                }
+                m_ball.position.x = rightWall(m_ballCell.col) - ballRadius() - halfWallWidth;
             }
-            m_ball.position.x = rightWall(m_ballCell.col) - ballRadius() - halfWallWidth;
-        }
-        if (cell.bottomWallExists() &&
-            m_ball.position.y > bottomWall(m_ballCell.row) - ballRadius() - halfWallWidth) {
-            if (m_ball.velocity.y > 0.0f) {
-                m_ball.velocity.y = 0.0f;
+            if (cell.bottomWallExists() &&
+                m_ball.position.y > bottomWall(m_ballCell.row) - ballRadius() - halfWallWidth) {
+                if (m_ball.velocity.y > 0.0f) {
+                    m_ball.velocity.y = 0.0f;
+                }
+                m_ball.position.y = bottomWall(m_ballCell.row) - ballRadius() - halfWallWidth;
             }
-            m_ball.position.y = bottomWall(m_ballCell.row) - ballRadius() - halfWallWidth;
-        }
-        if (cell.topWallExists() &&
-            m_ball.position.y < topWall(m_ballCell.row) + ballRadius() + halfWallWidth) {
-            if (m_ball.velocity.y < 0.0f) {
-                m_ball.velocity.y = 0.0f;
+            if (cell.topWallExists() &&
+                m_ball.position.y < topWall(m_ballCell.row) + ballRadius() + halfWallWidth) {
+                if (m_ball.velocity.y < 0.0f) {
+                    m_ball.velocity.y = 0.0f;
+                }
+                m_ball.position.y = topWall(m_ballCell.row) + ballRadius() + halfWallWidth;
             }
-            m_ball.position.y = topWall(m_ballCell.row) + ballRadius() + halfWallWidth;
-        }
 
-        float cellHeight = m_height / (numberRows * numberBlocksPerCell + 1) * numberBlocksPerCell;
-        float cellWidth = m_width / (numberColumns * numberBlocksPerCell + 1) * numberBlocksPerCell;
+            float cellHeight = m_height / (numberRows * numberBlocksPerCell + 1) * numberBlocksPerCell;
+            float cellWidth = m_width / (numberColumns * numberBlocksPerCell + 1) * numberBlocksPerCell;
 
-        float cellCenterX = getColumnCenterPosition(m_ballCell.col);
-        float cellCenterY = getRowCenterPosition(m_ballCell.row);
-        float deltax = m_ball.position.x - cellCenterX;
-        float deltay = m_ball.position.y - cellCenterY;
+            float cellCenterX = getColumnCenterPosition(m_ballCell.col);
+            float cellCenterY = getRowCenterPosition(m_ballCell.row);
+            float deltax = m_ball.position.x - cellCenterX;
+            float deltay = m_ball.position.y - cellCenterY;
 
-        int rowinc = 0;
-        int colinc = 0;
-        if (deltay > cellHeight / 2.0f && m_ballCell.row != numberRows - 1) {
-            rowinc++;
-        } else if (deltay < -cellHeight / 2.0f && m_ballCell.row != 0) {
-            rowinc--;
-        }
+            int rowinc = 0;
+            int colinc = 0;
+            if (deltay > cellHeight / 2.0f && m_ballCell.row != numberRows - 1) {
+                rowinc++;
+            } else if (deltay < -cellHeight / 2.0f && m_ballCell.row != 0) {
+                rowinc--;
+            }
 
-        if (deltax > cellWidth / 2.0f && m_ballCell.col != numberColumns - 1) {
-            colinc++;
-        } else if (deltax < -cellWidth / 2.0f && m_ballCell.col != 0) {
-            colinc--;
-        }
+            if (deltax > cellWidth / 2.0f && m_ballCell.col != numberColumns - 1) {
+                colinc++;
+            } else if (deltax < -cellWidth / 2.0f && m_ballCell.col != 0) {
+                colinc--;
+            }
 
-        // stop balls from going through the corners of the maze.  If both rows and columns are
-        // changing, the ball could go through a corner if the ball is in the cell were two would be
-        // touching walls are not there.  If this is the case, as long as the ball has not registered
-        // as being in the other cell, it is ok to go through the wall on that side.
-        if (rowinc != 0 && colinc != 0) {
-            colinc = 0;
-        }
+            // stop balls from going through the corners of the maze.  If both rows and columns are
+            // changing, the ball could go through a corner if the ball is in the cell were two would be
+            // touching walls are not there.  If this is the case, as long as the ball has not registered
+            // as being in the other cell, it is ok to go through the wall on that side.
+            if (rowinc != 0 && colinc != 0) {
+                colinc = 0;
+            }
 
-        m_ballCell.row += rowinc;
-        m_ballCell.col += colinc;
+            m_ballCell.row += rowinc;
+            m_ballCell.col += colinc;
 
-        if (checkFinishCondition(timeDiff)) {
-            m_finished = true;
+            if (checkFinishCondition(timeDiff)) {
+                m_finished = true;
+                return false;
+            }
+
+            if (m_ballTeleported) {
+                // stop stepping so that the ball is drawn where it was moved to instead of on its
+                // way there.
+                m_ballTeleported = false;
+                return false;
+            }
+
+            updateRotation(timeDiff);
             return true;
-        }
+        });
 
-        updateRotation(timeDiff);
-        modelMatrixBall = glm::translate(glm::mat4(1.0f), m_ball.position) *
-                          glm::mat4_cast(m_ball.totalRotated) * scaleBall;
+        if (m_finished) {
+            return true;
+        }
 
         return drawingNecessary();
     }
@@ -27,6 +27,9 @@ namespace openAreaMaze {
     protected:
         virtual bool checkFinishCondition(float timeDiff) = 0;
 
+        // set by checkFinishCondition when it moved the ball somewhere else in the maze.
+        bool m_ballTeleported = false;
+
         float leftWall(uint32_t col) {
             return m_width / (m_mazeBoard.numberColumns() * numberBlocksPerCell + 1) *
                    (col * numberBlocksPerCell + 0.5f) - m_width / 2;
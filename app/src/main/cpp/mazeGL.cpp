@@ -34,12 +34,17 @@ void GraphicsGL::initPipeline(bool enableShadows, bool testFramebuffer) {
         if (!m_surfaceDetails->useIntTexture || !testDepthTexture(levelDrawer::Adaptor(levelDrawer::LEVEL, m_levelDrawer))) {
             m_surfaceDetails->useIntTexture = false;
             m_levelDrawer = std::make_shared<levelDrawer::LevelDrawerGL>(
-                    levelDrawer::NeededForDrawingGL{}, m_surfaceDetails, m_renderLoader,
+                    levelDrawer::NeededForDrawingGL{m_surface->glVersion()}, m_surfaceDetails, m_renderLoader,
                     enableShadows ? shadowsChainingRenderDetailsName : objectNoShadowsRenderDetailsName,
                     m_gameRequester);
             if (!testDepthTexture(levelDrawer::Adaptor(levelDrawer::LEVEL, m_levelDrawer))) {
-                throw std::runtime_error(
-                        "This version of OpenGL has bugs making it impossible to get the depth texture and normal map.");
+                // this version of OpenGL can't draw the depth texture and normal map correctly,
+                // draw them on the CPU instead.
+                m_levelDrawer->setDrawToBufferRasterizer(levelDrawer::CPU_RASTERIZER);
+                if (!testDepthTexture(levelDrawer::Adaptor(levelDrawer::LEVEL, m_levelDrawer))) {
+                    throw std::runtime_error(
+                            "Unable to get the depth texture and normal map.");
+                }
             }
         }
     }
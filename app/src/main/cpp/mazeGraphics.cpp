@@ -47,6 +47,8 @@ void LevelSequence::notifySurfaceChanged(
             levelDrawer::Adaptor(levelDrawer::FINISHER, m_levelDrawer), x, y, z);
 
     saveLevelData();
+
+    m_levelTracker->preloadNextLevel();
 }
 
 void LevelSequence::changeLevel(std::string const &level) {
@@ -63,6 +65,8 @@ void LevelSequence::changeLevel(std::string const &level) {
     m_level->getLevelFinisherCenter(x, y, z);
     m_levelFinisher = m_levelGroupFcns.getFinisherFcn(
             levelDrawer::Adaptor(levelDrawer::FINISHER, m_levelDrawer), x, y, z);
+
+    m_levelTracker->preloadNextLevel();
 }
 
 bool LevelSequence::updateData(bool alwaysUpdateDynObjs) {
@@ -86,6 +90,8 @@ bool LevelSequence::updateData(bool alwaysUpdateDynObjs) {
         } else {
             if (m_levelFinisher->isDone()) {
 
+                // the configuration for the next level was preloaded when this level started, so
+                // only the level objects need to be created here.
                 m_levelTracker->gotoNextLevel();
                 m_levelGroupFcns = m_levelTracker->getLevelGroupFcns(m_surfaceWidth, m_surfaceHeight);
 
@@ -101,6 +107,8 @@ bool LevelSequence::updateData(bool alwaysUpdateDynObjs) {
 
                 saveLevelData();
 
+                m_levelTracker->preloadNextLevel();
+
                 m_levelFinisher->unveilNewLevel();
                 return false;
             }
@@ -214,11 +222,9 @@ bool Graphics::testDepthTexture(levelDrawer::Adaptor inLevelDrawer) {
     depthParameters.farthestDepth = -1.0f;
     depthParameters.widthAtDepth = 2.0f;
     depthParameters.heightAtDepth = 2.0f;
-    std::vector<float> depthMap;
-    inLevelDrawer.drawToBuffer(depthMapRenderDetailsName, modelsTextures, {modelMatrix},
-            2.0f, 2.0f, 200,
-            std::make_shared<renderDetails::ParametersDepthMap>(depthParameters),
-            depthMap);
+    auto depthMapFuture = inLevelDrawer.drawToBufferAsync(depthMapRenderDetailsName, modelsTextures,
+            {modelMatrix}, 2.0f, 2.0f, 200,
+            std::make_shared<renderDetails::ParametersDepthMap>(depthParameters));
 
     levelDrawer::ModelsTextures modelsTextures1{
             std::make_pair<std::shared_ptr<levelDrawer::ModelDescription>, std::shared_ptr<levelDrawer::TextureDescription>>(
@@ -233,13 +239,13 @@ bool Graphics::testDepthTexture(levelDrawer::Adaptor inLevelDrawer) {
     normalParameters.farPlane = levelDrawer::DefaultConfig::farPlane;
     normalParameters.widthAtDepth = 2.0f;
     normalParameters.heightAtDepth = 2.0f;
-    std::vector<float> rawNormalMap;
-    inLevelDrawer.drawToBuffer(normalMapRenderDetailsName, modelsTextures1, {modelMatrix},
-                               2.0f, 2.0f, 200,
-                               std::make_shared<renderDetails::ParametersNormalMap>(normalParameters),
-                               rawNormalMap);
+    auto normalMapFuture = inLevelDrawer.drawToBufferAsync(normalMapRenderDetailsName, modelsTextures1,
+                               {modelMatrix}, 2.0f, 2.0f, 200,
+                               std::make_shared<renderDetails::ParametersNormalMap>(normalParameters));
+
+    std::vector<float> depthMap = depthMapFuture.get();
     std::vector<glm::vec3> normalMap;
-    unFlattenMap(rawNormalMap, normalMap);
+    unFlattenMap(normalMapFuture.get(), normalMap);
 
     float errVal = 0.01f;
     auto cmpDepth = std::function<bool(float, float)>([errVal](float v1, float v2) -> bool {
@@ -24,9 +24,11 @@
 #include <boost/implicit_cast.hpp>
 
 #include "levelTracker/levelTracker.hpp"
+#include "levelTracker/saveDataWriter.hpp"
 #include "levels/basic/level.hpp"
 #include "levels/finisher/types.hpp"
 #include "common.hpp"
+#include "sensorFilter.hpp"
 
 class LevelSequence {
 public:
@@ -35,11 +37,17 @@ public:
     bool needFinisherObjs() { return m_level->isFinished() || m_levelFinisher->isUnveiling(); }
     bool levelStarterRequired() { return m_levelStarter != nullptr; }
 
+    // the data is written to the save file on the save data writer's thread.
     void saveLevelData() {
-        levelTracker::saveGameData(m_gameRequester, m_surfaceWidth, m_surfaceHeight,
+        levelTracker::saveGameData(*m_saveDataWriter, m_surfaceWidth, m_surfaceHeight,
                 m_levelTracker->levelName(), m_level, (m_levelStarter != nullptr));
     }
 
+    // wait for all the save data to be written.
+    void flushSaveData() {
+        m_saveDataWriter->flush();
+    }
+
     void updateAcceleration(float x, float y, float z) {
         if (m_levelStarter) {
             m_levelStarter->updateAcceleration(x, y, z);
@@ -102,6 +110,8 @@ public:
               m_surfaceHeight{surfaceHeight},
               m_gameRequester{std::move(inGameRequester)},
               m_levelDrawer{std::move(inLevelDrawer)},
+              m_saveDataWriter{std::make_shared<levelTracker::SaveDataWriter>(
+                      m_gameRequester->getSaveDataFileName())},
               m_levelTracker{std::make_shared<levelTracker::Loader>(m_gameRequester)},
               m_levelGroupFcns{m_levelTracker->getLevelGroupFcns(m_surfaceWidth, m_surfaceHeight)},
               m_level{m_levelGroupFcns.getLevelFcn(levelDrawer::Adaptor(levelDrawer::LEVEL, m_levelDrawer))},
@@ -111,6 +121,8 @@ public:
         float x, y, z;
         m_level->getLevelFinisherCenter(x, y, z);
         m_levelFinisher = m_levelGroupFcns.getFinisherFcn(levelDrawer::Adaptor(levelDrawer::FINISHER, m_levelDrawer), x, y, z);
+
+        m_levelTracker->preloadNextLevel();
     }
 
 private:
@@ -118,6 +130,7 @@ private:
     uint32_t m_surfaceHeight;
     std::shared_ptr<GameRequester> m_gameRequester;
     std::shared_ptr<levelDrawer::LevelDrawer> m_levelDrawer;
+    std::shared_ptr<levelTracker::SaveDataWriter> m_saveDataWriter;
 
 protected:
     std::shared_ptr<levelTracker::Loader> m_levelTracker;
@@ -144,16 +157,13 @@ public:
 
     void changeRotationAngle(float rotationAngle) {
         m_rotationAngle = rotationAngle;
+        m_accelerationRotation = accelerationRotation(rotationAngle);
     }
 
-    void updateAcceleration(float x, float y, float z) {
-        glm::vec4 acceleration{x, y, z, 1.0f};
-        glm::mat4 rotation = glm::rotate(glm::mat4{1.0f}, glm::radians(m_rotationAngle), glm::vec3{0.0f, 0.0f, 1.0f});
-        acceleration = rotation * acceleration;
-        m_levelSequence->updateAcceleration(
-                acceleration.x/acceleration.w,
-                acceleration.y/acceleration.w,
-                acceleration.z/acceleration.w);
+    // called once per frame with the filtered acceleration (see AccelerationFilter).
+    void updateAcceleration(glm::vec3 const &deviceAcceleration) {
+        glm::vec3 acceleration = m_accelerationRotation * deviceAcceleration;
+        m_levelSequence->updateAcceleration(acceleration.x, acceleration.y, acceleration.z);
     }
 
     void changeLevel(std::string const &level) {
@@ -186,6 +196,10 @@ public:
         return m_levelSequence->saveLevelData();
     }
 
+    void flushSaveData() {
+        m_levelSequence->flushSaveData();
+    }
+
     bool drag(float startX, float startY, float distanceX, float distanceY) {
         return m_levelSequence->drag(startX, startY, distanceX, distanceY);
     }
@@ -205,7 +219,8 @@ public:
             float inRotationAngle)
         : m_gameRequester{std::move(inGameRequester)},
         m_levelSequence{},
-        m_rotationAngle{inRotationAngle}
+        m_rotationAngle{inRotationAngle},
+        m_accelerationRotation{accelerationRotation(inRotationAngle)}
     {}
 
     virtual ~Graphics() = default;
@@ -214,6 +229,7 @@ protected:
     std::shared_ptr<GameRequester> m_gameRequester;
     std::shared_ptr<LevelSequence> m_levelSequence;
     float m_rotationAngle;
+    glm::mat3 m_accelerationRotation;
 
     static float constexpr m_depthTextureNearPlane = 0.1f;
     static float constexpr m_depthTextureFarPlane = 10.0f;
@@ -19,6 +19,7 @@
  */
 #include <unistd.h>
 #include <vector>
+#include <algorithm>
 #include <memory>
 #include <glm/glm.hpp>
 
@@ -62,6 +63,17 @@ glm::mat4 GraphicsVulkan::preTransform() {
     return preTransformRet;
 }
 
+/* The pipeline cache is saved in the same directory as the save data. */
+std::string GraphicsVulkan::pipelineCacheFileName(std::shared_ptr<GameRequester> const &gameRequester) {
+    std::string saveDataFileName = gameRequester->getSaveDataFileName();
+    size_t pos = saveDataFileName.find_last_of('/');
+    if (pos == std::string::npos) {
+        return std::string{"vulkanPipelineCache.bin"};
+    }
+
+    return saveDataFileName.substr(0, pos + 1) + "vulkanPipelineCache.bin";
+}
+
 void GraphicsVulkan::recreateSwapChain(uint32_t width, uint32_t height) {
     VkExtent2D extent = m_swapChain->extent();
 
@@ -85,8 +97,17 @@ void GraphicsVulkan::recreateSwapChain(uint32_t width, uint32_t height) {
     m_surfaceDetails->preTransform = preTransform();
     m_swapChainCommands = std::make_shared<vulkan::SwapChainCommands>(m_swapChain, m_commandPool, m_surfaceDetails->renderPass, m_depthImageView);
 
+    /* the device is idle, so none of the old images are in flight.  The new swap chain might
+     * have a different number of images.
+     */
+    m_imagesInFlight.clear();
+    m_imagesInFlight.resize(m_swapChainCommands->size());
+
     extent = m_swapChain->extent();
     m_levelSequence->notifySurfaceChanged(extent.width, extent.height, m_levelSequence->levelStarterRequired());
+
+    // save any pipelines that had to be created for the new surface.
+    m_device->pipelineCache()->save();
 }
 
 void GraphicsVulkan::cleanupSwapChain() {
@@ -108,11 +129,12 @@ void GraphicsVulkan::cleanupSwapChain() {
 void GraphicsVulkan::initializeCommandBuffers() {
     /* begin recording commands into each comand buffer */
     for (size_t i = 0; i < m_swapChainCommands->size(); i++) {
-        initializeCommandBuffer(i);
+        initializeCommandBuffer(i, m_currentFrame);
     }
 }
 
-void GraphicsVulkan::initializeCommandBuffer(uint32_t cmdBufferIndex) {
+void GraphicsVulkan::initializeCommandBuffer(uint32_t cmdBufferIndex, uint32_t frameIndex)
+{
     VkCommandBuffer commandBuffer = m_swapChainCommands->commandBuffer(cmdBufferIndex);
     VkFramebuffer framebuffer = m_swapChainCommands->frameBuffer(cmdBufferIndex);
 
@@ -120,13 +142,39 @@ void GraphicsVulkan::initializeCommandBuffer(uint32_t cmdBufferIndex) {
     info.cmdBuffer = commandBuffer;
     info.framebuffer = framebuffer;
     info.extent = m_swapChain->extent();
+    info.frameIndex = frameIndex;
 
     m_levelDrawer->draw(info);
 }
 
+void GraphicsVulkan::createFramesInFlight(uint32_t framesInFlight) {
+    framesInFlight = std::max(m_minFramesInFlight, std::min(m_maxFramesInFlight, framesInFlight));
+
+    for (uint32_t i = 0; i < framesInFlight; i++) {
+        m_framesInFlight.push_back(FrameInFlight{vulkan::Semaphore{m_device}, vulkan::Semaphore{m_device},
+                                                 std::make_shared<vulkan::Fence>(m_device)});
+    }
+
+    m_imagesInFlight.resize(m_swapChainCommands->size());
+
+    // each frame in flight reads its own slice of the uniform buffers.
+    m_device->uniformUpdates().setFramesInFlight(framesInFlight);
+}
+
 void GraphicsVulkan::drawFrame() {
-    /* wait for presentation to finish before drawing the next frame.  Avoids a memory leak */
-    vkQueueWaitIdle(m_device->presentQueue());
+    FrameInFlight &frame = m_framesInFlight[m_currentFrame];
+
+    /* wait for the GPU to finish with the last frame that used this frame's semaphores and fence
+     * before reusing them.  With more than one frame in flight, this usually does not block.
+     */
+    if (!frame.inFlightFence->isSignaled()) {
+        m_framePacing.framesBlockedOnGPU++;
+        frame.inFlightFence->wait();
+    }
+
+    // the objects the level drawer removed while this frame was the last one submitted are free
+    // to go now.
+    m_deferredRelease->frameDone(m_currentFrame);
 
     uint32_t imageIndex;
     /* the third parameter is a timeout indicating how much time in nanoseconds we want to
@@ -135,17 +183,9 @@ void GraphicsVulkan::drawFrame() {
      * the program
      */
     VkResult result = vkAcquireNextImageKHR(m_device->logicalDevice().get(), getVkType<>(m_swapChain->swapChain().get()),
-                                            std::numeric_limits<uint64_t>::max(), getVkType<>(m_imageAvailableSemaphore.semaphore().get()),
+                                            std::numeric_limits<uint64_t>::max(), getVkType<>(frame.imageAvailableSemaphore.semaphore().get()),
                                             VK_NULL_HANDLE, &imageIndex);
 
-    //if (maze->isFinished() || levelFinisher->isUnveiling() || texturesChanged) {
-    // The user completed the maze or the textures changed.  If the maze is completed, we need
-    // to display the level finished animation.  Since there are additional objects, we need to
-    // rewrite the command buffer to display the new objects.  If the textures changed, then we
-    // need to update the descriptor sets, so the command buffers need to be rewritten.
-    initializeCommandBuffer(imageIndex);
-    //}
-
     /* If the window surface is no longer compatible with the swap chain, then we need to
      * recreate the swap chain and let the next call draw the image.
      * VK_SUBOPTIMAL_KHR means that the swap chain can still be used to present to the surface
@@ -158,13 +198,35 @@ void GraphicsVulkan::drawFrame() {
         throw std::runtime_error("failed to acquire swap chain image!");
     }
 
+    /* the command buffer for this image might still be in use by a previous frame if the
+     * swap chain handed the images back out of order.  Wait for that frame to finish before
+     * rerecording it.
+     */
+    if (m_imagesInFlight[imageIndex] != nullptr && m_imagesInFlight[imageIndex] != frame.inFlightFence) {
+        m_imagesInFlight[imageIndex]->wait();
+    }
+    m_imagesInFlight[imageIndex] = frame.inFlightFence;
+
+    if (m_lastSubmittedFrame != nullptr && !m_lastSubmittedFrame->isSignaled()) {
+        // we are recording this frame while the GPU is still working on the previous one.
+        m_framePacing.framesOverlappedWithGPU++;
+    }
+
+    //if (maze->isFinished() || levelFinisher->isUnveiling() || texturesChanged) {
+    // The user completed the maze or the textures changed.  If the maze is completed, we need
+    // to display the level finished animation.  Since there are additional objects, we need to
+    // rewrite the command buffer to display the new objects.  If the textures changed, then we
+    // need to update the descriptor sets, so the command buffers need to be rewritten.
+    initializeCommandBuffer(imageIndex, static_cast<uint32_t>(m_currentFrame));
+    //}
+
     VkSubmitInfo submitInfo = {};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
     /* wait for the semaphore before writing to the color attachment.  This means that we
      * could start executing the vertex shader before the image is available.
      */
-    VkSemaphore waitSemaphores[] = {getVkType<>(m_imageAvailableSemaphore.semaphore().get())/*, m_shadowsAvailableForRead.semaphore().get() */};
+    VkSemaphore waitSemaphores[] = {getVkType<>(frame.imageAvailableSemaphore.semaphore().get())/*, m_shadowsAvailableForRead.semaphore().get() */};
     VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT /*, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT */};
     submitInfo.waitSemaphoreCount = 1;//2;
     submitInfo.pWaitSemaphores = waitSemaphores;
@@ -176,16 +238,22 @@ void GraphicsVulkan::drawFrame() {
     submitInfo.pCommandBuffers = &commandBuffer;
 
     /* indicate which semaphore to signal when execution is done */
-    VkSemaphore signalSemaphores[] = {getVkType<>(m_renderFinishedSemaphore.semaphore().get())/*, m_shadowsAvailableForWrite.semaphore().get()*/};
+    VkSemaphore signalSemaphores[] = {getVkType<>(frame.renderFinishedSemaphore.semaphore().get())/*, m_shadowsAvailableForWrite.semaphore().get()*/};
     submitInfo.signalSemaphoreCount = 1;//2;
     submitInfo.pSignalSemaphores = signalSemaphores;
 
-    /* the last parameter is a fence to indicate when execution is done, but we are using
-     * semaphores instead so pass VK_NULL_HANDLE
+    /* the last parameter is a fence to indicate when execution is done.  Reset it just before
+     * submitting so that it is never left unsignaled without work that will signal it.
      */
-    if (vkQueueSubmit(m_device->graphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+    frame.inFlightFence->reset();
+    if (vkQueueSubmit(m_device->graphicsQueue(), 1, &submitInfo,
+            getVkType<>(frame.inFlightFence->fence().get())) != VK_SUCCESS) {
         throw std::runtime_error("failed to submit draw command buffer!");
     }
+    m_lastSubmittedFrame = frame.inFlightFence;
+    m_deferredRelease->frameSubmitted(m_currentFrame);
+    m_framePacing.framesSubmitted++;
+    m_currentFrame = (m_currentFrame + 1) % m_framesInFlight.size();
 
     /* submit the image back to the swap chain to have it eventually show up on the screen */
     VkPresentInfoKHR presentInfo = {};
@@ -221,11 +289,6 @@ void GraphicsVulkan::drawFrame() {
     } else if (result != VK_SUCCESS) {
         throw std::runtime_error("failed to present swap chain image!");
     }
-
-    result = vkQueueWaitIdle(m_device->presentQueue());
-    if (result != VK_SUCCESS) {
-        throw std::runtime_error("Failed to wait on present queue.");
-    }
 }
 
 void GraphicsVulkan::prepareDepthResources() {
@@ -27,29 +27,50 @@
 
 class GraphicsVulkan : public Graphics {
 public:
+    /* Keeps track of how well the CPU and GPU overlap.  A frame whose recording started while
+     * the GPU was still executing the previous frame overlapped the GPU.  A frame that had to
+     * wait on its fence was blocked by the GPU because all the frames in flight were in use.
+     */
+    struct FramePacing {
+        uint64_t framesSubmitted;
+        uint64_t framesOverlappedWithGPU;
+        uint64_t framesBlockedOnGPU;
+    };
+
+    static uint32_t constexpr m_minFramesInFlight = 1;
+    static uint32_t constexpr m_maxFramesInFlight = vulkan::maxFramesInFlight;
+    static uint32_t constexpr m_defaultFramesInFlight = 2;
+
     GraphicsVulkan(std::shared_ptr<WindowType> window,
             bool shadowsEnabled,
             std::shared_ptr<GameRequester> inGameRequester,
-            float rotationAngle)
+            float rotationAngle,
+            uint32_t framesInFlight = m_defaultFramesInFlight)
             : Graphics{std::move(inGameRequester), rotationAngle},
               m_instance{new vulkan::Instance(std::move(window))},
-              m_device{new vulkan::Device{m_instance}},
+              m_device{new vulkan::Device{m_instance, pipelineCacheFileName(m_gameRequester)}},
               m_swapChain{new vulkan::SwapChain{m_device}},
               m_surfaceDetails{std::make_shared<vulkan::SurfaceDetails>(
                       vulkan::SurfaceDetails{vulkan::RenderPass::createRenderPass(m_device, m_swapChain),
                       preTransform(), m_swapChain->extent().width, m_swapChain->extent().height})},
               m_commandPool{new vulkan::CommandPool{m_device}},
+              m_stagingRing{std::make_shared<vulkan::StagingRing>(m_device, m_commandPool)},
+              m_deferredRelease{std::make_shared<vulkan::DeferredRelease>(m_maxFramesInFlight)},
               m_depthImageView{new vulkan::ImageView{vulkan::ImageFactory::createDepthImage(m_swapChain),
                                                      VK_IMAGE_ASPECT_DEPTH_BIT}},
               m_swapChainCommands{new vulkan::SwapChainCommands{m_swapChain, m_commandPool, m_surfaceDetails->renderPass, m_depthImageView}},
-              m_imageAvailableSemaphore{m_device},
-              m_renderFinishedSemaphore{m_device},
+              m_framesInFlight{},
+              m_imagesInFlight{},
+              m_currentFrame{0},
+              m_lastSubmittedFrame{},
+              m_framePacing{0, 0, 0},
               m_renderLoader{std::make_shared<RenderLoaderVulkan>(m_device)},
-              m_levelDrawer{std::make_shared<levelDrawer::LevelDrawerVulkan>(levelDrawer::NeededForDrawingVulkan{m_device, m_commandPool},
+              m_levelDrawer{std::make_shared<levelDrawer::LevelDrawerVulkan>(levelDrawer::NeededForDrawingVulkan{m_device, m_commandPool, m_stagingRing, m_deferredRelease},
                       m_surfaceDetails, m_renderLoader,
                       shadowsEnabled ? shadowsChainingRenderDetailsName : objectNoShadowsRenderDetailsName,
                       m_gameRequester)}
     {
+        createFramesInFlight(framesInFlight);
         prepareDepthResources();
 
         if (!testDepthTexture(levelDrawer::Adaptor(levelDrawer::LEVEL, m_levelDrawer))) {
@@ -59,6 +80,11 @@ public:
 
         m_levelSequence = std::make_shared<LevelSequence>(
                 m_gameRequester, m_levelDrawer, m_swapChain->extent().width, m_swapChain->extent().height);
+
+        /* save the pipeline cache now too since Android might kill the app without running the
+         * destructor.
+         */
+        m_device->pipelineCache()->save();
     }
 
     void initThread() override { }
@@ -73,6 +99,8 @@ public:
 
     void recreateSwapChain(uint32_t width, uint32_t height) override ;
 
+    FramePacing const &framePacing() { return m_framePacing; }
+
     GraphicsDescription graphicsDescription() override {
         auto devGraphicsDescription = m_device->properties();
         return GraphicsDescription{std::string{"Vulkan"},
@@ -84,33 +112,56 @@ public:
     ~GraphicsVulkan() override {
         if (m_device) {
             vkDeviceWaitIdle(m_device->logicalDevice().get());
+
+            // keep the pipelines compiled during this run for the next time the game starts.
+            m_device->pipelineCache()->save();
         }
     }
 protected:
     glm::mat4 preTransform();
 
+    static std::string pipelineCacheFileName(std::shared_ptr<GameRequester> const &gameRequester);
+
 private:
     std::shared_ptr<vulkan::Instance> m_instance;
     std::shared_ptr<vulkan::Device> m_device;
     std::shared_ptr<vulkan::SwapChain> m_swapChain;
     std::shared_ptr<vulkan::SurfaceDetails> m_surfaceDetails;
     std::shared_ptr<vulkan::CommandPool> m_commandPool;
+    std::shared_ptr<vulkan::StagingRing> m_stagingRing;
+    std::shared_ptr<vulkan::DeferredRelease> m_deferredRelease;
     std::shared_ptr<vulkan::ImageView> m_depthImageView;
     std::shared_ptr<vulkan::SwapChainCommands> m_swapChainCommands;
 
-    /* use semaphores to coordinate the rendering and presentation. Could also use fences
-     * but fences are more for coordinating in our program itself and not for internal
-     * Vulkan coordination of resource usage.
+    /* use semaphores to coordinate the rendering and presentation and a fence to tell our
+     * program when the GPU is done with the frame.  Each frame in flight gets its own set so that
+     * we can record and submit the next frame while the GPU is still working on the previous
+     * one.
+     */
+    struct FrameInFlight {
+        vulkan::Semaphore imageAvailableSemaphore;
+        vulkan::Semaphore renderFinishedSemaphore;
+        std::shared_ptr<vulkan::Fence> inFlightFence;
+    };
+
+    std::vector<FrameInFlight> m_framesInFlight;
+
+    /* The fence for the frame that last used the swap chain image (and its command buffer).
+     * Used to avoid rerecording a command buffer that the GPU is still using when the
+     * swap chain returns images out of order or has fewer images than we have frames in flight.
      */
-    vulkan::Semaphore m_imageAvailableSemaphore;
-    vulkan::Semaphore m_renderFinishedSemaphore;
+    std::vector<std::shared_ptr<vulkan::Fence>> m_imagesInFlight;
+    size_t m_currentFrame;
+    std::shared_ptr<vulkan::Fence> m_lastSubmittedFrame;
+    FramePacing m_framePacing;
 
     std::shared_ptr<RenderLoaderVulkan> m_renderLoader;
     std::shared_ptr<levelDrawer::LevelDrawerVulkan> m_levelDrawer;
 
+    void createFramesInFlight(uint32_t framesInFlight);
     void cleanupSwapChain();
     void initializeCommandBuffers();
-    void initializeCommandBuffer(uint32_t cmdBufferIndex);
+    void initializeCommandBuffer(uint32_t cmdBufferIndex, uint32_t frameIndex);
     void prepareDepthResources();
 };
 
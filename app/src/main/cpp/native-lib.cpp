@@ -18,6 +18,7 @@
  *
  */
 
+#include <algorithm>
 #include <jni.h>
 #include <android/native_window.h>
 #include <android/native_window_jni.h>
@@ -40,7 +41,9 @@ Java_com_quasar_cerulean_amazinglabyrinth_Draw_startGame(
         jfloat jrotationAngle,
         jboolean jtryVulkan,
         jboolean jtryVulkanReadFromFile,
-        jboolean juseShadows)
+        jboolean juseShadows,
+        jint jmaxFrameRate,
+        jfloat jdisplayRefreshRate)
 {
     std::string saveDataFile;
     try {
@@ -88,7 +91,11 @@ Java_com_quasar_cerulean_amazinglabyrinth_Draw_startGame(
             // devices to test it on...
             tryVulkan = false;
         }
-        GameWorker worker{surface, gameRequester, true, tryVulkan, useShadows, jrotationAngle};
+        FrameTuning frameTuning{};
+        frameTuning.maxFrameRate = static_cast<uint32_t>(std::max(jmaxFrameRate, 1));
+        frameTuning.displayRefreshRate = jdisplayRefreshRate;
+        GameWorker worker{surface, gameRequester, true, tryVulkan, useShadows, jrotationAngle,
+                          SensorTuning{}, frameTuning};
         worker.drawingLoop();
     } catch (std::runtime_error &e) {
         gameRequester->sendError(e.what());
@@ -108,8 +115,7 @@ Java_com_quasar_cerulean_amazinglabyrinth_Draw_tellDrawerSendSaveData(
         JNIEnv *,
         jclass)
 {
-    auto ev = std::make_shared<SaveLevelDataEvent>();
-    gameFromGuiChannel().sendEvent(ev);
+    gameFromGuiChannel().sendEvent(SaveLevelDataEvent{});
 }
 
 extern "C" JNIEXPORT void JNICALL
@@ -120,8 +126,8 @@ Java_com_quasar_cerulean_amazinglabyrinth_Draw_tellDrawerSurfaceChanged(
         jint jheight,
         jfloat jrotationAngle)
 {
-    auto ev = std::make_shared<SurfaceChangedEvent>(jwidth, jheight, jrotationAngle);
-    gameFromGuiChannel().sendEvent(ev);
+    gameFromGuiChannel().sendEvent(SurfaceChangedEvent{
+            static_cast<uint32_t>(jwidth), static_cast<uint32_t>(jheight), jrotationAngle});
 }
 
 extern "C" JNIEXPORT void JNICALL
@@ -135,8 +141,7 @@ Java_com_quasar_cerulean_amazinglabyrinth_Draw_tellDrawerSwitchLevel(
     std::string level(clevel);
     env->ReleaseStringUTFChars(jlevel, clevel);
 
-    auto ev = std::make_shared<LevelChangedEvent>(std::move(level));
-    gameFromGuiChannel().sendEvent(ev);
+    gameFromGuiChannel().sendEvent(LevelChangedEvent{std::move(level)});
 }
 
 extern "C" JNIEXPORT void JNICALL
@@ -148,8 +153,7 @@ Java_com_quasar_cerulean_amazinglabyrinth_Draw_tellDrawerDragOccurred(
         jfloat jDistanceX,
         jfloat jDistanceY)
 {
-    auto ev = std::make_shared<DragEvent>(jStartX, jStartY, jDistanceX, jDistanceY);
-    gameFromGuiChannel().sendEvent(ev);
+    gameFromGuiChannel().sendEvent(DragEvent{jStartX, jStartY, jDistanceX, jDistanceY});
 }
 
 extern "C" JNIEXPORT void JNICALL
@@ -159,8 +163,7 @@ Java_com_quasar_cerulean_amazinglabyrinth_Draw_tellDrawerDragEnded(
         jfloat jPositionX,
         jfloat jPositionY)
 {
-    auto ev = std::make_shared<DragEndedEvent>(jPositionX, jPositionY);
-    gameFromGuiChannel().sendEvent(ev);
+    gameFromGuiChannel().sendEvent(DragEndedEvent{jPositionX, jPositionY});
 }
 
 extern "C" JNIEXPORT void JNICALL
@@ -170,6 +173,14 @@ Java_com_quasar_cerulean_amazinglabyrinth_Draw_tellDrawerTapOccurred(
         jfloat jPositionX,
         jfloat jPositionY)
 {
-    auto ev = std::make_shared<TapEvent>(jPositionX, jPositionY);
-    gameFromGuiChannel().sendEvent(ev);
+    gameFromGuiChannel().sendEvent(TapEvent{jPositionX, jPositionY});
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_quasar_cerulean_amazinglabyrinth_Draw_tellDrawerThermalStatusChanged(
+        JNIEnv *,
+        jclass,
+        jint jstatus)
+{
+    gameFromGuiChannel().sendEvent(ThermalStatusChangedEvent{static_cast<ThermalStatus>(jstatus)});
 }
@@ -1,4 +1,3 @@
-#include <stdexcept>
 /**
  * Copyright 2019 Cerulean Quasar. All Rights Reserved.
  *
@@ -19,58 +18,115 @@
  *
  */
 #include <limits>
+#include <stdexcept>
+#include <cstring>
 #include <unistd.h>
 #include <fcntl.h>
 
 #include "random.hpp"
 
-Random::~Random() {
-    if (fd != -1) {
-        close(fd);
+namespace {
+    // used to expand a 64 bit seed into the 256 bits of state needed by xoshiro256**.
+    uint64_t splitMix64(uint64_t &x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
     }
 }
 
-template<typename T> T Random::get() {
-    if (fd == -1) {
-        fd = open("/dev/urandom", O_RDONLY);
+Random::Random() : m_state{} {
+    reseed();
+}
+
+Random::Random(uint64_t inSeed) : m_state{} {
+    seed(inSeed);
+}
+
+void Random::seed(uint64_t inSeed) {
+    for (auto &state : m_state) {
+        state = splitMix64(inSeed);
     }
+}
 
+void Random::reseed() {
+    int fd = open("/dev/urandom", O_RDONLY);
     if (fd == -1) {
         throw std::runtime_error("Could not open /dev/urandom");
     }
 
-    T random;
-
-    ssize_t readlen = read(fd, &random, sizeof (random));
+    ssize_t readlen = read(fd, m_state, sizeof (m_state));
+    close(fd);
 
-    if (readlen != sizeof (random)) {
+    if (readlen != sizeof (m_state)) {
         throw std::runtime_error("Could not read enough random data");
     }
 
-    return random;
+    // the state must not be all zeros or the generator only returns 0.
+    if ((m_state[0] | m_state[1] | m_state[2] | m_state[3]) == 0) {
+        seed(0);
+    }
 }
 
-unsigned int Random::getUInt(unsigned int lowerBound, unsigned int upperBound) {
-    unsigned int range = upperBound - lowerBound + 1;
-    unsigned int too_big = std::numeric_limits<unsigned int>::max() / range * range;
+/* Lemire's nearly divisionless method: multiply the random number by the range and take the upper
+ * 32 bits.  The lower 32 bits tell us if the result is in a part of the range that would be
+ * over represented.  Only in that case (which is rare for small ranges) do we need to do a division
+ * and try again.
+ */
+uint32_t Random::getBounded(uint32_t range) {
+    uint64_t m = (next() >> 32) * static_cast<uint64_t>(range);
+    auto low = static_cast<uint32_t>(m);
+    if (low < range) {
+        uint32_t threshold = static_cast<uint32_t>(-range) % range;
+        while (low < threshold) {
+            m = (next() >> 32) * static_cast<uint64_t>(range);
+            low = static_cast<uint32_t>(m);
+        }
+    }
+    return static_cast<uint32_t>(m >> 32);
+}
 
-    unsigned int random;
+unsigned int Random::getUInt(unsigned int lowerBound, unsigned int upperBound) {
+    static_assert(sizeof (unsigned int) == sizeof (uint32_t), "unsigned int must be 32 bits");
 
-    do {
-        random = get<unsigned int>();
-    } while (random >= too_big);
+    uint32_t range = upperBound - lowerBound + 1;
+    if (range == 0) {
+        // the whole range of unsigned int was requested.
+        return static_cast<unsigned int>(next() >> 32);
+    }
 
-    return random % range + lowerBound;
+    return getBounded(range) + lowerBound;
 }
 
 float Random::getFloat(float lowerBound, float upperBound) {
     float range = upperBound - lowerBound;
     if (range <= 0) {
-        throw std::runtime_error("Could not read enough random data.");
+        throw std::runtime_error("Invalid range for random float.");
+    }
+
+    // use the upper 24 bits so that every value is exactly representable as a float in [0, 1).
+    float rc = static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+    return rc * range + lowerBound;
+}
+
+void Random::fill(std::vector<unsigned int> &values, unsigned int lowerBound, unsigned int upperBound) {
+    uint32_t range = upperBound - lowerBound + 1;
+    for (auto &value : values) {
+        value = range == 0 ? static_cast<unsigned int>(next() >> 32) : getBounded(range) + lowerBound;
+    }
+}
+
+void Random::fill(void *buffer, size_t size) {
+    auto bytes = static_cast<unsigned char *>(buffer);
+    while (size >= sizeof (uint64_t)) {
+        uint64_t value = next();
+        memcpy(bytes, &value, sizeof (value));
+        bytes += sizeof (value);
+        size -= sizeof (value);
     }
 
-    auto random = get<unsigned int>();
-    double rc = random;
-    rc = rc / std::numeric_limits<unsigned int>::max() * range + lowerBound;
-    return static_cast<float>(rc);
+    if (size > 0) {
+        uint64_t value = next();
+        memcpy(bytes, &value, size);
+    }
 }
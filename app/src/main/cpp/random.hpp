@@ -19,14 +19,62 @@
  */
 #ifndef AMAZING_LABYRINTH_RANDOM_HPP
 #define AMAZING_LABYRINTH_RANDOM_HPP
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/* Pseudo random number generator using the xoshiro256** algorithm.  The state is seeded once from
+ * /dev/urandom (or from the seed passed in, for reproducible sequences, e.g. for replays) and all
+ * numbers after that are generated without making any system calls.
+ */
 class Random {
-private:
-    int fd;
-    template<typename T> T get();
 public:
-    Random() : fd(-1) { }
+    Random();
+    explicit Random(uint64_t seed);
+
+    // seed the generator so that it produces the same sequence of numbers for the same seed.
+    void seed(uint64_t seed);
+
+    // seed the generator from /dev/urandom.
+    void reseed();
+
+    // the next 64 bits from the generator.
+    uint64_t next() {
+        uint64_t const result = rotl(m_state[1] * 5, 7) * 9;
+        uint64_t const t = m_state[1] << 17;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+
+        m_state[2] ^= t;
+
+        m_state[3] = rotl(m_state[3], 45);
+
+        return result;
+    }
+
+    // returns a number in [0, range).  range must not be 0.
+    uint32_t getBounded(uint32_t range);
+
+    // returns a number in [lowerBound, upperBound].
     unsigned int getUInt(unsigned int lowerBound, unsigned int upperBound);
+
+    // returns a number in [lowerBound, upperBound).
     float getFloat(float lowerBound, float upperBound);
-    ~Random();
+
+    // fill values with numbers in [lowerBound, upperBound].
+    void fill(std::vector<unsigned int> &values, unsigned int lowerBound, unsigned int upperBound);
+
+    // fill the buffer with random bytes.
+    void fill(void *buffer, size_t size);
+
+private:
+    uint64_t m_state[4];
+
+    static inline uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
 };
-#endif
\ No newline at end of file
+#endif
@@ -161,9 +161,9 @@ namespace darkChaining {
             uint32_t /* unused matrix ID */,
             levelDrawer::CommonObjectDataList const &commonObjectDataList,
             levelDrawer::DrawObjectTableGList const &drawObjTableList,
-            std::set<levelDrawer::ZValueReference> const &,
-            std::set<levelDrawer::ZValueReference> const &levelZValues,
-            std::set<levelDrawer::ZValueReference> const &)
+            levelDrawer::ZValueReferences const &,
+            levelDrawer::ZValueReferences const &levelZValues,
+            levelDrawer::ZValueReferences const &)
     {
         // get the shadows common object data
         auto codLevel = dynamic_cast<CommonObjectDataGL*>(
@@ -194,8 +194,8 @@ namespace darkChaining {
             uint32_t /* unused model matrix ID */,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs)
     {
         // get the shadows common object data
         auto cod = dynamic_cast<CommonObjectDataGL*>(commonObjectData.get());
@@ -78,6 +78,14 @@ namespace darkChaining {
             }
         }
 
+        glm::mat4 normalMatrix(uint32_t id) override {
+            if (id == renderDetails::MODEL_MATRIX_ID_MAIN) {
+                return m_mainDOD->normalMatrix(id);
+            } else {
+                return m_shadowsDOD->normalMatrix(id);
+            }
+        }
+
         void update(glm::mat4 const &modelMatrix) override {
             m_mainDOD->update(modelMatrix);
             m_shadowsDOD->update(modelMatrix);
@@ -120,16 +128,16 @@ namespace darkChaining {
                 uint32_t modelMatrixID,
                 levelDrawer::CommonObjectDataList const &commonObjectDataList,
                 levelDrawer::DrawObjectTableGList const &drawObjTableList,
-                std::set<levelDrawer::ZValueReference> const &starterZValues,
-                std::set<levelDrawer::ZValueReference> const &levelZValues,
-                std::set<levelDrawer::ZValueReference> const &finisherZValues) override;
+                levelDrawer::ZValueReferences const &starterZValues,
+                levelDrawer::ZValueReferences const &levelZValues,
+                levelDrawer::ZValueReferences const &finisherZValues) override;
 
         void draw(
                 uint32_t modelMatrixID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs) override;
 
         RenderDetailsGL(char const *name, bool useIntSurface, uint32_t inWidth, uint32_t inHeight)
                 : renderDetails::RenderDetailsGL{inWidth, inHeight, useIntSurface},
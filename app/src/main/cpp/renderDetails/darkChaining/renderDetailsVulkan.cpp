@@ -111,9 +111,9 @@ namespace darkChaining {
             size_t /* descriptor set ID, not used */,
             levelDrawer::CommonObjectDataList const &commonObjectDataList,
             levelDrawer::DrawObjectTableVulkanList const &drawObjTableList,
-            std::set<levelDrawer::ZValueReference> const &/* starter Z Value references - unused */,
-            std::set<levelDrawer::ZValueReference> const &levelZValues,
-            std::set<levelDrawer::ZValueReference> const &/* finisher Z Value references - unused */)
+            levelDrawer::ZValueReferences const &/* starter Z Value references - unused */,
+            levelDrawer::ZValueReferences const &levelZValues,
+            levelDrawer::ZValueReferences const &/* finisher Z Value references - unused */)
     {
         // check to see if shadows need to be rendered...
         auto cod = dynamic_cast<CommonObjectDataVulkan *>(commonObjectDataList[levelDrawer::ObjectType::LEVEL].get());
@@ -163,7 +163,7 @@ namespace darkChaining {
                     commonObjectDataList[levelDrawer::ObjectType::LEVEL],
                     drawObjTableList[levelDrawer::ObjectType::LEVEL],
                     levelZValues.begin(), levelZValues.end(),
-                    nameString()); // only pay attention to dark chaining draw objects.
+                    id()); // only pay attention to dark chaining draw objects.
 
             vkCmdEndRenderPass(commandBuffer);
         }
@@ -177,9 +177,9 @@ namespace darkChaining {
             size_t /* unused descriptor set ID */,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-            std::string const &)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs,
+            boost::optional<renderDetails::RenderDetailsID> const &)
     {
         m_darkObjectRenderDetails->addDrawCmdsToCommandBuffer(
                 commandBuffer, renderDetails::MODEL_MATRIX_ID_MAIN /* main render details ID */,
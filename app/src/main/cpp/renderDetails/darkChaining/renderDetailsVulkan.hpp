@@ -105,8 +105,8 @@ namespace darkChaining {
     public:
         bool hasTexture() override { return m_mainDrawObjectData->hasTexture(); }
 
-        std::shared_ptr<vulkan::Buffer> const &bufferModelMatrix() override {
-            return m_mainDrawObjectData->bufferModelMatrix();
+        std::shared_ptr<vulkan::UniformSlot> const &uniformSlotModelMatrix() override {
+            return m_mainDrawObjectData->uniformSlotModelMatrix();
         }
 
         glm::mat4 modelMatrix(uint32_t id) override {
@@ -150,6 +150,15 @@ namespace darkChaining {
             }
         }
 
+        uint32_t dynamicOffset(uint32_t id) override {
+            switch (id) {
+                case 0:
+                    return m_mainDrawObjectData->dynamicOffset(id);
+                default:
+                    return m_shadowsDrawObjectsData[id-1]->dynamicOffset(id > 0 ? 1 : 0);
+            }
+        }
+
         DrawObjectDataVulkan(
                 std::shared_ptr<renderDetails::DrawObjectDataVulkan> inMainDrawObjectData,
                 std::array<std::shared_ptr<renderDetails::DrawObjectDataVulkan>, numberShadowMaps> inShadowsDrawObjectsData)
@@ -198,18 +207,18 @@ namespace darkChaining {
                 size_t /* descriptor set ID, not used */,
                 levelDrawer::CommonObjectDataList const &commonObjectDataList,
                 levelDrawer::DrawObjectTableVulkanList const &drawObjTableList,
-                std::set<levelDrawer::ZValueReference> const &starterZValues,
-                std::set<levelDrawer::ZValueReference> const &levelZValues,
-                std::set<levelDrawer::ZValueReference> const &finisherZValues) override;
+                levelDrawer::ZValueReferences const &starterZValues,
+                levelDrawer::ZValueReferences const &levelZValues,
+                levelDrawer::ZValueReferences const &finisherZValues) override;
 
         void addDrawCmdsToCommandBuffer(
                 VkCommandBuffer const &commandBuffer,
                 size_t descriptorSetID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-                std::string const &renderDetailsName) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs,
+                boost::optional<renderDetails::RenderDetailsID> const &renderDetailsID) override;
 
         std::shared_ptr<vulkan::Device> const &device() override { return m_darkObjectRenderDetails->device(); }
 
@@ -110,10 +110,9 @@ namespace darkObject {
         return std::move(ref);
     }
 
-    void loadTexture(CommonObjectDataGL const *cod, GLuint programID, int activeTexture, char const *textureVarName, int imageID) {
+    void loadTexture(CommonObjectDataGL const *cod, renderDetails::GLProgram &program, int activeTexture, char const *textureVarName, int imageID) {
         auto &fb = cod->darkFramebuffer(imageID);
-        auto textureID = glGetUniformLocation(programID, textureVarName);
-        checkGraphicsError();
+        auto textureID = program.uniformLocation(textureVarName);
         glActiveTexture(activeTexture);
         checkGraphicsError();
         glBindTexture(GL_TEXTURE_2D, fb->depthImage());
@@ -126,15 +125,13 @@ namespace darkObject {
             uint32_t modelMatrixID,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs)
     {
         glCullFace(GL_BACK);
         checkGraphicsError();
 
-        GLuint textureProgramID = m_textureProgram->programID();
-        GLuint colorProgramID = m_colorProgram->programID();
-        GLuint programID = textureProgramID;
+        renderDetails::GLProgram *program = nullptr;
         GLint MatrixID = -1;
         GLint normalMatrixID = -1;
         GLint textureID = -1;
@@ -148,103 +145,88 @@ namespace darkObject {
             auto &drawObj = drawObjTable->drawObject(it->drawObjectReference);
             auto &modelData = drawObj->modelData();
             auto &textureData = drawObj->textureData();
-            if (it == beginZValRefs ||
-                (programID == textureProgramID && !textureData) ||
-                    (programID == colorProgramID && textureData)) {
-                programID = textureData ? textureProgramID : colorProgramID;
-                glUseProgram(programID);
+            renderDetails::GLProgram *nextProgram = textureData ? m_textureProgram.get() : m_colorProgram.get();
+            if (program != nextProgram) {
+                program = nextProgram;
+                glUseProgram(program->programID());
                 checkGraphicsError();
 
                 auto projView = cod->getProjViewForLevel();
 
                 // the projection matrix * the view matrix
-                MatrixID = glGetUniformLocation(programID, "projView");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("projView");
                 glm::mat4 projTimesView = projView.first * projView.second;
                 glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projTimesView[0][0]);
                 checkGraphicsError();
 
                 // the projection matrix * the view matrix from the light source point of view (Ball)
                 auto projViewLightBall = projView.first * cod->getViewLightSource(0, CommonObjectDataGL::up);
-                MatrixID = glGetUniformLocation(programID, "projViewLightBallUp");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("projViewLightBallUp");
                 glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projViewLightBall[0][0]);
                 checkGraphicsError();
 
                 projViewLightBall = projView.first * cod->getViewLightSource(0, CommonObjectDataGL::right);
-                MatrixID = glGetUniformLocation(programID, "projViewLightBallRight");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("projViewLightBallRight");
                 glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projViewLightBall[0][0]);
                 checkGraphicsError();
 
                 projViewLightBall = projView.first * cod->getViewLightSource(0, CommonObjectDataGL::down);
-                MatrixID = glGetUniformLocation(programID, "projViewLightBallDown");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("projViewLightBallDown");
                 glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projViewLightBall[0][0]);
                 checkGraphicsError();
 
                 projViewLightBall = projView.first * cod->getViewLightSource(0, CommonObjectDataGL::left);
-                MatrixID = glGetUniformLocation(programID, "projViewLightBallLeft");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("projViewLightBallLeft");
                 glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projViewLightBall[0][0]);
                 checkGraphicsError();
 
-                GLint lightBallPosID = glGetUniformLocation(programID, "lightPosBall");
-                checkGraphicsError();
+                GLint lightBallPosID = program->uniformLocation("lightPosBall");
                 glm::vec3 lightBallPos = cod->getLightSource(0);
                 glUniform3fv(lightBallPosID, 1, &lightBallPos[0]);
                 checkGraphicsError();
 
                 // the projection matrix * the view matrix from the light source point of view (Hole)
                 auto projViewLight = projView.first * cod->getViewLightSource(1, CommonObjectDataGL::up);
-                MatrixID = glGetUniformLocation(programID, "projViewLightHoleUp");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("projViewLightHoleUp");
                 glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projViewLight[0][0]);
                 checkGraphicsError();
 
                 projViewLight = projView.first * cod->getViewLightSource(1, CommonObjectDataGL::right);
-                MatrixID = glGetUniformLocation(programID, "projViewLightHoleRight");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("projViewLightHoleRight");
                 glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projViewLight[0][0]);
                 checkGraphicsError();
 
                 projViewLight = projView.first * cod->getViewLightSource(1, CommonObjectDataGL::down);
-                MatrixID = glGetUniformLocation(programID, "projViewLightHoleDown");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("projViewLightHoleDown");
                 glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projViewLight[0][0]);
                 checkGraphicsError();
 
                 projViewLight = projView.first * cod->getViewLightSource(1, CommonObjectDataGL::left);
-                MatrixID = glGetUniformLocation(programID, "projViewLightHoleLeft");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("projViewLightHoleLeft");
                 glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projViewLight[0][0]);
                 checkGraphicsError();
 
-                GLint lightPosID = glGetUniformLocation(programID, "lightPosHole");
-                checkGraphicsError();
+                GLint lightPosID = program->uniformLocation("lightPosHole");
                 glm::vec3 lightPos = cod->getLightSource(1);
                 glUniform3fv(lightPosID, 1, &lightPos[0]);
                 checkGraphicsError();
 
                 // Dark maps
-                loadTexture(cod, programID, GL_TEXTURE0, "texDarkMap0", 0);
-                loadTexture(cod, programID, GL_TEXTURE1, "texDarkMap1", 1);
-                loadTexture(cod, programID, GL_TEXTURE2, "texDarkMap2", 2);
-                loadTexture(cod, programID, GL_TEXTURE3, "texDarkMap3", 3);
-                loadTexture(cod, programID, GL_TEXTURE4, "texDarkMap4", 4);
-                loadTexture(cod, programID, GL_TEXTURE5, "texDarkMap5", 5);
-                loadTexture(cod, programID, GL_TEXTURE6, "texDarkMap6", 6);
-                loadTexture(cod, programID, GL_TEXTURE7, "texDarkMap7", 7);
-
-                MatrixID = glGetUniformLocation(programID, "model");
-                checkGraphicsError();
+                loadTexture(cod, *program, GL_TEXTURE0, "texDarkMap0", 0);
+                loadTexture(cod, *program, GL_TEXTURE1, "texDarkMap1", 1);
+                loadTexture(cod, *program, GL_TEXTURE2, "texDarkMap2", 2);
+                loadTexture(cod, *program, GL_TEXTURE3, "texDarkMap3", 3);
+                loadTexture(cod, *program, GL_TEXTURE4, "texDarkMap4", 4);
+                loadTexture(cod, *program, GL_TEXTURE5, "texDarkMap5", 5);
+                loadTexture(cod, *program, GL_TEXTURE6, "texDarkMap6", 6);
+                loadTexture(cod, *program, GL_TEXTURE7, "texDarkMap7", 7);
 
-                normalMatrixID = glGetUniformLocation(programID, "normalMatrix");
-                checkGraphicsError();
+                MatrixID = program->uniformLocation("model");
+
+                normalMatrixID = program->uniformLocation("normalMatrix");
 
                 if (textureData) {
-                    textureID = glGetUniformLocation(programID, "texSampler");
-                    checkGraphicsError();
+                    textureID = program->uniformLocation("texSampler");
                 }
             }
 
@@ -263,11 +245,11 @@ namespace darkObject {
             glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &modelMatrix[0][0]);
             checkGraphicsError();
 
-            glm::mat4 normalMatrix = glm::transpose(glm::inverse(modelMatrix));
+            auto normalMatrix = objData->normalMatrix(modelMatrixID);
             glUniformMatrix4fv(normalMatrixID, 1, GL_FALSE, &normalMatrix[0][0]);
             checkGraphicsError();
 
-            drawVertices(programID, modelData);
+            drawVertices(*program, modelData);
         }
     }
 
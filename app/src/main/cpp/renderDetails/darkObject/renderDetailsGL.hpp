@@ -91,19 +91,26 @@ namespace darkObject {
             return m_modelMatrix;
         }
 
+        glm::mat4 normalMatrix(uint32_t) override {
+            return m_normalMatrix;
+        }
+
         void update(glm::mat4 const &modelMatrix) override {
             m_modelMatrix = modelMatrix;
+            m_normalMatrix = glm::transpose(glm::inverse(m_modelMatrix));
         }
 
         DrawObjectDataGL(
                 glm::mat4 inModelMatrix)
                 : renderDetails::DrawObjectDataGL{},
-                  m_modelMatrix{std::move(inModelMatrix)}
+                  m_modelMatrix{std::move(inModelMatrix)},
+                  m_normalMatrix{glm::transpose(glm::inverse(m_modelMatrix))}
         {}
 
         ~DrawObjectDataGL() override = default;
     private:
         glm::mat4 m_modelMatrix;
+        glm::mat4 m_normalMatrix;
     };
 
     class RenderDetailsGL : public renderDetails::RenderDetailsGL {
@@ -128,8 +135,8 @@ namespace darkObject {
                 uint32_t modelMatrixID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs) override;
 
         RenderDetailsGL(
                 char const *name,
@@ -44,6 +44,7 @@ namespace darkObject {
         std::shared_ptr<vulkan::Buffer> const &lightingBuffer() { return m_lightingSourceBuffer; }
         uint32_t lightingBufferSize() { return sizeof (CommonFragmentUBO); }
         std::shared_ptr<vulkan::ImageSampler> const &darkSampler(size_t i) { return m_darkSamplers[i]; }
+        renderDetails::DescriptorSetCache &descriptorSets() { return m_descriptorSets; }
 
         std::pair<glm::mat4, glm::mat4> getProjViewForLevel() override {
             /* perspective matrix: takes the perspective projection, the aspect ratio, near and far
@@ -137,6 +138,7 @@ namespace darkObject {
         std::shared_ptr<vulkan::Buffer> m_lightingSourceBuffer;
         float m_aspectRatio;
         std::array<std::shared_ptr<vulkan::ImageSampler>, numberShadowMaps> m_darkSamplers;
+        renderDetails::DescriptorSetCache m_descriptorSets;
     };
 
     class TextureDescriptorSetLayout : public vulkan::DescriptorSetLayout {
@@ -153,13 +155,13 @@ namespace darkObject {
 
         TextureDescriptorSetLayout(std::shared_ptr<vulkan::Device> inDevice)
                 : m_device(inDevice) {
-            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[0].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[1].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             m_poolSizes[2].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[3].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolSizes[4].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             m_poolSizes[4].descriptorCount = m_numberOfDescriptorSetsInPool;
@@ -215,11 +217,11 @@ namespace darkObject {
 
         ColorDescriptorSetLayout(std::shared_ptr<vulkan::Device> inDevice)
                 : m_device(inDevice) {
-            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[0].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[1].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[2].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolSizes[3].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             m_poolSizes[3].descriptorCount = m_numberOfDescriptorSetsInPool;
@@ -269,7 +271,7 @@ namespace darkObject {
         void update(glm::mat4 const &inModelMatrix) override {
             PerObjectUBO ubo{};
             ubo.modelMatrix = inModelMatrix;
-            m_uniformBuffer->copyRawTo(&ubo, sizeof (ubo));
+            m_uniformSlot->copyRawTo(&ubo, sizeof (ubo));
             m_modelMatrix = inModelMatrix;
         }
 
@@ -282,7 +284,7 @@ namespace darkObject {
                 if (cod == nullptr) {
                     return false;
                 }
-                textureUpdateDescriptorSet(m_device, cod, textureData);
+                m_descriptorSet = descriptorSet(cod, textureData);
             } else if (!m_hasTexture && !textureData) {
                 // no need to update the descriptor set, but return true since the update is successful
                 return true;
@@ -294,33 +296,32 @@ namespace darkObject {
             m_modelMatrix = modelMatrix;
         }
 
-        std::shared_ptr<vulkan::Buffer> const &bufferModelMatrix() override {
-            return m_uniformBuffer;
+        std::shared_ptr<vulkan::UniformSlot> const &uniformSlotModelMatrix() override {
+            return m_uniformSlot;
         }
 
         std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet(uint32_t) override {
             return m_descriptorSet;
         }
 
+        uint32_t dynamicOffset(uint32_t) override { return m_uniformSlot->offset(); }
+
         glm::mat4 modelMatrix(uint32_t) override { return m_modelMatrix; }
 
         DrawObjectDataVulkan(std::shared_ptr<vulkan::Device> const &inDevice,
                 std::shared_ptr<CommonObjectDataVulkan> const &cod,
                 std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData,
-                std::shared_ptr<vulkan::DescriptorSet> inDescriptorSet,
-                std::shared_ptr<vulkan::Buffer> inBuffer,
+                std::shared_ptr<vulkan::DescriptorPools> inDescriptorPools,
+                std::shared_ptr<vulkan::UniformSlot> inUniformSlot,
                 glm::mat4 const &inModelMatrix)
                 : m_hasTexture{textureData != nullptr},
                   m_device{inDevice},
-                  m_descriptorSet{std::move(inDescriptorSet)},
-                  m_uniformBuffer{std::move(inBuffer)},
+                  m_descriptorPools{std::move(inDescriptorPools)},
+                  m_descriptorSet{},
+                  m_uniformSlot{std::move(inUniformSlot)},
                   m_modelMatrix{inModelMatrix}
         {
-            if (m_hasTexture) {
-                textureUpdateDescriptorSet(inDevice, cod, textureData);
-            } else {
-                colorUpdateDescriptorSet(inDevice, cod);
-            }
+            m_descriptorSet = descriptorSet(cod, textureData);
         }
 
         ~DrawObjectDataVulkan() override = default;
@@ -331,17 +332,22 @@ namespace darkObject {
 
         bool m_hasTexture;
         std::shared_ptr<vulkan::Device> m_device;
+        std::shared_ptr<vulkan::DescriptorPools> m_descriptorPools;
         std::shared_ptr<vulkan::DescriptorSet> m_descriptorSet;
-        std::shared_ptr<vulkan::Buffer> m_uniformBuffer;
+        std::shared_ptr<vulkan::UniformSlot> m_uniformSlot;
         glm::mat4 m_modelMatrix;
 
+        std::shared_ptr<vulkan::DescriptorSet> descriptorSet(
+                std::shared_ptr<CommonObjectDataVulkan> const &cod,
+                std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData);
+
         void textureUpdateDescriptorSet(
-                std::shared_ptr<vulkan::Device> const &inDevice,
+                std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                 std::shared_ptr<CommonObjectDataVulkan> const &cod,
                 std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData);
 
         void colorUpdateDescriptorSet(
-                std::shared_ptr<vulkan::Device> const &inDevice,
+                std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                 std::shared_ptr<CommonObjectDataVulkan> const &cod);
     };
 
@@ -407,9 +413,9 @@ namespace darkObject {
                 size_t descriptorSetID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-                std::string const &renderDetailsName) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs,
+                boost::optional<renderDetails::RenderDetailsID> const &renderDetailsID) override;
 
         bool structuralChangeNeeded(
                 std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails) override
@@ -455,7 +461,9 @@ namespace darkObject {
                           surfaceDetails->renderPass, m_descriptorPoolsColor,
                           getBindingDescription(),
                           getAttributeDescriptions(),
-                          vertexShader, colorFragShader, m_pipelineTexture)}
+                          vertexShader, colorFragShader, m_pipelineTexture)},
+                  m_uniformArena{std::make_shared<vulkan::UniformArena>(
+                          m_device, sizeof (DrawObjectDataVulkan::PerObjectUBO))}
         {}
 
         ~RenderDetailsVulkan() override = default;
@@ -477,6 +485,8 @@ namespace darkObject {
         std::shared_ptr<vulkan::DescriptorPools> m_descriptorPoolsColor;
         std::shared_ptr<vulkan::Pipeline> m_pipelineColor;
 
+        std::shared_ptr<vulkan::UniformArena> m_uniformArena;
+
         std::shared_ptr<CommonObjectDataVulkan> createCommonObjectData(
                 glm::mat4 const &preTransform,
                 renderDetails::ParametersDarkObjectVulkan const *parameters)
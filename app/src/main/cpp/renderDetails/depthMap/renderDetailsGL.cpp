@@ -147,8 +147,8 @@ namespace depthMap {
             uint32_t modelMatrixID,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs)
     {
         auto cod = dynamic_cast<CommonObjectDataGL*>(commonObjectData.get());
         if (!cod) {
@@ -156,8 +156,8 @@ namespace depthMap {
         }
 
         // set the shader to use
-        GLuint programID = m_depthProgram->programID();
-        glUseProgram(programID);
+        auto &program = *m_depthProgram;
+        glUseProgram(program.programID());
         checkGraphicsError();
         glCullFace(GL_BACK);
         checkGraphicsError();
@@ -167,27 +167,24 @@ namespace depthMap {
         GLint MatrixID;
 
         // the projection matrix
-        MatrixID = glGetUniformLocation(programID, "proj");
-        checkGraphicsError();
+        MatrixID = program.uniformLocation("proj");
         glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &(projView.first)[0][0]);
         checkGraphicsError();
 
         // the view matrix
-        MatrixID = glGetUniformLocation(programID, "view");
-        checkGraphicsError();
+        MatrixID = program.uniformLocation("view");
         glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &(projView.second)[0][0]);
         checkGraphicsError();
 
-        GLint loc = glGetUniformLocation(programID, "nearestDepth");
+        GLint loc = program.uniformLocation("nearestDepth");
         glUniform1f(loc, cod->nearestDepth());
         checkGraphicsError();
 
-        loc = glGetUniformLocation(programID, "farthestDepth");
+        loc = program.uniformLocation("farthestDepth");
         glUniform1f(loc, cod->farthestDepth());
         checkGraphicsError();
 
-        MatrixID = glGetUniformLocation(programID, "model");
-        checkGraphicsError();
+        MatrixID = program.uniformLocation("model");
 
         for (auto it = beginZValRefs; it != endZValRefs; it++) {
             auto drawObj = drawObjTable->drawObject(it->drawObjectReference);
@@ -199,7 +196,7 @@ namespace depthMap {
             glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &modelMatrix[0][0]);
             checkGraphicsError();
 
-            drawVertices(programID, modelData);
+            drawVertices(program, modelData);
         }
     }
 
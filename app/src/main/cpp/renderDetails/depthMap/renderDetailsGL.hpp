@@ -122,8 +122,8 @@ namespace depthMap {
                 uint32_t modelMatrixID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs) override;
 
         void postProcessImageBuffer(
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
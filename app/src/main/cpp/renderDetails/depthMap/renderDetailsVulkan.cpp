@@ -29,7 +29,7 @@ namespace depthMap {
         /* Common Object Data */
         std::array<VkDescriptorSetLayoutBinding, 2> uboLayoutBinding = {};
         uboLayoutBinding[0].binding = 0;
-        uboLayoutBinding[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        uboLayoutBinding[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         uboLayoutBinding[0].descriptorCount = 1;
 
         /* only accessing the common object data from the vertex shader */
@@ -38,7 +38,7 @@ namespace depthMap {
 
         /* the model matrix */
         uboLayoutBinding[1].binding = 1;
-        uboLayoutBinding[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        uboLayoutBinding[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         uboLayoutBinding[1].descriptorCount = 1;
 
         /* only accessing the model matrix from the vertex shader */
@@ -67,6 +67,7 @@ namespace depthMap {
     /* descriptor set for the MVP matrix and texture samplers */
     void
     DrawObjectDataVulkan::updateDescriptorSet(std::shared_ptr<vulkan::Device> const &inDevice,
+                                              std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                                               std::shared_ptr<CommonObjectDataVulkan> const &cod)
     {
         VkDescriptorBufferInfo bufferInfoCOD = {};
@@ -76,10 +77,10 @@ namespace depthMap {
 
         std::array<VkWriteDescriptorSet, 2> descriptorWrite = {};
         descriptorWrite[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite[0].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrite[0].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrite[0].dstBinding = 0;
         descriptorWrite[0].dstArrayElement = 0;
-        descriptorWrite[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrite[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrite[0].descriptorCount = 1;
         descriptorWrite[0].pBufferInfo = &bufferInfoCOD;
         descriptorWrite[0].pNext = nullptr;
@@ -87,22 +88,22 @@ namespace depthMap {
         descriptorWrite[0].pTexelBufferView = nullptr; // Optional
 
         VkDescriptorBufferInfo bufferInfo = {};
-        bufferInfo.buffer = m_uniformBuffer->buffer();
+        bufferInfo.buffer = m_uniformSlot->buffer()->buffer();
         bufferInfo.offset = 0;
         bufferInfo.range = sizeof (PerObjectUBO);
 
         descriptorWrite[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrite[1].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrite[1].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrite[1].dstBinding = 1;
         descriptorWrite[1].dstArrayElement = 0;
-        descriptorWrite[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrite[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrite[1].descriptorCount = 1;
         descriptorWrite[1].pBufferInfo = &bufferInfo;
         descriptorWrite[1].pNext = nullptr;
         descriptorWrite[1].pImageInfo = nullptr; // Optional
         descriptorWrite[1].pTexelBufferView = nullptr; // Optional
 
-        vkUpdateDescriptorSets(inDevice->logicalDevice().get(), descriptorWrite.size(), descriptorWrite.data(), 0, nullptr);
+        descriptorSet->updateDescriptors(static_cast<uint32_t>(descriptorWrite.size()), descriptorWrite.data());
     }
 
     void RenderDetailsVulkan::addDrawCmdsToCommandBuffer(
@@ -110,9 +111,9 @@ namespace depthMap {
             size_t descriptorSetID,
             std::shared_ptr<renderDetails::CommonObjectData> const &,
             std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-            std::string const &)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs,
+            boost::optional<renderDetails::RenderDetailsID> const &)
     {
         initializeCommandBufferDrawObjects(
                 commandBuffer, descriptorSetID, m_pipeline, nullptr,
@@ -131,22 +132,19 @@ namespace depthMap {
                            glm::mat4 const &modelMatrix) ->
                         std::shared_ptr<renderDetails::DrawObjectDataVulkan>
                 {
-                    std::shared_ptr<vulkan::Buffer> modelMatrixBuffer{};
+                    std::shared_ptr<vulkan::UniformSlot> modelMatrixSlot{};
                     if (sharingDOD) {
-                        modelMatrixBuffer = sharingDOD->bufferModelMatrix();
+                        modelMatrixSlot = sharingDOD->uniformSlotModelMatrix();
                     } else {
-                        modelMatrixBuffer =
-                                renderDetails::createUniformBuffer(rd->device(),
-                                                                sizeof (DrawObjectDataVulkan::PerObjectUBO));
+                        modelMatrixSlot = rd->m_uniformArena->allocate();
                         DrawObjectDataVulkan::PerObjectUBO perObjectUbo{};
                         perObjectUbo.modelMatrix = modelMatrix;
-                        modelMatrixBuffer->copyRawTo(&perObjectUbo,
-                                                     sizeof(DrawObjectDataVulkan::PerObjectUBO));
+                        modelMatrixSlot->copyRawTo(&perObjectUbo,
+                                                   sizeof(DrawObjectDataVulkan::PerObjectUBO));
                     }
 
-                    auto descriptorSet = rd->descriptorPools()->allocateDescriptor();
                     return std::make_shared<DrawObjectDataVulkan>(
-                            rd->device(), cod, std::move(descriptorSet), std::move(modelMatrixBuffer),
+                            rd->device(), cod, rd->descriptorPools(), std::move(modelMatrixSlot),
                             modelMatrix);
                 });
 
@@ -56,6 +56,7 @@ namespace depthMap {
         std::shared_ptr<vulkan::Buffer> const &buffer() { return m_buffer; }
 
         uint32_t bufferSize() { return sizeof(CommonUBO); }
+        renderDetails::DescriptorSetCache &descriptorSets() { return m_descriptorSets; }
 
         void update(renderDetails::Parameters const &parametersBase) override {
             auto parameters = dynamic_cast<renderDetails::ParametersDepthMap const &>(parametersBase);
@@ -103,6 +104,7 @@ namespace depthMap {
         glm::mat4 m_preTransform;
         float m_nearestDepth;
         float m_farthestDepth;
+        renderDetails::DescriptorSetCache m_descriptorSets;
     };
 
     /* for passing data other than the vertex data to the vertex shader */
@@ -112,7 +114,7 @@ namespace depthMap {
         void update(glm::mat4 const &inModelMatrix) override {
             PerObjectUBO ubo{};
             ubo.modelMatrix = inModelMatrix;
-            m_uniformBuffer->copyRawTo(&ubo, sizeof(ubo));
+            m_uniformSlot->copyRawTo(&ubo, sizeof(ubo));
             m_modelMatrix = inModelMatrix;
         }
 
@@ -121,20 +123,25 @@ namespace depthMap {
         }
 
         bool hasTexture() override { return false; }
-        std::shared_ptr<vulkan::Buffer> const &bufferModelMatrix() override { return m_uniformBuffer; }
+        std::shared_ptr<vulkan::UniformSlot> const &uniformSlotModelMatrix() override { return m_uniformSlot; }
         std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet(uint32_t) override { return m_descriptorSet; }
+        uint32_t dynamicOffset(uint32_t) override { return m_uniformSlot->offset(); }
         glm::mat4 modelMatrix(uint32_t) override { return m_modelMatrix; }
 
         DrawObjectDataVulkan(std::shared_ptr<vulkan::Device> const &inDevice,
                              std::shared_ptr<CommonObjectDataVulkan> const &inCommonObjectData,
-                             std::shared_ptr<vulkan::DescriptorSet> inDescriptorSet,
-                             std::shared_ptr<vulkan::Buffer> inUniformBuffer,
+                             std::shared_ptr<vulkan::DescriptorPools> const &descriptorPools,
+                             std::shared_ptr<vulkan::UniformSlot> inUniformSlot,
                              glm::mat4 const &inModelMatrix)
-                : m_descriptorSet{std::move(inDescriptorSet)},
-                  m_uniformBuffer{std::move(inUniformBuffer)},
+                : m_descriptorSet{},
+                  m_uniformSlot{std::move(inUniformSlot)},
                   m_modelMatrix{inModelMatrix}
         {
-            updateDescriptorSet(inDevice, inCommonObjectData);
+            m_descriptorSet = inCommonObjectData->descriptorSets().descriptorSet(
+                    descriptorPools, m_uniformSlot, nullptr,
+                    [this, &inDevice, &inCommonObjectData](std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet) {
+                        updateDescriptorSet(inDevice, descriptorSet, inCommonObjectData);
+                    });
         }
 
         ~DrawObjectDataVulkan() override = default;
@@ -145,10 +152,11 @@ namespace depthMap {
         };
 
         std::shared_ptr<vulkan::DescriptorSet> m_descriptorSet;
-        std::shared_ptr<vulkan::Buffer> m_uniformBuffer;
+        std::shared_ptr<vulkan::UniformSlot> m_uniformSlot;
         glm::mat4 m_modelMatrix;
 
         void updateDescriptorSet(std::shared_ptr<vulkan::Device> const &inDevice,
+                                 std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                                  std::shared_ptr<CommonObjectDataVulkan> const &inCommonObjectData);
     };
 
@@ -157,9 +165,9 @@ namespace depthMap {
         DescriptorSetLayout(std::shared_ptr<vulkan::Device> inDevice)
                 : m_device(inDevice)
         {
-            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[0].descriptorCount = 1;
-            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[1].descriptorCount = 1;
 
             m_poolInfo = {};
@@ -268,9 +276,9 @@ namespace depthMap {
                 size_t descriptorSetID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-                std::string const &renderDetailsName) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs,
+                boost::optional<renderDetails::RenderDetailsID> const &renderDetailsID) override;
 
         bool structuralChangeNeeded(
                 std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails) override
@@ -305,7 +313,9 @@ namespace depthMap {
                   m_device{inDevice},
                   m_descriptorSetLayout{std::make_shared<DescriptorSetLayout>(m_device)},
                   m_descriptorPools{std::make_shared<vulkan::DescriptorPools>(m_device, m_descriptorSetLayout)},
-                  m_pipeline{}
+                  m_pipeline{},
+                  m_uniformArena{std::make_shared<vulkan::UniformArena>(
+                          m_device, sizeof (DrawObjectDataVulkan::PerObjectUBO))}
         {
             std::string vertFile{m_vertShader};
             std::string fragFile{m_fragShader};
@@ -329,6 +339,7 @@ namespace depthMap {
         std::shared_ptr<DescriptorSetLayout> m_descriptorSetLayout;
         std::shared_ptr<vulkan::DescriptorPools> m_descriptorPools;
         std::shared_ptr<vulkan::Pipeline> m_pipeline;
+        std::shared_ptr<vulkan::UniformArena> m_uniformArena;
 
         static renderDetails::ReferenceVulkan createReference(
                 std::shared_ptr<RenderDetailsVulkan> rd,
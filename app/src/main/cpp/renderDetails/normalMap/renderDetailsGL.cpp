@@ -148,8 +148,8 @@ namespace normalMap {
             uint32_t modelMatrixID,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs)
     {
         auto cod = dynamic_cast<CommonObjectDataGL*>(commonObjectData.get());
         if (!cod) {
@@ -157,8 +157,8 @@ namespace normalMap {
         }
 
         // set the shader to use
-        GLuint programID = m_program->programID();
-        glUseProgram(programID);
+        auto &program = *m_program;
+        glUseProgram(program.programID());
         checkGraphicsError();
         glCullFace(GL_BACK);
         checkGraphicsError();
@@ -168,22 +168,18 @@ namespace normalMap {
         GLint MatrixID;
 
         // the projection matrix
-        MatrixID = glGetUniformLocation(programID, "proj");
-        checkGraphicsError();
+        MatrixID = program.uniformLocation("proj");
         glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &(projView.first)[0][0]);
         checkGraphicsError();
 
         // the view matrix
-        MatrixID = glGetUniformLocation(programID, "view");
-        checkGraphicsError();
+        MatrixID = program.uniformLocation("view");
         glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &(projView.second)[0][0]);
         checkGraphicsError();
 
-        MatrixID = glGetUniformLocation(programID, "model");
-        checkGraphicsError();
+        MatrixID = program.uniformLocation("model");
 
-        GLint normalMatrixID = glGetUniformLocation(programID, "normalMatrix");
-        checkGraphicsError();
+        GLint normalMatrixID = program.uniformLocation("normalMatrix");
 
         for (auto it = beginZValRefs; it != endZValRefs; it++) {
             auto drawObj = drawObjTable->drawObject(it->drawObjectReference);
@@ -195,11 +191,11 @@ namespace normalMap {
             glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &modelMatrix[0][0]);
             checkGraphicsError();
 
-            glm::mat4 normalMatrix = glm::transpose(glm::inverse(modelMatrix));
+            auto normalMatrix = objData->normalMatrix(modelMatrixID);
             glUniformMatrix4fv(normalMatrixID, 1, GL_FALSE, &normalMatrix[0][0]);
             checkGraphicsError();
 
-            drawVertices(programID, modelData, true);
+            drawVertices(program, modelData, true);
         }
     }
 
@@ -55,17 +55,22 @@ namespace normalMap {
     public:
         glm::mat4 modelMatrix(uint32_t) override { return m_modelMatrix; }
 
+        glm::mat4 normalMatrix(uint32_t) override { return m_normalMatrix; }
+
         void update(glm::mat4 const &modelMatrix) override {
             m_modelMatrix = modelMatrix;
+            m_normalMatrix = glm::transpose(glm::inverse(m_modelMatrix));
         }
 
         DrawObjectDataGL(glm::mat4 const &inModelMatrix)
-                : m_modelMatrix{inModelMatrix}
+                : m_modelMatrix{inModelMatrix},
+                  m_normalMatrix{glm::transpose(glm::inverse(m_modelMatrix))}
         {}
 
         ~DrawObjectDataGL() override = default;
     private:
         glm::mat4 m_modelMatrix;
+        glm::mat4 m_normalMatrix;
     };
 
     class PostProcessNormalsVisitor : public boost::static_visitor<std::vector<float>> {
@@ -109,8 +114,8 @@ namespace normalMap {
                 uint32_t modelMatrixID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs) override;
 
         bool overrideClearColor(glm::vec4 &clearColor) override {
             clearColor = {0.5f, 0.5f, 1.0f, 1.0f};
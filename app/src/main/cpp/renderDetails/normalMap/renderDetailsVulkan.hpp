@@ -51,6 +51,7 @@ namespace normalMap {
         }
 
         std::shared_ptr<vulkan::Buffer> const &cameraBuffer() { return m_camera; }
+        renderDetails::DescriptorSetCache &descriptorSets() { return m_descriptorSets; }
 
         uint32_t cameraBufferSize() { return sizeof(CommonUBO); }
 
@@ -93,6 +94,8 @@ namespace normalMap {
         std::shared_ptr<vulkan::Buffer> m_camera;
 
         glm::mat4 m_preTransform;
+
+        renderDetails::DescriptorSetCache m_descriptorSets;
     };
 
     /* for passing data other than the vertex data to the vertex shader */
@@ -102,7 +105,7 @@ namespace normalMap {
         void update(glm::mat4 const &modelMatrix) override {
             PerObjectUBO ubo{};
             ubo.modelMatrix = modelMatrix;
-            m_uniformBuffer->copyRawTo(&ubo, sizeof(ubo));
+            m_uniformSlot->copyRawTo(&ubo, sizeof(ubo));
             m_modelMatrix = modelMatrix;
         }
 
@@ -111,20 +114,25 @@ namespace normalMap {
         }
 
         bool hasTexture() override { return false; }
-        std::shared_ptr<vulkan::Buffer> const &bufferModelMatrix() override { return m_uniformBuffer; }
+        std::shared_ptr<vulkan::UniformSlot> const &uniformSlotModelMatrix() override { return m_uniformSlot; }
         std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet(uint32_t) override { return m_descriptorSet; }
+        uint32_t dynamicOffset(uint32_t) override { return m_uniformSlot->offset(); }
         glm::mat4 modelMatrix(uint32_t) override { return m_modelMatrix; }
 
         DrawObjectDataVulkan(std::shared_ptr<vulkan::Device> const &inDevice,
                              std::shared_ptr<CommonObjectDataVulkan> const &inCommonObjectData,
-                             std::shared_ptr<vulkan::DescriptorSet> inDescriptorSet,
-                             std::shared_ptr<vulkan::Buffer> inUniformBuffer,
+                             std::shared_ptr<vulkan::DescriptorPools> const &descriptorPools,
+                             std::shared_ptr<vulkan::UniformSlot> inUniformSlot,
                              glm::mat4 const &inModelMatrix)
-                : m_descriptorSet{std::move(inDescriptorSet)},
-                  m_uniformBuffer{std::move(inUniformBuffer)},
+                : m_descriptorSet{},
+                  m_uniformSlot{std::move(inUniformSlot)},
                   m_modelMatrix{inModelMatrix}
         {
-            updateDescriptorSet(inDevice, inCommonObjectData);
+            m_descriptorSet = inCommonObjectData->descriptorSets().descriptorSet(
+                    descriptorPools, m_uniformSlot, nullptr,
+                    [this, &inDevice, &inCommonObjectData](std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet) {
+                        updateDescriptorSet(inDevice, descriptorSet, inCommonObjectData);
+                    });
         }
 
         ~DrawObjectDataVulkan() override = default;
@@ -136,9 +144,10 @@ namespace normalMap {
 
         glm::mat4 m_modelMatrix;
         std::shared_ptr<vulkan::DescriptorSet> m_descriptorSet;
-        std::shared_ptr<vulkan::Buffer> m_uniformBuffer;
+        std::shared_ptr<vulkan::UniformSlot> m_uniformSlot;
 
         void updateDescriptorSet(std::shared_ptr<vulkan::Device> const &inDevice,
+                                 std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                                  std::shared_ptr<CommonObjectDataVulkan> const &inCommonObjectData);
     };
 
@@ -147,9 +156,9 @@ namespace normalMap {
         DescriptorSetLayout(std::shared_ptr<vulkan::Device> inDevice)
                 : m_device(inDevice)
         {
-            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[0].descriptorCount = 1;
-            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[1].descriptorCount = 1;
             m_poolInfo = {};
             m_poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -250,9 +259,9 @@ namespace normalMap {
                 size_t descriptorSetID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-                std::string const &renderDetailsName) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs,
+                boost::optional<renderDetails::RenderDetailsID> const &renderDetailsID) override;
 
         bool structuralChangeNeeded(
                 std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails) override
@@ -292,7 +301,9 @@ namespace normalMap {
                           VkExtent2D{m_surfaceWidth, m_surfaceHeight},
                           surfaceDetails->renderPass, m_descriptorPools, getBindingDescription(),
                           getAttributeDescriptions(),
-                          m_normalShader, m_simpleFragShader, basePipeline)}
+                          m_normalShader, m_simpleFragShader, basePipeline)},
+                  m_uniformArena{std::make_shared<vulkan::UniformArena>(
+                          m_device, sizeof (DrawObjectDataVulkan::PerObjectUBO))}
         {}
 
         ~RenderDetailsVulkan() override = default;
@@ -306,6 +317,7 @@ namespace normalMap {
         std::shared_ptr<DescriptorSetLayout> m_descriptorSetLayout;
         std::shared_ptr<vulkan::DescriptorPools> m_descriptorPools;
         std::shared_ptr<vulkan::Pipeline> m_pipeline;
+        std::shared_ptr<vulkan::UniformArena> m_uniformArena;
 
         static renderDetails::ReferenceVulkan createReference(
                 std::shared_ptr<RenderDetailsVulkan> rd,
@@ -115,8 +115,8 @@ namespace objectNoShadows {
             uint32_t modelMatrixID,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs)
     {
         glCullFace(GL_BACK);
         checkGraphicsError();
@@ -126,57 +126,34 @@ namespace objectNoShadows {
             throw std::runtime_error("Invalid common object data type");
         }
 
-        GLuint textureProgramID = m_textureProgram->programID();
-        GLuint colorProgramID = m_colorProgram->programID();
-        GLuint programID = textureProgramID;
+        renderDetails::GLProgram *program = nullptr;
         GLint MatrixID = -1;
         GLint normalMatrixID = -1;
-        GLint textureID = -1;
+        GLuint boundTexture = 0;
 
         for (auto it = beginZValRefs; it != endZValRefs; it++) {
             auto &drawObj = drawObjTable->drawObject(it->drawObjectReference);
             auto &modelData = drawObj->modelData();
             auto &textureData = drawObj->textureData();
-            if (it == beginZValRefs ||
-                (programID == textureProgramID && !textureData) ||
-                    (programID == colorProgramID && textureData)) {
-                programID = textureData ? textureProgramID : colorProgramID;
-                glUseProgram(programID);
+            renderDetails::GLProgram *nextProgram = textureData ? m_textureProgram.get() : m_colorProgram.get();
+            if (program != nextProgram) {
+                program = nextProgram;
+                glUseProgram(program->programID());
                 checkGraphicsError();
 
-                auto projView = cod->getProjViewForLevel();
-
-                // the projection matrix * the view matrix
-                MatrixID = glGetUniformLocation(programID, "projView");
-                checkGraphicsError();
-                glm::mat4 projTimesView = projView.first * projView.second;
-                glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projTimesView[0][0]);
-                checkGraphicsError();
-
-                GLint lightPosID = glGetUniformLocation(programID, "lightPos");
-                checkGraphicsError();
-                glm::vec3 lightPos = cod->getLightSource(0);
-                glUniform3fv(lightPosID, 1, &lightPos[0]);
-                checkGraphicsError();
-
-                MatrixID = glGetUniformLocation(programID, "model");
-                checkGraphicsError();
-
-                normalMatrixID = glGetUniformLocation(programID, "normalMatrix");
-                checkGraphicsError();
-
-                if (textureData) {
-                    textureID = glGetUniformLocation(programID, "texSampler");
-                    checkGraphicsError();
+                if (program->commonUniformsNeedUpdate(cod->revision())) {
+                    loadCommonUniforms(*program, *cod, textureData != nullptr);
                 }
+
+                MatrixID = program->uniformLocation("model");
+                normalMatrixID = program->uniformLocation("normalMatrix");
             }
 
-            if (textureData) {
+            if (textureData && textureData->handle() != boundTexture) {
+                boundTexture = textureData->handle();
                 glActiveTexture(GL_TEXTURE1);
                 checkGraphicsError();
-                glBindTexture(GL_TEXTURE_2D, textureData->handle());
-                checkGraphicsError();
-                glUniform1i(textureID, 1);
+                glBindTexture(GL_TEXTURE_2D, boundTexture);
                 checkGraphicsError();
             }
 
@@ -186,11 +163,33 @@ namespace objectNoShadows {
             glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &modelMatrix[0][0]);
             checkGraphicsError();
 
-            glm::mat4 normalMatrix = glm::transpose(glm::inverse(modelMatrix));
+            auto normalMatrix = objData->normalMatrix(modelMatrixID);
             glUniformMatrix4fv(normalMatrixID, 1, GL_FALSE, &normalMatrix[0][0]);
             checkGraphicsError();
 
-            drawVertices(programID, modelData);
+            drawVertices(*program, modelData);
+        }
+    }
+
+    void RenderDetailsGL::loadCommonUniforms(
+            renderDetails::GLProgram &program,
+            CommonObjectDataGL &cod,
+            bool hasTexture)
+    {
+        auto projView = cod.getProjViewForLevel();
+
+        // the projection matrix * the view matrix
+        glm::mat4 projTimesView = projView.first * projView.second;
+        glUniformMatrix4fv(program.uniformLocation("projView"), 1, GL_FALSE, &projTimesView[0][0]);
+        checkGraphicsError();
+
+        glm::vec3 lightPos = cod.getLightSource(0);
+        glUniform3fv(program.uniformLocation("lightPos"), 1, &lightPos[0]);
+        checkGraphicsError();
+
+        if (hasTexture) {
+            glUniform1i(program.uniformLocation("texSampler"), 1);
+            checkGraphicsError();
         }
     }
 
@@ -59,19 +59,26 @@ namespace objectNoShadows {
             return m_modelMatrix;
         }
 
+        glm::mat4 normalMatrix(uint32_t) override {
+            return m_normalMatrix;
+        }
+
         void update(glm::mat4 const &modelMatrix) override {
             m_modelMatrix = modelMatrix;
+            m_normalMatrix = glm::transpose(glm::inverse(m_modelMatrix));
         }
 
         DrawObjectDataGL(
                 glm::mat4 inModelMatrix)
                 : renderDetails::DrawObjectDataGL{},
-                  m_modelMatrix{std::move(inModelMatrix)}
+                  m_modelMatrix{std::move(inModelMatrix)},
+                  m_normalMatrix{glm::transpose(glm::inverse(m_modelMatrix))}
         {}
 
         ~DrawObjectDataGL() override = default;
     private:
         glm::mat4 m_modelMatrix;
+        glm::mat4 m_normalMatrix;
     };
 
     class RenderDetailsGL : public renderDetails::RenderDetailsGL {
@@ -97,8 +104,8 @@ namespace objectNoShadows {
                 uint32_t modelMatrixID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs) override;
 
         RenderDetailsGL(
                 char const *name,
@@ -118,6 +125,12 @@ namespace objectNoShadows {
         std::shared_ptr<renderDetails::GLProgram> m_textureProgram;
         std::shared_ptr<renderDetails::GLProgram> m_colorProgram;
 
+        // load the uniforms that come from the common object data into the program.
+        static void loadCommonUniforms(
+                renderDetails::GLProgram &program,
+                CommonObjectDataGL &cod,
+                bool hasTexture);
+
         static renderDetails::ReferenceGL createReference(
                 std::shared_ptr<renderDetails::RenderDetailsGL> rd,
                 std::shared_ptr<CommonObjectDataGL> cod);
@@ -24,19 +24,33 @@
 #include "../../renderLoader/registerVulkan.hpp"
 
 namespace objectNoShadows {
+    std::shared_ptr<vulkan::DescriptorSet> DrawObjectDataVulkan::descriptorSet(
+            std::shared_ptr<CommonObjectDataVulkan> const &cod,
+            std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData)
+    {
+        return cod->descriptorSets().descriptorSet(m_descriptorPools, m_uniformSlot, textureData,
+                [this, &cod, &textureData](std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet) {
+                    if (textureData) {
+                        textureUpdateDescriptorSet(descriptorSet, cod, textureData);
+                    } else {
+                        colorUpdateDescriptorSet(descriptorSet, cod);
+                    }
+                });
+    }
+
     /* descriptor set for the MVP matrix and texture samplers */
     void DrawObjectDataVulkan::colorUpdateDescriptorSet(
-            std::shared_ptr<vulkan::Device> const &inDevice,
+            std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
             std::shared_ptr<CommonObjectDataVulkan> const &cod)
     {
         VkDescriptorBufferInfo bufferInfo = {};
-        bufferInfo.buffer = m_uniformBuffer->buffer();
+        bufferInfo.buffer = m_uniformSlot->buffer()->buffer();
         bufferInfo.offset = 0;
         bufferInfo.range = sizeof (PerObjectUBO);
 
         std::array<VkWriteDescriptorSet, 3> descriptorWrites = {};
         descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[0].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[0].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
 
         /* must be the same as the binding in the vertex shader */
         descriptorWrites[0].dstBinding = 0;
@@ -44,7 +58,7 @@ namespace objectNoShadows {
         /* index into the array of descriptors */
         descriptorWrites[0].dstArrayElement = 0;
 
-        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 
         /* how many array elements you want to update */
         descriptorWrites[0].descriptorCount = 1;
@@ -63,10 +77,10 @@ namespace objectNoShadows {
         commonInfo.range = cod->cameraBufferSize();
 
         descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[1].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[1].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[1].dstBinding = 1;
         descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[1].descriptorCount = 1;
         descriptorWrites[1].pBufferInfo = &commonInfo;
 
@@ -76,32 +90,30 @@ namespace objectNoShadows {
         bufferLightingSource.range = cod->lightingBufferSize();
 
         descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[2].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[2].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[2].dstBinding = 2;
         descriptorWrites[2].dstArrayElement = 0;
-        descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[2].descriptorCount = 1;
         descriptorWrites[2].pBufferInfo = &bufferLightingSource;
 
-        vkUpdateDescriptorSets(inDevice->logicalDevice().get(),
-                               static_cast<uint32_t>(descriptorWrites.size()),
-                               descriptorWrites.data(), 0, nullptr);
+        descriptorSet->updateDescriptors(static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data());
     }
 
     /* descriptor set for the MVP matrix and texture samplers */
     void DrawObjectDataVulkan::textureUpdateDescriptorSet(
-            std::shared_ptr<vulkan::Device> const &inDevice,
+            std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
             std::shared_ptr<CommonObjectDataVulkan> const &cod,
             std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData)
     {
         VkDescriptorBufferInfo bufferInfo = {};
-        bufferInfo.buffer = m_uniformBuffer->buffer();
+        bufferInfo.buffer = m_uniformSlot->buffer()->buffer();
         bufferInfo.offset = 0;
         bufferInfo.range = sizeof (PerObjectUBO);
 
         std::array<VkWriteDescriptorSet, 4> descriptorWrites = {};
         descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[0].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[0].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
 
         /* must be the same as the binding in the vertex shader */
         descriptorWrites[0].dstBinding = 0;
@@ -109,7 +121,7 @@ namespace objectNoShadows {
         /* index into the array of descriptors */
         descriptorWrites[0].dstArrayElement = 0;
 
-        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 
         /* how many array elements you want to update */
         descriptorWrites[0].descriptorCount = 1;
@@ -128,10 +140,10 @@ namespace objectNoShadows {
         commonInfo.range = cod->cameraBufferSize();
 
         descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[1].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[1].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[1].dstBinding = 1;
         descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[1].descriptorCount = 1;
         descriptorWrites[1].pBufferInfo = &commonInfo;
 
@@ -141,7 +153,7 @@ namespace objectNoShadows {
         imageInfo.sampler = getVkType<>(textureData->sampler()->sampler().get());
 
         descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[2].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[2].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[2].dstBinding = 2;
         descriptorWrites[2].dstArrayElement = 0;
         descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -154,16 +166,14 @@ namespace objectNoShadows {
         bufferLightingSource.range = cod->lightingBufferSize();
 
         descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[3].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[3].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[3].dstBinding = 3;
         descriptorWrites[3].dstArrayElement = 0;
-        descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[3].descriptorCount = 1;
         descriptorWrites[3].pBufferInfo = &bufferLightingSource;
 
-        vkUpdateDescriptorSets(inDevice->logicalDevice().get(),
-                               static_cast<uint32_t>(descriptorWrites.size()),
-                               descriptorWrites.data(), 0, nullptr);
+        descriptorSet->updateDescriptors(static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data());
     }
 
     /* for accessing data other than the vertices from the shaders */
@@ -171,7 +181,7 @@ namespace objectNoShadows {
         /* model matrix - different for each object */
         VkDescriptorSetLayoutBinding modelMatrixBinding = {};
         modelMatrixBinding.binding = 0;
-        modelMatrixBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        modelMatrixBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         modelMatrixBinding.descriptorCount = 1;
 
         /* only accessing the MVP matrix from the vertex shader */
@@ -181,7 +191,7 @@ namespace objectNoShadows {
         /* view and projection matrix - the same for all objects */
         VkDescriptorSetLayoutBinding commonDataBinding = {};
         commonDataBinding.binding = 1;
-        commonDataBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        commonDataBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         commonDataBinding.descriptorCount = 1;
         commonDataBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
         commonDataBinding.pImmutableSamplers = nullptr; // Optional
@@ -196,7 +206,7 @@ namespace objectNoShadows {
 
         VkDescriptorSetLayoutBinding lightingSourceBinding = {};
         lightingSourceBinding.binding = 3;
-        lightingSourceBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        lightingSourceBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         lightingSourceBinding.descriptorCount = 1;
         lightingSourceBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
         lightingSourceBinding.pImmutableSamplers = nullptr;
@@ -230,7 +240,7 @@ namespace objectNoShadows {
         /* model matrix - different for each object */
         VkDescriptorSetLayoutBinding modelMatrixBinding = {};
         modelMatrixBinding.binding = 0;
-        modelMatrixBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        modelMatrixBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         modelMatrixBinding.descriptorCount = 1;
 
         /* only accessing the MVP matrix from the vertex shader */
@@ -240,14 +250,14 @@ namespace objectNoShadows {
         /* view and projection matrix - the same for all objects */
         VkDescriptorSetLayoutBinding commonDataBinding = {};
         commonDataBinding.binding = 1;
-        commonDataBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        commonDataBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         commonDataBinding.descriptorCount = 1;
         commonDataBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
         commonDataBinding.pImmutableSamplers = nullptr; // Optional
 
         VkDescriptorSetLayoutBinding lightingSourceBinding = {};
         lightingSourceBinding.binding = 2;
-        lightingSourceBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        lightingSourceBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         lightingSourceBinding.descriptorCount = 1;
         lightingSourceBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
         lightingSourceBinding.pImmutableSamplers = nullptr;
@@ -286,31 +296,23 @@ namespace objectNoShadows {
                            glm::mat4 const &modelMatrix) ->
                         std::shared_ptr<renderDetails::DrawObjectDataVulkan>
                 {
-                    std::shared_ptr<vulkan::Buffer> modelMatrixBuffer{};
+                    std::shared_ptr<vulkan::UniformSlot> modelMatrixSlot{};
                     if (sharingDOD) {
-                        modelMatrixBuffer = sharingDOD->bufferModelMatrix();
+                        modelMatrixSlot = sharingDOD->uniformSlotModelMatrix();
                     } else {
-                        modelMatrixBuffer = renderDetails::createUniformBuffer(
-                                rd->device(), sizeof (DrawObjectDataVulkan::PerObjectUBO));
+                        modelMatrixSlot = rd->m_uniformArena->allocate();
                         DrawObjectDataVulkan::PerObjectUBO perObjectUbo{};
                         perObjectUbo.modelMatrix = modelMatrix;
-                        modelMatrixBuffer->copyRawTo(
+                        modelMatrixSlot->copyRawTo(
                                 &perObjectUbo, sizeof(DrawObjectDataVulkan::PerObjectUBO));
                     }
 
-                    std::shared_ptr<vulkan::DescriptorSet> ds;
-                    if (textureData) {
-                        ds = rd->m_descriptorPoolsTexture->allocateDescriptor();
-                    } else {
-                        ds = rd->m_descriptorPoolsColor->allocateDescriptor();
-                    }
-
                     return std::make_shared<DrawObjectDataVulkan>(
                             rd->device(),
                             cod,
                             textureData,
-                            std::move(ds),
-                            std::move(modelMatrixBuffer),
+                            textureData ? rd->m_descriptorPoolsTexture : rd->m_descriptorPoolsColor,
+                            std::move(modelMatrixSlot),
                             modelMatrix);
                 });
 
@@ -330,9 +332,9 @@ namespace objectNoShadows {
             size_t descriptorSetID,
             std::shared_ptr<renderDetails::CommonObjectData> const &,
             std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-            std::string const &)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs,
+            boost::optional<renderDetails::RenderDetailsID> const &)
     {
         initializeCommandBufferDrawObjects(
                 commandBuffer, descriptorSetID, m_pipelineColor,
@@ -41,6 +41,7 @@ namespace objectNoShadows {
         std::shared_ptr<vulkan::Buffer> const &cameraBuffer() { return m_cameraBuffer; }
         uint32_t cameraBufferSize() { return sizeof (CommonVertexUBO); }
         std::shared_ptr<vulkan::Buffer> const &lightingBuffer() { return m_lightingSourceBuffer; }
+        renderDetails::DescriptorSetCache &descriptorSets() { return m_descriptorSets; }
         uint32_t lightingBufferSize() { return sizeof (glm::vec3) * m_lightSources.size(); }
 
         std::pair<glm::mat4, glm::mat4> getProjViewForLevel() override {
@@ -92,6 +93,7 @@ namespace objectNoShadows {
         glm::mat4 m_preTransform;
         std::shared_ptr<vulkan::Buffer> m_cameraBuffer;
         std::shared_ptr<vulkan::Buffer> m_lightingSourceBuffer;
+        renderDetails::DescriptorSetCache m_descriptorSets;
 
         void doUpdate() {
             CommonVertexUBO commonUbo;
@@ -134,13 +136,13 @@ namespace objectNoShadows {
 
         TextureDescriptorSetLayout(std::shared_ptr<vulkan::Device> inDevice)
                 : m_device(inDevice) {
-            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[0].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[1].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             m_poolSizes[2].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[3].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolInfo = {};
             m_poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -179,11 +181,11 @@ namespace objectNoShadows {
 
         ColorDescriptorSetLayout(std::shared_ptr<vulkan::Device> inDevice)
                 : m_device(inDevice) {
-            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[0].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[1].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[2].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolInfo = {};
             m_poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -217,7 +219,7 @@ namespace objectNoShadows {
         void update(glm::mat4 const &inModelMatrix) override {
             PerObjectUBO ubo{};
             ubo.modelMatrix = inModelMatrix;
-            m_uniformBuffer->copyRawTo(&ubo, sizeof (ubo));
+            m_uniformSlot->copyRawTo(&ubo, sizeof (ubo));
             m_modelMatrix = inModelMatrix;
         }
 
@@ -230,7 +232,7 @@ namespace objectNoShadows {
                 if (cod == nullptr) {
                     return false;
                 }
-                textureUpdateDescriptorSet(m_device, cod, textureData);
+                m_descriptorSet = descriptorSet(cod, textureData);
             } else if (!m_hasTexture && !textureData) {
                 // no need to update the descriptor set, but return true since the update is successful
                 return true;
@@ -242,8 +244,8 @@ namespace objectNoShadows {
             m_modelMatrix = modelMatrix;
         }
 
-        std::shared_ptr<vulkan::Buffer> const &bufferModelMatrix() override {
-            return m_uniformBuffer;
+        std::shared_ptr<vulkan::UniformSlot> const &uniformSlotModelMatrix() override {
+            return m_uniformSlot;
         }
 
         std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet(uint32_t id) override {
@@ -253,25 +255,24 @@ namespace objectNoShadows {
             return m_descriptorSet;
         }
 
+        uint32_t dynamicOffset(uint32_t) override { return m_uniformSlot->offset(); }
+
         glm::mat4 modelMatrix(uint32_t) override { return m_modelMatrix; }
 
         DrawObjectDataVulkan(std::shared_ptr<vulkan::Device> const &inDevice,
                 std::shared_ptr<CommonObjectDataVulkan> const &cod,
                 std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData,
-                std::shared_ptr<vulkan::DescriptorSet> inDescriptorSet,
-                std::shared_ptr<vulkan::Buffer> inBuffer,
+                std::shared_ptr<vulkan::DescriptorPools> inDescriptorPools,
+                std::shared_ptr<vulkan::UniformSlot> inUniformSlot,
                 glm::mat4 const &inModelMatrix)
                 : m_hasTexture{textureData != nullptr},
                   m_device{inDevice},
-                  m_descriptorSet{std::move(inDescriptorSet)},
-                  m_uniformBuffer{std::move(inBuffer)},
+                  m_descriptorPools{std::move(inDescriptorPools)},
+                  m_descriptorSet{},
+                  m_uniformSlot{std::move(inUniformSlot)},
                   m_modelMatrix{inModelMatrix}
         {
-            if (m_hasTexture) {
-                textureUpdateDescriptorSet(inDevice, cod, textureData);
-            } else {
-                colorUpdateDescriptorSet(inDevice, cod);
-            }
+            m_descriptorSet = descriptorSet(cod, textureData);
         }
 
         ~DrawObjectDataVulkan() override = default;
@@ -282,17 +283,22 @@ namespace objectNoShadows {
 
         bool m_hasTexture;
         std::shared_ptr<vulkan::Device> m_device;
+        std::shared_ptr<vulkan::DescriptorPools> m_descriptorPools;
         std::shared_ptr<vulkan::DescriptorSet> m_descriptorSet;
-        std::shared_ptr<vulkan::Buffer> m_uniformBuffer;
+        std::shared_ptr<vulkan::UniformSlot> m_uniformSlot;
         glm::mat4 m_modelMatrix;
 
+        std::shared_ptr<vulkan::DescriptorSet> descriptorSet(
+                std::shared_ptr<CommonObjectDataVulkan> const &cod,
+                std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData);
+
         void textureUpdateDescriptorSet(
-                std::shared_ptr<vulkan::Device> const &inDevice,
+                std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                 std::shared_ptr<CommonObjectDataVulkan> const &cod,
                 std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData);
 
         void colorUpdateDescriptorSet(
-                std::shared_ptr<vulkan::Device> const &inDevice,
+                std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                 std::shared_ptr<CommonObjectDataVulkan> const &cod);
     };
 
@@ -358,9 +364,9 @@ namespace objectNoShadows {
                 size_t descriptorSetID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-                std::string const &renderDetailsName) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs,
+                boost::optional<renderDetails::RenderDetailsID> const &renderDetailsID) override;
 
         bool structuralChangeNeeded(
                 std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails) override
@@ -406,7 +412,9 @@ namespace objectNoShadows {
                           surfaceDetails->renderPass, m_descriptorPoolsColor,
                           getBindingDescription(),
                           getAttributeDescriptions(),
-                          m_vertexShader, m_colorFragShader, m_pipelineTexture)}
+                          m_vertexShader, m_colorFragShader, m_pipelineTexture)},
+                  m_uniformArena{std::make_shared<vulkan::UniformArena>(
+                          m_device, sizeof (DrawObjectDataVulkan::PerObjectUBO))}
         {}
 
         ~RenderDetailsVulkan() override = default;
@@ -429,6 +437,8 @@ namespace objectNoShadows {
         std::shared_ptr<vulkan::DescriptorPools> m_descriptorPoolsColor;
         std::shared_ptr<vulkan::Pipeline> m_pipelineColor;
 
+        std::shared_ptr<vulkan::UniformArena> m_uniformArena;
+
         std::shared_ptr<CommonObjectDataVulkan> createCommonObjectData(
                 glm::mat4 const &preTransform,
                 renderDetails::ParametersPerspective const *parameters)
@@ -41,14 +41,14 @@ namespace objectWithShadows {
             throw std::runtime_error("Invalid render details parameter type.");
         }
 
-        if (shaders.size() != 3) {
+        if (shaders.size() != 4) {
             throw std::runtime_error("Wrong number of shaders passed to Object With Shadows Render Details.");
         }
 
         auto rd = std::make_shared<RenderDetailsGL>(
-                name, shaders[0], shaders[1], shaders[2],
+                name, shaders[0], shaders[1], shaders[2], shaders[3],
                 gameRequester, surfaceDetails->surfaceWidth, surfaceDetails->surfaceHeight,
-                surfaceDetails->useIntTexture);
+                surfaceDetails->useIntTexture, surfaceDetails->useInstancing);
 
         auto cod = std::make_shared<CommonObjectDataGL>(*parameters,
                 surfaceDetails->surfaceWidth / static_cast<float>(surfaceDetails->surfaceHeight));
@@ -115,8 +115,8 @@ namespace objectWithShadows {
             uint32_t modelMatrixID,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs)
     {
         glCullFace(GL_BACK);
         checkGraphicsError();
@@ -126,88 +126,99 @@ namespace objectWithShadows {
             throw std::runtime_error("Invalid common object data type");
         }
 
-        auto fb = cod->shadowsFramebuffer();
+        // the shadow map is always on texture unit 0 and the object's texture on unit 1.
+        glActiveTexture(GL_TEXTURE0);
+        checkGraphicsError();
+        glBindTexture(GL_TEXTURE_2D, cod->shadowsFramebuffer()->depthImage());
+        checkGraphicsError();
 
-        GLuint textureProgramID = m_textureProgram->programID();
-        GLuint colorProgramID = m_colorProgram->programID();
-        GLuint programID = textureProgramID;
+        renderDetails::GLProgram *program = nullptr;
         GLint MatrixID = -1;
         GLint normalMatrixID = -1;
-        GLint textureID = -1;
+        GLuint boundTexture = 0;
         for (auto it = beginZValRefs; it != endZValRefs; it++) {
             auto &drawObj = drawObjTable->drawObject(it->drawObjectReference);
             auto &modelData = drawObj->modelData();
             auto &textureData = drawObj->textureData();
-            if (it == beginZValRefs ||
-                (programID == textureProgramID && !textureData) ||
-                    (programID == colorProgramID && textureData)) {
-                programID = textureData ? textureProgramID : colorProgramID;
-                glUseProgram(programID);
-                checkGraphicsError();
-
-                auto projView = cod->getProjViewForLevel();
-
-                // the projection matrix * the view matrix
-                MatrixID = glGetUniformLocation(programID, "projView");
-                checkGraphicsError();
-                glm::mat4 projTimesView = projView.first * projView.second;
-                glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projTimesView[0][0]);
-                checkGraphicsError();
-
-                // the projection matrix * the view matrix from the light source point of view
-                auto projViewLight = projView.first * cod->getViewLightSource(0);
-                MatrixID = glGetUniformLocation(programID, "projViewLight");
-                checkGraphicsError();
-                glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projViewLight[0][0]);
-                checkGraphicsError();
-
-                GLint lightPosID = glGetUniformLocation(programID, "lightPos");
-                checkGraphicsError();
-                glm::vec3 lightPos = cod->getLightSource(0);
-                glUniform3fv(lightPosID, 1, &lightPos[0]);
-                checkGraphicsError();
-
-                textureID = glGetUniformLocation(programID, "texShadowMap");
-                checkGraphicsError();
-                glActiveTexture(GL_TEXTURE0);
-                checkGraphicsError();
-                glBindTexture(GL_TEXTURE_2D, fb->depthImage());
-                checkGraphicsError();
-                glUniform1i(textureID, 0);
-                checkGraphicsError();
+            bool instanced = drawObj->isInstanced();
+            if (instanced && !drawObj->instanceBuffer()) {
+                // all the instances were removed, nothing to draw.
+                continue;
+            }
 
-                MatrixID = glGetUniformLocation(programID, "model");
-                checkGraphicsError();
+            renderDetails::GLProgram *nextProgram;
+            if (instanced) {
+                nextProgram = textureData ? m_textureProgramInstanced.get() : m_colorProgramInstanced.get();
+            } else {
+                nextProgram = textureData ? m_textureProgram.get() : m_colorProgram.get();
+            }
 
-                normalMatrixID = glGetUniformLocation(programID, "normalMatrix");
+            if (program != nextProgram) {
+                program = nextProgram;
+                glUseProgram(program->programID());
                 checkGraphicsError();
 
-                if (textureData) {
-                    textureID = glGetUniformLocation(programID, "texSampler");
-                    checkGraphicsError();
+                if (program->commonUniformsNeedUpdate(cod->revision())) {
+                    loadCommonUniforms(*program, *cod, textureData != nullptr);
                 }
+
+                MatrixID = program->uniformLocation("model");
+                normalMatrixID = program->uniformLocation("normalMatrix");
             }
 
-            if (textureData) {
+            if (textureData && textureData->handle() != boundTexture) {
+                boundTexture = textureData->handle();
                 glActiveTexture(GL_TEXTURE1);
                 checkGraphicsError();
-                glBindTexture(GL_TEXTURE_2D, textureData->handle());
-                checkGraphicsError();
-                glUniform1i(textureID, 1);
+                glBindTexture(GL_TEXTURE_2D, boundTexture);
                 checkGraphicsError();
             }
 
-            auto objData = drawObj->objData(it->drawObjectDataReference.get());
+            // instances share one draw object data, its model matrix is applied to all of them.
+            auto objData = instanced ?
+                    drawObj->instancedObjData() :
+                    drawObj->objData(it->drawObjectDataReference.get());
             auto modelMatrix = objData->modelMatrix(modelMatrixID);
 
             glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &modelMatrix[0][0]);
             checkGraphicsError();
 
-            glm::mat4 normalMatrix = glm::transpose(glm::inverse(modelMatrix));
+            auto normalMatrix = objData->normalMatrix(modelMatrixID);
             glUniformMatrix4fv(normalMatrixID, 1, GL_FALSE, &normalMatrix[0][0]);
             checkGraphicsError();
 
-            drawVertices(programID, modelData);
+            drawVertices(*program, modelData, false,
+                         instanced ? drawObj->instanceBuffer() : nullptr);
+        }
+    }
+
+    void RenderDetailsGL::loadCommonUniforms(
+            renderDetails::GLProgram &program,
+            CommonObjectDataGL &cod,
+            bool hasTexture)
+    {
+        auto projView = cod.getProjViewForLevel();
+
+        // the projection matrix * the view matrix
+        glm::mat4 projTimesView = projView.first * projView.second;
+        glUniformMatrix4fv(program.uniformLocation("projView"), 1, GL_FALSE, &projTimesView[0][0]);
+        checkGraphicsError();
+
+        // the projection matrix * the view matrix from the light source point of view
+        auto projViewLight = projView.first * cod.getViewLightSource(0);
+        glUniformMatrix4fv(program.uniformLocation("projViewLight"), 1, GL_FALSE, &projViewLight[0][0]);
+        checkGraphicsError();
+
+        glm::vec3 lightPos = cod.getLightSource(0);
+        glUniform3fv(program.uniformLocation("lightPos"), 1, &lightPos[0]);
+        checkGraphicsError();
+
+        glUniform1i(program.uniformLocation("texShadowMap"), 0);
+        checkGraphicsError();
+
+        if (hasTexture) {
+            glUniform1i(program.uniformLocation("texSampler"), 1);
+            checkGraphicsError();
         }
     }
 
@@ -216,12 +227,16 @@ namespace objectWithShadows {
             char const *vertShaderFile,
             char const *textureFragShaderFile,
             char const *colorFragShaderFile,
+            char const *instancedVertShaderFile,
             std::shared_ptr<GameRequester> const &inGameRequester,
-            uint32_t inWidth, uint32_t inHeight, bool usesIntSurface)
+            uint32_t inWidth, uint32_t inHeight, bool usesIntSurface, bool useInstancing)
         : renderDetails::RenderDetailsGL(inWidth, inHeight, usesIntSurface),
         m_renderDetailsName{name},
+        m_useInstancing{useInstancing},
         m_textureProgram{},
-        m_colorProgram{}
+        m_colorProgram{},
+        m_textureProgramInstanced{},
+        m_colorProgramInstanced{}
     {
         auto vertexShader = cacheShader(inGameRequester, vertShaderFile, GL_VERTEX_SHADER);
         auto textureFragShader = cacheShader(inGameRequester, textureFragShaderFile, GL_FRAGMENT_SHADER);
@@ -231,12 +246,20 @@ namespace objectWithShadows {
                 std::vector{vertexShader, textureFragShader});
         m_colorProgram = std::make_shared<renderDetails::GLProgram>(
                 std::vector{vertexShader, colorFragShader});
+
+        auto instancedVertexShader = cacheShader(inGameRequester, instancedVertShaderFile, GL_VERTEX_SHADER);
+        m_textureProgramInstanced = std::make_shared<renderDetails::GLProgram>(
+                std::vector{instancedVertexShader, textureFragShader});
+        m_colorProgramInstanced = std::make_shared<renderDetails::GLProgram>(
+                std::vector{instancedVertexShader, colorFragShader});
     }
 
     static char constexpr const *SHADER_VERT_GL_FILE = "shaders/shaderGL.vert";
     static char constexpr const *TEXTURE_SHADER_FRAG_GL_FILE = "shaders/shaderGL.frag";
     static char constexpr const *COLOR_SHADER_FRAG_GL_FILE = "shaders/colorGL.frag";
+    static char constexpr const *SHADER_INSTANCED_VERT_GL_FILE = "shaders/shaderInstancedGL.vert";
     RegisterGL<renderDetails::RenderDetailsGL, RenderDetailsGL> registerGL(
             objectWithShadowsRenderDetailsName,
-            std::vector<char const *>{SHADER_VERT_GL_FILE, TEXTURE_SHADER_FRAG_GL_FILE, COLOR_SHADER_FRAG_GL_FILE});
+            std::vector<char const *>{SHADER_VERT_GL_FILE, TEXTURE_SHADER_FRAG_GL_FILE,
+                                      COLOR_SHADER_FRAG_GL_FILE, SHADER_INSTANCED_VERT_GL_FILE});
 } // objectWithShadows
@@ -63,19 +63,26 @@ namespace objectWithShadows {
             return m_modelMatrix;
         }
 
+        glm::mat4 normalMatrix(uint32_t) override {
+            return m_normalMatrix;
+        }
+
         void update(glm::mat4 const &modelMatrix) override {
             m_modelMatrix = modelMatrix;
+            m_normalMatrix = glm::transpose(glm::inverse(m_modelMatrix));
         }
 
         DrawObjectDataGL(
                 glm::mat4 inModelMatrix)
                 : renderDetails::DrawObjectDataGL{},
-                  m_modelMatrix{std::move(inModelMatrix)}
+                  m_modelMatrix{std::move(inModelMatrix)},
+                  m_normalMatrix{glm::transpose(glm::inverse(m_modelMatrix))}
         {}
 
         ~DrawObjectDataGL() override = default;
     private:
         glm::mat4 m_modelMatrix;
+        glm::mat4 m_normalMatrix;
     };
 
     class RenderDetailsGL : public renderDetails::RenderDetailsGL {
@@ -100,30 +107,43 @@ namespace objectWithShadows {
                 uint32_t modelMatrixID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs) override;
+
+        bool supportsInstancing() override { return m_useInstancing; }
 
         RenderDetailsGL(
                 char const *name,
                 char const *vertShader,
                 char const *textureFragShader,
                 char const *colorFragShader,
+                char const *instancedVertShader,
                 std::shared_ptr<GameRequester> const &inGameRequester,
                 uint32_t inWidth,
                 uint32_t inHeight,
-                bool usesIntSurface);
+                bool usesIntSurface,
+                bool useInstancing);
 
         ~RenderDetailsGL() override = default;
 
     private:
         char const *m_renderDetailsName;
+        bool m_useInstancing;
         std::shared_ptr<renderDetails::GLProgram> m_textureProgram;
         std::shared_ptr<renderDetails::GLProgram> m_colorProgram;
+        std::shared_ptr<renderDetails::GLProgram> m_textureProgramInstanced;
+        std::shared_ptr<renderDetails::GLProgram> m_colorProgramInstanced;
 
         static renderDetails::ReferenceGL createReference(
                 std::shared_ptr<renderDetails::RenderDetailsGL> rd,
                 std::shared_ptr<CommonObjectDataGL> cod);
 
+        // load the uniforms that come from the common object data into the program.
+        static void loadCommonUniforms(
+                renderDetails::GLProgram &program,
+                CommonObjectDataGL &cod,
+                bool hasTexture);
+
     };
 }
 
@@ -24,19 +24,34 @@
 #include "../../renderLoader/registerVulkan.hpp"
 
 namespace objectWithShadows {
+    std::shared_ptr<vulkan::DescriptorSet> DrawObjectDataVulkan::descriptorSet(
+            std::shared_ptr<CommonObjectDataVulkan> const &cod,
+            std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData)
+    {
+        return cod->descriptorSets().descriptorSet(m_descriptorPools, m_uniformSlot, textureData,
+                [this, &cod, &textureData](std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet) {
+                    if (textureData) {
+                        textureUpdateDescriptorSet(descriptorSet, cod, textureData);
+                    } else {
+                        colorUpdateDescriptorSet(descriptorSet, cod);
+                    }
+                });
+    }
+
     /* descriptor set for the MVP matrix and texture samplers */
     void DrawObjectDataVulkan::colorUpdateDescriptorSet(
-            std::shared_ptr<vulkan::Device> const &inDevice,
+            std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
             std::shared_ptr<CommonObjectDataVulkan> const &cod)
     {
+        // the model matrix is at a dynamic offset in the arena buffer.
         VkDescriptorBufferInfo bufferInfo = {};
-        bufferInfo.buffer = m_uniformBuffer->buffer();
+        bufferInfo.buffer = m_uniformSlot->buffer()->buffer();
         bufferInfo.offset = 0;
         bufferInfo.range = sizeof (PerObjectUBO);
 
         std::array<VkWriteDescriptorSet, 4> descriptorWrites = {};
         descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[0].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[0].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
 
         /* must be the same as the binding in the vertex shader */
         descriptorWrites[0].dstBinding = 0;
@@ -44,7 +59,7 @@ namespace objectWithShadows {
         /* index into the array of descriptors */
         descriptorWrites[0].dstArrayElement = 0;
 
-        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 
         /* how many array elements you want to update */
         descriptorWrites[0].descriptorCount = 1;
@@ -63,10 +78,10 @@ namespace objectWithShadows {
         commonInfo.range = cod->cameraBufferSize();
 
         descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[1].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[1].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[1].dstBinding = 1;
         descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[1].descriptorCount = 1;
         descriptorWrites[1].pBufferInfo = &commonInfo;
 
@@ -76,10 +91,10 @@ namespace objectWithShadows {
         bufferLightingSource.range = cod->lightingBufferSize();
 
         descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[2].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[2].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[2].dstBinding = 2;
         descriptorWrites[2].dstArrayElement = 0;
-        descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[2].descriptorCount = 1;
         descriptorWrites[2].pBufferInfo = &bufferLightingSource;
 
@@ -89,32 +104,31 @@ namespace objectWithShadows {
         shadowInfo.sampler = getVkType<>(cod->shadowsSampler()->sampler().get());
 
         descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[3].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[3].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[3].dstBinding = 3;
         descriptorWrites[3].dstArrayElement = 0;
         descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         descriptorWrites[3].descriptorCount = 1;
         descriptorWrites[3].pImageInfo = &shadowInfo;
 
-        vkUpdateDescriptorSets(inDevice->logicalDevice().get(),
-                               static_cast<uint32_t>(descriptorWrites.size()),
-                               descriptorWrites.data(), 0, nullptr);
+        descriptorSet->updateDescriptors(static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data());
     }
 
     /* descriptor set for the MVP matrix and texture samplers */
     void DrawObjectDataVulkan::textureUpdateDescriptorSet(
-            std::shared_ptr<vulkan::Device> const &inDevice,
+            std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
             std::shared_ptr<CommonObjectDataVulkan> const &cod,
             std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData)
     {
+        // the model matrix is at a dynamic offset in the arena buffer.
         VkDescriptorBufferInfo bufferInfo = {};
-        bufferInfo.buffer = m_uniformBuffer->buffer();
+        bufferInfo.buffer = m_uniformSlot->buffer()->buffer();
         bufferInfo.offset = 0;
         bufferInfo.range = sizeof (PerObjectUBO);
 
         std::array<VkWriteDescriptorSet, 5> descriptorWrites = {};
         descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[0].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[0].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
 
         /* must be the same as the binding in the vertex shader */
         descriptorWrites[0].dstBinding = 0;
@@ -122,7 +136,7 @@ namespace objectWithShadows {
         /* index into the array of descriptors */
         descriptorWrites[0].dstArrayElement = 0;
 
-        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 
         /* how many array elements you want to update */
         descriptorWrites[0].descriptorCount = 1;
@@ -141,10 +155,10 @@ namespace objectWithShadows {
         commonInfo.range = cod->cameraBufferSize();
 
         descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[1].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[1].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[1].dstBinding = 1;
         descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[1].descriptorCount = 1;
         descriptorWrites[1].pBufferInfo = &commonInfo;
 
@@ -154,7 +168,7 @@ namespace objectWithShadows {
         imageInfo.sampler = getVkType<>(textureData->sampler()->sampler().get());
 
         descriptorWrites[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[2].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[2].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[2].dstBinding = 2;
         descriptorWrites[2].dstArrayElement = 0;
         descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
@@ -167,10 +181,10 @@ namespace objectWithShadows {
         bufferLightingSource.range = cod->lightingBufferSize();
 
         descriptorWrites[3].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[3].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[3].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[3].dstBinding = 3;
         descriptorWrites[3].dstArrayElement = 0;
-        descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[3].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[3].descriptorCount = 1;
         descriptorWrites[3].pBufferInfo = &bufferLightingSource;
 
@@ -180,16 +194,14 @@ namespace objectWithShadows {
         shadowInfo.sampler = getVkType<>(cod->shadowsSampler()->sampler().get());
 
         descriptorWrites[4].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[4].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[4].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[4].dstBinding = 4;
         descriptorWrites[4].dstArrayElement = 0;
         descriptorWrites[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
         descriptorWrites[4].descriptorCount = 1;
         descriptorWrites[4].pImageInfo = &shadowInfo;
 
-        vkUpdateDescriptorSets(inDevice->logicalDevice().get(),
-                               static_cast<uint32_t>(descriptorWrites.size()),
-                               descriptorWrites.data(), 0, nullptr);
+        descriptorSet->updateDescriptors(static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data());
     }
 
     /* for accessing data other than the vertices from the shaders */
@@ -197,7 +209,7 @@ namespace objectWithShadows {
         /* model matrix - different for each object */
         VkDescriptorSetLayoutBinding modelMatrixBinding = {};
         modelMatrixBinding.binding = 0;
-        modelMatrixBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        modelMatrixBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         modelMatrixBinding.descriptorCount = 1;
 
         /* only accessing the MVP matrix from the vertex shader */
@@ -207,7 +219,7 @@ namespace objectWithShadows {
         /* view and projection matrix - the same for all objects */
         VkDescriptorSetLayoutBinding commonDataBinding = {};
         commonDataBinding.binding = 1;
-        commonDataBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        commonDataBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         commonDataBinding.descriptorCount = 1;
         commonDataBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
         commonDataBinding.pImmutableSamplers = nullptr; // Optional
@@ -222,7 +234,7 @@ namespace objectWithShadows {
 
         VkDescriptorSetLayoutBinding lightingSourceBinding = {};
         lightingSourceBinding.binding = 3;
-        lightingSourceBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        lightingSourceBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         lightingSourceBinding.descriptorCount = 1;
         lightingSourceBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
         lightingSourceBinding.pImmutableSamplers = nullptr;
@@ -264,7 +276,7 @@ namespace objectWithShadows {
         /* model matrix - different for each object */
         VkDescriptorSetLayoutBinding modelMatrixBinding = {};
         modelMatrixBinding.binding = 0;
-        modelMatrixBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        modelMatrixBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         modelMatrixBinding.descriptorCount = 1;
 
         /* only accessing the MVP matrix from the vertex shader */
@@ -274,14 +286,14 @@ namespace objectWithShadows {
         /* view and projection matrix - the same for all objects */
         VkDescriptorSetLayoutBinding commonDataBinding = {};
         commonDataBinding.binding = 1;
-        commonDataBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        commonDataBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         commonDataBinding.descriptorCount = 1;
         commonDataBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
         commonDataBinding.pImmutableSamplers = nullptr; // Optional
 
         VkDescriptorSetLayoutBinding lightingSourceBinding = {};
         lightingSourceBinding.binding = 2;
-        lightingSourceBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        lightingSourceBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         lightingSourceBinding.descriptorCount = 1;
         lightingSourceBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
         lightingSourceBinding.pImmutableSamplers = nullptr;
@@ -328,31 +340,23 @@ namespace objectWithShadows {
                            glm::mat4 const &modelMatrix) ->
                         std::shared_ptr<renderDetails::DrawObjectDataVulkan>
                 {
-                    std::shared_ptr<vulkan::Buffer> modelMatrixBuffer{};
+                    std::shared_ptr<vulkan::UniformSlot> modelMatrixSlot{};
                     if (sharingDOD) {
-                        modelMatrixBuffer = sharingDOD->bufferModelMatrix();
+                        modelMatrixSlot = sharingDOD->uniformSlotModelMatrix();
                     } else {
-                        modelMatrixBuffer = renderDetails::createUniformBuffer(
-                                rd->device(), sizeof (DrawObjectDataVulkan::PerObjectUBO));
+                        modelMatrixSlot = rd->m_uniformArena->allocate();
                         DrawObjectDataVulkan::PerObjectUBO perObjectUbo{};
                         perObjectUbo.modelMatrix = modelMatrix;
-                        modelMatrixBuffer->copyRawTo(
+                        modelMatrixSlot->copyRawTo(
                                 &perObjectUbo, sizeof(DrawObjectDataVulkan::PerObjectUBO));
                     }
 
-                    std::shared_ptr<vulkan::DescriptorSet> ds;
-                    if (textureData) {
-                        ds = rd->m_descriptorPoolsTexture->allocateDescriptor();
-                    } else {
-                        ds = rd->m_descriptorPoolsColor->allocateDescriptor();
-                    }
-
                     return std::make_shared<DrawObjectDataVulkan>(
                             rd->device(),
                             cod,
                             textureData,
-                            std::move(ds),
-                            std::move(modelMatrixBuffer),
+                            textureData ? rd->m_descriptorPoolsTexture : rd->m_descriptorPoolsColor,
+                            std::move(modelMatrixSlot),
                             modelMatrix);
                 });
 
@@ -372,19 +376,22 @@ namespace objectWithShadows {
             size_t descriptorSetID,
             std::shared_ptr<renderDetails::CommonObjectData> const &,
             std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-            std::string const &)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs,
+            boost::optional<renderDetails::RenderDetailsID> const &)
     {
         initializeCommandBufferDrawObjects(
                 commandBuffer, descriptorSetID, m_pipelineColor,
-                m_pipelineTexture, drawObjTable, beginZValRefs, endZValRefs);
+                m_pipelineTexture, drawObjTable, beginZValRefs, endZValRefs, false, "",
+                m_pipelineColorInstanced, m_pipelineTextureInstanced);
     }
 
     void RenderDetailsVulkan::reload(
             std::shared_ptr<GameRequester> const &gameRequester,
             std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails)
     {
+        m_pipelineColorInstanced.reset();
+        m_pipelineTextureInstanced.reset();
         m_pipelineColor.reset();
         m_pipelineTexture.reset();
 
@@ -404,12 +411,28 @@ namespace objectWithShadows {
                 getBindingDescription(),
                 getAttributeDescriptions(),
                 m_vertexShader, m_colorShader, m_pipelineTexture);
+
+        m_pipelineTextureInstanced = std::make_shared<vulkan::Pipeline>(
+                gameRequester, m_device, VkExtent2D{m_surfaceWidth, m_surfaceHeight},
+                surfaceDetails->renderPass, m_descriptorPoolsTexture,
+                getBindingDescriptionsInstanced(),
+                getAttributeDescriptionsInstanced(),
+                m_instancedVertexShader, m_textureShader, m_pipelineTexture);
+
+        m_pipelineColorInstanced = std::make_shared<vulkan::Pipeline>(
+                gameRequester, m_device, VkExtent2D{m_surfaceWidth, m_surfaceHeight},
+                surfaceDetails->renderPass, m_descriptorPoolsColor,
+                getBindingDescriptionsInstanced(),
+                getAttributeDescriptionsInstanced(),
+                m_instancedVertexShader, m_colorShader, m_pipelineTexture);
     }
 
     char constexpr const *SHADER_VERT_VK_FILE = "shaders/shader.vert.spv";
     char constexpr const *TEXTURE_SHADER_FRAG_VK_FILE = "shaders/shader.frag.spv";
     char constexpr const *COLOR_SHADER_FRAG_VK_FILE = "shaders/colorShader.frag.spv";
+    char constexpr const *SHADER_INSTANCED_VERT_VK_FILE = "shaders/shaderInstanced.vert.spv";
     RegisterVulkan<renderDetails::RenderDetailsVulkan, RenderDetailsVulkan> registerVulkan(
             objectWithShadowsRenderDetailsName,
-            std::vector<char const *>{SHADER_VERT_VK_FILE, TEXTURE_SHADER_FRAG_VK_FILE, COLOR_SHADER_FRAG_VK_FILE});
+            std::vector<char const *>{SHADER_VERT_VK_FILE, TEXTURE_SHADER_FRAG_VK_FILE,
+                                      COLOR_SHADER_FRAG_VK_FILE, SHADER_INSTANCED_VERT_VK_FILE});
 }
@@ -43,6 +43,7 @@ namespace objectWithShadows {
         std::shared_ptr<vulkan::Buffer> const &lightingBuffer() { return m_lightingSourceBuffer; }
         uint32_t lightingBufferSize() { return sizeof (CommonFragmentUBO); }
         std::shared_ptr<vulkan::ImageSampler> const &shadowsSampler() { return m_shadowsSampler; }
+        renderDetails::DescriptorSetCache &descriptorSets() { return m_descriptorSets; }
 
         std::pair<glm::mat4, glm::mat4> getProjViewForLevel() override {
             /* perspective matrix: takes the perspective projection, the aspect ratio, near and far
@@ -87,6 +88,7 @@ namespace objectWithShadows {
         std::shared_ptr<vulkan::Buffer> m_cameraBuffer;
         std::shared_ptr<vulkan::Buffer> m_lightingSourceBuffer;
         std::shared_ptr<vulkan::ImageSampler> m_shadowsSampler;
+        renderDetails::DescriptorSetCache m_descriptorSets;
 
         void doUpdate() {
             CommonVertexUBO commonUbo;
@@ -119,13 +121,13 @@ namespace objectWithShadows {
 
         TextureDescriptorSetLayout(std::shared_ptr<vulkan::Device> inDevice)
                 : m_device(inDevice) {
-            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[0].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[1].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             m_poolSizes[2].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[3].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolSizes[4].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             m_poolSizes[4].descriptorCount = m_numberOfDescriptorSetsInPool;
@@ -166,11 +168,11 @@ namespace objectWithShadows {
 
         ColorDescriptorSetLayout(std::shared_ptr<vulkan::Device> inDevice)
                 : m_device(inDevice) {
-            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[0].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[1].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[2].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolSizes[3].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             m_poolSizes[3].descriptorCount = m_numberOfDescriptorSetsInPool;
@@ -206,7 +208,7 @@ namespace objectWithShadows {
         void update(glm::mat4 const &inModelMatrix) override {
             PerObjectUBO ubo{};
             ubo.modelMatrix = inModelMatrix;
-            m_uniformBuffer->copyRawTo(&ubo, sizeof (ubo));
+            m_uniformSlot->copyRawTo(&ubo, sizeof (ubo));
             m_modelMatrix = inModelMatrix;
         }
 
@@ -219,7 +221,7 @@ namespace objectWithShadows {
                 if (cod == nullptr) {
                     return false;
                 }
-                textureUpdateDescriptorSet(m_device, cod, textureData);
+                m_descriptorSet = descriptorSet(cod, textureData);
             } else if (!m_hasTexture && !textureData) {
                 // no need to update the descriptor set, but return true since the update is successful
                 return true;
@@ -231,33 +233,32 @@ namespace objectWithShadows {
             m_modelMatrix = modelMatrix;
         }
 
-        std::shared_ptr<vulkan::Buffer> const &bufferModelMatrix() override {
-            return m_uniformBuffer;
+        std::shared_ptr<vulkan::UniformSlot> const &uniformSlotModelMatrix() override {
+            return m_uniformSlot;
         }
 
         std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet(uint32_t) override {
             return m_descriptorSet;
         }
 
+        uint32_t dynamicOffset(uint32_t) override { return m_uniformSlot->offset(); }
+
         glm::mat4 modelMatrix(uint32_t) override { return m_modelMatrix; }
 
         DrawObjectDataVulkan(std::shared_ptr<vulkan::Device> const &inDevice,
                 std::shared_ptr<CommonObjectDataVulkan> const &cod,
                 std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData,
-                std::shared_ptr<vulkan::DescriptorSet> inDescriptorSet,
-                std::shared_ptr<vulkan::Buffer> inBuffer,
+                std::shared_ptr<vulkan::DescriptorPools> inDescriptorPools,
+                std::shared_ptr<vulkan::UniformSlot> inUniformSlot,
                 glm::mat4 const &inModelMatrix)
                 : m_hasTexture{textureData != nullptr},
                   m_device{inDevice},
-                  m_descriptorSet{std::move(inDescriptorSet)},
-                  m_uniformBuffer{std::move(inBuffer)},
+                  m_descriptorPools{std::move(inDescriptorPools)},
+                  m_descriptorSet{},
+                  m_uniformSlot{std::move(inUniformSlot)},
                   m_modelMatrix{inModelMatrix}
         {
-            if (m_hasTexture) {
-                textureUpdateDescriptorSet(inDevice, cod, textureData);
-            } else {
-                colorUpdateDescriptorSet(inDevice, cod);
-            }
+            m_descriptorSet = descriptorSet(cod, textureData);
         }
 
         ~DrawObjectDataVulkan() override = default;
@@ -268,17 +269,25 @@ namespace objectWithShadows {
 
         bool m_hasTexture;
         std::shared_ptr<vulkan::Device> m_device;
+
+        // the texture descriptor pools if the object has a texture, the color ones otherwise.
+        std::shared_ptr<vulkan::DescriptorPools> m_descriptorPools;
         std::shared_ptr<vulkan::DescriptorSet> m_descriptorSet;
-        std::shared_ptr<vulkan::Buffer> m_uniformBuffer;
+        std::shared_ptr<vulkan::UniformSlot> m_uniformSlot;
         glm::mat4 m_modelMatrix;
 
+        // the descriptor set shared by the objects with the same arena buffer and texture.
+        std::shared_ptr<vulkan::DescriptorSet> descriptorSet(
+                std::shared_ptr<CommonObjectDataVulkan> const &cod,
+                std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData);
+
         void textureUpdateDescriptorSet(
-                std::shared_ptr<vulkan::Device> const &inDevice,
+                std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                 std::shared_ptr<CommonObjectDataVulkan> const &cod,
                 std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData);
 
         void colorUpdateDescriptorSet(
-                std::shared_ptr<vulkan::Device> const &inDevice,
+                std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                 std::shared_ptr<CommonObjectDataVulkan> const &cod);
     };
 
@@ -300,12 +309,12 @@ namespace objectWithShadows {
                 throw std::runtime_error("Invalid render details parameter type.");
             }
 
-            if (shaders.size() != 3) {
+            if (shaders.size() != 4) {
                 throw std::runtime_error("Wrong number of shaders for Object with Shadows Render Details.");
             }
 
             auto rd = std::make_shared<RenderDetailsVulkan>(name,
-                    shaders[0], shaders[1], shaders[2],
+                    shaders[0], shaders[1], shaders[2], shaders[3],
                     gameRequester, inDevice, nullptr, surfaceDetails);
 
             auto cod = rd->createCommonObjectData(surfaceDetails->preTransform, parameters);
@@ -344,9 +353,9 @@ namespace objectWithShadows {
                 size_t descriptorSetID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-                std::string const &renderDetailsName) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs,
+                boost::optional<renderDetails::RenderDetailsID> const &renderDetailsID) override;
 
         bool structuralChangeNeeded(
                 std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails) override
@@ -362,11 +371,14 @@ namespace objectWithShadows {
 
         std::shared_ptr<vulkan::Device> const &device() override { return m_device; }
 
+        bool supportsInstancing() override { return true; }
+
         RenderDetailsVulkan(
                 char const *name,
                 char const *vertexShader,
                 char const *textureShader,
                 char const *colorShader,
+                char const *instancedVertexShader,
                 std::shared_ptr<GameRequester> const &gameRequester,
                 std::shared_ptr<vulkan::Device> const &inDevice,
                 std::shared_ptr<vulkan::Pipeline> const &basePipeline,
@@ -376,6 +388,7 @@ namespace objectWithShadows {
                   m_vertexShader{vertexShader},
                   m_textureShader{textureShader},
                   m_colorShader{colorShader},
+                  m_instancedVertexShader{instancedVertexShader},
                   m_device{inDevice},
                   m_descriptorSetLayoutTexture{std::make_shared<TextureDescriptorSetLayout>(m_device)},
                   m_descriptorPoolsTexture{std::make_shared<vulkan::DescriptorPools>(m_device, m_descriptorSetLayoutTexture)},
@@ -392,7 +405,21 @@ namespace objectWithShadows {
                           surfaceDetails->renderPass, m_descriptorPoolsColor,
                           getBindingDescription(),
                           getAttributeDescriptions(),
-                          m_vertexShader, m_colorShader, m_pipelineTexture)}
+                          m_vertexShader, m_colorShader, m_pipelineTexture)},
+                  m_pipelineTextureInstanced{std::make_shared<vulkan::Pipeline>(
+                          gameRequester, m_device, VkExtent2D{m_surfaceWidth, m_surfaceHeight},
+                          surfaceDetails->renderPass, m_descriptorPoolsTexture,
+                          getBindingDescriptionsInstanced(),
+                          getAttributeDescriptionsInstanced(),
+                          m_instancedVertexShader, m_textureShader, m_pipelineTexture)},
+                  m_pipelineColorInstanced{std::make_shared<vulkan::Pipeline>(
+                          gameRequester, m_device, VkExtent2D{m_surfaceWidth, m_surfaceHeight},
+                          surfaceDetails->renderPass, m_descriptorPoolsColor,
+                          getBindingDescriptionsInstanced(),
+                          getAttributeDescriptionsInstanced(),
+                          m_instancedVertexShader, m_colorShader, m_pipelineTexture)},
+                  m_uniformArena{std::make_shared<vulkan::UniformArena>(
+                          m_device, sizeof (DrawObjectDataVulkan::PerObjectUBO))}
         {}
 
         ~RenderDetailsVulkan() override = default;
@@ -402,6 +429,7 @@ namespace objectWithShadows {
         char const *m_vertexShader;
         char const *m_textureShader;
         char const *m_colorShader;
+        char const *m_instancedVertexShader;
         std::shared_ptr<vulkan::Device> m_device;
 
         /* object with texture resources */
@@ -414,6 +442,13 @@ namespace objectWithShadows {
         std::shared_ptr<vulkan::DescriptorPools> m_descriptorPoolsColor;
         std::shared_ptr<vulkan::Pipeline> m_pipelineColor;
 
+        /* pipelines for instanced draw objects, they use the same descriptor sets as above */
+        std::shared_ptr<vulkan::Pipeline> m_pipelineTextureInstanced;
+        std::shared_ptr<vulkan::Pipeline> m_pipelineColorInstanced;
+
+        // the model matrices of all the draw objects.
+        std::shared_ptr<vulkan::UniformArena> m_uniformArena;
+
         std::shared_ptr<CommonObjectDataVulkan> createCommonObjectData(
                 glm::mat4 const &preTransform,
                 renderDetails::ParametersObjectWithShadowsVulkan const *parameters)
@@ -20,6 +20,7 @@
 #ifndef AMAZING_LABYRINTH_RENDER_DETAILS_HPP
 #define AMAZING_LABYRINTH_RENDER_DETAILS_HPP
 
+#include <atomic>
 #include <memory>
 #include <functional>
 #include <glm/glm.hpp>
@@ -28,7 +29,15 @@
 #include "../levelTracker/levelTracker.hpp"
 #include "../levelDrawer/textureTable/textureLoader.hpp"
 
+template <typename traits>
+class RenderLoader;
+
 namespace renderDetails {
+    // Identifies a type of render details.  It is assigned when the render details type is
+    // registered with RegisterGL or RegisterVulkan and is a small integer (an index into the
+    // registered render details) so that it can be used to index arrays.
+    using RenderDetailsID = uint32_t;
+
     // only really matters to the shadowsChaining render details.  It tells the Draw Object data
     // which descriptor set to return when requested.  MODEL_MATRIX_ID_MAIN is for the main
     // render details descriptor set, and MODEL_MATRIX_ID_SHADOWS is for the shadows render details
@@ -42,22 +51,36 @@ namespace renderDetails {
     public:
         CommonObjectData(std::shared_ptr<Parameters> const &parameters)
             : m_nearPlane{parameters->nearPlane},
-            m_farPlane{parameters->farPlane} {}
+            m_farPlane{parameters->farPlane},
+            m_revision{nextRevision()} {}
 
         CommonObjectData(Parameters const &parameters)
                 : m_nearPlane{parameters.nearPlane},
-                  m_farPlane{parameters.farPlane} {}
+                  m_farPlane{parameters.farPlane},
+                  m_revision{nextRevision()} {}
 
         virtual void update(renderDetails::Parameters const &parameters) {
             m_nearPlane = parameters.nearPlane;
             m_farPlane = parameters.farPlane;
+            m_revision = nextRevision();
         }
 
+        // changes every time the common object data changes and is never the same for two
+        // different common object data.  Used to tell if uniforms loaded from this data are out
+        // of date.
+        uint64_t revision() { return m_revision; }
+
         virtual ~CommonObjectData() = default;
 
     protected:
         float m_nearPlane;
         float m_farPlane;
+        uint64_t m_revision;
+
+        static uint64_t nextRevision() {
+            static std::atomic<uint64_t> revision{0};
+            return ++revision;
+        }
     };
 
     class CommonObjectDataLightSources : public CommonObjectData {
@@ -78,6 +101,7 @@ namespace renderDetails {
 
         void update(renderDetails::ParametersLightSources const &parameters)  {
             m_lightSources = parameters.lightingSources;
+            m_revision = nextRevision();
         }
 
         CommonObjectDataLightSources(std::shared_ptr<ParametersLightSources> const &parameters)
@@ -257,7 +281,8 @@ namespace renderDetails {
     public:
         RenderDetails(uint32_t inWidth, uint32_t inHeight)
                 : m_surfaceWidth{inWidth},
-                  m_surfaceHeight{inHeight}
+                  m_surfaceHeight{inHeight},
+                  m_id{0}
         {}
 
         uint32_t width() { return m_surfaceWidth; }
@@ -265,11 +290,26 @@ namespace renderDetails {
 
         virtual std::string nameString() = 0;
 
+        // use this instead of nameString() to tell render details apart when drawing.
+        RenderDetailsID id() const { return m_id; }
+
+        // true if the render details can draw instanced draw objects (one draw call for all the
+        // model matrices of the draw object).  Most render details can't.
+        virtual bool supportsInstancing() { return false; }
+
         virtual ~RenderDetails() = default;
 
     protected:
         uint32_t m_surfaceWidth;
         uint32_t m_surfaceHeight;
+
+    private:
+        // The render loader is the only one that creates render details.  It sets the ID from
+        // the registration of the render details type.
+        template <typename traits>
+        friend class ::RenderLoader;
+
+        RenderDetailsID m_id;
     };
 }
 #endif // AMAZING_LABYRINTH_RENDER_DETAILS_HPP
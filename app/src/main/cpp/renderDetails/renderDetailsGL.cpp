@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <array>
 
 #include <GLES3/gl3.h>
 
@@ -33,9 +34,10 @@ namespace renderDetails {
     size_t RenderDetailsGL::m_timesTillPrune = 0;
 
     void RenderDetailsGL::drawVertices(
-            GLuint programID,
+            GLProgram &program,
             std::shared_ptr<levelDrawer::ModelDataGL> const &modelData,
-            bool useVertexNormals)
+            bool useVertexNormals,
+            std::shared_ptr<levelDrawer::InstanceBufferGL> const &instanceBuffer)
     {
         GLuint vertexBuffer = useVertexNormals ?
                 modelData->vertexBufferWithVertexNormals() :
@@ -54,7 +56,7 @@ namespace renderDetails {
 
         // 1st attribute buffer : colors
         // color is only needed when doing the final render, not the depth texture render
-        GLint colorID = glGetAttribLocation(programID, "inColor");
+        GLint colorID = program.attributeLocation("inColor");
         if (colorID != -1) {
             glVertexAttribPointer(
                     colorID,                          // The position of the attribute in the shader.
@@ -70,7 +72,7 @@ namespace renderDetails {
         }
 
         // attribute: position
-        GLint position = glGetAttribLocation(programID, "inPosition");
+        GLint position = program.attributeLocation("inPosition");
         glVertexAttribPointer(
                 position,                        // The position of the attribute in the shader.
                 3,                               // size
@@ -85,7 +87,7 @@ namespace renderDetails {
 
         // Send in the texture coordinates
         // only required for the final rendering.
-        GLint texCoordID = glGetAttribLocation(programID, "inTexCoord");
+        GLint texCoordID = program.attributeLocation("inTexCoord");
         if (texCoordID != -1) {
             glVertexAttribPointer(
                     texCoordID,                       // The position of the attribute in the shader
@@ -100,7 +102,7 @@ namespace renderDetails {
             checkGraphicsError();
         }
 
-        GLint normCoordID = glGetAttribLocation(programID, "inNormal");
+        GLint normCoordID = program.attributeLocation("inNormal");
         if (normCoordID != -1) {
             checkGraphicsError();
             glVertexAttribPointer(
@@ -116,9 +118,57 @@ namespace renderDetails {
             checkGraphicsError();
         }
 
-        // Draw the triangles !
-        glDrawElements(GL_TRIANGLES, nbrIndices, GL_UNSIGNED_INT, 0);
-        checkGraphicsError();
+        // the per instance attributes.  A mat4 attribute takes up four attribute locations, one
+        // for each column.  They advance once per instance instead of once per vertex.
+        std::vector<GLuint> instanceAttributes;
+        if (instanceBuffer) {
+            glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer->buffer());
+            checkGraphicsError();
+
+            std::array<std::pair<char const *, size_t>, 2> matrices = {
+                    std::make_pair("inModel", offsetof(levelDrawer::InstanceData, model)),
+                    std::make_pair("inNormalMatrix", offsetof(levelDrawer::InstanceData, normalMatrix))};
+            for (auto const &matrix : matrices) {
+                GLint matrixID = program.attributeLocation(matrix.first);
+                if (matrixID == -1) {
+                    continue;
+                }
+                for (GLuint i = 0; i < 4; i++) {
+                    GLuint columnID = static_cast<GLuint>(matrixID) + i;
+                    glVertexAttribPointer(
+                            columnID,                               // The position of the attribute in the shader
+                            4,                                      // size
+                            GL_FLOAT,                               // type
+                            GL_FALSE,                               // normalized?
+                            sizeof(levelDrawer::InstanceData),      // stride
+                            (void *) (matrix.second + i * sizeof(glm::vec4))  // array buffer offset
+                    );
+                    checkGraphicsError();
+                    glEnableVertexAttribArray(columnID);
+                    checkGraphicsError();
+                    glVertexAttribDivisor(columnID, 1);
+                    checkGraphicsError();
+                    instanceAttributes.push_back(columnID);
+                }
+            }
+
+            glDrawElementsInstanced(GL_TRIANGLES, nbrIndices, GL_UNSIGNED_INT, 0,
+                                    instanceBuffer->numberInstances());
+            checkGraphicsError();
+        } else {
+            // Draw the triangles !
+            glDrawElements(GL_TRIANGLES, nbrIndices, GL_UNSIGNED_INT, 0);
+            checkGraphicsError();
+        }
+
+        // the divisor is part of the attribute state, reset it so that the next draw that uses
+        // these locations per vertex works.
+        for (auto columnID : instanceAttributes) {
+            glVertexAttribDivisor(columnID, 0);
+            checkGraphicsError();
+            glDisableVertexAttribArray(columnID);
+            checkGraphicsError();
+        }
 
         glDisableVertexAttribArray(position);
         checkGraphicsError();
@@ -21,6 +21,7 @@
 #define AMAZING_LABYRINTH_RENDER_DETAILS_GL_HPP
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include <GLES3/gl3.h>
 #include <boost/variant.hpp>
@@ -55,6 +56,13 @@ namespace renderDetails {
 
     class DrawObjectDataGL : public DrawObjectData {
     public:
+        // transpose(inverse(model matrix)), used to transform the normals.  GLSL 100 does not have
+        // inverse, so the render details that do lighting pass it in.  The draw object data of
+        // those render details compute it when the model matrix changes instead of every draw.
+        virtual glm::mat4 normalMatrix(uint32_t modelMatrixID) {
+            return glm::transpose(glm::inverse(modelMatrix(modelMatrixID)));
+        }
+
         // no work is needed for this function in GL.  Just return true to indicate that it
         // succeeded
         virtual bool updateTextureData(
@@ -132,9 +140,49 @@ namespace renderDetails {
     public:
         GLuint programID() { return m_programID; }
 
+        // the location of the uniform.  GL is only asked for it the first time.
+        GLint uniformLocation(char const *name) {
+            auto it = m_uniformLocations.find(name);
+            if (it != m_uniformLocations.end()) {
+                return it->second;
+            }
+
+            GLint location = glGetUniformLocation(m_programID, name);
+            checkGraphicsError();
+            m_uniformLocations.emplace(name, location);
+            return location;
+        }
+
+        // the location of the vertex attribute.  GL is only asked for it the first time.
+        GLint attributeLocation(char const *name) {
+            auto it = m_attributeLocations.find(name);
+            if (it != m_attributeLocations.end()) {
+                return it->second;
+            }
+
+            GLint location = glGetAttribLocation(m_programID, name);
+            m_attributeLocations.emplace(name, location);
+            return location;
+        }
+
+        /* Uniform values are part of the program's state so the uniforms that come from the
+         * common object data (the projection, view, lighting, etc) only need to be loaded into
+         * the program again if the common object data changed or this program was last used with
+         * another common object data.  Returns true if they need to be loaded and records that
+         * they will be.
+         */
+        bool commonUniformsNeedUpdate(uint64_t commonObjectDataRevision) {
+            if (m_commonObjectDataRevision == commonObjectDataRevision) {
+                return false;
+            }
+            m_commonObjectDataRevision = commonObjectDataRevision;
+            return true;
+        }
+
         GLProgram(
                 std::vector<std::shared_ptr<Shader>> shaders)
-                : m_programID{}
+                : m_programID{},
+                  m_commonObjectDataRevision{0}
         {
             if (shaders.empty()) {
                 throw std::runtime_error("A shader was incorrectly initialized when loading the GL program.");
@@ -178,6 +226,9 @@ namespace renderDetails {
 
     private:
         GLuint m_programID;
+        std::unordered_map<std::string, GLint> m_uniformLocations;
+        std::unordered_map<std::string, GLint> m_attributeLocations;
+        uint64_t m_commonObjectDataRevision;
     };
 
     class RenderDetailsGL : public RenderDetails {
@@ -202,9 +253,9 @@ namespace renderDetails {
                 uint32_t,
                 levelDrawer::CommonObjectDataList const &,
                 levelDrawer::DrawObjectTableGList const &,
-                std::set<levelDrawer::ZValueReference> const & /* starter */,
-                std::set<levelDrawer::ZValueReference> const & /* level */,
-                std::set<levelDrawer::ZValueReference> const & /* finisher */)
+                levelDrawer::ZValueReferences const & /* starter */,
+                levelDrawer::ZValueReferences const & /* level */,
+                levelDrawer::ZValueReferences const & /* finisher */)
         {}
 
         virtual bool structuralChangeNeeded(
@@ -226,8 +277,8 @@ namespace renderDetails {
                 uint32_t modelMatrixID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs) = 0;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs) = 0;
 
         virtual bool overrideClearColor(glm::vec4 &) {
             return false;
@@ -244,10 +295,13 @@ namespace renderDetails {
         ~RenderDetailsGL() override = default;
 
     protected:
+        // if instanceBuffer is set, all the instances in it are drawn with one instanced draw.
+        // The program must have the inModel and inNormalMatrix attributes in this case.
         static void drawVertices(
-                GLuint programID,
+                GLProgram &program,
                 std::shared_ptr<levelDrawer::ModelDataGL> const &modelData,
-                bool useVertexNormals = false);
+                bool useVertexNormals = false,
+                std::shared_ptr<levelDrawer::InstanceBufferGL> const &instanceBuffer = nullptr);
 
         std::shared_ptr<Shader> cacheShader(
                 std::shared_ptr<GameRequester> const &inGameRequester,
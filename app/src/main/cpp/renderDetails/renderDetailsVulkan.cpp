@@ -25,9 +25,45 @@
 namespace renderDetails {
     std::shared_ptr<vulkan::Buffer> createUniformBuffer(
             std::shared_ptr<vulkan::Device> const &device, size_t bufferSize) {
+        /* each frame in flight reads its own slice of the uniform buffer so that frames still in
+         * flight keep reading the values they were recorded with.
+         */
         return std::shared_ptr<vulkan::Buffer>{new vulkan::Buffer{device, bufferSize,
                                                                   VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                                                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT}};
+                                                                  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, true}};
+    }
+
+    std::shared_ptr<vulkan::DescriptorSet> DescriptorSetCache::descriptorSet(
+            std::shared_ptr<vulkan::DescriptorPools> const &descriptorPools,
+            std::shared_ptr<vulkan::UniformSlot> const &slot,
+            std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData,
+            UpdateDescriptorSet const &updateDescriptorSet)
+    {
+        Key key{descriptorPools.get(), slot->buffer()->buffer(), textureData.get()};
+        auto it = m_descriptorSets.find(key);
+        if (it != m_descriptorSets.end() &&
+            (textureData == nullptr || !it->second.textureData.expired()))
+        {
+            auto descriptorSet = it->second.descriptorSet.lock();
+            if (descriptorSet != nullptr) {
+                return descriptorSet;
+            }
+        }
+
+        // forget the descriptor sets that are not used anymore.
+        for (auto itEntry = m_descriptorSets.begin(); itEntry != m_descriptorSets.end();) {
+            if (itEntry->second.descriptorSet.expired()) {
+                itEntry = m_descriptorSets.erase(itEntry);
+            } else {
+                itEntry++;
+            }
+        }
+
+        auto descriptorSet = descriptorPools->allocateDescriptor();
+        updateDescriptorSet(descriptorSet);
+        descriptorSet->setPerObjectBuffer(slot->buffer()->buffer());
+        m_descriptorSets[key] = Entry{descriptorSet, textureData};
+        return descriptorSet;
     }
 
     VkVertexInputBindingDescription RenderDetailsVulkan::getBindingDescription() {
@@ -37,8 +73,8 @@ namespace renderDetails {
         bindingDescription.stride = sizeof(levelDrawer::Vertex);
 
         /* move to the next data entry after each vertex.  VK_VERTEX_INPUT_RATE_INSTANCE
-         * moves to the next data entry after each instance, but we are not using instanced
-         * rendering
+         * moves to the next data entry after each instance, it is used for the per instance
+         * data at binding 1 (see getBindingDescriptionsInstanced).
          */
         bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
 
@@ -76,16 +112,55 @@ namespace renderDetails {
         return attributeDescriptions;
     }
 
+    std::vector<VkVertexInputBindingDescription> RenderDetailsVulkan::getBindingDescriptionsInstanced() {
+        std::vector<VkVertexInputBindingDescription> bindingDescriptions = {getBindingDescription()};
+
+        /* the model matrix and normal matrix for each instance, we move to the next entry after
+         * each instance is drawn.
+         */
+        VkVertexInputBindingDescription instanceBindingDescription = {};
+        instanceBindingDescription.binding = 1;
+        instanceBindingDescription.stride = sizeof(levelDrawer::InstanceData);
+        instanceBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+        bindingDescriptions.push_back(instanceBindingDescription);
+
+        return bindingDescriptions;
+    }
+
+    std::vector<VkVertexInputAttributeDescription> RenderDetailsVulkan::getAttributeDescriptionsInstanced() {
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions = getAttributeDescriptions();
+
+        /* A mat4 takes up 4 locations in the vertex shader, one for each column.  The model
+         * matrix uses locations 4-7 and the normal matrix uses locations 8-11.
+         */
+        uint32_t location = static_cast<uint32_t>(attributeDescriptions.size());
+        for (auto offset : {offsetof(levelDrawer::InstanceData, model),
+                            offsetof(levelDrawer::InstanceData, normalMatrix)}) {
+            for (uint32_t i = 0; i < 4; i++) {
+                VkVertexInputAttributeDescription attributeDescription = {};
+                attributeDescription.binding = 1;
+                attributeDescription.location = location++;
+                attributeDescription.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                attributeDescription.offset = static_cast<uint32_t>(offset + i * sizeof(glm::vec4));
+                attributeDescriptions.push_back(attributeDescription);
+            }
+        }
+
+        return attributeDescriptions;
+    }
+
     void RenderDetailsVulkan::initializeCommandBufferDrawObjects(
             VkCommandBuffer const &commandBuffer,
             size_t descriptorSetID,
             std::shared_ptr<vulkan::Pipeline> const &colorPipeline,
             std::shared_ptr<vulkan::Pipeline> const &texturePipeline,
             std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjectTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs,
             bool useVertexNormals,
-            std::string const &renderDetailsName)
+            boost::optional<RenderDetailsID> const &renderDetailsID,
+            std::shared_ptr<vulkan::Pipeline> const &colorPipelineInstanced,
+            std::shared_ptr<vulkan::Pipeline> const &texturePipelineInstanced)
     {
         if (!drawObjectTable || beginZValRefs == endZValRefs) {
             return;
@@ -93,47 +168,50 @@ namespace renderDetails {
 
         VkDeviceSize offsets[1] = {0};
 
-        std::pair<levelDrawer::DrawObjReference, levelDrawer::DrawObjDataReference> prev;
+        boost::optional<levelDrawer::DrawObjReference> prevObjRef;
         uint32_t nbrIndices = 0;
-        bool usingColorPipeline = true;
+        std::vector<uint32_t> dynamicOffsets;
+        vulkan::Pipeline *boundPipeline = nullptr;
         for (auto it = beginZValRefs; it != endZValRefs; it++) {
             auto const &drawObj = drawObjectTable->drawObject(it->drawObjectReference);
             auto ref = drawObjectTable->renderDetailsReference(it->drawObjectReference);
-            if (!renderDetailsName.empty() && renderDetailsName != ref.renderDetails->nameString()) {
+            if (renderDetailsID && renderDetailsID.get() != ref.renderDetails->id()) {
                 continue;
             }
-            if (nbrIndices == 0 ||
-                it->drawObjectReference != prev.first || it->drawObjectDataReference != prev.second)
-            {
-                auto const &modelData = drawObj->modelData();
-                auto const &textureData = drawObj->textureData();
-
-                if (nbrIndices == 0) {
-                    /* bind the graphics pipeline to the command buffer, the second parameter tells Vulkan
-                     * that we are binding to a graphics pipeline.
-                     */
-                    if (texturePipeline && textureData) {
-                        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                          getVkType<>(texturePipeline->pipeline().get()));
-                        usingColorPipeline = false;
-                    } else {
-                        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                          getVkType<>(colorPipeline->pipeline().get()));
-                        usingColorPipeline = true;
-                    }
-                } else if (texturePipeline && textureData && usingColorPipeline) {
-                    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                      getVkType<>(texturePipeline->pipeline().get()));
-                    usingColorPipeline = false;
-                } else if (texturePipeline && !textureData && !usingColorPipeline) {
-                    // if we have a texture pipeline, we need to check to see if we should switch
-                    // to the color pipeline.  If we only have one pipeline (the color pipeline),
-                    // then we are already bound to it (when nbrIndices was 0), so no need to bind
-                    // here again.
-                    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                      getVkType<>(colorPipeline->pipeline().get()));
-                    usingColorPipeline = true;
+
+            auto const &textureData = drawObj->textureData();
+            bool instanced = drawObj->isInstanced();
+            if (instanced && !drawObj->instanceBuffer()) {
+                // all the instances were removed, nothing to draw.
+                continue;
+            }
+
+            /* pick the pipeline for this object: texture or color, instanced or not.  If we only
+             * have the color pipeline, use it for objects with textures too.
+             */
+            vulkan::Pipeline *pipeline;
+            if (instanced) {
+                pipeline = texturePipelineInstanced && textureData ?
+                        texturePipelineInstanced.get() : colorPipelineInstanced.get();
+                if (pipeline == nullptr) {
+                    throw std::runtime_error("Instanced draw object used with render details that do not support instancing.");
                 }
+            } else {
+                pipeline = texturePipeline && textureData ?
+                        texturePipeline.get() : colorPipeline.get();
+            }
+
+            if (pipeline != boundPipeline) {
+                /* bind the graphics pipeline to the command buffer, the second parameter tells Vulkan
+                 * that we are binding to a graphics pipeline.
+                 */
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                  getVkType<>(pipeline->pipeline().get()));
+                boundPipeline = pipeline;
+            }
+
+            if (prevObjRef == boost::none || it->drawObjectReference != prevObjRef.get()) {
+                auto const &modelData = drawObj->modelData();
 
                 VkBuffer vertexBuffer = useVertexNormals ?
                                         modelData->vertexBufferWithVertexNormals()->cbuffer() :
@@ -150,31 +228,40 @@ namespace renderDetails {
                 vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, offsets);
                 vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
 
-                prev.first = it->drawObjectReference;
-                prev.second = it->drawObjectDataReference.get();
-            }
+                if (instanced) {
+                    VkBuffer instanceBuffer = drawObj->instanceBuffer()->buffer()->cbuffer();
+                    vkCmdBindVertexBuffers(commandBuffer, 1, 1, &instanceBuffer, offsets);
+                }
 
-            auto const &drawObjData = drawObj->objData(it->drawObjectDataReference.get());
+                prevObjRef = it->drawObjectReference;
+            }
 
-            VkPipelineLayout pipelineLayout =
-                    usingColorPipeline ? getVkType<>(colorPipeline->layout().get()) : getVkType<>(texturePipeline->layout().get());
+            auto const &drawObjData = instanced ?
+                    drawObj->instancedObjData() :
+                    drawObj->objData(it->drawObjectDataReference.get());
 
-            /* The MVP matrix and texture samplers */
-            VkDescriptorSet descriptorSet =
-                    getVkType<>(drawObjData->descriptorSet(descriptorSetID)->descriptorSet().get());
+            /* The MVP matrix and texture samplers.  The dynamic offsets select the slice of the
+             * uniform buffers for the frame, and the model matrix is at the draw object's offset
+             * in that slice of the uniform arena buffer.
+             */
+            auto const &objDescriptorSet = drawObjData->descriptorSet(descriptorSetID);
+            VkDescriptorSet descriptorSet = getVkType<>(objDescriptorSet->descriptorSet().get());
+            objDescriptorSet->dynamicOffsets(
+                    drawObjData->dynamicOffset(static_cast<uint32_t>(descriptorSetID)), dynamicOffsets);
             vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                    pipelineLayout, 0, 1, &descriptorSet, 0,
-                                    nullptr);
+                                    getVkType<>(pipeline->layout().get()), 0, 1, &descriptorSet,
+                                    static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 
             /* indexed draw command:
              * parameter 1 - Command buffer for the draw command
              * parameter 2 - the number of indices (the vertex count)
-             * parameter 3 - the instance count, use 1 because we are not using instanced rendering
+             * parameter 3 - the instance count, 1 unless the draw object is instanced
              * parameter 4 - offset into the index buffer
              * parameter 5 - offset to add to the indices in the index buffer
              * parameter 6 - offset for instance rendering
              */
-            vkCmdDrawIndexed(commandBuffer, nbrIndices, 1, 0, 0, 0);
+            uint32_t nbrInstances = instanced ? drawObj->instanceBuffer()->numberInstances() : 1;
+            vkCmdDrawIndexed(commandBuffer, nbrIndices, nbrInstances, 0, 0, 0);
         }
     }
-}
\ No newline at end of file
+}
@@ -21,7 +21,10 @@
 #ifndef AMAZING_LABYRINTH_RENDER_DETAILS_VULKAN_HPP
 #define AMAZING_LABYRINTH_RENDER_DETAILS_VULKAN_HPP
 
+#include <functional>
+#include <map>
 #include <memory>
+#include <tuple>
 #include <vector>
 #include <set>
 #include <glm/glm.hpp>
@@ -38,6 +41,36 @@ namespace renderDetails {
     std::shared_ptr<vulkan::Buffer> createUniformBuffer(
             std::shared_ptr<vulkan::Device> const &device, size_t bufferSize);
 
+    /* The descriptor sets of the draw objects of a common object data.  The per object uniforms
+     * are in a uniform arena (see vulkan::UniformArena) and are bound with a dynamic offset, so the
+     * draw objects with their uniforms in the same arena buffer and with the same texture (or
+     * no texture) share a descriptor set.  A descriptor set is freed when the last draw object
+     * using it is freed.
+     */
+    class DescriptorSetCache {
+    public:
+        using UpdateDescriptorSet = std::function<void(std::shared_ptr<vulkan::DescriptorSet> const &)>;
+
+        // updateDescriptorSet writes the descriptors of a newly allocated descriptor set.
+        std::shared_ptr<vulkan::DescriptorSet> descriptorSet(
+                std::shared_ptr<vulkan::DescriptorPools> const &descriptorPools,
+                std::shared_ptr<vulkan::UniformSlot> const &slot,
+                std::shared_ptr<levelDrawer::TextureDataVulkan> const &textureData,
+                UpdateDescriptorSet const &updateDescriptorSet);
+
+    private:
+        using Key = std::tuple<vulkan::DescriptorPools *, VkBuffer, levelDrawer::TextureDataVulkan *>;
+
+        struct Entry {
+            std::weak_ptr<vulkan::DescriptorSet> descriptorSet;
+
+            // so that a new texture at the address of a freed one does not match.
+            std::weak_ptr<levelDrawer::TextureDataVulkan> textureData;
+        };
+
+        std::map<Key, Entry> m_descriptorSets;
+    };
+
     struct ParametersObjectWithShadowsVulkan : public ParametersPerspective {
         std::shared_ptr<vulkan::ImageSampler> shadowsSampler;
 
@@ -87,9 +120,14 @@ namespace renderDetails {
         // the buffer is shared with another DrawObjectData (as in objectWithShadows and shadows).
         virtual void updateModelMatrixNoBufferUpdate(glm::mat4 const &modelMatrix) = 0;
 
-        virtual std::shared_ptr<vulkan::Buffer> const &bufferModelMatrix() = 0;
+        // the slot in a uniform arena with the model matrix.
+        virtual std::shared_ptr<vulkan::UniformSlot> const &uniformSlotModelMatrix() = 0;
+
         virtual std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet(uint32_t id) = 0;
 
+        // the offset of the per object uniforms in the arena buffer slice, see DescriptorSet::dynamicOffsets.
+        virtual uint32_t dynamicOffset(uint32_t id) = 0;
+
         ~DrawObjectDataVulkan() override = default;
     };
 
@@ -102,9 +140,9 @@ namespace renderDetails {
                 size_t /* descriptor set ID, not used */,
                 levelDrawer::CommonObjectDataList const &/* common object data */,
                 levelDrawer::DrawObjectTableVulkanList const &/* draw object table */,
-                std::set<levelDrawer::ZValueReference> const & /* starter */,
-                std::set<levelDrawer::ZValueReference> const & /* level */,
-                std::set<levelDrawer::ZValueReference> const & /* finisher */)
+                levelDrawer::ZValueReferences const & /* starter */,
+                levelDrawer::ZValueReferences const & /* level */,
+                levelDrawer::ZValueReferences const & /* finisher */)
         {}
 
         // For postprocessing results written to an image buffer whose contents are put in input.
@@ -126,19 +164,22 @@ namespace renderDetails {
                 size_t descriptorSetID,
                 std::shared_ptr<CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-                std::string const &renderDetailsName = "") = 0;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs,
+                boost::optional<RenderDetailsID> const &renderDetailsID = boost::none) = 0;
 
         /*
-         * renderDetailsName is left empty for most cases.  It is used to cast out any objects
-         * not using renderDetailsName for their draw.  In most cases, this is handled by the
+         * renderDetailsID is left empty for most cases.  It is used to cast out any objects
+         * not using the render details with that ID for their draw.  In most cases, this is handled by the
          * level drawer so that all objects already use the same render details.  But in a few cases
          * like executing the pre-draw commands for the dark chaining and shadows chaining, all
          * objects must be set up to be drawn with the same initializeCommandBufferDrawObjects call...
          * so, they must all use the same render details.  This says that having dark chaining and
          * shadows chaining in the same maze is not possible.  But one can use either of these with
          * object no shadows.
+         *
+         * colorPipelineInstanced and texturePipelineInstanced are used for instanced draw objects.
+         * They are only needed by render details that support instancing.
          */
         void initializeCommandBufferDrawObjects(
                 VkCommandBuffer const &commandBuffer,
@@ -146,10 +187,12 @@ namespace renderDetails {
                 std::shared_ptr<vulkan::Pipeline> const &colorPipeline,
                 std::shared_ptr<vulkan::Pipeline> const &texturePipeline,
                 std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjectTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs,
                 bool useVertexNormals = false,
-                std::string const &renderDetailsName = "");
+                boost::optional<RenderDetailsID> const &renderDetailsID = boost::none,
+                std::shared_ptr<vulkan::Pipeline> const &colorPipelineInstanced = nullptr,
+                std::shared_ptr<vulkan::Pipeline> const &texturePipelineInstanced = nullptr);
 
         virtual bool overrideClearColor(glm::vec4 &) {
             return false;
@@ -185,6 +228,11 @@ namespace renderDetails {
         VkVertexInputBindingDescription getBindingDescription();
 
         std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+
+        // binding 0 is the per vertex data and binding 1 is the per instance data.
+        std::vector<VkVertexInputBindingDescription> getBindingDescriptionsInstanced();
+
+        std::vector<VkVertexInputAttributeDescription> getAttributeDescriptionsInstanced();
     };
 
     using ReferenceVulkan = renderDetails::Reference<RenderDetailsVulkan, levelDrawer::TextureDataVulkan, renderDetails::DrawObjectDataVulkan>;
@@ -29,18 +29,24 @@ namespace shadows {
             char const *name,
             char const *vertexShaderFile,
             char const *fragmentShaderFile,
+            char const *instancedVertexShaderFile,
             std::shared_ptr<GameRequester> const &inGameRequester,
             uint32_t inWidth,
             uint32_t inHeight,
-            bool usesIntSurface)
+            bool usesIntSurface,
+            bool useInstancing)
             : renderDetails::RenderDetailsGL(inWidth, inHeight, usesIntSurface),
-              m_renderDetailsName{name}
+              m_renderDetailsName{name},
+              m_useInstancing{useInstancing}
     {
         auto vertexShader = cacheShader(inGameRequester, vertexShaderFile, GL_VERTEX_SHADER);
         auto fragmentShader = cacheShader(inGameRequester, fragmentShaderFile, GL_FRAGMENT_SHADER);
+        auto instancedVertexShader = cacheShader(inGameRequester, instancedVertexShaderFile, GL_VERTEX_SHADER);
 
         m_program = std::make_shared<renderDetails::GLProgram>(
-                std::vector{std::move(vertexShader), std::move(fragmentShader)});
+                std::vector{std::move(vertexShader), fragmentShader});
+        m_programInstanced = std::make_shared<renderDetails::GLProgram>(
+                std::vector{std::move(instancedVertexShader), std::move(fragmentShader)});
     }
 
     renderDetails::ReferenceGL RenderDetailsGL::loadNew(
@@ -57,14 +63,14 @@ namespace shadows {
             throw std::runtime_error("Invalid render details parameter type.");
         }
 
-        if (shaders.size() != 2) {
+        if (shaders.size() != 3) {
             throw std::runtime_error("Invalid number of shaders passed into Render Details.");
         }
 
         auto rd = std::make_shared<RenderDetailsGL>(
-                name, shaders[0], shaders[1],
+                name, shaders[0], shaders[1], shaders[2],
                 gameRequester, surfaceDetails->surfaceWidth, surfaceDetails->surfaceHeight,
-                surfaceDetails->useIntTexture);
+                surfaceDetails->useIntTexture, surfaceDetails->useInstancing);
 
         auto cod = std::make_shared<CommonObjectDataGL>(*parameters,
                 surfaceDetails->surfaceWidth / static_cast<float>(surfaceDetails->surfaceHeight));
@@ -131,53 +137,65 @@ namespace shadows {
             uint32_t modelMatrixID,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs)
     {
         auto cod = dynamic_cast<CommonObjectDataGL *>(commonObjectData.get());
         if (!cod) {
             throw std::runtime_error("Invalid common object data type");
         }
 
-        // set the shader to use
-        GLuint programID = m_program->programID();
-        glUseProgram(programID);
-        checkGraphicsError();
         glCullFace(GL_FRONT);
         checkGraphicsError();
 
         auto projView = cod->getProjViewForLevel();
 
-        GLint MatrixID;
-
         // the projection matrix * the view matrix
         glm::mat4 projTimesView = projView.first * projView.second;
-        MatrixID = glGetUniformLocation(programID, "projView");
-        checkGraphicsError();
-        glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projTimesView[0][0]);
-        checkGraphicsError();
-
-        MatrixID = glGetUniformLocation(programID, "model");
-        checkGraphicsError();
 
+        renderDetails::GLProgram *program = nullptr;
+        GLint MatrixID = -1;
         for (auto it = beginZValRefs; it != endZValRefs; it++) {
             auto drawObj = drawObjTable->drawObject(it->drawObjectReference);
             auto modelData = drawObj->modelData();
-
-            auto objData = drawObj->objData(it->drawObjectDataReference.get());
+            bool instanced = drawObj->isInstanced();
+            if (instanced && !drawObj->instanceBuffer()) {
+                // all the instances were removed, nothing to draw.
+                continue;
+            }
+
+            // set the shader to use
+            renderDetails::GLProgram *nextProgram = instanced ? m_programInstanced.get() : m_program.get();
+            if (program != nextProgram) {
+                program = nextProgram;
+                glUseProgram(program->programID());
+                checkGraphicsError();
+
+                MatrixID = program->uniformLocation("projView");
+                glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &projTimesView[0][0]);
+                checkGraphicsError();
+
+                MatrixID = program->uniformLocation("model");
+            }
+
+            auto objData = instanced ?
+                    drawObj->instancedObjData() :
+                    drawObj->objData(it->drawObjectDataReference.get());
             auto modelMatrix = objData->modelMatrix(modelMatrixID);
 
             glUniformMatrix4fv(MatrixID, 1, GL_FALSE, &modelMatrix[0][0]);
             checkGraphicsError();
 
-            drawVertices(programID, modelData);
+            drawVertices(*program, modelData, false,
+                         instanced ? drawObj->instanceBuffer() : nullptr);
         }
     }
 
     char constexpr const *DEPTH_VERT_FILE = "shaders/depthShaderGL.vert";
     char constexpr const *SIMPLE_FRAG_FILE = "shaders/simpleShadowsGL.frag";
+    char constexpr const *DEPTH_INSTANCED_VERT_FILE = "shaders/depthShaderInstancedGL.vert";
     RegisterGL<renderDetails::RenderDetailsGL, RenderDetailsGL> registerGL(
         shadowsRenderDetailsName,
-        std::vector<char const *>{DEPTH_VERT_FILE, SIMPLE_FRAG_FILE});
+        std::vector<char const *>{DEPTH_VERT_FILE, SIMPLE_FRAG_FILE, DEPTH_INSTANCED_VERT_FILE});
 
 } // namespace shadows
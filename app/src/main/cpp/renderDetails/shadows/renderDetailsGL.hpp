@@ -93,24 +93,30 @@ namespace shadows {
                 uint32_t modelMatrixID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs) override;
+
+        bool supportsInstancing() override { return m_useInstancing; }
 
         RenderDetailsGL(
                 char const *name,
                 char const *vertexShaderFile,
                 char const *fragmentShaderFile,
+                char const *instancedVertexShaderFile,
                 std::shared_ptr<GameRequester> const &inGameRequester,
                 uint32_t inWidth,
                 uint32_t inHeight,
-                bool usesIntSurface);
+                bool usesIntSurface,
+                bool useInstancing);
 
         ~RenderDetailsGL() override = default;
 
     private:
         char const *m_renderDetailsName;
+        bool m_useInstancing;
 
         std::shared_ptr<renderDetails::GLProgram> m_program;
+        std::shared_ptr<renderDetails::GLProgram> m_programInstanced;
 
         static renderDetails::ReferenceGL createReference(
                 std::shared_ptr<renderDetails::RenderDetailsGL> rd,
@@ -29,7 +29,7 @@ namespace shadows {
         /* model matrix */
         VkDescriptorSetLayoutBinding perObject = {};
         perObject.binding = 0;
-        perObject.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        perObject.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         perObject.descriptorCount = 1;
         perObject.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
         perObject.pImmutableSamplers = nullptr; // Optional
@@ -37,7 +37,7 @@ namespace shadows {
         /* the projection, view, and view light source matrix */
         VkDescriptorSetLayoutBinding commonData = {};
         commonData.binding = 1;
-        commonData.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        commonData.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         commonData.descriptorCount = 1;
         commonData.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
         commonData.pImmutableSamplers = nullptr;
@@ -66,16 +66,17 @@ namespace shadows {
     /* descriptor set for the MVP matrix and texture samplers */
     void
     DrawObjectDataVulkan::updateDescriptorSet(std::shared_ptr<vulkan::Device> const &inDevice,
+            std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
             std::shared_ptr<CommonObjectDataVulkan> const &inCommonObjectData)
     {
         VkDescriptorBufferInfo bufferInfo = {};
-        bufferInfo.buffer = m_uniformBuffer->buffer();
+        bufferInfo.buffer = m_uniformSlot->buffer()->buffer();
         bufferInfo.offset = 0;
         bufferInfo.range = sizeof (PerObjectUBO);
 
         std::array<VkWriteDescriptorSet, 2> descriptorWrites = {};
         descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[0].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[0].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
 
         /* must be the same as the binding in the vertex shader */
         descriptorWrites[0].dstBinding = 0;
@@ -83,7 +84,7 @@ namespace shadows {
         /* index into the array of descriptors */
         descriptorWrites[0].dstArrayElement = 0;
 
-        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 
         /* how many array elements you want to update */
         descriptorWrites[0].descriptorCount = 1;
@@ -102,15 +103,14 @@ namespace shadows {
         commonInfo.range = inCommonObjectData->cameraBufferSize();
 
         descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWrites[1].dstSet = getVkType<>(m_descriptorSet->descriptorSet().get());
+        descriptorWrites[1].dstSet = getVkType<>(descriptorSet->descriptorSet().get());
         descriptorWrites[1].dstBinding = 1;
         descriptorWrites[1].dstArrayElement = 0;
-        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         descriptorWrites[1].descriptorCount = 1;
         descriptorWrites[1].pBufferInfo = &commonInfo;
 
-        vkUpdateDescriptorSets(inDevice->logicalDevice().get(), descriptorWrites.size(),
-                               descriptorWrites.data(), 0, nullptr);
+        descriptorSet->updateDescriptors(static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data());
     }
 
     void RenderDetailsVulkan::addDrawCmdsToCommandBuffer(
@@ -118,13 +118,14 @@ namespace shadows {
             size_t descriptorSetID,
             std::shared_ptr<renderDetails::CommonObjectData> const &,
             std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-            std::string const &renderDetailsName)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs,
+            boost::optional<renderDetails::RenderDetailsID> const &renderDetailsID)
     {
         initializeCommandBufferDrawObjects(
                 commandBuffer, descriptorSetID, m_pipeline, nullptr,
-                drawObjTable, beginZValRefs, endZValRefs, false, renderDetailsName);
+                drawObjTable, beginZValRefs, endZValRefs, false, renderDetailsID,
+                m_pipelineInstanced, nullptr);
     }
 
     renderDetails::ReferenceVulkan RenderDetailsVulkan::createReference(
@@ -138,22 +139,20 @@ namespace shadows {
                            glm::mat4 const &modelMatrix) ->
                         std::shared_ptr<renderDetails::DrawObjectDataVulkan>
                 {
-                    std::shared_ptr<vulkan::Buffer> modelMatrixBuffer{};
+                    std::shared_ptr<vulkan::UniformSlot> modelMatrixSlot{};
                     if (sharingDOD) {
-                        modelMatrixBuffer = sharingDOD->bufferModelMatrix();
+                        modelMatrixSlot = sharingDOD->uniformSlotModelMatrix();
                     } else {
-                        modelMatrixBuffer = renderDetails::createUniformBuffer(rd->device(),
-                                                                sizeof (DrawObjectDataVulkan::PerObjectUBO));
+                        modelMatrixSlot = rd->m_uniformArena->allocate();
                         DrawObjectDataVulkan::PerObjectUBO perObjectUbo{};
                         perObjectUbo.modelMatrix = modelMatrix;
-                        modelMatrixBuffer->copyRawTo(&perObjectUbo,
-                                                     sizeof(DrawObjectDataVulkan::PerObjectUBO));
+                        modelMatrixSlot->copyRawTo(&perObjectUbo,
+                                                   sizeof(DrawObjectDataVulkan::PerObjectUBO));
                     }
 
-                    auto descriptorSet = rd->descriptorPools()->allocateDescriptor();
                     return std::make_shared<DrawObjectDataVulkan>(
-                            rd->device(), cod, std::move(descriptorSet),
-                            std::move(modelMatrixBuffer), modelMatrix);
+                            rd->device(), cod, rd->descriptorPools(), std::move(modelMatrixSlot),
+                            modelMatrix);
                 });
 
         ref.getProjViewForLevel = renderDetails::ReferenceVulkan::GetProjViewForLevel(
@@ -171,6 +170,7 @@ namespace shadows {
             std::shared_ptr<GameRequester> const &gameRequester,
             std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails)
     {
+        m_pipelineInstanced.reset();
         m_pipeline.reset();
 
         m_surfaceWidth = surfaceDetails->surfaceWidth;
@@ -183,11 +183,20 @@ namespace shadows {
                 getAttributeDescriptions(),
                 m_vertexShader, m_fragShader, nullptr,
                 VK_CULL_MODE_FRONT_BIT);
+
+        m_pipelineInstanced = std::make_shared<vulkan::Pipeline>(
+                gameRequester, m_device,
+                VkExtent2D{m_surfaceWidth, m_surfaceHeight},
+                surfaceDetails->renderPass, m_descriptorPools, getBindingDescriptionsInstanced(),
+                getAttributeDescriptionsInstanced(),
+                m_instancedVertexShader, m_fragShader, m_pipeline,
+                VK_CULL_MODE_FRONT_BIT);
     }
 
     char constexpr const *SHADOW_VERT_FILE = "shaders/depthShader.vert.spv";
     char constexpr const *SHADER_SIMPLE_FRAG_FILE = "shaders/simple.frag.spv";
+    char constexpr const *SHADOW_INSTANCED_VERT_FILE = "shaders/depthShaderInstanced.vert.spv";
     RegisterVulkan<renderDetails::RenderDetailsVulkan, RenderDetailsVulkan> registerVulkan(
             shadowsRenderDetailsName,
-            std::vector<char const *>{SHADOW_VERT_FILE, SHADER_SIMPLE_FRAG_FILE});
+            std::vector<char const *>{SHADOW_VERT_FILE, SHADER_SIMPLE_FRAG_FILE, SHADOW_INSTANCED_VERT_FILE});
 }
\ No newline at end of file
@@ -49,6 +49,8 @@ namespace shadows {
 
         uint32_t cameraBufferSize() { return sizeof(CommonUBO); }
 
+        renderDetails::DescriptorSetCache &descriptorSets() { return m_descriptorSets; }
+
         CommonObjectDataVulkan(
                 std::shared_ptr<vulkan::Buffer> buffer,
                 glm::mat4 preTransform,
@@ -91,6 +93,7 @@ namespace shadows {
         std::shared_ptr<vulkan::Buffer> m_camera;
         glm::mat4 m_preTransform;
         float m_aspectRatio;
+        renderDetails::DescriptorSetCache m_descriptorSets;
     };
 
     /* for passing data other than the vertex data to the vertex shader */
@@ -100,13 +103,14 @@ namespace shadows {
         void update(glm::mat4 const &inModelMatrix) override {
             PerObjectUBO ubo{};
             ubo.modelMatrix = inModelMatrix;
-            m_uniformBuffer->copyRawTo(&ubo, sizeof(ubo));
+            m_uniformSlot->copyRawTo(&ubo, sizeof(ubo));
             m_modelMatrix = inModelMatrix;
         }
 
         bool hasTexture() override { return false; }
-        std::shared_ptr<vulkan::Buffer> const &bufferModelMatrix() override { return m_uniformBuffer; }
+        std::shared_ptr<vulkan::UniformSlot> const &uniformSlotModelMatrix() override { return m_uniformSlot; }
         std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet(uint32_t) override { return m_descriptorSet; }
+        uint32_t dynamicOffset(uint32_t) override { return m_uniformSlot->offset(); }
         glm::mat4 modelMatrix(uint32_t) override { return m_modelMatrix; }
 
         void updateModelMatrixNoBufferUpdate(glm::mat4 const &modelMatrix) override {
@@ -115,14 +119,18 @@ namespace shadows {
 
         DrawObjectDataVulkan(std::shared_ptr<vulkan::Device> const &inDevice,
                              std::shared_ptr<CommonObjectDataVulkan> const &inCommonObjectData,
-                             std::shared_ptr<vulkan::DescriptorSet> inDescriptorSet,
-                             std::shared_ptr<vulkan::Buffer> inUniformBuffer,
+                             std::shared_ptr<vulkan::DescriptorPools> const &descriptorPools,
+                             std::shared_ptr<vulkan::UniformSlot> inUniformSlot,
                              glm::mat4 const &inModelMatrix)
-                : m_descriptorSet{std::move(inDescriptorSet)},
-                  m_uniformBuffer{std::move(inUniformBuffer)},
+                : m_descriptorSet{},
+                  m_uniformSlot{std::move(inUniformSlot)},
                   m_modelMatrix{inModelMatrix}
         {
-            updateDescriptorSet(inDevice, inCommonObjectData);
+            m_descriptorSet = inCommonObjectData->descriptorSets().descriptorSet(
+                    descriptorPools, m_uniformSlot, nullptr,
+                    [this, &inDevice, &inCommonObjectData](std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet) {
+                        updateDescriptorSet(inDevice, descriptorSet, inCommonObjectData);
+                    });
         }
 
         ~DrawObjectDataVulkan() override = default;
@@ -133,10 +141,11 @@ namespace shadows {
         };
 
         std::shared_ptr<vulkan::DescriptorSet> m_descriptorSet;
-        std::shared_ptr<vulkan::Buffer> m_uniformBuffer;
+        std::shared_ptr<vulkan::UniformSlot> m_uniformSlot;
         glm::mat4 m_modelMatrix;
 
         void updateDescriptorSet(std::shared_ptr<vulkan::Device> const &inDevice,
+                std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet,
                 std::shared_ptr<CommonObjectDataVulkan> const &inCommonObjectData);
     };
 
@@ -144,9 +153,9 @@ namespace shadows {
     public:
         DescriptorSetLayout(std::shared_ptr<vulkan::Device> inDevice)
                 : m_device(inDevice) {
-            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[0].descriptorCount = m_numberOfDescriptorSetsInPool;
-            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            m_poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
             m_poolSizes[1].descriptorCount = m_numberOfDescriptorSetsInPool;
             m_poolInfo = {};
             m_poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -199,12 +208,12 @@ namespace shadows {
                 throw std::runtime_error("Invalid render details parameter type.");
             }
 
-            if (shaders.size() != 2) {
+            if (shaders.size() != 3) {
                 throw std::runtime_error("Invalid number of shaders passed into Render Details.");
             }
 
             auto rd = std::make_shared<RenderDetailsVulkan>(
-                    name, shaders[0], shaders[1],
+                    name, shaders[0], shaders[1], shaders[2],
                     gameRequester, inDevice, nullptr, surfaceDetails);
 
             auto cod = rd->createCommonObjectData(surfaceDetails->preTransform, parameters);
@@ -243,9 +252,9 @@ namespace shadows {
                 size_t descriptorSetID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-                std::string const &renderDetailsName) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs,
+                boost::optional<renderDetails::RenderDetailsID> const &renderDetailsID) override;
 
         bool structuralChangeNeeded(
                 std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails) override
@@ -262,10 +271,13 @@ namespace shadows {
             return m_descriptorPools;
         }
 
+        bool supportsInstancing() override { return true; }
+
         RenderDetailsVulkan(
                 char const *name,
                 char const *vertexShader,
                 char const *fragmentShader,
+                char const *instancedVertexShader,
                 std::shared_ptr<GameRequester> const &gameRequester,
                 std::shared_ptr<vulkan::Device> const &inDevice,
                 std::shared_ptr<vulkan::Pipeline> const &basePipeline,
@@ -274,10 +286,14 @@ namespace shadows {
                   m_renderDetailsName{name},
                   m_vertexShader{vertexShader},
                   m_fragShader{fragmentShader},
+                  m_instancedVertexShader{instancedVertexShader},
                   m_device{inDevice},
                   m_descriptorSetLayout{std::make_shared<DescriptorSetLayout>(m_device)},
                   m_descriptorPools{std::make_shared<vulkan::DescriptorPools>(m_device, m_descriptorSetLayout)},
-                  m_pipeline{}
+                  m_pipeline{},
+                  m_pipelineInstanced{},
+                  m_uniformArena{std::make_shared<vulkan::UniformArena>(
+                          m_device, sizeof (DrawObjectDataVulkan::PerObjectUBO))}
         {
             VkExtent2D extent{m_surfaceWidth, m_surfaceHeight};
             m_pipeline = std::make_shared<vulkan::Pipeline>(
@@ -287,6 +303,13 @@ namespace shadows {
                     getAttributeDescriptions(),
                     m_vertexShader, m_fragShader,
                     basePipeline, VK_CULL_MODE_FRONT_BIT);
+            m_pipelineInstanced = std::make_shared<vulkan::Pipeline>(
+                    gameRequester, m_device,
+                    extent,
+                    surfaceDetails->renderPass, m_descriptorPools, getBindingDescriptionsInstanced(),
+                    getAttributeDescriptionsInstanced(),
+                    m_instancedVertexShader, m_fragShader,
+                    m_pipeline, VK_CULL_MODE_FRONT_BIT);
         }
 
         ~RenderDetailsVulkan() override = default;
@@ -294,12 +317,19 @@ namespace shadows {
         char const *m_renderDetailsName;
         char const *m_vertexShader;
         char const *m_fragShader;
+        char const *m_instancedVertexShader;
 
         std::shared_ptr<vulkan::Device> m_device;
 
         std::shared_ptr<DescriptorSetLayout> m_descriptorSetLayout;
         std::shared_ptr<vulkan::DescriptorPools> m_descriptorPools;
         std::shared_ptr<vulkan::Pipeline> m_pipeline;
+        std::shared_ptr<vulkan::Pipeline> m_pipelineInstanced;
+
+        /* the model matrices of the draw objects that do not share the model matrix of an
+         * objectWithShadows draw object.
+         */
+        std::shared_ptr<vulkan::UniformArena> m_uniformArena;
 
         static renderDetails::ReferenceVulkan createReference(
                 std::shared_ptr<RenderDetailsVulkan> rd,
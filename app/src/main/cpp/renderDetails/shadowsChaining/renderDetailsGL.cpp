@@ -39,7 +39,8 @@ namespace shadowsChaining {
         }
 
         auto rd = std::make_shared<RenderDetailsGL>(name,
-                surfaceDetails->useIntTexture, surfaceDetails->surfaceWidth, surfaceDetails->surfaceHeight);
+                surfaceDetails->useIntTexture, surfaceDetails->surfaceWidth, surfaceDetails->surfaceHeight,
+                surfaceDetails->useBlitFramebuffer);
 
         auto parametersShadows = std::make_shared<renderDetails::ParametersPerspective>(*parameters);
         parametersShadows->viewPoint = parametersShadows->lightingSources[0];
@@ -111,6 +112,11 @@ namespace shadowsChaining {
 
         m_framebufferShadows = std::make_shared<graphicsGL::Framebuffer>(
                 m_surfaceWidth, m_surfaceHeight, colorImageFormats);
+        if (m_useStaticShadowsCache) {
+            m_framebufferStaticShadows = std::make_shared<graphicsGL::Framebuffer>(
+                    m_surfaceWidth, m_surfaceHeight, colorImageFormats);
+        }
+        m_shadowsCache.invalidate();
     }
 
     renderDetails::ReferenceGL RenderDetailsGL::createReference(
@@ -153,28 +159,80 @@ namespace shadowsChaining {
             uint32_t /* unused matrix ID */,
             levelDrawer::CommonObjectDataList const &commonObjectDataList,
             levelDrawer::DrawObjectTableGList const &drawObjTableList,
-            std::set<levelDrawer::ZValueReference> const &,
-            std::set<levelDrawer::ZValueReference> const &levelZValues,
-            std::set<levelDrawer::ZValueReference> const &)
+            levelDrawer::ZValueReferences const &,
+            levelDrawer::ZValueReferences const &levelZValues,
+            levelDrawer::ZValueReferences const &)
     {
         // get the shadows common object data
         auto codLevel = dynamic_cast<CommonObjectDataGL*>(
                 commonObjectDataList[levelDrawer::ObjectType::LEVEL].get());
 
-        glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferShadows->fbo());
-        checkGraphicsError();
+        if (!m_useStaticShadowsCache) {
+            glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferShadows->fbo());
+            checkGraphicsError();
+
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClearDepthf(1.0f);
+            checkGraphicsError();
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            checkGraphicsError();
+
+            m_shadowsRenderDetails->draw(
+                    renderDetails::MODEL_MATRIX_ID_SHADOWS,
+                    codLevel->shadowsCOD(),
+                    drawObjTableList[levelDrawer::ObjectType::LEVEL],
+                    levelZValues.begin(), levelZValues.end());
+
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            checkGraphicsError();
+            return;
+        }
+
+        if (!m_shadowsCache.update<DrawObjectDataGL>(codLevel->shadowsCOD()->revision(),
+                drawObjTableList[levelDrawer::ObjectType::LEVEL], levelZValues))
+        {
+            // the shadow map already has the static casters in it and nothing else.
+            return;
+        }
 
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClearDepthf(1.0f);
         checkGraphicsError();
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        if (m_shadowsCache.staticCastersChanged()) {
+            glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferStaticShadows->fbo());
+            checkGraphicsError();
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            checkGraphicsError();
+
+            auto const &staticCasters = m_shadowsCache.staticCasters();
+            m_shadowsRenderDetails->draw(
+                    renderDetails::MODEL_MATRIX_ID_SHADOWS,
+                    codLevel->shadowsCOD(),
+                    drawObjTableList[levelDrawer::ObjectType::LEVEL],
+                    staticCasters.begin(), staticCasters.end());
+        }
+
+        // start from the static casters, color and depth, then draw the dynamic casters on top.
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebufferStaticShadows->fbo());
+        checkGraphicsError();
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_framebufferShadows->fbo());
+        checkGraphicsError();
+        auto width = static_cast<GLint>(m_surfaceWidth);
+        auto height = static_cast<GLint>(m_surfaceHeight);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height,
+                GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        checkGraphicsError();
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferShadows->fbo());
         checkGraphicsError();
 
+        auto const &dynamicCasters = m_shadowsCache.dynamicCasters();
         m_shadowsRenderDetails->draw(
                 renderDetails::MODEL_MATRIX_ID_SHADOWS,
                 codLevel->shadowsCOD(),
                 drawObjTableList[levelDrawer::ObjectType::LEVEL],
-                levelZValues.begin(), levelZValues.end());
+                dynamicCasters.begin(), dynamicCasters.end());
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
         checkGraphicsError();
@@ -184,8 +242,8 @@ namespace shadowsChaining {
             uint32_t /* unused model matrix ID */,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs)
     {
         // get the shadows common object data
         auto cod = dynamic_cast<CommonObjectDataGL*>(commonObjectData.get());
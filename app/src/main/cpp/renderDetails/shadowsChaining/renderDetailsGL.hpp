@@ -31,6 +31,7 @@
 #include "../renderDetails.hpp"
 #include "../shadows/renderDetailsGL.hpp"
 #include "../objectWithShadows/renderDetailsGL.hpp"
+#include "staticShadows.hpp"
 #include "../../graphicsGL.hpp"
 #include "../../renderLoader/renderLoaderGL.hpp"
 
@@ -73,11 +74,22 @@ namespace shadowsChaining {
             }
         }
 
+        glm::mat4 normalMatrix(uint32_t id) override {
+            if (id == renderDetails::MODEL_MATRIX_ID_MAIN) {
+                return m_mainDOD->normalMatrix(id);
+            } else {
+                return m_shadowsDOD->normalMatrix(id);
+            }
+        }
+
         void update(glm::mat4 const &modelMatrix) override {
+            m_caster.update(m_shadowsDOD->modelMatrix(renderDetails::MODEL_MATRIX_ID_SHADOWS), modelMatrix);
             m_mainDOD->update(modelMatrix);
             m_shadowsDOD->update(modelMatrix);
         }
 
+        ShadowCaster const &caster() const { return m_caster; }
+
         DrawObjectDataGL(
                 std::shared_ptr<renderDetails::DrawObjectDataGL> mainDOD,
                 std::shared_ptr<renderDetails::DrawObjectDataGL> shadowsDOD)
@@ -90,6 +102,7 @@ namespace shadowsChaining {
     private:
         std::shared_ptr<renderDetails::DrawObjectDataGL> m_mainDOD;
         std::shared_ptr<renderDetails::DrawObjectDataGL> m_shadowsDOD;
+        ShadowCaster m_caster;
     };
 
     class RenderDetailsGL : public renderDetails::RenderDetailsGL {
@@ -115,20 +128,28 @@ namespace shadowsChaining {
                 uint32_t modelMatrixID,
                 levelDrawer::CommonObjectDataList const &commonObjectDataList,
                 levelDrawer::DrawObjectTableGList const &drawObjTableList,
-                std::set<levelDrawer::ZValueReference> const &starterZValues,
-                std::set<levelDrawer::ZValueReference> const &levelZValues,
-                std::set<levelDrawer::ZValueReference> const &finisherZValues) override;
+                levelDrawer::ZValueReferences const &starterZValues,
+                levelDrawer::ZValueReferences const &levelZValues,
+                levelDrawer::ZValueReferences const &finisherZValues) override;
 
         void draw(
                 uint32_t modelMatrixID,
                 std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
                 std::shared_ptr<levelDrawer::DrawObjectTableGL> const &drawObjTable,
-                std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-                std::set<levelDrawer::ZValueReference>::iterator endZValRefs) override;
+                levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+                levelDrawer::ZValueReferences::const_iterator endZValRefs) override;
 
-        RenderDetailsGL(char const *name, bool useIntSurface, uint32_t inWidth, uint32_t inHeight)
+        // both the shadows and the main render details draw the objects.
+        bool supportsInstancing() override {
+            return m_objectWithShadowsRenderDetails->supportsInstancing() &&
+                   m_shadowsRenderDetails->supportsInstancing();
+        }
+
+        RenderDetailsGL(char const *name, bool useIntSurface, uint32_t inWidth, uint32_t inHeight,
+                        bool useStaticShadowsCache)
                 : renderDetails::RenderDetailsGL{inWidth, inHeight, useIntSurface},
-                m_renderDetailsName{name}
+                m_renderDetailsName{name},
+                m_useStaticShadowsCache{useStaticShadowsCache}
         {
             createFramebuffer();
         }
@@ -138,6 +159,15 @@ namespace shadowsChaining {
     private:
         char const *m_renderDetailsName;
         std::shared_ptr<graphicsGL::Framebuffer> m_framebufferShadows;
+
+        // copying the static shadow map into m_framebufferShadows uses glBlitFramebuffer.  Without
+        // it, all the casters are drawn every frame.
+        bool m_useStaticShadowsCache;
+
+        // the shadow map of the static casters only, copied into m_framebufferShadows each frame.
+        std::shared_ptr<graphicsGL::Framebuffer> m_framebufferStaticShadows;
+        StaticShadowsCache m_shadowsCache;
+
         std::shared_ptr<renderDetails::RenderDetailsGL> m_shadowsRenderDetails;
         std::shared_ptr<renderDetails::RenderDetailsGL> m_objectWithShadowsRenderDetails;
 
@@ -146,7 +176,7 @@ namespace shadowsChaining {
                 renderDetails::ReferenceGL const &refObjectWithShadows,
                 renderDetails::ReferenceGL const &refShadows);
 
-        // Initialize framebuffer for shadow mapping.
+        // Initialize the framebuffers for shadow mapping.
         void createFramebuffer();
     };
 }
@@ -17,12 +17,65 @@
  *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
  *
  */
+#include <array>
 #include <memory>
 
 #include "renderDetailsVulkan.hpp"
 #include "../../renderLoader/renderLoaderVulkan.hpp"
 
 namespace shadowsChaining {
+    namespace {
+        VkImageAspectFlags depthAspectFlags(VkFormat format) {
+            if (format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT) {
+                return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+            }
+            return VK_IMAGE_ASPECT_DEPTH_BIT;
+        }
+
+        VkImageMemoryBarrier imageBarrier(
+                VkImage image,
+                VkImageAspectFlags aspect,
+                VkImageLayout oldLayout,
+                VkImageLayout newLayout,
+                VkAccessFlags srcAccess,
+                VkAccessFlags dstAccess)
+        {
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout = oldLayout;
+            barrier.newLayout = newLayout;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = image;
+            barrier.subresourceRange.aspectMask = aspect;
+            barrier.subresourceRange.baseMipLevel = 0;
+            barrier.subresourceRange.levelCount = 1;
+            barrier.subresourceRange.baseArrayLayer = 0;
+            barrier.subresourceRange.layerCount = 1;
+            barrier.srcAccessMask = srcAccess;
+            barrier.dstAccessMask = dstAccess;
+            return barrier;
+        }
+
+        // src must be in the transfer source layout and dst in the transfer destination layout.
+        void addCopyImageCmds(VkCommandBuffer commandBuffer, vulkan::Image &src, vulkan::Image &dst,
+                              VkImageAspectFlags aspect)
+        {
+            VkImageCopy region = {};
+            region.srcSubresource.aspectMask = aspect;
+            region.srcSubresource.mipLevel = 0;
+            region.srcSubresource.baseArrayLayer = 0;
+            region.srcSubresource.layerCount = 1;
+            region.srcOffset = {0, 0, 0};
+            region.dstSubresource = region.srcSubresource;
+            region.dstOffset = {0, 0, 0};
+            region.extent = {dst.width(), dst.height(), 1};
+
+            vkCmdCopyImage(commandBuffer, src.image(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           dst.image(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        }
+    }
+
     renderDetails::ReferenceVulkan RenderDetailsVulkan::loadNew(
             char const *name,
             std::vector<char const *> const &shaders,
@@ -113,24 +166,110 @@ namespace shadowsChaining {
             size_t /* descriptor set ID, not used */,
             levelDrawer::CommonObjectDataList const &commonObjectDataList,
             levelDrawer::DrawObjectTableVulkanList const &drawObjTableList,
-            std::set<levelDrawer::ZValueReference> const &/* starter Z Value references - unused */,
-            std::set<levelDrawer::ZValueReference> const &levelZValues,
-            std::set<levelDrawer::ZValueReference> const &/* finisher Z Value references - unused */)
+            levelDrawer::ZValueReferences const &/* starter Z Value references - unused */,
+            levelDrawer::ZValueReferences const &levelZValues,
+            levelDrawer::ZValueReferences const &/* finisher Z Value references - unused */)
     {
         // The shadows rendering needs to occur before the main render pass.
+        // only do shadows for the level itself
+        auto const &commonObjectData = commonObjectDataList[levelDrawer::ObjectType::LEVEL];
+        auto const &drawObjTable = drawObjTableList[levelDrawer::ObjectType::LEVEL];
+        auto cod = dynamic_cast<CommonObjectDataVulkan*>(commonObjectData.get());
+        if (!cod) {
+            throw std::runtime_error("Invalid common object data type");
+        }
 
+        if (!m_shadowsCache.update<DrawObjectDataVulkan>(cod->m_shadowsCOD->revision(),
+                drawObjTable, levelZValues))
+        {
+            // the shadow map already has the static casters in it and nothing else.
+            return;
+        }
+
+        auto staticColorImage = m_staticShadowsColorAttachment->image();
+        auto staticDepthImage = m_depthImageViewStaticShadows->image();
+        auto colorImage = m_shadowsColorAttachment->image();
+        auto depthImage = m_depthImageViewShadows->image();
+        VkImageAspectFlags depthAspect = depthAspectFlags(depthImage->format());
+
+        if (m_shadowsCache.staticCastersChanged()) {
+            // the last frame may still be copying from the static shadow images.
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+                    0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+            addShadowsRenderPassCmds(commandBuffer, m_renderPassShadows, m_framebufferStaticShadows,
+                    commonObjectData, drawObjTable, m_shadowsCache.staticCasters());
+
+            std::array<VkImageMemoryBarrier, 2> barriers = {
+                    imageBarrier(staticColorImage->image(), VK_IMAGE_ASPECT_COLOR_BIT,
+                            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT),
+                    imageBarrier(staticDepthImage->image(), depthAspect,
+                            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT)};
+            vkCmdPipelineBarrier(commandBuffer,
+                    VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                    VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                    static_cast<uint32_t>(barriers.size()), barriers.data());
+        }
+
+        // copy the static casters into the shadow images.  The last frame may still be drawing
+        // to or sampling the shadow images.
+        std::array<VkImageMemoryBarrier, 2> barriers = {
+                imageBarrier(colorImage->image(), VK_IMAGE_ASPECT_COLOR_BIT,
+                        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT),
+                imageBarrier(depthImage->image(), depthAspect,
+                        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT)};
+        vkCmdPipelineBarrier(commandBuffer,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                static_cast<uint32_t>(barriers.size()), barriers.data());
+
+        addCopyImageCmds(commandBuffer, *staticColorImage, *colorImage, VK_IMAGE_ASPECT_COLOR_BIT);
+        addCopyImageCmds(commandBuffer, *staticDepthImage, *depthImage, VK_IMAGE_ASPECT_DEPTH_BIT);
+
+        barriers = {
+                imageBarrier(colorImage->image(), VK_IMAGE_ASPECT_COLOR_BIT,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                        VK_ACCESS_TRANSFER_WRITE_BIT,
+                        VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT),
+                imageBarrier(depthImage->image(), depthAspect,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                        VK_ACCESS_TRANSFER_WRITE_BIT,
+                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT)};
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+        addShadowsRenderPassCmds(commandBuffer, m_renderPassDynamicShadows, m_framebufferShadows,
+                commonObjectData, drawObjTable, m_shadowsCache.dynamicCasters());
+    }
+
+    void RenderDetailsVulkan::addShadowsRenderPassCmds(
+            VkCommandBuffer const &commandBuffer,
+            std::shared_ptr<vulkan::RenderPass> const &renderPass,
+            std::shared_ptr<vulkan::Framebuffer> const &framebuffer,
+            std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
+            std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
+            levelDrawer::ZValueReferences const &zValRefs)
+    {
         /* begin the shadows render pass */
         VkRenderPassBeginInfo renderPassInfo = {};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = getVkType<>(m_renderPassShadows->renderPass().get());
-        renderPassInfo.framebuffer = getVkType<>(m_framebufferShadows->framebuffer().get());
+        renderPassInfo.renderPass = getVkType<>(renderPass->renderPass().get());
+        renderPassInfo.framebuffer = getVkType<>(framebuffer->framebuffer().get());
         /* size of the render area */
         renderPassInfo.renderArea.offset = {0, 0};
         renderPassInfo.renderArea.extent = VkExtent2D{getShadowsFramebufferDimension(m_surfaceWidth),
                                                       getShadowsFramebufferDimension(m_surfaceHeight)};
 
         /* the color value to use when clearing the image with VK_ATTACHMENT_LOAD_OP_CLEAR,
-         * using black with 0% opacity
+         * using black with 0% opacity.  Unused by the dynamic shadows render pass.
          */
         std::vector<VkClearValue> clearValues{};
         clearValues.resize(2);
@@ -145,13 +284,12 @@ namespace shadowsChaining {
          */
         vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
-        // only do shadows for the level itself
         m_shadowsRenderDetails->addDrawCmdsToCommandBuffer(
                 commandBuffer,
                 renderDetails::MODEL_MATRIX_ID_SHADOWS /* shadows ID */,
-                commonObjectDataList[levelDrawer::ObjectType::LEVEL],
-                drawObjTableList[levelDrawer::ObjectType::LEVEL],
-                levelZValues.begin(), levelZValues.end(), nameString());
+                commonObjectData,
+                drawObjTable,
+                zValRefs.begin(), zValRefs.end(), id());
 
         vkCmdEndRenderPass(commandBuffer);
     }
@@ -161,9 +299,9 @@ namespace shadowsChaining {
             size_t /* unused descriptor set ID */,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-            std::string const &)
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs,
+            boost::optional<renderDetails::RenderDetailsID> const &)
     {
         m_objectWithShadowsRenderDetails->addDrawCmdsToCommandBuffer(
                 commandBuffer, renderDetails::MODEL_MATRIX_ID_MAIN /* main render details ID */,
@@ -218,10 +356,15 @@ namespace shadowsChaining {
 
     void RenderDetailsVulkan::createShadowResources(std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails) {
         m_framebufferShadows.reset();
+        m_renderPassDynamicShadows.reset();
+        m_framebufferStaticShadows.reset();
         m_renderPassShadows.reset();
         m_samplerShadows.reset();
         m_shadowsColorAttachment.reset();
         m_depthImageViewShadows.reset();
+        m_staticShadowsColorAttachment.reset();
+        m_depthImageViewStaticShadows.reset();
+        m_shadowsCache.invalidate();
 
         auto width = getShadowsFramebufferDimension(surfaceDetails->surfaceWidth);
         auto height = getShadowsFramebufferDimension(surfaceDetails->surfaceHeight);
@@ -229,7 +372,9 @@ namespace shadowsChaining {
         // shadow resources
         m_depthImageViewShadows = std::make_shared<vulkan::ImageView>(
                 vulkan::ImageFactory::createDepthImage(
-                        m_device, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, width, height),
+                        m_device,
+                        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+                        width, height),
                 VK_IMAGE_ASPECT_DEPTH_BIT);
 
         m_shadowsColorAttachment = vulkan::ImageView::createImageViewAndImage(
@@ -238,34 +383,76 @@ namespace shadowsChaining {
                 height,
                 VK_FORMAT_R32G32B32A32_SFLOAT,
                 VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 VK_IMAGE_ASPECT_COLOR_BIT);
         m_samplerShadows = std::make_shared<vulkan::ImageSampler>(
                 m_device, m_shadowsColorAttachment,
                 VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER,
                 VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE);
+
+        // the static casters only
+        m_depthImageViewStaticShadows = std::make_shared<vulkan::ImageView>(
+                vulkan::ImageFactory::createDepthImage(
+                        m_device,
+                        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                        width, height),
+                VK_IMAGE_ASPECT_DEPTH_BIT);
+
+        m_staticShadowsColorAttachment = vulkan::ImageView::createImageViewAndImage(
+                m_device,
+                width,
+                height,
+                VK_FORMAT_R32G32B32A32_SFLOAT,
+                VK_IMAGE_TILING_OPTIMAL,
+                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                VK_IMAGE_ASPECT_COLOR_BIT);
+
+        // the static shadows render pass leaves the images in the attachment layouts, they are
+        // transitioned for the copy with a pipeline barrier.
         auto colorImageInfo =
                 std::vector<vulkan::RenderPass::ImageAttachmentInfo>{vulkan::RenderPass::ImageAttachmentInfo{
                         VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_STORE,
-                        m_shadowsColorAttachment->image()->format(),
-                        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}};
+                        m_staticShadowsColorAttachment->image()->format(),
+                        VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL}};
         auto depthImageInfo =
                 std::make_shared<vulkan::RenderPass::ImageAttachmentInfo>(
                         VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_STORE,
-                        m_depthImageViewShadows->image()->format(),
+                        m_depthImageViewStaticShadows->image()->format(),
                         VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
         m_renderPassShadows = vulkan::RenderPass::createDepthTextureRenderPass(
                 m_device, colorImageInfo, depthImageInfo);
 
-        // shadows framebuffer
-        m_framebufferShadows = std::make_shared<vulkan::Framebuffer>(
+        // the dynamic shadows render pass draws on top of the copy of the static shadow images.
+        // It is compatible with m_renderPassShadows, so it can use the same pipeline.
+        auto colorImageInfoDynamic =
+                std::vector<vulkan::RenderPass::ImageAttachmentInfo>{vulkan::RenderPass::ImageAttachmentInfo{
+                        VK_ATTACHMENT_LOAD_OP_LOAD, VK_ATTACHMENT_STORE_OP_STORE,
+                        m_shadowsColorAttachment->image()->format(),
+                        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}};
+        auto depthImageInfoDynamic =
+                std::make_shared<vulkan::RenderPass::ImageAttachmentInfo>(
+                        VK_ATTACHMENT_LOAD_OP_LOAD, VK_ATTACHMENT_STORE_OP_DONT_CARE,
+                        m_depthImageViewShadows->image()->format(),
+                        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+        m_renderPassDynamicShadows = vulkan::RenderPass::createDepthTextureRenderPass(
+                m_device, colorImageInfoDynamic, depthImageInfoDynamic);
+
+        // shadows framebuffers
+        m_framebufferStaticShadows = std::make_shared<vulkan::Framebuffer>(
                 m_device, m_renderPassShadows,
+                std::vector<std::shared_ptr<vulkan::ImageView>>{m_staticShadowsColorAttachment,
+                                                                m_depthImageViewStaticShadows},
+                width, height);
+
+        m_framebufferShadows = std::make_shared<vulkan::Framebuffer>(
+                m_device, m_renderPassDynamicShadows,
                 std::vector<std::shared_ptr<vulkan::ImageView>>{m_shadowsColorAttachment,
                                                                 m_depthImageViewShadows},
                 width, height);
-
-
     }
 
     RegisterVulkan<renderDetails::RenderDetailsVulkan, RenderDetailsVulkan> registerVulkan(
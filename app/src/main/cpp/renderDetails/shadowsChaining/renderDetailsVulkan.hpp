@@ -31,6 +31,7 @@
 #include "../renderDetailsVulkan.hpp"
 #include "../../levelDrawer/drawObjectTable/drawObjectTableVulkan.hpp"
 #include "../../levelDrawer/common.hpp"
+#include "staticShadows.hpp"
 
 namespace shadowsChaining {
     class RenderDetailsVulkan;
@@ -73,8 +74,8 @@ namespace shadowsChaining {
     public:
         bool hasTexture() override { return m_mainDrawObjectData->hasTexture(); }
 
-        std::shared_ptr<vulkan::Buffer> const &bufferModelMatrix() override {
-            return m_mainDrawObjectData->bufferModelMatrix();
+        std::shared_ptr<vulkan::UniformSlot> const &uniformSlotModelMatrix() override {
+            return m_mainDrawObjectData->uniformSlotModelMatrix();
         }
 
         glm::mat4 modelMatrix(uint32_t id) override {
@@ -99,12 +100,17 @@ namespace shadowsChaining {
         }
 
         void update(glm::mat4 const &modelMatrix) override {
+            m_caster.update(m_shadowsDrawObjectData->modelMatrix(renderDetails::MODEL_MATRIX_ID_SHADOWS),
+                            modelMatrix);
+
             // the main draw object data and the shadows draw object data share a buffer.
             // So it is only necessary to update one.
             m_mainDrawObjectData->update(modelMatrix);
             m_shadowsDrawObjectData->updateModelMatrixNoBufferUpdate(modelMatrix);
         }
 
+        ShadowCaster const &caster() const { return m_caster; }
+
         std::shared_ptr<vulkan::DescriptorSet> const &descriptorSet(uint32_t id) override {
             switch (id) {
                 case 0:
@@ -115,6 +121,16 @@ namespace shadowsChaining {
             }
         }
 
+        uint32_t dynamicOffset(uint32_t id) override {
+            switch (id) {
+                case 0:
+                    return m_mainDrawObjectData->dynamicOffset(id);
+                case 1:
+                default:
+                    return m_shadowsDrawObjectData->dynamicOffset(id);
+            }
+        }
+
         DrawObjectDataVulkan(
                 std::shared_ptr<renderDetails::DrawObjectDataVulkan> inMainDrawObjectData,
                 std::shared_ptr<renderDetails::DrawObjectDataVulkan> inShadowsDrawObjectData)
@@ -127,6 +143,7 @@ namespace shadowsChaining {
     private:
         std::shared_ptr<renderDetails::DrawObjectDataVulkan> m_mainDrawObjectData;
         std::shared_ptr<renderDetails::DrawObjectDataVulkan> m_shadowsDrawObjectData;
+        ShadowCaster m_caster;
     };
 
     class RenderDetailsVulkan : public renderDetails::RenderDetailsVulkan {
@@ -163,21 +180,27 @@ namespace shadowsChaining {
             size_t /* descriptor set ID, not used */,
             levelDrawer::CommonObjectDataList const &commonObjectDataList,
             levelDrawer::DrawObjectTableVulkanList const &drawObjTableList,
-            std::set<levelDrawer::ZValueReference> const &starterZValues,
-            std::set<levelDrawer::ZValueReference> const &levelZValues,
-            std::set<levelDrawer::ZValueReference> const &finisherZValues) override;
+            levelDrawer::ZValueReferences const &starterZValues,
+            levelDrawer::ZValueReferences const &levelZValues,
+            levelDrawer::ZValueReferences const &finisherZValues) override;
 
         void addDrawCmdsToCommandBuffer(
             VkCommandBuffer const &commandBuffer,
             size_t descriptorSetID,
             std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
             std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
-            std::set<levelDrawer::ZValueReference>::iterator beginZValRefs,
-            std::set<levelDrawer::ZValueReference>::iterator endZValRefs,
-            std::string const &renderDetailsName) override;
+            levelDrawer::ZValueReferences::const_iterator beginZValRefs,
+            levelDrawer::ZValueReferences::const_iterator endZValRefs,
+            boost::optional<renderDetails::RenderDetailsID> const &renderDetailsID) override;
 
         std::shared_ptr<vulkan::Device> const &device() override { return m_objectWithShadowsRenderDetails->device(); }
 
+        // both the shadows and the main render details draw the objects.
+        bool supportsInstancing() override {
+            return m_objectWithShadowsRenderDetails->supportsInstancing() &&
+                   m_shadowsRenderDetails->supportsInstancing();
+        }
+
         RenderDetailsVulkan(
             char const *name,
             std::shared_ptr<vulkan::Device> const &inDevice,
@@ -202,9 +225,19 @@ namespace shadowsChaining {
         std::shared_ptr<vulkan::ImageView> m_depthImageViewShadows;
         std::shared_ptr<vulkan::ImageView> m_shadowsColorAttachment;
         std::shared_ptr<vulkan::ImageSampler> m_samplerShadows;
-        std::shared_ptr<vulkan::RenderPass> m_renderPassShadows;
         std::shared_ptr<renderDetails::RenderDetailsVulkan> m_shadowsRenderDetails;
+
+        /* The static casters are drawn into the static shadow images with m_renderPassShadows
+         * (which clears them).  Each frame they are copied into the shadow images and the dynamic
+         * casters are drawn on top with m_renderPassDynamicShadows (which loads them).
+         */
+        std::shared_ptr<vulkan::ImageView> m_depthImageViewStaticShadows;
+        std::shared_ptr<vulkan::ImageView> m_staticShadowsColorAttachment;
+        std::shared_ptr<vulkan::RenderPass> m_renderPassShadows;
+        std::shared_ptr<vulkan::Framebuffer> m_framebufferStaticShadows;
+        std::shared_ptr<vulkan::RenderPass> m_renderPassDynamicShadows;
         std::shared_ptr<vulkan::Framebuffer> m_framebufferShadows;
+        StaticShadowsCache m_shadowsCache;
 
         static uint32_t getShadowsFramebufferDimension(uint32_t dimension) {
             return static_cast<uint32_t>(std::floor(dimension * shadowsSizeMultiplier));
@@ -227,6 +260,14 @@ namespace shadowsChaining {
         }
 
         void createShadowResources(std::shared_ptr<vulkan::SurfaceDetails> const &surfaceDetails);
+
+        void addShadowsRenderPassCmds(
+                VkCommandBuffer const &commandBuffer,
+                std::shared_ptr<vulkan::RenderPass> const &renderPass,
+                std::shared_ptr<vulkan::Framebuffer> const &framebuffer,
+                std::shared_ptr<renderDetails::CommonObjectData> const &commonObjectData,
+                std::shared_ptr<levelDrawer::DrawObjectTableVulkan> const &drawObjTable,
+                levelDrawer::ZValueReferences const &zValRefs);
     };
 }
 
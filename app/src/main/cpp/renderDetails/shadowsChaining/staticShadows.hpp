@@ -0,0 +1,154 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_SHADOWSCHAINING_STATIC_SHADOWS_HPP
+#define AMAZING_LABYRINTH_SHADOWSCHAINING_STATIC_SHADOWS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../../levelDrawer/zValueIndex.hpp"
+
+namespace shadowsChaining {
+    /* Kept by each shadows chaining draw object data.  A shadow caster is static until its model
+     * matrix changes, then it is dynamic for the rest of its life.  In most levels only the ball
+     * ever becomes dynamic.
+     */
+    class ShadowCaster {
+    public:
+        // never the same for two casters, so a caster that was removed and replaced by another
+        // caster is not mistaken for the old one.
+        uint64_t id() const { return m_id; }
+
+        bool isDynamic() const { return m_dynamic; }
+
+        void update(glm::mat4 const &oldModelMatrix, glm::mat4 const &newModelMatrix) {
+            if (oldModelMatrix != newModelMatrix) {
+                m_dynamic = true;
+            }
+        }
+
+        ShadowCaster()
+                : m_id{nextID()},
+                  m_dynamic{false}
+        {}
+
+    private:
+        uint64_t m_id;
+        bool m_dynamic;
+
+        static uint64_t nextID() {
+            static std::atomic<uint64_t> id{0};
+            return ++id;
+        }
+    };
+
+    /* The shadow map is drawn in two layers.  The static casters are drawn into a cached shadow
+     * map which is only drawn again when the set of static casters or the light changes.  Each
+     * frame, the cached shadow map is copied into the shadow map and then the dynamic casters are
+     * drawn on top of it.
+     *
+     * Objects that are not shadows chaining draw object data (the ones with overriding render
+     * details) and instanced objects are always treated as dynamic.
+     */
+    class StaticShadowsCache {
+    public:
+        /* Split the Z value references into static and dynamic casters.  Returns false if the
+         * shadow map from the last call is still correct and nothing needs to be drawn.
+         */
+        template <typename DrawObjectDataType, typename DrawObjectTableType>
+        bool update(uint64_t lightRevision,
+                    std::shared_ptr<DrawObjectTableType> const &drawObjTable,
+                    levelDrawer::ZValueReferences const &zValRefs)
+        {
+            m_staticCasters.clear();
+            m_dynamicCasters.clear();
+            m_staticCasterIDs.clear();
+            for (auto const &zValRef : zValRefs) {
+                auto const &drawObj = drawObjTable->drawObject(zValRef.drawObjectReference);
+                DrawObjectDataType *objData = nullptr;
+                if (!drawObj->isInstanced() && zValRef.drawObjectDataReference) {
+                    objData = dynamic_cast<DrawObjectDataType *>(
+                            drawObj->objData(zValRef.drawObjectDataReference.get()).get());
+                }
+
+                if (objData && !objData->caster().isDynamic()) {
+                    m_staticCasters.push_back(zValRef);
+                    m_staticCasterIDs.push_back(objData->caster().id());
+                } else {
+                    m_dynamicCasters.push_back(zValRef);
+                }
+            }
+
+            // the order the casters are drawn in does not change the shadow map.
+            std::sort(m_staticCasterIDs.begin(), m_staticCasterIDs.end());
+            m_staticCastersChanged = !m_valid || lightRevision != m_lightRevision ||
+                    m_staticCasterIDs != m_cachedCasterIDs;
+            if (m_staticCastersChanged) {
+                m_cachedCasterIDs.swap(m_staticCasterIDs);
+                m_lightRevision = lightRevision;
+                m_valid = true;
+            }
+
+            // the shadow map has to be drawn if there are dynamic casters in it now or there were
+            // dynamic casters in it the last time it was drawn.
+            bool shadowMapChanged = m_staticCastersChanged || !m_dynamicCasters.empty() ||
+                    m_shadowMapHasDynamicCasters;
+            m_shadowMapHasDynamicCasters = !m_dynamicCasters.empty();
+            return shadowMapChanged;
+        }
+
+        // true if the cached shadow map needs to be drawn again (from the last call to update).
+        bool staticCastersChanged() const { return m_staticCastersChanged; }
+
+        levelDrawer::ZValueReferences const &staticCasters() const { return m_staticCasters; }
+        levelDrawer::ZValueReferences const &dynamicCasters() const { return m_dynamicCasters; }
+
+        // call when the cached shadow map or the shadow map is recreated.
+        void invalidate() { m_valid = false; }
+
+        StaticShadowsCache()
+                : m_valid{false},
+                  m_staticCastersChanged{true},
+                  m_shadowMapHasDynamicCasters{false},
+                  m_lightRevision{0}
+        {}
+
+    private:
+        bool m_valid;
+        bool m_staticCastersChanged;
+        bool m_shadowMapHasDynamicCasters;
+        uint64_t m_lightRevision;
+
+        // the IDs of the casters in the cached shadow map, sorted.
+        std::vector<uint64_t> m_cachedCasterIDs;
+
+        // rebuilt every frame, kept here to reuse the allocations.
+        std::vector<uint64_t> m_staticCasterIDs;
+        levelDrawer::ZValueReferences m_staticCasters;
+        levelDrawer::ZValueReferences m_dynamicCasters;
+    };
+}
+
+#endif // AMAZING_LABYRINTH_SHADOWSCHAINING_STATIC_SHADOWS_HPP
@@ -56,8 +56,13 @@ struct RenderDetailsGLRetrieveFcns {
     RenderDetailsLoadExistingFcn renderDetailsLoadExistingFcn;
 };
 
-using RenderDetailsGLRetrieveMap =
-    std::map<std::string, std::function<RenderDetailsGLRetrieveFcns()>>;
+// the ID is assigned in the order the render details types are registered.
+struct RenderDetailsGLRegistration {
+    renderDetails::RenderDetailsID id;
+    std::function<RenderDetailsGLRetrieveFcns()> retrieveFcns;
+};
+
+using RenderDetailsGLRetrieveMap = std::map<std::string, RenderDetailsGLRegistration>;
 
 RenderDetailsGLRetrieveMap &getRenderDetailsGLMap();
 
@@ -67,9 +72,11 @@ public:
     RegisterGL(
             char const *name,
             std::vector<char const *> shaders) {
-        getRenderDetailsGLMap().emplace(
+        auto &renderDetailsMap = getRenderDetailsGLMap();
+        auto id = static_cast<renderDetails::RenderDetailsID>(renderDetailsMap.size());
+        renderDetailsMap.emplace(
             name,
-            std::function<RenderDetailsGLRetrieveFcns()> (
+            RenderDetailsGLRegistration{id, std::function<RenderDetailsGLRetrieveFcns()> (
                 [name, shaders]() -> RenderDetailsGLRetrieveFcns {
                     RenderDetailsGLRetrieveFcns fcns;
                     fcns.renderDetailsLoadNewFcn = RenderDetailsGLRetrieveFcns::RenderDetailsLoadNewFcn (
@@ -93,7 +100,7 @@ public:
                             });
                     return std::move(fcns);
                 }
-            )
+            )}
         );
     }
 };
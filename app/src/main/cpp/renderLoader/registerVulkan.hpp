@@ -50,8 +50,13 @@ struct RenderDetailsVulkanRetrieveFcns {
     RenderDetailsLoadExistingFcn renderDetailsLoadExistingFcn;
 };
 
-using RenderDetailsVulkanRetrieveMap =
-    std::map<std::string, std::function<RenderDetailsVulkanRetrieveFcns()>>;
+// the ID is assigned in the order the render details types are registered.
+struct RenderDetailsVulkanRegistration {
+    renderDetails::RenderDetailsID id;
+    std::function<RenderDetailsVulkanRetrieveFcns()> retrieveFcns;
+};
+
+using RenderDetailsVulkanRetrieveMap = std::map<std::string, RenderDetailsVulkanRegistration>;
 
 RenderDetailsVulkanRetrieveMap &getRenderDetailsVulkanMap();
 
@@ -63,9 +68,11 @@ public:
     RegisterVulkan(
             char const *name,
             std::vector<char const*> shaders) {
-        getRenderDetailsVulkanMap().emplace(
+        auto &renderDetailsMap = getRenderDetailsVulkanMap();
+        auto id = static_cast<renderDetails::RenderDetailsID>(renderDetailsMap.size());
+        renderDetailsMap.emplace(
             name,
-            std::function<RenderDetailsVulkanRetrieveFcns()> (
+            RenderDetailsVulkanRegistration{id, std::function<RenderDetailsVulkanRetrieveFcns()> (
                 [name, shaders]() -> RenderDetailsVulkanRetrieveFcns {
                     RenderDetailsVulkanRetrieveFcns fcns;
                     fcns.renderDetailsLoadNewFcn = RenderDetailsVulkanRetrieveFcns::RenderDetailsLoadNewFcn (
@@ -90,7 +97,7 @@ public:
                             });
                     return std::move(fcns);
                 }
-            )
+            )}
         );
     }
 };
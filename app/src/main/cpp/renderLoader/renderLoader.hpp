@@ -21,7 +21,7 @@
 #define AMAZING_LABYRINTH_RENDER_LOADER_HPP
 
 #include <memory>
-#include <list>
+#include <vector>
 #include <string>
 
 #include "../renderDetails/renderDetails.hpp"
@@ -35,33 +35,31 @@ public:
             std::shared_ptr<typename traits::SurfaceDetailsType> const &surfaceDetails,
             std::shared_ptr<renderDetails::Parameters> const &parameters)
     {
-        typename traits::RetrieveFcns fcns = getFcns(name);
-        for (auto it = m_loadedRenderDetails.begin(); it != m_loadedRenderDetails.end(); it++) {
-            if ((*it)->nameString() == name) {
-                if (structuralChangeNeeded(*it, surfaceDetails))
-                {
-                    // There was a structural change to the render details.  Just get rid of it
-                    // in the cache and load a new one.
-                    m_loadedRenderDetails.erase(it);
-                    break;
-                }
+        auto const &registration = getRegistration(name);
+        typename traits::RetrieveFcns fcns = registration.retrieveFcns();
 
-                auto renderDetails = *it;
-                if (m_loadedRenderDetails.size() > m_nbrRenderDetailsToKeep/2) {
-                    m_loadedRenderDetails.erase(it);
-                    m_loadedRenderDetails.push_front(renderDetails);
+        // there is at most one render details of each type loaded.  They are kept in the
+        // order they were registered in, so the render details ID is the index.
+        if (registration.id < m_loadedRenderDetails.size()) {
+            // copy the pointer: loading render details can load other render details too.
+            auto renderDetails = m_loadedRenderDetails[registration.id];
+            if (renderDetails != nullptr) {
+                if (!structuralChangeNeeded(renderDetails, surfaceDetails)) {
+                    return loadExisting(fcns, gameRequester, renderDetails, surfaceDetails, parameters);
                 }
 
-                return loadExisting(fcns, gameRequester, renderDetails, surfaceDetails, parameters);
+                // There was a structural change to the render details.  Just get rid of it
+                // in the cache and load a new one.
+                m_loadedRenderDetails[registration.id].reset();
             }
+        } else {
+            m_loadedRenderDetails.resize(registration.id + 1);
         }
 
         typename traits::RenderDetailsReferenceType renderDetailsRef =
                 loadNew(fcns, gameRequester, surfaceDetails, parameters);
-        m_loadedRenderDetails.push_front(renderDetailsRef.renderDetails);
-        while (m_loadedRenderDetails.size() > m_nbrRenderDetailsToKeep) {
-            m_loadedRenderDetails.pop_back();
-        }
+        renderDetailsRef.renderDetails->m_id = registration.id;
+        m_loadedRenderDetails[registration.id] = renderDetailsRef.renderDetails;
 
         return std::move(renderDetailsRef);
     };
@@ -69,8 +67,8 @@ public:
     virtual ~RenderLoader() = default;
 
 protected:
-    static size_t constexpr m_nbrRenderDetailsToKeep = 10;
-    std::list<std::shared_ptr<typename traits::RenderDetailsType>> m_loadedRenderDetails;
+    // indexed by render details ID.
+    std::vector<std::shared_ptr<typename traits::RenderDetailsType>> m_loadedRenderDetails;
 
     virtual typename traits::RenderDetailsReferenceType loadNew(
             typename traits::RetrieveFcns const &fcns,
@@ -87,12 +85,12 @@ protected:
             std::shared_ptr<typename traits::SurfaceDetailsType> const &surfaceDetails,
             std::shared_ptr<renderDetails::Parameters> const &parameters) = 0;
 private:
-    typename traits::RetrieveFcns getFcns(std::string const &name) {
+    static auto const &getRegistration(std::string const &name) {
         auto loaderFcnIt = traits::getRenderDetailsMap().find(name);
         if (loaderFcnIt == traits::getRenderDetailsMap().end()) {
             throw std::runtime_error("RenderDetails not registered.");
         }
-        return loaderFcnIt->second();
+        return loaderFcnIt->second;
     }
 };
 
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "sensorFilter.hpp"
+
+namespace {
+    float constexpr pi = 3.14159265358979f;
+
+    // the smoothing factor of a first order low pass filter with the cutoff frequency in Hz.
+    float lowPassAlpha(float cutoff, float dt) {
+        float tau = 1.0f / (2.0f * pi * cutoff);
+        return 1.0f / (1.0f + tau / dt);
+    }
+
+    float median(float a, float b, float c) {
+        return std::max(std::min(a, b), std::min(std::max(a, b), c));
+    }
+}
+
+float AccelerationFilter::secondsSinceLast(int64_t timestamp) {
+    float dt = m_tuning.samplingPeriod / 1000000.0f;
+    if (m_nbrEvents > 0 && timestamp > m_lastTimestamp) {
+        dt = (timestamp - m_lastTimestamp) / 1000000000.0f;
+    }
+    m_lastTimestamp = timestamp;
+    return dt;
+}
+
+void AccelerationFilter::add(float x, float y, float z, int64_t timestamp) {
+    glm::vec3 raw{x, y, z};
+    float dt = secondsSinceLast(timestamp);
+
+    if (m_nbrEvents == 0) {
+        m_value = raw;
+        m_derivative = glm::vec3{0.0f};
+    } else {
+        switch (m_tuning.filter) {
+        case SensorFilterType::exponential: {
+            float alpha = m_tuning.timeConstant > 0.0f ?
+                    1.0f - std::exp(-dt / m_tuning.timeConstant) : 1.0f;
+            m_value += alpha * (raw - m_value);
+            break;
+        }
+        case SensorFilterType::oneEuro: {
+            float alphaDerivative = lowPassAlpha(m_tuning.derivativeCutoff, dt);
+            for (int i = 0; i < 3; i++) {
+                float derivative = (raw[i] - m_lastRaw[i]) / dt;
+                m_derivative[i] += alphaDerivative * (derivative - m_derivative[i]);
+                float cutoff = m_tuning.minCutoff + m_tuning.beta * std::fabs(m_derivative[i]);
+                m_value[i] += lowPassAlpha(cutoff, dt) * (raw[i] - m_value[i]);
+            }
+            break;
+        }
+        case SensorFilterType::medianOf3:
+            break;
+        }
+    }
+
+    m_history[m_historyNext] = raw;
+    m_historyNext = (m_historyNext + 1) % m_history.size();
+    m_historySize = std::min<uint32_t>(m_historySize + 1, m_history.size());
+    if (m_tuning.filter == SensorFilterType::medianOf3) {
+        if (m_historySize < m_history.size()) {
+            m_value = raw;
+        } else {
+            for (int i = 0; i < 3; i++) {
+                m_value[i] = median(m_history[0][i], m_history[1][i], m_history[2][i]);
+            }
+        }
+    }
+
+    m_lastRaw = raw;
+    m_nbrEvents++;
+    m_hasNewValue = true;
+}
+
+bool AccelerationFilter::take(glm::vec3 &acceleration) {
+    if (!m_hasNewValue) {
+        return false;
+    }
+
+    acceleration = m_value;
+    m_hasNewValue = false;
+    return true;
+}
+
+glm::mat3 accelerationRotation(float rotationAngle) {
+    // the sine and cosine of the quarter turns, so that they are exactly 0, 1 or -1.
+    static std::array<std::pair<float, float>, 4> constexpr quarterTurns = {
+            std::make_pair(0.0f, 1.0f),
+            std::make_pair(1.0f, 0.0f),
+            std::make_pair(0.0f, -1.0f),
+            std::make_pair(-1.0f, 0.0f)};
+
+    float turns = rotationAngle / 90.0f;
+    float sin;
+    float cos;
+    if (turns == std::round(turns)) {
+        auto quarterTurn = static_cast<int>(std::round(turns)) % 4;
+        if (quarterTurn < 0) {
+            quarterTurn += 4;
+        }
+        sin = quarterTurns[quarterTurn].first;
+        cos = quarterTurns[quarterTurn].second;
+    } else {
+        float radians = rotationAngle * pi / 180.0f;
+        sin = std::sin(radians);
+        cos = std::cos(radians);
+    }
+
+    // a rotation about the z axis, the same as glm::rotate with the axis {0, 0, 1}.
+    glm::mat3 rotation{1.0f};
+    rotation[0][0] = cos;
+    rotation[0][1] = sin;
+    rotation[1][0] = -sin;
+    rotation[1][1] = cos;
+    return rotation;
+}
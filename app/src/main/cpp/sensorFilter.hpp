@@ -0,0 +1,110 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_SENSOR_FILTER_HPP
+#define AMAZING_LABYRINTH_SENSOR_FILTER_HPP
+
+#include <array>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+// the filters the accelerometer events can be smoothed with.
+enum class SensorFilterType {
+    exponential,        // exponential moving average with a fixed time constant
+    oneEuro,            // low pass whose cutoff rises with the speed of the change
+    medianOf3           // median of the last three events, removes single event spikes
+};
+
+struct SensorTuning {
+    // Levels used to get the raw sensor events.  A 30 ms exponential filter keeps that tilt
+    // response, it only lags a couple of frames, while removing jitter.  One euro with
+    // minCutoff = 1 Hz lags about 160 ms when the device is held still.
+    SensorFilterType filter = SensorFilterType::exponential;
+
+    // the period, in microseconds, the accelerometer is asked to report events at.  The sensor
+    // may report faster than this.
+    int32_t samplingPeriod = 20000;
+
+    // exponential: seconds for the output to move 63% of the way to a new value.
+    float timeConstant = 0.03f;
+
+    // one euro: the cutoff frequency (Hz) when the acceleration is not changing, how much the
+    // cutoff rises per unit per second of change, and the cutoff for the rate of change.
+    float minCutoff = 1.0f;
+    float beta = 0.05f;
+    float derivativeCutoff = 1.0f;
+};
+
+/* Takes all the accelerometer events that arrived since the last frame and gives the level one
+ * filtered acceleration per frame, in the device's coordinates.  Nothing is allocated after
+ * construction.
+ */
+class AccelerationFilter {
+public:
+    // timestamp is in nanoseconds, as in ASensorEvent.
+    void add(float x, float y, float z, int64_t timestamp);
+
+    // the filtered acceleration.  Returns false if there were no events since the last call.
+    bool take(glm::vec3 &acceleration);
+
+    // the number of events added since the filter was created.
+    uint64_t nbrEvents() const { return m_nbrEvents; }
+
+    explicit AccelerationFilter(SensorTuning const &tuning)
+            : m_tuning{tuning},
+              m_value{0.0f},
+              m_derivative{0.0f},
+              m_lastRaw{0.0f},
+              m_history{},
+              m_historySize{0},
+              m_historyNext{0},
+              m_lastTimestamp{0},
+              m_nbrEvents{0},
+              m_hasNewValue{false}
+    {}
+
+private:
+    SensorTuning m_tuning;
+
+    // the current output, and for one euro, the filtered rate of change and the last event.
+    glm::vec3 m_value;
+    glm::vec3 m_derivative;
+    glm::vec3 m_lastRaw;
+
+    // the last three events, for the median filter.
+    std::array<glm::vec3, 3> m_history;
+    uint32_t m_historySize;
+    uint32_t m_historyNext;
+
+    int64_t m_lastTimestamp;
+    uint64_t m_nbrEvents;
+    bool m_hasNewValue;
+
+    // the seconds since the last event.  Uses the sampling period if the timestamps are not usable.
+    float secondsSinceLast(int64_t timestamp);
+};
+
+/* The rotation from the device's coordinates to the surface's coordinates.  Computed once when the
+ * surface rotation changes instead of for every event.  The usual rotations (0, 90, 180 and 270
+ * degrees) are exact.
+ */
+glm::mat3 accelerationRotation(float rotationAngle);
+
+#endif // AMAZING_LABYRINTH_SENSOR_FILTER_HPP
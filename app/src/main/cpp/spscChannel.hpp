@@ -0,0 +1,192 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_SPSC_CHANNEL_HPP
+#define AMAZING_LABYRINTH_SPSC_CHANNEL_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <thread>
+#include <boost/optional.hpp>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace spscChannel {
+    inline void futexWait(std::atomic<uint32_t> &word, uint32_t expected, std::chrono::microseconds timeout) {
+        timespec ts{};
+        ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000);
+        ts.tv_nsec = static_cast<long>((timeout.count() % 1000000) * 1000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, &ts,
+                nullptr, 0);
+    }
+
+    inline void futexWake(std::atomic<uint32_t> &word) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr,
+                nullptr, 0);
+    }
+}
+
+/* A fixed capacity ring buffer that passes values from exactly one producer thread to exactly one
+ * consumer thread without locks.  The producer only writes m_tail and the consumer only writes
+ * m_head, so neither side ever waits on the other except when the ring is full (the producer
+ * yields) or empty and the consumer wants to sleep.  The consumer sleeps on a futex and the
+ * producer only makes the wake up system call if the consumer is actually asleep.
+ */
+template <typename T, size_t Capacity>
+class SpscChannel {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+public:
+    // Producer side.  Returns false if the channel is full.
+    bool trySend(T value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_producerCachedHead == Capacity) {
+            // only look at the consumer's index when the ring looks full to keep its cache line
+            // from bouncing between the threads on every send.
+            m_producerCachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_producerCachedHead == Capacity) {
+                return false;
+            }
+        }
+
+        m_slots[tail & (Capacity - 1)] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        wakeConsumer();
+        return true;
+    }
+
+    // Producer side.  Waits for room if the channel is full.
+    void send(T value) {
+        while (!trySend(value)) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Wake up the consumer if it is waiting in waitForData.  Can be called from any thread, so it
+    // can be used for signals sent outside of the channel.
+    void wakeConsumer() {
+        // pairs with the fence in waitForData: either the consumer sees the new data or we see
+        // that it is waiting.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_consumerWaiting.load(std::memory_order_relaxed) != 0) {
+            m_wakeSequence.fetch_add(1, std::memory_order_relaxed);
+            spscChannel::futexWake(m_wakeSequence);
+        }
+    }
+
+    // Consumer side.  Returns the next value or boost::none if the channel is empty.
+    boost::optional<T> tryReceive() {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (!available(head)) {
+            return boost::none;
+        }
+
+        boost::optional<T> value = std::move(m_slots[head & (Capacity - 1)]);
+        m_head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    /* Consumer side.  Returns the next value after merging the values that follow it into it.
+     * merge(T &value, T const &next) returns true if next was merged into value, in which case
+     * next is removed from the channel and the value after it is tried.
+     */
+    template <typename Merge>
+    boost::optional<T> tryReceive(Merge &&merge) {
+        boost::optional<T> value = tryReceive();
+        if (!value) {
+            return value;
+        }
+
+        size_t head = m_head.load(std::memory_order_relaxed);
+        while (available(head) && merge(value.get(), m_slots[head & (Capacity - 1)].get())) {
+            head++;
+            m_head.store(head, std::memory_order_release);
+        }
+
+        return value;
+    }
+
+    // Consumer side.  Waits until there is data in the channel, the timeout expires or
+    // wakeConsumer is called.  Returns true if there is data.
+    bool waitForData(std::chrono::microseconds timeout) {
+        // data usually arrives in bursts, so check a few times before paying for the system
+        // calls to sleep and wake up.
+        for (uint32_t i = 0; i < m_spinsBeforeSleep; i++) {
+            if (!empty()) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+
+        uint32_t sequence = m_wakeSequence.load(std::memory_order_relaxed);
+        m_consumerWaiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (empty()) {
+            spscChannel::futexWait(m_wakeSequence, sequence, timeout);
+        }
+        m_consumerWaiting.store(0, std::memory_order_relaxed);
+
+        return !empty();
+    }
+
+    bool empty() const {
+        return m_head.load(std::memory_order_relaxed) == m_tail.load(std::memory_order_acquire);
+    }
+
+    SpscChannel()
+            : m_head{0},
+              m_consumerCachedTail{0},
+              m_tail{0},
+              m_producerCachedHead{0},
+              m_consumerWaiting{0},
+              m_wakeSequence{0},
+              m_slots{}
+    {}
+
+    SpscChannel(SpscChannel const &) = delete;
+    SpscChannel &operator=(SpscChannel const &) = delete;
+
+private:
+    static uint32_t constexpr m_spinsBeforeSleep = 16;
+
+    // Keep the consumer's and the producer's indices on different cache lines.  Each side also
+    // keeps the last value it read of the other side's index.
+    alignas(64) std::atomic<size_t> m_head;
+    size_t m_consumerCachedTail;
+    alignas(64) std::atomic<size_t> m_tail;
+    size_t m_producerCachedHead;
+    alignas(64) std::atomic<uint32_t> m_consumerWaiting;
+    std::atomic<uint32_t> m_wakeSequence;
+    alignas(64) std::array<boost::optional<T>, Capacity> m_slots;
+
+    // consumer side: true if there is a value at index head.
+    bool available(size_t head) {
+        if (head != m_consumerCachedTail) {
+            return true;
+        }
+        m_consumerCachedTail = m_tail.load(std::memory_order_acquire);
+        return head != m_consumerCachedTail;
+    }
+};
+
+#endif // AMAZING_LABYRINTH_SPSC_CHANNEL_HPP
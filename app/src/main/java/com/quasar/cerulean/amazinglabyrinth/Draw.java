@@ -31,6 +31,11 @@ public class Draw implements Runnable {
     public static final float ROTATION_180 = 180;
     public static final float ROTATION_270 = 270;
 
+    public static final int FRAME_RATE_30 = 30;
+    public static final int FRAME_RATE_60 = 60;
+    public static final int FRAME_RATE_90 = 90;
+    public static final int FRAME_RATE_120 = 120;
+
     private final Handler m_notify;
     private final Surface m_drawingSurface;
     private final AssetManager m_assetManager;
@@ -39,10 +44,13 @@ public class Draw implements Runnable {
     private final boolean m_tryVulkan;
     private final boolean m_tryVulkanReadFromFile;
     private final boolean m_useShadows;
+    private final int m_maxFrameRate;
+    private final float m_refreshRate;
 
     public Draw(Handler inNotify, Surface inDrawingSurface, AssetManager inAssetManager,
                 String inSaveGameDir, float inRotation, boolean inTryVulkan,
-                boolean inTryVulkanReadFromFile, boolean inUseShadows) {
+                boolean inTryVulkanReadFromFile, boolean inUseShadows, int inMaxFrameRate,
+                float inRefreshRate) {
         m_notify = inNotify;
         m_drawingSurface = inDrawingSurface;
         m_assetManager = inAssetManager;
@@ -51,11 +59,14 @@ public class Draw implements Runnable {
         m_tryVulkan = inTryVulkan;
         m_tryVulkanReadFromFile = inTryVulkanReadFromFile;
         m_useShadows = inUseShadows;
+        m_maxFrameRate = inMaxFrameRate;
+        m_refreshRate = inRefreshRate;
     }
 
     public void run() {
         startGame(m_drawingSurface, m_assetManager, m_saveGameDir, new GameReturnChannel(m_notify),
-                  m_rotaation, m_tryVulkan, m_tryVulkanReadFromFile, m_useShadows);
+                  m_rotaation, m_tryVulkan, m_tryVulkanReadFromFile, m_useShadows,
+                  m_maxFrameRate, m_refreshRate);
     }
 
     public static void switchLevel(String level) {
@@ -82,6 +93,10 @@ public class Draw implements Runnable {
         tellDrawerTapOccurred(x, y);
     }
 
+    public static void thermalStatusChanged(int status) {
+        tellDrawerThermalStatusChanged(status);
+    }
+
     /**
      * Native methods.
      */
@@ -91,8 +106,10 @@ public class Draw implements Runnable {
     private static native void tellDrawerSwitchLevel(String level);
     private static native void tellDrawerSurfaceChanged(int width, int height, float rotationAngle);
     private static native void tellDrawerStop();
+    private static native void tellDrawerThermalStatusChanged(int status);
 
     private native void startGame(Surface drawingSurface, AssetManager manager, String saveData,
                                   GameReturnChannel notify, float rotationAngle, boolean tryVulkan,
-                                  boolean tryVulkanReadFromFile, boolean useShadows);
+                                  boolean tryVulkanReadFromFile, boolean useShadows,
+                                  int maxFrameRate, float refreshRate);
 }
@@ -251,6 +251,11 @@ public class MainActivity extends AppCompatActivity implements AdapterView.OnIte
         return drawSurfaceView.getDisplay().getRotation();
     }
 
+    public float getRefreshRate() {
+        SurfaceView drawSurfaceView = findViewById(R.id.mainDrawingSurface);
+        return drawSurfaceView.getDisplay().getRefreshRate();
+    }
+
     public Settings getSettings() {
         return m_settings;
     }
@@ -20,9 +20,12 @@
 
 package com.quasar.cerulean.amazinglabyrinth;
 
+import android.content.Context;
+import android.os.Build;
 import android.os.Bundle;
 import android.os.Handler;
 import android.os.Message;
+import android.os.PowerManager;
 import android.view.Surface;
 import android.view.SurfaceHolder;
 
@@ -32,10 +35,12 @@ import java.util.Locale;
 public class MySurfaceCallback implements SurfaceHolder.Callback {
     private MainActivity m_app;
     private Thread m_game;
+    private PowerManager.OnThermalStatusChangedListener m_thermalListener;
 
     public MySurfaceCallback(MainActivity inApp) {
         m_app = inApp;
         m_game = null;
+        m_thermalListener = null;
     }
 
     public void surfaceChanged(SurfaceHolder holder,
@@ -65,13 +70,16 @@ public class MySurfaceCallback implements SurfaceHolder.Callback {
             boolean tryVulkanReadFromFile = settings.isTryVulkanReadFromFile();
             boolean useShadows = settings.getUseShadows();
             m_game = new Thread(new Draw(notify, drawSurface, m_app.getAssets(),
-                    m_app.getFilesDir().toString(), getRotation(), tryVulkan, tryVulkanReadFromFile, useShadows));
+                    m_app.getFilesDir().toString(), getRotation(), tryVulkan, tryVulkanReadFromFile, useShadows,
+                    Draw.FRAME_RATE_60, m_app.getRefreshRate()));
             m_game.start();
+            addThermalListener();
         }
     }
 
     public void joinDrawer() {
         if (m_game != null) {
+            removeThermalListener();
             Draw.stopDrawer();
             try {
                 m_game.join();
@@ -82,6 +90,40 @@ public class MySurfaceCallback implements SurfaceHolder.Callback {
         }
     }
 
+    /* The drawer lowers the frame rate when the device gets hot.  The listener is called with the
+     * current status when it is added.
+     */
+    private void addThermalListener() {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.Q) {
+            return;
+        }
+
+        PowerManager powerManager = (PowerManager) m_app.getSystemService(Context.POWER_SERVICE);
+        if (powerManager == null) {
+            return;
+        }
+
+        m_thermalListener = new PowerManager.OnThermalStatusChangedListener() {
+            @Override
+            public void onThermalStatusChanged(int status) {
+                Draw.thermalStatusChanged(status);
+            }
+        };
+        powerManager.addThermalStatusListener(m_thermalListener);
+    }
+
+    private void removeThermalListener() {
+        if (m_thermalListener == null || Build.VERSION.SDK_INT < Build.VERSION_CODES.Q) {
+            return;
+        }
+
+        PowerManager powerManager = (PowerManager) m_app.getSystemService(Context.POWER_SERVICE);
+        if (powerManager != null) {
+            powerManager.removeThermalStatusListener(m_thermalListener);
+        }
+        m_thermalListener = null;
+    }
+
     private float getRotation() {
         switch (m_app.getRotation()) {
             case Surface.ROTATION_90:
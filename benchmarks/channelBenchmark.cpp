@@ -0,0 +1,202 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Stress test and throughput benchmark for SpscChannel.  A producer thread sends a stream of
+ * drag and tap events to a consumer thread which checks that nothing was lost, reordered or
+ * duplicated, with and without merging consecutive drags.  The same stream is also sent through a
+ * mutex and condition variable protected queue of shared_ptrs like the one GameSendChannel used to
+ * have for comparison.
+ *
+ * usage: channelBenchmark [number of events]
+ */
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <boost/variant.hpp>
+
+#include "spscChannel.hpp"
+
+namespace {
+    struct Drag {
+        uint64_t start;
+        uint64_t distance;
+        uint64_t count;
+    };
+
+    struct Tap {
+        uint64_t sequence;
+    };
+
+    using Event = boost::variant<Drag, Tap>;
+
+    // every 16th event is a tap, the rest are drags.  A new drag starts after each tap.
+    Event makeEvent(uint64_t i) {
+        if (i % 16 == 15) {
+            return Tap{i};
+        }
+        return Drag{i / 16, i, 1};
+    }
+
+    bool mergeDrags(Event &event, Event const &next) {
+        auto drag = boost::get<Drag>(&event);
+        auto nextDrag = boost::get<Drag>(&next);
+        if (drag == nullptr || nextDrag == nullptr || drag->start != nextDrag->start) {
+            return false;
+        }
+        drag->distance += nextDrag->distance;
+        drag->count += nextDrag->count;
+        return true;
+    }
+
+    // checks the events as they are received.
+    class Checker {
+    public:
+        void receive(Event const &event) {
+            m_received++;
+            if (auto drag = boost::get<Drag>(&event)) {
+                // the drags must follow each other without gaps.
+                uint64_t first = m_next;
+                uint64_t last = m_next + drag->count - 1;
+                uint64_t expectedDistance = (first + last) * drag->count / 2;
+                if (drag->start != first / 16 || drag->distance != expectedDistance) {
+                    m_ok = false;
+                }
+                m_next += drag->count;
+            } else {
+                if (boost::get<Tap>(event).sequence != m_next) {
+                    m_ok = false;
+                }
+                m_next++;
+            }
+        }
+
+        bool ok(uint64_t count) const { return m_ok && m_next == count; }
+        bool done(uint64_t count) const { return m_next >= count; }
+        uint64_t received() const { return m_received; }
+
+    private:
+        uint64_t m_next = 0;
+        uint64_t m_received = 0;
+        bool m_ok = true;
+    };
+
+    // a copy of the queue GameSendChannel used before.
+    class LockedQueue {
+    public:
+        void send(std::shared_ptr<Event> const &event) {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_queue.push(event);
+            m_cv.notify_one();
+        }
+
+        std::shared_ptr<Event> receive() {
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_cv.wait(lock, [this]() -> bool { return !m_queue.empty(); });
+            auto event = m_queue.front();
+            m_queue.pop();
+            return event;
+        }
+
+    private:
+        std::mutex m_lock;
+        std::condition_variable m_cv;
+        std::queue<std::shared_ptr<Event>> m_queue;
+    };
+
+    template <typename Fcn>
+    double timeIt(Fcn &&fcn) {
+        auto start = std::chrono::steady_clock::now();
+        fcn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    bool report(char const *name, double ms, uint64_t count, Checker const &checker) {
+        bool ok = checker.ok(count);
+        std::cout << name << ": " << ms << " ms, " << ms * 1000000.0 / count << " ns per event, "
+                  << checker.received() << " events received"
+                  << (ok ? "" : " (EVENTS LOST OR OUT OF ORDER)") << "\n";
+        return ok;
+    }
+
+    bool runLockedQueue(uint64_t count) {
+        LockedQueue queue;
+        Checker checker;
+        double ms = timeIt([&]() {
+            std::thread producer([&]() {
+                for (uint64_t i = 0; i < count; i++) {
+                    queue.send(std::make_shared<Event>(makeEvent(i)));
+                }
+            });
+            for (uint64_t i = 0; i < count; i++) {
+                checker.receive(*queue.receive());
+            }
+            producer.join();
+        });
+        return report("mutex queue of shared_ptr", ms, count, checker);
+    }
+
+    template <typename Receive>
+    bool runSpsc(char const *name, uint64_t count, Receive &&receive) {
+        SpscChannel<Event, 256> channel;
+        Checker checker;
+        double ms = timeIt([&]() {
+            std::thread producer([&]() {
+                for (uint64_t i = 0; i < count; i++) {
+                    channel.send(makeEvent(i));
+                }
+            });
+            while (!checker.done(count)) {
+                auto event = receive(channel);
+                if (event) {
+                    checker.receive(event.get());
+                } else {
+                    channel.waitForData(std::chrono::microseconds{1000});
+                }
+            }
+            producer.join();
+        });
+        return report(name, ms, count, checker);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    uint64_t count = 10000000;
+    if (argc > 1) {
+        count = std::strtoull(argv[1], nullptr, 10);
+    }
+
+    bool success = runLockedQueue(count);
+
+    success = runSpsc("spsc channel", count, [](SpscChannel<Event, 256> &channel) {
+        return channel.tryReceive();
+    }) && success;
+
+    success = runSpsc("spsc channel merging drags", count, [](SpscChannel<Event, 256> &channel) {
+        return channel.tryReceive(mergeDrags);
+    }) && success;
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,330 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Runs the frame loop of GraphicsVulkan::drawFrame against a simulated GPU that executes the
+ * submitted frames one after the other, with the uniform buffer slices (SlicedUniformUpdates) and
+ * the deferred release (DeferredRelease) the Vulkan backend uses, for 1 to 3 frames in flight.
+ *
+ * Checks that:
+ *     - writing a frame's slice never changes the slice of another frame still on the GPU.
+ *     - each frame reads the latest uniform values, and so does each draw to buffer.
+ *     - the writes are dropped once every frame slice has them.
+ *     - released objects are only freed after the fence of the last frame submitted before their
+ *       release.
+ *     - with more than one frame in flight, the CPU records frames while the GPU works on the
+ *       previous one.
+ *
+ * Then times writing the slices on the host.
+ *
+ * usage: framesInFlightBenchmark
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "framesInFlight.hpp"
+
+namespace {
+    using UniformUpdates = vulkan::SlicedUniformUpdates<int>;
+
+    // the per object uniforms, the size of a model matrix.
+    struct ObjectUniforms {
+        uint64_t frameNumber;
+        float padding[14];
+    };
+
+    size_t constexpr sliceAlignment = 256;
+    size_t constexpr nbrSlots = 256;
+    size_t constexpr slotSize = (sizeof (ObjectUniforms) + sliceAlignment - 1) / sliceAlignment * sliceAlignment;
+
+    int constexpr commonBuffer = 1;
+    int constexpr arenaBuffer = 2;
+
+    uint64_t nbrFailures = 0;
+
+    void check(bool ok, char const *what, uint64_t frameNumber) {
+        if (!ok) {
+            if (nbrFailures < 10) {
+                std::cerr << "frame " << frameNumber << ": " << what << "\n";
+            }
+            nbrFailures++;
+        }
+    }
+
+    // a uniform buffer divided into slices, as vulkan::Buffer creates it.
+    struct SlicedBuffer {
+        int handle;
+        size_t sliceSize;
+        std::vector<unsigned char> memory;
+
+        SlicedBuffer(UniformUpdates &updates, int inHandle, size_t inSliceSize)
+                : handle{inHandle},
+                  sliceSize{inSliceSize},
+                  memory(inSliceSize * UniformUpdates::numberSlices, 0)
+        {
+            updates.addBuffer(handle, memory.data(), sliceSize);
+        }
+
+        uint64_t frameNumberAt(uint32_t slice, size_t offset) const {
+            uint64_t frameNumber;
+            memcpy(&frameNumber, memory.data() + slice * sliceSize + offset, sizeof (frameNumber));
+            return frameNumber;
+        }
+
+        std::vector<unsigned char> slice(uint32_t slice) const {
+            auto begin = memory.begin() + slice * sliceSize;
+            return std::vector<unsigned char>(begin, begin + sliceSize);
+        }
+    };
+
+    struct FramePacing {
+        uint64_t framesSubmitted;
+        uint64_t framesOverlappedWithGPU;
+        uint64_t framesBlockedOnGPU;
+        double simulatedTime;
+    };
+
+    /* The frame loop of GraphicsVulkan::drawFrame.  The times are in milliseconds of simulated
+     * time: recording a frame takes cpuTime and the GPU takes gpuTime for it.
+     */
+    FramePacing runFrames(uint32_t framesInFlight, uint64_t nbrFrames, double cpuTime, double gpuTime) {
+        UniformUpdates updates;
+        updates.setFramesInFlight(framesInFlight);
+        vulkan::DeferredRelease deferredRelease{vulkan::maxFramesInFlight};
+
+        SlicedBuffer common{updates, commonBuffer, sliceAlignment};
+        SlicedBuffer arena{updates, arenaBuffer, slotSize * nbrSlots};
+
+        // the frame number of the latest values written at each slot, 0 if the slot is free.
+        std::vector<uint64_t> latest(nbrSlots, 0);
+        uint64_t latestCommon = 0;
+
+        struct FrameInFlight {
+            bool submitted;
+            double fenceSignaledAt;
+            uint64_t frameNumber;
+
+            // the slice as it was when the frame was submitted, what the GPU reads.
+            std::vector<unsigned char> commonSlice;
+            std::vector<unsigned char> arenaSlice;
+        };
+        std::vector<FrameInFlight> frames(framesInFlight);
+
+        double now = 0.0;
+        double gpuFreeAt = 0.0;
+        double lastSubmittedFence = 0.0;
+        size_t currentFrame = 0;
+        FramePacing pacing{0, 0, 0, 0.0};
+
+        uint64_t nbrReleased = 0;
+        uint64_t nbrFreed = 0;
+
+        ObjectUniforms uniforms{};
+        for (uint64_t frameNumber = 1; frameNumber <= nbrFrames + framesInFlight; frameNumber++) {
+            // the last frames don't change anything so that all the writes reach all the slices.
+            bool gameUpdates = frameNumber <= nbrFrames;
+            FrameInFlight &frame = frames[currentFrame];
+
+            if (frame.submitted && now < frame.fenceSignaledAt) {
+                pacing.framesBlockedOnGPU++;
+                now = frame.fenceSignaledAt;
+            }
+
+            // the GPU read the slice while the frame was in flight, it must not have changed.
+            if (frame.submitted) {
+                check(common.slice(currentFrame) == frame.commonSlice &&
+                      arena.slice(currentFrame) == frame.arenaSlice,
+                      "a slice was written while the frame reading it was on the GPU", frame.frameNumber);
+            }
+            deferredRelease.frameDone(currentFrame);
+
+            if (lastSubmittedFence > now) {
+                pacing.framesOverlappedWithGPU++;
+            }
+
+            if (gameUpdates) {
+                // the camera and lighting change every frame, a quarter of the objects move.
+                uniforms.frameNumber = frameNumber;
+                updates.update(commonBuffer, &uniforms, sizeof (uniforms));
+                latestCommon = frameNumber;
+                for (size_t slot = frameNumber % 4; slot < nbrSlots; slot += 4) {
+                    updates.update(arenaBuffer, slot * slotSize, &uniforms, sizeof (uniforms));
+                    latest[slot] = frameNumber;
+                }
+
+                // an object is removed: its slot is freed and its draw object data released.
+                if (frameNumber % 10 == 0) {
+                    size_t slot = (frameNumber / 10) % nbrSlots;
+                    updates.discard(arenaBuffer, slot * slotSize);
+                    latest[slot] = 0;
+
+                    double mustBeDoneAt = lastSubmittedFence;
+                    bool anySubmitted = pacing.framesSubmitted > 0;
+                    double const *simulatedNow = &now;
+                    uint64_t *freed = &nbrFreed;
+                    std::shared_ptr<void> objectData{new int{0}, [=](void *p) {
+                        check(!anySubmitted || *simulatedNow >= mustBeDoneAt,
+                              "released object freed while a frame using it was on the GPU", frameNumber);
+                        (*freed)++;
+                        delete static_cast<int *>(p);
+                    }};
+                    deferredRelease.release(std::move(objectData));
+                    nbrReleased++;
+                }
+            }
+
+            std::vector<std::vector<unsigned char>> otherSlicesBefore;
+            for (uint32_t slice = 0; slice < UniformUpdates::numberSlices; slice++) {
+                otherSlicesBefore.push_back(arena.slice(slice));
+            }
+
+            uint32_t frameIndex = static_cast<uint32_t>(currentFrame);
+            updates.writeSlice(frameIndex);
+
+            check(updates.currentSlice() == frameIndex, "the draws do not read the frame's slice", frameNumber);
+            for (uint32_t slice = 0; slice < UniformUpdates::numberSlices; slice++) {
+                if (slice != frameIndex) {
+                    check(arena.slice(slice) == otherSlicesBefore[slice],
+                          "writing the frame's slice changed another slice", frameNumber);
+                }
+            }
+            check(common.frameNumberAt(frameIndex, 0) == latestCommon,
+                  "the frame does not read the latest common values", frameNumber);
+            for (size_t slot = 0; slot < nbrSlots; slot++) {
+                if (latest[slot] != 0) {
+                    check(arena.frameNumberAt(frameIndex, slot * slotSize) == latest[slot],
+                          "the frame does not read the latest object values", frameNumber);
+                }
+            }
+
+            // every 100 frames, a draw to buffer reads its own slice.
+            if (gameUpdates && frameNumber % 100 == 0) {
+                std::vector<std::vector<unsigned char>> frameSlicesBefore;
+                for (uint32_t slice = 0; slice < framesInFlight; slice++) {
+                    frameSlicesBefore.push_back(arena.slice(slice));
+                }
+
+                updates.writeDrawToBufferSlice();
+                uint32_t slice = UniformUpdates::drawToBufferSlice;
+                check(updates.currentSlice() == slice, "the draw to buffer does not read its slice", frameNumber);
+                check(common.frameNumberAt(slice, 0) == latestCommon,
+                      "the draw to buffer does not read the latest common values", frameNumber);
+                for (size_t slot = 0; slot < nbrSlots; slot++) {
+                    if (latest[slot] != 0) {
+                        check(arena.frameNumberAt(slice, slot * slotSize) == latest[slot],
+                              "the draw to buffer does not read the latest object values", frameNumber);
+                    }
+                }
+                for (uint32_t other = 0; other < framesInFlight; other++) {
+                    check(arena.slice(other) == frameSlicesBefore[other],
+                          "the draw to buffer changed a frame's slice", frameNumber);
+                }
+            }
+
+            // record and submit.
+            now += cpuTime;
+            gpuFreeAt = std::max(now, gpuFreeAt) + gpuTime;
+            frame.submitted = true;
+            frame.fenceSignaledAt = gpuFreeAt;
+            frame.frameNumber = frameNumber;
+            frame.commonSlice = common.slice(frameIndex);
+            frame.arenaSlice = arena.slice(frameIndex);
+            lastSubmittedFence = gpuFreeAt;
+            deferredRelease.frameSubmitted(currentFrame);
+            pacing.framesSubmitted++;
+            currentFrame = (currentFrame + 1) % framesInFlight;
+        }
+
+        check(updates.pendingUpdates() == 0, "writes are still pending after every slice was written", nbrFrames);
+
+        // wait for the device to be idle, then everything released is freed.
+        now = std::max(now, gpuFreeAt);
+        for (size_t frame = 0; frame < vulkan::maxFramesInFlight; frame++) {
+            deferredRelease.frameDone(frame);
+        }
+        check(nbrFreed == nbrReleased, "released objects were not freed", nbrFrames);
+
+        pacing.simulatedTime = now;
+        return pacing;
+    }
+
+    // the host time to write a frame's slice when a quarter of the objects moved.
+    double timeSliceWrites(uint32_t framesInFlight, uint64_t nbrFrames) {
+        UniformUpdates updates;
+        updates.setFramesInFlight(framesInFlight);
+        SlicedBuffer common{updates, commonBuffer, sliceAlignment};
+        SlicedBuffer arena{updates, arenaBuffer, slotSize * nbrSlots};
+
+        ObjectUniforms uniforms{};
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t frameNumber = 1; frameNumber <= nbrFrames; frameNumber++) {
+            uniforms.frameNumber = frameNumber;
+            updates.update(commonBuffer, &uniforms, sizeof (uniforms));
+            for (size_t slot = frameNumber % 4; slot < nbrSlots; slot += 4) {
+                updates.update(arenaBuffer, slot * slotSize, &uniforms, sizeof (uniforms));
+            }
+            updates.writeSlice(static_cast<uint32_t>(frameNumber % framesInFlight));
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        // use the results so that the writes are not optimized away.
+        check(arena.frameNumberAt(nbrFrames % framesInFlight, (nbrFrames % 4) * slotSize) == nbrFrames,
+              "the timed writes did not reach the slice", nbrFrames);
+        return std::chrono::duration<double, std::nano>(end - start).count() / nbrFrames;
+    }
+}
+
+int main() {
+    uint64_t constexpr nbrFrames = 3000;
+
+    // the GPU takes longer than the CPU for a frame, about 60 frames per second.
+    double constexpr cpuTime = 6.0;
+    double constexpr gpuTime = 16.0;
+
+    for (uint32_t framesInFlight = 1; framesInFlight <= vulkan::maxFramesInFlight; framesInFlight++) {
+        FramePacing pacing = runFrames(framesInFlight, nbrFrames, cpuTime, gpuTime);
+        std::cout << framesInFlight << " frames in flight: "
+                  << pacing.framesSubmitted << " frames, "
+                  << pacing.framesOverlappedWithGPU << " recorded while the GPU was busy, "
+                  << pacing.framesBlockedOnGPU << " blocked on their fence, "
+                  << pacing.simulatedTime / pacing.framesSubmitted << " ms per frame (simulated)\n";
+
+        if (framesInFlight == 1) {
+            check(pacing.framesOverlappedWithGPU == 0, "one frame in flight overlapped the GPU", nbrFrames);
+        } else {
+            // the first frame has nothing to overlap with.
+            check(pacing.framesOverlappedWithGPU == pacing.framesSubmitted - 1,
+                  "the CPU waited for the GPU to go idle between frames", nbrFrames);
+        }
+
+        std::cout << "    writing a frame's slice: " << timeSliceWrites(framesInFlight, 100000)
+                  << " ns per frame\n";
+    }
+
+    if (nbrFailures != 0) {
+        std::cerr << nbrFailures << " checks failed\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_HOST_GAME_REQUESTER_HPP
+#define AMAZING_LABYRINTH_HOST_GAME_REQUESTER_HPP
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+
+/* A GameRequester for running the game code on the development machine.  Assets are read from a
+ * directory on the file system laid out like app/src/main/assets instead of from the APK and the
+ * Java side requests are either ignored or answered with placeholder data.
+ */
+class HostGameRequester : public GameRequester {
+public:
+    std::unique_ptr<std::streambuf> getAssetStream(std::string const &file) override {
+        auto buf = std::make_unique<std::filebuf>();
+        if (buf->open(m_assetDirectory + "/" + file, std::ios_base::in | std::ios_base::binary) == nullptr) {
+            throw std::runtime_error("Could not open asset: " + file);
+        }
+        return buf;
+    }
+
+    std::unique_ptr<std::streambuf> getLevelTableAssetStream() override {
+        return getAssetStream(m_levelTableFilePath);
+    }
+
+    // an empty save file name means that there is no saved game to restore.
+    std::string getSaveDataFileName() override { return m_pathSaveFile; }
+
+    void sendError(std::string const &error) override {
+        std::cerr << "Error: " << error << std::endl;
+    }
+
+    void sendError(char const *error) override {
+        std::cerr << "Error: " << error << std::endl;
+    }
+
+    void sendGraphicsDescription(GraphicsDescription const &, bool, bool) override {}
+
+    void sendKeepAliveEnabled(bool) override {}
+
+    // There is no Android text rendering here.  Return a blank RGBA image of about the size the
+    // text would be.
+    std::vector<char> getTextImage(std::string text, uint32_t &width, uint32_t &height,
+                                   uint32_t &channels) override
+    {
+        height = m_textHeight;
+        width = static_cast<uint32_t>(text.size()) * m_textHeight / 2 + 1;
+        channels = 4;
+        return std::vector<char>(width * height * channels, 0);
+    }
+
+    std::string const &assetDirectory() const { return m_assetDirectory; }
+    std::string const &levelTableFilePath() const { return m_levelTableFilePath; }
+
+    HostGameRequester(std::string inAssetDirectory, std::string inSaveGameFile = "")
+        : m_assetDirectory{std::move(inAssetDirectory)},
+          m_pathSaveFile{std::move(inSaveGameFile)},
+          m_levelTableFilePath{"configs/levels.json"}
+    {}
+
+    ~HostGameRequester() override = default;
+
+private:
+    static uint32_t constexpr m_textHeight = 64;
+
+    std::string m_assetDirectory;
+    std::string m_pathSaveFile;
+    std::string m_levelTableFilePath;
+};
+
+#endif // AMAZING_LABYRINTH_HOST_GAME_REQUESTER_HPP
@@ -0,0 +1,275 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef AMAZING_LABYRINTH_HOST_LEVEL_DRAWER_HPP
+#define AMAZING_LABYRINTH_HOST_LEVEL_DRAWER_HPP
+
+#include <array>
+#include <future>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "common.hpp"
+#include "mathGraphics.hpp"
+#include "levelDrawer/common.hpp"
+#include "levelDrawer/levelDrawer.hpp"
+#include "levelDrawer/modelTable/modelLoader.hpp"
+#include "levelDrawer/softwareRasterizer/softwareRasterizer.hpp"
+#include "levelDrawer/textureTable/textureLoader.hpp"
+#include "renderDetails/renderDetails.hpp"
+
+/* A LevelDrawer that does not draw.  It keeps the same bookkeeping the graphics level drawers
+ * do for the levels (draw objects, their model matrices and the global render details
+ * parameters) and decodes each distinct model and texture once like the model and texture tables,
+ * but it never talks to a GPU.  It is used to run the levels on the development machine.
+ *
+ * The projection and view matrices are computed with the OpenGL conventions from the perspective
+ * parameters the level requested.  drawToBuffer is done with the software rasterizer.
+ */
+class HostLevelDrawer : public levelDrawer::LevelDrawer {
+public:
+    void setClearColor(levelDrawer::ObjectType, glm::vec4 const &) override {}
+
+    bool emptyOfDrawObjects(levelDrawer::ObjectType type) override {
+        return m_drawObjectTableList[type].drawObjects.empty();
+    }
+
+    size_t numberObjects(levelDrawer::ObjectType type) override {
+        return m_drawObjectTableList[type].drawObjects.size();
+    }
+
+    void clearDrawObjectTable(levelDrawer::ObjectType type) override {
+        m_drawObjectTableList[type] = DrawObjectTable{};
+    }
+
+    levelDrawer::DrawObjReference addObject(
+            levelDrawer::ObjectType type,
+            std::shared_ptr<levelDrawer::ModelDescription> const &modelDescription,
+            std::shared_ptr<levelDrawer::TextureDescription> const &textureDescription) override
+    {
+        loadModelTexture(modelDescription, textureDescription);
+        auto &table = m_drawObjectTableList[type];
+        auto objRef = table.nextDrawObjReference++;
+        table.drawObjects.emplace(objRef, DrawObject{});
+        return objRef;
+    }
+
+    levelDrawer::DrawObjReference addObject(
+            levelDrawer::ObjectType type,
+            std::shared_ptr<levelDrawer::ModelDescription> const &modelDescription,
+            std::shared_ptr<levelDrawer::TextureDescription> const &textureDescription,
+            std::string const &,
+            std::shared_ptr<renderDetails::Parameters> const &) override
+    {
+        return addObject(type, modelDescription, textureDescription);
+    }
+
+    levelDrawer::DrawObjReference addInstancedObject(
+            levelDrawer::ObjectType type,
+            std::shared_ptr<levelDrawer::ModelDescription> const &modelDescription,
+            std::shared_ptr<levelDrawer::TextureDescription> const &textureDescription) override
+    {
+        return addObject(type, modelDescription, textureDescription);
+    }
+
+    void removeObject(levelDrawer::ObjectType type, levelDrawer::DrawObjReference objRef) override {
+        m_drawObjectTableList[type].drawObjects.erase(objRef);
+    }
+
+    levelDrawer::DrawObjDataReference addModelMatrixForObject(
+            levelDrawer::ObjectType type,
+            levelDrawer::DrawObjReference objRef,
+            glm::mat4 const &modelMatrix) override
+    {
+        auto &drawObj = drawObject(type, objRef);
+        auto objDataRef = drawObj.nextDrawObjDataReference++;
+        drawObj.modelMatrices.emplace(objDataRef, modelMatrix);
+        return objDataRef;
+    }
+
+    void updateModelMatrixForObject(
+            levelDrawer::ObjectType type,
+            levelDrawer::DrawObjReference objRef,
+            levelDrawer::DrawObjDataReference objDataRef,
+            glm::mat4 const &modelMatrix) override
+    {
+        modelMatrix_(type, objRef, objDataRef) = modelMatrix;
+    }
+
+    boost::optional<levelDrawer::DrawObjDataReference> transferObject(
+            levelDrawer::ObjectType type,
+            levelDrawer::DrawObjReference fromObjRef,
+            levelDrawer::DrawObjDataReference objDataRef,
+            levelDrawer::DrawObjReference toObjRef) override
+    {
+        glm::mat4 modelMatrix = modelMatrix_(type, fromObjRef, objDataRef);
+        auto newObjDataRef = addModelMatrixForObject(type, toObjRef, modelMatrix);
+        drawObject(type, fromObjRef).modelMatrices.erase(objDataRef);
+        return newObjDataRef;
+    }
+
+    void removeObjectData(
+            levelDrawer::ObjectType type,
+            levelDrawer::DrawObjReference objRef,
+            levelDrawer::DrawObjDataReference objDataRef) override
+    {
+        drawObject(type, objRef).modelMatrices.erase(objDataRef);
+    }
+
+    size_t numberObjectsDataForObject(levelDrawer::ObjectType type, levelDrawer::DrawObjReference objRef) override {
+        return drawObject(type, objRef).modelMatrices.size();
+    }
+
+    void requestRenderDetails(
+            levelDrawer::ObjectType type,
+            std::string const &,
+            std::shared_ptr<renderDetails::Parameters> const &parameters) override
+    {
+        auto perspective = std::dynamic_pointer_cast<renderDetails::ParametersPerspective>(parameters);
+        if (perspective == nullptr) {
+            throw std::runtime_error("Host level drawer: only perspective render details are supported for a level.");
+        }
+        m_drawObjectTableList[type].parameters = std::move(perspective);
+    }
+
+    std::pair<glm::mat4, glm::mat4> getProjectionView(levelDrawer::ObjectType type) override {
+        auto const &parameters = m_drawObjectTableList[type].parameters;
+        if (parameters == nullptr) {
+            throw std::runtime_error("Render details reference not set for level type");
+        }
+
+        return std::make_pair(
+                getPerspectiveMatrix(parameters->viewAngle,
+                        static_cast<float>(m_surfaceWidth) / static_cast<float>(m_surfaceHeight),
+                        parameters->nearPlane, parameters->farPlane, false, false),
+                glm::lookAt(parameters->viewPoint, parameters->lookAt, parameters->up));
+    }
+
+    char const *getDefaultRenderDetailsName() override { return objectNoShadowsRenderDetailsName; }
+
+    std::future<std::vector<float>> drawToBufferAsync(
+            std::string const &renderDetailsName,
+            levelDrawer::ModelsTextures const &modelsTextures,
+            std::vector<glm::mat4> const &modelMatrix,
+            float width,
+            float height,
+            uint32_t nbrSamplesForWidth,
+            std::shared_ptr<renderDetails::Parameters> const &parameters) override
+    {
+        return m_softwareRasterizer.drawToBufferAsync(m_gameRequester, renderDetailsName,
+                modelsTextures, modelMatrix, width, height, nbrSamplesForWidth, parameters);
+    }
+
+    // there is no GPU, drawToBuffer is always done on the CPU.
+    void setDrawToBufferRasterizer(levelDrawer::DrawToBufferRasterizer) override {}
+
+    std::unique_ptr<std::streambuf> getAssetStream(std::string const &file) override {
+        return m_gameRequester->getAssetStream(file);
+    }
+
+    void updateCommonObjectData(
+            levelDrawer::ObjectType,
+            levelDrawer::DrawObjReference const &,
+            renderDetails::Parameters const &) override {}
+
+    // number of distinct models and textures decoded so far.
+    size_t numberModelsLoaded() const { return m_models.size(); }
+    size_t numberTexturesLoaded() const { return m_textures.size(); }
+
+    HostLevelDrawer(std::shared_ptr<GameRequester> inGameRequester,
+                    uint32_t inSurfaceWidth,
+                    uint32_t inSurfaceHeight)
+        : m_gameRequester{std::move(inGameRequester)},
+          m_surfaceWidth{inSurfaceWidth},
+          m_surfaceHeight{inSurfaceHeight}
+    {}
+
+    ~HostLevelDrawer() override = default;
+
+private:
+    struct DrawObject {
+        levelDrawer::DrawObjDataReference nextDrawObjDataReference = 0;
+        std::unordered_map<levelDrawer::DrawObjDataReference, glm::mat4> modelMatrices;
+    };
+
+    struct DrawObjectTable {
+        levelDrawer::DrawObjReference nextDrawObjReference = 0;
+        std::unordered_map<levelDrawer::DrawObjReference, DrawObject> drawObjects;
+        std::shared_ptr<renderDetails::ParametersPerspective> parameters;
+    };
+
+    std::shared_ptr<GameRequester> m_gameRequester;
+    uint32_t m_surfaceWidth;
+    uint32_t m_surfaceHeight;
+    std::array<DrawObjectTable, levelDrawer::nbrDrawObjectTables> m_drawObjectTableList;
+    levelDrawer::SoftwareRasterizer m_softwareRasterizer;
+    std::set<std::shared_ptr<levelDrawer::ModelDescription>,
+            levelDrawer::BaseClassPtrLess<levelDrawer::ModelDescription>> m_models;
+    std::set<std::shared_ptr<levelDrawer::TextureDescription>,
+            levelDrawer::BaseClassPtrLess<levelDrawer::TextureDescription>> m_textures;
+
+    DrawObject &drawObject(levelDrawer::ObjectType type, levelDrawer::DrawObjReference objRef) {
+        auto &drawObjects = m_drawObjectTableList[type].drawObjects;
+        auto it = drawObjects.find(objRef);
+        if (it == drawObjects.end()) {
+            throw std::runtime_error("Invalid draw object reference.");
+        }
+        return it->second;
+    }
+
+    glm::mat4 &modelMatrix_(
+            levelDrawer::ObjectType type,
+            levelDrawer::DrawObjReference objRef,
+            levelDrawer::DrawObjDataReference objDataRef)
+    {
+        auto &modelMatrices = drawObject(type, objRef).modelMatrices;
+        auto it = modelMatrices.find(objDataRef);
+        if (it == modelMatrices.end()) {
+            throw std::runtime_error("Invalid draw object data reference.");
+        }
+        return it->second;
+    }
+
+    // decode the model and texture the first time they are used, like the model and texture
+    // tables do, and throw the data away.
+    void loadModelTexture(
+            std::shared_ptr<levelDrawer::ModelDescription> const &modelDescription,
+            std::shared_ptr<levelDrawer::TextureDescription> const &textureDescription)
+    {
+        if (modelDescription != nullptr && m_models.insert(modelDescription).second) {
+            modelDescription->getData(m_gameRequester);
+        }
+
+        if (textureDescription != nullptr && m_textures.insert(textureDescription).second) {
+            uint32_t texWidth;
+            uint32_t texHeight;
+            uint32_t texChannels;
+            textureDescription->getData(m_gameRequester, texWidth, texHeight, texChannels);
+        }
+    }
+};
+
+#endif // AMAZING_LABYRINTH_HOST_LEVEL_DRAWER_HPP
@@ -0,0 +1,236 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Loads each level listed in levels.json without a GPU and plays it for a number of simulated
+ * seconds with a scripted accelerometer, then reports how long loading the configuration,
+ * creating the level, updateData and updateDrawObjects took.
+ *
+ * The levels measure time with the system clock, so the frames are paced at 60 frames per
+ * second and only the time spent in the level code is counted.
+ *
+ * usage: levelBenchmark [simulated seconds] [asset directory] [level name...]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <istream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <json.hpp>
+
+#include "levelTracker/levelTracker.hpp"
+#include "hostGameRequester.hpp"
+#include "hostLevelDrawer.hpp"
+
+namespace {
+    uint32_t constexpr surfaceWidth = 1080;
+    uint32_t constexpr surfaceHeight = 1920;
+    uint32_t constexpr framesPerSecond = 60;
+    float constexpr gravity = 9.8f;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct PhaseTime {
+        double total = 0.0;
+        double max = 0.0;
+        size_t count = 0;
+
+        void add(double microseconds) {
+            total += microseconds;
+            max = std::max(max, microseconds);
+            count++;
+        }
+
+        double mean() const { return count == 0 ? 0.0 : total / count; }
+    };
+
+    struct LevelResult {
+        std::string name;
+        PhaseTime load;
+        PhaseTime create;
+        PhaseTime updateData;
+        PhaseTime updateDrawObjects;
+        bool finished = false;
+    };
+
+    template <typename Fcn>
+    double timeIt(Fcn &&fcn) {
+        auto start = Clock::now();
+        fcn();
+        auto end = Clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    /* The device is tilted about 30 degrees from flat and the direction it is tilted in turns
+     * once every 8 seconds, with a sharp jolt in the opposite direction every 3 seconds so that
+     * the ball hits walls at speed.
+     */
+    void scriptedAcceleration(float t, float &x, float &y, float &z) {
+        float tilt = 0.5f;
+        float direction = t * 2.0f * 3.1415926f / 8.0f;
+        if (std::fmod(t, 3.0f) < 0.25f) {
+            direction += 3.1415926f;
+            tilt = 1.0f;
+        }
+
+        x = gravity * std::sin(tilt) * std::cos(direction);
+        y = gravity * std::sin(tilt) * std::sin(direction);
+        z = gravity * std::cos(tilt);
+    }
+
+    std::vector<std::string> allLevelNames(std::shared_ptr<HostGameRequester> const &gameRequester) {
+        auto streambuf = gameRequester->getLevelTableAssetStream();
+        std::istream stream(streambuf.get());
+        nlohmann::json j;
+        stream >> j;
+
+        std::vector<std::string> names;
+        for (auto const &entry : j["Levels"]) {
+            names.push_back(entry["Name"].get<std::string>());
+        }
+        return names;
+    }
+
+    LevelResult runLevel(
+            std::shared_ptr<HostGameRequester> const &gameRequester,
+            levelTracker::Loader &loader,
+            std::string const &levelName,
+            uint32_t nbrFrames)
+    {
+        LevelResult result;
+        result.name = levelName;
+
+        if (!loader.setLevel(levelName)) {
+            throw std::runtime_error("Unknown level: " + levelName);
+        }
+
+        auto drawer = std::make_shared<HostLevelDrawer>(gameRequester, surfaceWidth, surfaceHeight);
+
+        levelTracker::LevelGroup levelGroup;
+        result.load.add(timeIt([&]() {
+            levelGroup = loader.getLevelGroupFcns(surfaceWidth, surfaceHeight);
+        }));
+
+        std::shared_ptr<basic::Level> level;
+        result.create.add(timeIt([&]() {
+            level = levelGroup.getLevelFcn(levelDrawer::Adaptor(levelDrawer::LEVEL, drawer));
+            level->start();
+        }));
+
+        auto frameTime = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / framesPerSecond));
+        auto nextFrame = Clock::now();
+        for (uint32_t frame = 0; frame < nbrFrames; frame++) {
+            nextFrame += frameTime;
+            std::this_thread::sleep_until(nextFrame);
+
+            float x, y, z;
+            scriptedAcceleration(static_cast<float>(frame) / framesPerSecond, x, y, z);
+            level->updateAcceleration(x, y, z);
+
+            bool drawingNecessary = false;
+            result.updateData.add(timeIt([&]() {
+                drawingNecessary = level->updateData();
+            }));
+
+            if (drawingNecessary) {
+                result.updateDrawObjects.add(timeIt([&]() {
+                    level->updateDrawObjects();
+                }));
+            }
+
+            if (level->isFinished()) {
+                result.finished = true;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    void report(LevelResult const &result) {
+        std::cout << std::left << std::setw(20) << result.name << std::right << std::fixed
+                  << std::setprecision(2)
+                  << " load: " << std::setw(9) << result.load.total / 1000.0 << " ms"
+                  << " create: " << std::setw(9) << result.create.total / 1000.0 << " ms"
+                  << " updateData: " << std::setw(8) << result.updateData.mean() << " us mean "
+                  << std::setw(9) << result.updateData.max << " us max (" << result.updateData.count << ")"
+                  << " updateDrawObjects: " << std::setw(8) << result.updateDrawObjects.mean() << " us mean "
+                  << std::setw(9) << result.updateDrawObjects.max << " us max (" << result.updateDrawObjects.count << ")"
+                  << (result.finished ? " finished" : "") << "\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    float seconds = 5.0f;
+    std::string assetDirectory = "../app/src/main/assets";
+    if (argc > 1) {
+        seconds = std::strtof(argv[1], nullptr);
+        if (seconds <= 0.0f) {
+            std::cerr << "usage: " << argv[0] << " [simulated seconds] [asset directory] [level name...]\n";
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        assetDirectory = argv[2];
+    }
+
+    try {
+        auto gameRequester = std::make_shared<HostGameRequester>(assetDirectory);
+        levelTracker::Loader loader(gameRequester);
+
+        std::vector<std::string> levelNames;
+        for (int i = 3; i < argc; i++) {
+            levelNames.emplace_back(argv[i]);
+        }
+        if (levelNames.empty()) {
+            levelNames = allLevelNames(gameRequester);
+        }
+
+        auto nbrFrames = static_cast<uint32_t>(seconds * framesPerSecond);
+        LevelResult total;
+        total.name = "all levels";
+        for (auto const &levelName : levelNames) {
+            auto result = runLevel(gameRequester, loader, levelName, nbrFrames);
+            report(result);
+
+            total.load.add(result.load.total);
+            total.create.add(result.create.total);
+            total.updateData.total += result.updateData.total;
+            total.updateData.count += result.updateData.count;
+            total.updateData.max = std::max(total.updateData.max, result.updateData.max);
+            total.updateDrawObjects.total += result.updateDrawObjects.total;
+            total.updateDrawObjects.count += result.updateDrawObjects.count;
+            total.updateDrawObjects.max = std::max(total.updateDrawObjects.max, result.updateDrawObjects.max);
+        }
+        report(total);
+    } catch (std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Times maze generation for each GeneratedMazeBoard mode from 10^2 to 10^6 cells and checks that
+ * each generated maze is a spanning tree of the cells (connected and without loops).
+ *
+ * usage: mazeBenchmark [maximum number of cells]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "levels/generatedMazeAlgorithms.hpp"
+
+namespace {
+    struct ModeName {
+        GeneratedMazeBoard::Mode mode;
+        char const *name;
+        // Wilson's random walks take quadratic time to cross a long narrow maze, so skip it there.
+        bool tallMazes;
+        // BFS and DFS don't go past the end cell, so in a maze one cell wide they can't reach the
+        // cells behind it.
+        bool oneWideMazes;
+    };
+
+    ModeName const modes[] = {
+            {GeneratedMazeBoard::Mode::BFS, "BFS", true, false},
+            {GeneratedMazeBoard::Mode::DFS, "DFS", true, false},
+            {GeneratedMazeBoard::Mode::Wilson, "Wilson", false, true},
+            {GeneratedMazeBoard::Mode::Kruskal, "Kruskal", true, true},
+            {GeneratedMazeBoard::Mode::Eller, "Eller", true, true}
+    };
+
+    // returns true if the passages form a spanning tree of the cells.
+    bool isSpanningTree(GeneratedMazeBoard const &board) {
+        size_t rows = board.numberRows();
+        size_t cols = board.numberColumns();
+        size_t nbrPassages = 0;
+        std::vector<bool> reached(rows * cols, false);
+        std::vector<std::pair<size_t, size_t>> stack;
+
+        for (size_t row = 0; row < rows; row++) {
+            for (size_t col = 0; col < cols; col++) {
+                if (row + 1 < rows && !board.getCell(row, col).bottomWallExists()) {
+                    nbrPassages++;
+                }
+                if (col + 1 < cols && !board.getCell(row, col).rightWallExists()) {
+                    nbrPassages++;
+                }
+            }
+        }
+
+        if (nbrPassages != rows * cols - 1) {
+            return false;
+        }
+
+        size_t nbrReached = 0;
+        stack.emplace_back(0, 0);
+        reached[0] = true;
+        while (!stack.empty()) {
+            auto current = stack.back();
+            stack.pop_back();
+            nbrReached++;
+            Cell cell = board.getCell(current.first, current.second);
+            auto visit = [&](bool wallExists, size_t row, size_t col) {
+                if (!wallExists && !reached[row * cols + col]) {
+                    reached[row * cols + col] = true;
+                    stack.emplace_back(row, col);
+                }
+            };
+            visit(current.first == 0 || cell.topWallExists(), current.first - 1, current.second);
+            visit(current.first + 1 == rows || cell.bottomWallExists(), current.first + 1, current.second);
+            visit(current.second == 0 || cell.leftWallExists(), current.first, current.second - 1);
+            visit(current.second + 1 == cols || cell.rightWallExists(), current.first, current.second + 1);
+        }
+
+        return nbrReached == rows * cols;
+    }
+
+    bool runBenchmark(ModeName const &mode, size_t rows, size_t cols) {
+        auto start = std::chrono::steady_clock::now();
+        GeneratedMazeBoard board(rows, cols, mode.mode);
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        bool valid = isSpanningTree(board);
+        std::cout << mode.name << " " << rows << "x" << cols << ": " << ms << " ms, "
+                  << ms * 1000000.0 / (rows * cols) << " ns per cell"
+                  << (valid ? "" : " (NOT A SPANNING TREE)") << "\n";
+        return valid;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t maxCells = 1000000;
+    if (argc > 1) {
+        maxCells = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    // square mazes, a very tall one and a single column and row.
+    std::vector<std::pair<size_t, size_t>> sizes = {
+            {10, 10},
+            {100, 100},
+            {1000, 1000},
+            {100000, 10},
+            {100, 1},
+            {1, 100}
+    };
+
+    bool success = true;
+    for (auto const &mode : modes) {
+        for (auto const &size : sizes) {
+            bool tall = size.first > 10 * size.second;
+            bool oneWide = size.first == 1 || size.second == 1;
+            if (size.first * size.second <= maxCells && (mode.tallMazes || !tall) &&
+                (mode.oneWideMazes || !oneWide))
+            {
+                success = runBenchmark(mode, size.first, size.second) && success;
+            }
+        }
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Compares the old Random implementation (one read from /dev/urandom per number) with the
+ * xoshiro256** engine now used by Random.
+ *
+ * usage: randomBenchmark [number of values]
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include "random.hpp"
+
+namespace {
+    // the implementation Random used to have.
+    class UrandomRandom {
+    public:
+        UrandomRandom() : m_fd{open("/dev/urandom", O_RDONLY)} {
+            if (m_fd == -1) {
+                throw std::runtime_error("Could not open /dev/urandom");
+            }
+        }
+
+        unsigned int getUInt(unsigned int lowerBound, unsigned int upperBound) {
+            unsigned int range = upperBound - lowerBound + 1;
+            unsigned int tooBig = std::numeric_limits<unsigned int>::max() / range * range;
+
+            unsigned int random;
+            do {
+                if (read(m_fd, &random, sizeof (random)) != sizeof (random)) {
+                    throw std::runtime_error("Could not read enough random data");
+                }
+            } while (random >= tooBig);
+
+            return random % range + lowerBound;
+        }
+
+        ~UrandomRandom() { close(m_fd); }
+    private:
+        int m_fd;
+    };
+
+    template <typename Fcn>
+    double timeIt(Fcn &&fcn) {
+        auto start = std::chrono::steady_clock::now();
+        fcn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    void report(char const *name, double microseconds, size_t count, unsigned long long checksum) {
+        std::cout << name << ": " << microseconds << " us total, "
+                  << microseconds * 1000.0 / count << " ns per value (checksum " << checksum << ")\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t count = 1000000;
+    if (argc > 1) {
+        count = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    // bounds similar to what maze generation uses: picking one of a cell's neighbors.
+    unsigned int const lowerBound = 0;
+    unsigned int const upperBound = 3;
+
+    unsigned long long checksum = 0;
+
+    UrandomRandom urandom;
+    double urandomTime = timeIt([&]() {
+        for (size_t i = 0; i < count; i++) {
+            checksum += urandom.getUInt(lowerBound, upperBound);
+        }
+    });
+    report("urandom getUInt", urandomTime, count, checksum);
+
+    checksum = 0;
+    Random random;
+    double engineTime = timeIt([&]() {
+        for (size_t i = 0; i < count; i++) {
+            checksum += random.getUInt(lowerBound, upperBound);
+        }
+    });
+    report("xoshiro256** getUInt", engineTime, count, checksum);
+
+    checksum = 0;
+    std::vector<unsigned int> values(count);
+    double fillTime = timeIt([&]() {
+        random.fill(values, lowerBound, upperBound);
+    });
+    for (auto value : values) {
+        checksum += value;
+    }
+    report("xoshiro256** fill", fillTime, count, checksum);
+
+    // the same seed must give the same sequence.
+    Random seeded1(12345);
+    Random seeded2(12345);
+    for (size_t i = 0; i < 1000; i++) {
+        if (seeded1.getUInt(0, 1000) != seeded2.getUInt(0, 1000)) {
+            std::cerr << "Seeded generators diverged\n";
+            return 1;
+        }
+    }
+
+    std::cout << "speedup: " << urandomTime / engineTime << "x\n";
+    return 0;
+}
@@ -0,0 +1,186 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Draws the depth and normal maps of a bumpy floor (like the fixed maze floor) with the software
+ * rasterizer at several resolutions, with one thread and with one thread per core, and reports
+ * how long each took.  The maps drawn with one thread and with several threads must be the same.
+ * The depth map of a flat floor is checked against its known depth.
+ *
+ * usage: rasterizerBenchmark [number of repetitions]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "levelDrawer/common.hpp"
+#include "levelDrawer/softwareRasterizer/softwareRasterizer.hpp"
+
+namespace {
+    float constexpr floorZ = levelTracker::m_maxZLevel;
+    float constexpr bumpHeight = 0.1f;
+
+    template <typename Fcn>
+    double timeIt(Fcn &&fcn) {
+        auto start = std::chrono::steady_clock::now();
+        fcn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    // a grid of nbrRows x nbrRows squares covering [-1, 1] x [-1, 1] at the floor z, with bumps
+    // of height bumpHeight if bumpy is true.
+    std::shared_ptr<levelDrawer::ModelVertices const> floorModel(uint32_t nbrRows, bool bumpy) {
+        levelDrawer::ModelVertices model;
+        uint32_t nbrVertices = nbrRows + 1;
+        for (uint32_t j = 0; j < nbrVertices; j++) {
+            for (uint32_t i = 0; i < nbrVertices; i++) {
+                float x = -1.0f + 2.0f * i / nbrRows;
+                float y = -1.0f + 2.0f * j / nbrRows;
+                float z = floorZ;
+                glm::vec3 normal{0.0f, 0.0f, 1.0f};
+                if (bumpy) {
+                    float a = 3.0f * 3.1415926f;
+                    z += bumpHeight * std::sin(a * x) * std::sin(a * y);
+                    normal = glm::vec3{-bumpHeight * a * std::cos(a * x) * std::sin(a * y),
+                                       -bumpHeight * a * std::sin(a * x) * std::cos(a * y), 1.0f};
+                }
+                model.first.emplace_back(glm::vec3{x, y, z}, glm::vec3{0.2f, 0.2f, 0.2f},
+                                         glm::vec2{0.0f, 0.0f}, glm::normalize(normal));
+            }
+        }
+
+        for (uint32_t j = 0; j < nbrRows; j++) {
+            for (uint32_t i = 0; i < nbrRows; i++) {
+                uint32_t bottomLeft = j * nbrVertices + i;
+                uint32_t topLeft = bottomLeft + nbrVertices;
+                for (uint32_t index : {bottomLeft, bottomLeft + 1, topLeft + 1,
+                                       bottomLeft, topLeft + 1, topLeft}) {
+                    model.second.push_back(index);
+                }
+            }
+        }
+
+        return std::make_shared<levelDrawer::ModelVertices const>(std::move(model));
+    }
+
+    renderDetails::ParametersDepthMap depthParameters() {
+        renderDetails::ParametersDepthMap parameters{};
+        parameters.nearestDepth = floorZ + bumpHeight;
+        parameters.farthestDepth = floorZ - bumpHeight;
+        parameters.widthAtDepth = 2.0f;
+        parameters.heightAtDepth = 2.0f;
+        parameters.lookAt = levelDrawer::DefaultConfig::lookAt;
+        parameters.up = levelDrawer::DefaultConfig::up;
+        parameters.viewPoint = levelDrawer::DefaultConfig::viewPoint;
+        parameters.nearPlane = levelDrawer::DefaultConfig::nearPlane;
+        parameters.farPlane = levelDrawer::DefaultConfig::farPlane;
+        return parameters;
+    }
+
+    renderDetails::ParametersNormalMap normalParameters() {
+        renderDetails::ParametersNormalMap parameters{};
+        parameters.widthAtDepth = 2.0f;
+        parameters.heightAtDepth = 2.0f;
+        parameters.lookAt = levelDrawer::DefaultConfig::lookAt;
+        parameters.up = levelDrawer::DefaultConfig::up;
+        parameters.viewPoint = levelDrawer::DefaultConfig::viewPoint;
+        parameters.nearPlane = levelDrawer::DefaultConfig::nearPlane;
+        parameters.farPlane = levelDrawer::DefaultConfig::farPlane;
+        return parameters;
+    }
+
+    bool runResolution(uint32_t nbrSamplesForWidth, size_t nbrRepetitions) {
+        std::vector<levelDrawer::SoftwareRasterizer::Object> objects{
+                {floorModel(64, true), glm::mat4(1.0f)}};
+        auto depth = depthParameters();
+        auto normal = normalParameters();
+        levelDrawer::SoftwareRasterizer oneThread(1);
+        levelDrawer::SoftwareRasterizer allThreads;
+        uint32_t nbrThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        double oneThreadTime = 0.0;
+        double allThreadsTime = 0.0;
+        bool same = true;
+        for (size_t i = 0; i < nbrRepetitions; i++) {
+            std::vector<float> depthMap1;
+            std::vector<float> normalMap1;
+            oneThreadTime += timeIt([&]() {
+                depthMap1 = oneThread.drawToBuffer(depthMapRenderDetailsName, objects,
+                        nbrSamplesForWidth, nbrSamplesForWidth, depth);
+                normalMap1 = oneThread.drawToBuffer(normalMapRenderDetailsName, objects,
+                        nbrSamplesForWidth, nbrSamplesForWidth, normal);
+            });
+
+            std::vector<float> depthMap;
+            std::vector<float> normalMap;
+            allThreadsTime += timeIt([&]() {
+                depthMap = allThreads.drawToBuffer(depthMapRenderDetailsName, objects,
+                        nbrSamplesForWidth, nbrSamplesForWidth, depth);
+                normalMap = allThreads.drawToBuffer(normalMapRenderDetailsName, objects,
+                        nbrSamplesForWidth, nbrSamplesForWidth, normal);
+            });
+
+            same = same && depthMap == depthMap1 && normalMap == normalMap1;
+        }
+
+        std::cout << nbrSamplesForWidth << "x" << nbrSamplesForWidth << " depth and normal maps: 1 thread "
+                  << oneThreadTime / nbrRepetitions / 1000.0 << " ms, " << nbrThreads << " threads "
+                  << allThreadsTime / nbrRepetitions / 1000.0 << " ms ("
+                  << oneThreadTime / allThreadsTime << "x)"
+                  << (same ? "" : " (MAPS DIFFER)") << "\n";
+        return same;
+    }
+
+    // every pixel of the depth map of a flat floor filling the view is at the floor's depth.
+    bool checkFlatFloor() {
+        levelDrawer::SoftwareRasterizer rasterizer;
+        std::vector<levelDrawer::SoftwareRasterizer::Object> objects{
+                {floorModel(7, false), glm::mat4(1.0f)}};
+        auto depthMap = rasterizer.drawToBuffer(depthMapRenderDetailsName, objects, 301, 301,
+                depthParameters());
+        for (float depth : depthMap) {
+            if (std::fabs(depth - floorZ) > 0.0001f) {
+                std::cout << "flat floor: depth " << depth << " expected " << floorZ << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t nbrRepetitions = 10;
+    if (argc > 1) {
+        nbrRepetitions = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    bool success = checkFlatFloor();
+    for (uint32_t nbrSamplesForWidth : {256, 512, 1024}) {
+        success = runResolution(nbrSamplesForWidth, nbrRepetitions) && success;
+    }
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Compares the old accelerometer path (a glm::rotate matrix built and applied for every event,
+ * every event forwarded to the level) with the AccelerationFilter path (every event filtered, one
+ * rotated acceleration forwarded per frame) on a recorded or generated trace of events.
+ *
+ * A trace file has one event per line: the timestamp in nanoseconds and the x, y and z
+ * acceleration, separated by spaces or commas.  Lines starting with # are ignored.  Without a
+ * trace file, a 400 Hz trace of a slowly tilting device with noise and the odd spike is used.
+ *
+ * usage: sensorFilterBenchmark [trace file] [rotation angle in degrees]
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "sensorFilter.hpp"
+
+namespace {
+    std::atomic<uint64_t> nbrAllocations{0};
+}
+
+void *operator new(size_t size) {
+    nbrAllocations++;
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc{};
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    struct Event {
+        int64_t timestamp;
+        glm::vec3 acceleration;
+    };
+
+    // the drawing loop draws at about 60 frames per second.
+    int64_t constexpr framePeriod = 1000000000 / 60;
+
+    std::vector<Event> readTrace(char const *fileName) {
+        std::ifstream in(fileName);
+        if (!in) {
+            throw std::runtime_error(std::string("Could not open trace file: ") + fileName);
+        }
+
+        std::vector<Event> events;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::istringstream fields(line);
+            Event event{};
+            if (!(fields >> event.timestamp >> event.acceleration.x >> event.acceleration.y >>
+                  event.acceleration.z))
+            {
+                throw std::runtime_error("Bad line in trace file: " + line);
+            }
+            events.push_back(event);
+        }
+        return events;
+    }
+
+    std::vector<Event> generateTrace(size_t count) {
+        std::mt19937 engine(12345);
+        std::normal_distribution<float> noise(0.0f, 0.15f);
+        std::uniform_int_distribution<int> spike(0, 199);
+
+        int64_t constexpr eventPeriod = 1000000000 / 400;
+        std::vector<Event> events;
+        events.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            float t = i * eventPeriod / 1000000000.0f;
+            glm::vec3 tilt{4.0f * std::sin(0.7f * t), 3.0f * std::cos(0.4f * t), 8.5f};
+            glm::vec3 acceleration = tilt + glm::vec3{noise(engine), noise(engine), noise(engine)};
+            if (spike(engine) == 0) {
+                acceleration.x += 6.0f;
+            }
+            events.push_back(Event{static_cast<int64_t>(i) * eventPeriod, acceleration});
+        }
+        return events;
+    }
+
+    // stands in for LevelSequence::updateAcceleration.
+    struct Sink {
+        glm::vec3 sum{0.0f};
+        size_t nbrUpdates = 0;
+
+        void updateAcceleration(float x, float y, float z) {
+            sum += glm::vec3{x, y, z};
+            nbrUpdates++;
+        }
+    };
+
+    // the path Graphics::updateAcceleration used to have, called for every event.
+    void oldUpdateAcceleration(Sink &sink, float rotationAngle, glm::vec3 const &event) {
+        glm::vec4 acceleration{event.x, event.y, event.z, 1.0f};
+        glm::mat4 rotation = glm::rotate(glm::mat4{1.0f}, glm::radians(rotationAngle), glm::vec3{0.0f, 0.0f, 1.0f});
+        acceleration = rotation * acceleration;
+        sink.updateAcceleration(
+                acceleration.x/acceleration.w,
+                acceleration.y/acceleration.w,
+                acceleration.z/acceleration.w);
+    }
+
+    template <typename Fcn>
+    double timeIt(Fcn &&fcn) {
+        auto start = std::chrono::steady_clock::now();
+        fcn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    void report(char const *name, double microseconds, size_t nbrEvents, Sink const &sink,
+                uint64_t allocations)
+    {
+        std::cout << name << ": " << microseconds << " us total, "
+                  << microseconds * 1000.0 / nbrEvents << " ns per event, "
+                  << sink.nbrUpdates << " level updates, " << allocations << " allocations "
+                  << "(checksum " << sink.sum.x + sink.sum.y + sink.sum.z << ")\n";
+    }
+
+    bool checkRotation(float rotationAngle) {
+        glm::mat4 expected = glm::rotate(glm::mat4{1.0f}, glm::radians(rotationAngle), glm::vec3{0.0f, 0.0f, 1.0f});
+        glm::mat3 rotation = accelerationRotation(rotationAngle);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                if (std::fabs(rotation[i][j] - expected[i][j]) > 1e-5f) {
+                    std::cerr << "accelerationRotation(" << rotationAngle << ") differs from glm::rotate\n";
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<Event> events;
+    if (argc > 1) {
+        events = readTrace(argv[1]);
+    } else {
+        events = generateTrace(400 * 600);
+    }
+    if (events.empty()) {
+        std::cerr << "The trace has no events\n";
+        return 1;
+    }
+
+    float rotationAngle = 90.0f;
+    if (argc > 2) {
+        rotationAngle = std::strtof(argv[2], nullptr);
+    }
+
+    for (float angle : {0.0f, 90.0f, 180.0f, 270.0f, -90.0f, 30.0f, rotationAngle}) {
+        if (!checkRotation(angle)) {
+            return 1;
+        }
+    }
+
+    Sink oldSink;
+    uint64_t allocationsBefore = nbrAllocations;
+    double oldTime = timeIt([&]() {
+        for (auto const &event : events) {
+            oldUpdateAcceleration(oldSink, rotationAngle, event.acceleration);
+        }
+    });
+    report("per event glm::rotate", oldTime, events.size(), oldSink, nbrAllocations - allocationsBefore);
+
+    std::pair<char const *, SensorFilterType> const filters[] = {
+            {"exponential", SensorFilterType::exponential},
+            {"one euro", SensorFilterType::oneEuro},
+            {"median of 3", SensorFilterType::medianOf3}};
+
+    double slowestTime = 0.0;
+    for (auto const &filter : filters) {
+        SensorTuning tuning{};
+        tuning.filter = filter.second;
+        AccelerationFilter accelerationFilter{tuning};
+        glm::mat3 rotation = accelerationRotation(rotationAngle);
+
+        Sink sink;
+        allocationsBefore = nbrAllocations;
+        double time = timeIt([&]() {
+            // the events that arrived during a frame are drained together at the start of the
+            // next frame.
+            int64_t nextFrame = events[0].timestamp + framePeriod;
+            glm::vec3 acceleration;
+            for (auto const &event : events) {
+                if (event.timestamp >= nextFrame) {
+                    if (accelerationFilter.take(acceleration)) {
+                        acceleration = rotation * acceleration;
+                        sink.updateAcceleration(acceleration.x, acceleration.y, acceleration.z);
+                    }
+                    while (nextFrame <= event.timestamp) {
+                        nextFrame += framePeriod;
+                    }
+                }
+                accelerationFilter.add(event.acceleration.x, event.acceleration.y,
+                                       event.acceleration.z, event.timestamp);
+            }
+            if (accelerationFilter.take(acceleration)) {
+                acceleration = rotation * acceleration;
+                sink.updateAcceleration(acceleration.x, acceleration.y, acceleration.z);
+            }
+        });
+        uint64_t allocations = nbrAllocations - allocationsBefore;
+        report(filter.first, time, events.size(), sink, allocations);
+        if (allocations != 0) {
+            std::cerr << "The filter path allocated memory\n";
+            return 1;
+        }
+        slowestTime = std::max(slowestTime, time);
+    }
+
+    std::cout << "speedup (slowest filter): " << oldTime / slowestTime << "x\n";
+    return 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Compares the std::set of Z value references the draw object tables used to keep (erase and
+ * re-insert on every model matrix update, linear scan on removing a draw object) with
+ * ZValueIndex.  Each frame, every object's z value is updated, some objects may be removed and
+ * added, and then the references are walked in draw order like a draw does.  The draw order of
+ * both is compared at the end of every frame.
+ *
+ * usage: zValueIndexBenchmark [number of frames]
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "levelDrawer/zValueIndex.hpp"
+
+using levelDrawer::DrawObjReference;
+using levelDrawer::ZValueReference;
+
+namespace {
+    // the way DrawObjectTable kept the Z value references before ZValueIndex.
+    class ZValueSet {
+    public:
+        std::set<ZValueReference> const &sorted() { return m_references; }
+
+        void add(float z, DrawObjReference objRef) {
+            m_references.emplace(z, objRef, 0);
+        }
+
+        void update(float oldZ, float z, DrawObjReference objRef) {
+            if (m_references.erase(ZValueReference(oldZ, objRef, 0)) != 1) {
+                throw std::runtime_error("Unexpected number of items removed!");
+            }
+            m_references.emplace(z, objRef, 0);
+        }
+
+        void removeObject(DrawObjReference objRef) {
+            ZValueReference zRefToFind(boost::none, objRef, boost::none);
+            for (auto it = m_references.begin(); it != m_references.end(); ) {
+                if (*it == zRefToFind) {
+                    it = m_references.erase(it);
+                } else {
+                    it++;
+                }
+            }
+        }
+
+    private:
+        std::set<ZValueReference> m_references;
+    };
+
+    struct Scenario {
+        char const *name;
+        // the z value changes each frame by up to this much.
+        float zJitter;
+        // the fraction of the objects removed and replaced each frame.
+        float churn;
+    };
+
+    Scenario const scenarios[] = {
+            {"rolling on a flat floor", 0.0f, 0.0f},
+            {"moving in z", 0.01f, 0.0f},
+            {"objects added and removed", 0.0f, 0.02f},
+    };
+
+    // z values are multiples of this so that two different z values never compare as equal.
+    float constexpr zStep = 0.001f;
+
+    template <typename Index>
+    struct Run {
+        Index index;
+        double microseconds = 0.0;
+        uint64_t checksum = 0;
+    };
+
+    template <typename Fcn>
+    double timeIt(Fcn &&fcn) {
+        auto start = std::chrono::steady_clock::now();
+        fcn();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    template <typename Container>
+    uint64_t walk(Container const &references) {
+        // like a draw, look at every reference in order.
+        uint64_t checksum = 0;
+        for (auto const &ref : references) {
+            checksum = checksum * 31 + ref.drawObjectReference;
+        }
+        return checksum;
+    }
+
+    bool runScenario(Scenario const &scenario, size_t nbrObjects, size_t nbrFrames) {
+        std::mt19937 rng(12345);
+        std::uniform_int_distribution<int> zDist(-1000, 0);
+        int jitterSteps = static_cast<int>(scenario.zJitter / zStep);
+        std::uniform_int_distribution<int> jitterDist(-jitterSteps, jitterSteps);
+        auto nbrChurn = static_cast<size_t>(scenario.churn * nbrObjects);
+
+        std::vector<DrawObjReference> objRefs;
+        std::vector<float> zValues;
+        DrawObjReference nextObjRef = 0;
+
+        Run<ZValueSet> oldRun;
+        Run<levelDrawer::ZValueIndex> newRun;
+
+        for (size_t i = 0; i < nbrObjects; i++) {
+            float z = zDist(rng) * zStep;
+            objRefs.push_back(nextObjRef);
+            zValues.push_back(z);
+            oldRun.index.add(z, nextObjRef);
+            newRun.index.add(z, nextObjRef, 0);
+            nextObjRef++;
+        }
+
+        bool sameOrder = true;
+        for (size_t frame = 0; frame < nbrFrames; frame++) {
+            // pick the changes for this frame up front so that both indices get the same ones.
+            std::vector<float> newZValues(zValues.size());
+            for (size_t i = 0; i < zValues.size(); i++) {
+                newZValues[i] = zValues[i] + jitterDist(rng) * zStep;
+            }
+            std::vector<size_t> removed;
+            for (size_t i = 0; i < nbrChurn; i++) {
+                removed.push_back(rng() % objRefs.size());
+            }
+            std::sort(removed.begin(), removed.end());
+            removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+
+            oldRun.microseconds += timeIt([&]() {
+                for (size_t i = 0; i < objRefs.size(); i++) {
+                    oldRun.index.update(zValues[i], newZValues[i], objRefs[i]);
+                }
+                DrawObjReference objRef = nextObjRef;
+                for (size_t i : removed) {
+                    oldRun.index.removeObject(objRefs[i]);
+                    oldRun.index.add(newZValues[i], objRef++);
+                }
+                oldRun.checksum += walk(oldRun.index.sorted());
+            });
+
+            newRun.microseconds += timeIt([&]() {
+                for (size_t i = 0; i < objRefs.size(); i++) {
+                    newRun.index.update(newZValues[i], objRefs[i], 0);
+                }
+                DrawObjReference objRef = nextObjRef;
+                for (size_t i : removed) {
+                    newRun.index.remove(objRefs[i], 0);
+                    newRun.index.add(newZValues[i], objRef++, 0);
+                }
+                newRun.checksum += walk(newRun.index.sorted());
+            });
+
+            for (size_t i : removed) {
+                objRefs[i] = nextObjRef++;
+            }
+            zValues = std::move(newZValues);
+
+            sameOrder = sameOrder && oldRun.checksum == newRun.checksum;
+        }
+
+        std::cout << scenario.name << ", " << nbrObjects << " objects: std::set "
+                  << oldRun.microseconds / nbrFrames << " us/frame, ZValueIndex "
+                  << newRun.microseconds / nbrFrames << " us/frame ("
+                  << oldRun.microseconds / newRun.microseconds << "x)"
+                  << (sameOrder ? "" : " (DRAW ORDER DIFFERS)") << "\n";
+        return sameOrder;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t nbrFrames = 1000;
+    if (argc > 1) {
+        nbrFrames = std::strtoul(argv[1], nullptr, 10);
+    }
+
+    bool success = true;
+    for (auto const &scenario : scenarios) {
+        for (size_t nbrObjects : {10, 100, 1000, 10000}) {
+            // fewer frames for the big scenes so that each one takes about as long.
+            size_t frames = std::max<size_t>(1, nbrFrames * 100 / std::max<size_t>(nbrObjects, 100));
+            success = runScenario(scenario, nbrObjects, frames) && success;
+        }
+    }
+
+    return success ? 0 : 1;
+}
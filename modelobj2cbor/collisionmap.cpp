@@ -0,0 +1,197 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Draws the collision maps (the depth map and the normal map) of fixed maze floor models with the
+ * software rasterizer and writes them next to the models, so that the fixed maze does not have
+ * to draw them when it starts.  The maps are drawn the same way the fixed maze draws them (see
+ * fixedMaze::Level::drawCollisionMap) for the default perspective.
+ */
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "common.hpp"
+#include "mathGraphics.hpp"
+#include "levelDrawer/common.hpp"
+#include "levelDrawer/softwareRasterizer/softwareRasterizer.hpp"
+#include "levels/fixedMaze/collisionMap.hpp"
+
+namespace {
+    // these have to be the same as in the fixed maze level.
+    uint32_t constexpr defaultWidth = 200;          // fixedMaze::Level::m_rowHeight
+    float constexpr depthRange = 1.0f;              // fixedMaze::Level::MODEL_MAXZ
+    float constexpr modelSize = 2.0f;               // basic::Level::m_modelSize
+    float constexpr floatErrorAmount = 0.0001f;     // basic::Level::m_floatErrorAmount
+
+    // Reads the models from the file system instead of the Android assets.
+    class FileGameRequester : public GameRequester {
+    public:
+        std::unique_ptr<std::streambuf> getAssetStream(std::string const &file) override {
+            auto buf = std::make_unique<std::filebuf>();
+            if (buf->open(file, std::ios_base::in | std::ios_base::binary) == nullptr) {
+                throw std::runtime_error("File not found: " + file);
+            }
+            return buf;
+        }
+
+        std::unique_ptr<std::streambuf> getLevelTableAssetStream() override {
+            throw std::runtime_error("No level table.");
+        }
+
+        std::string getSaveDataFileName() override { return std::string{}; }
+
+        void sendError(std::string const &error) override { std::cerr << error << std::endl; }
+
+        void sendError(char const *error) override { std::cerr << error << std::endl; }
+
+        void sendGraphicsDescription(GraphicsDescription const &, bool, bool) override {}
+
+        void sendKeepAliveEnabled(bool) override {}
+
+        std::vector<char> getTextImage(std::string, uint32_t &, uint32_t &, uint32_t &) override {
+            throw std::runtime_error("No text images.");
+        }
+    };
+
+    // the height of the screen at the floor for the default perspective.  It does not depend on
+    // the aspect ratio.
+    float defaultFloorSize(float floorZ) {
+        auto wh = getWidthHeight(floorZ,
+                getPerspectiveMatrix(levelDrawer::DefaultConfig::viewAngle, 1.0f,
+                        levelDrawer::DefaultConfig::nearPlane, levelDrawer::DefaultConfig::farPlane,
+                        false, false),
+                glm::lookAt(levelDrawer::DefaultConfig::viewPoint, levelDrawer::DefaultConfig::lookAt,
+                        levelDrawer::DefaultConfig::up));
+        return wh.second;
+    }
+
+    void makeCollisionMap(
+            std::shared_ptr<GameRequester> const &gameRequester,
+            std::string const &modelFile,
+            std::string const &outputDir,
+            uint32_t width)
+    {
+        fixedMaze::CollisionMapParameters parameters{};
+        parameters.modelHash = fixedMaze::collisionMapModelHash(
+                gameRequester->getAssetStream(modelFile).get());
+        parameters.width = width;
+        parameters.floorZ = levelTracker::m_maxZLevel;
+        parameters.floorSize = defaultFloorSize(parameters.floorZ);
+        parameters.depthRange = depthRange;
+
+        levelDrawer::ModelDescriptionPath model(modelFile, glm::vec3{0.2f, 0.2f, 0.2f},
+                levelDrawer::ModelDescription::LOAD_BOTH);
+        auto vertices = model.getData(gameRequester);
+        glm::mat4 floorMatrix = fixedMaze::collisionMapFloorMatrix(parameters.floorZ,
+                parameters.floorSize, modelSize);
+
+        levelDrawer::SoftwareRasterizer rasterizer;
+        fixedMaze::CollisionMap collisionMap{};
+        collisionMap.width = width;
+        collisionMap.height = width;
+        collisionMap.depthMap = rasterizer.drawToBuffer(depthMapRenderDetailsName,
+                {{std::make_shared<levelDrawer::ModelVertices const>(std::move(vertices.first)), floorMatrix}},
+                width, width,
+                fixedMaze::collisionMapDepthParameters(parameters.floorZ, parameters.floorSize, depthRange));
+        unFlattenMap(rasterizer.drawToBuffer(normalMapRenderDetailsName,
+                {{std::make_shared<levelDrawer::ModelVertices const>(std::move(vertices.second)), floorMatrix}},
+                width, width,
+                fixedMaze::collisionMapNormalParameters(parameters.floorSize)),
+                collisionMap.normalMap);
+
+        if (!fixedMaze::findCollisionMapHole(collisionMap.depthMap, width,
+                parameters.floorZ - depthRange + floatErrorAmount,
+                collisionMap.holeColumn, collisionMap.holeRow))
+        {
+            throw std::runtime_error("Model finish condition not found.");
+        }
+
+        std::string collisionMapFile = fixedMaze::collisionMapFileName(modelFile);
+        size_t slashpos = collisionMapFile.find_last_of('/');
+        if (slashpos != std::string::npos) {
+            collisionMapFile = collisionMapFile.substr(slashpos + 1);
+        }
+        collisionMapFile = outputDir + collisionMapFile;
+
+        std::ofstream outStream(collisionMapFile, std::ofstream::binary);
+        if (!outStream.good()) {
+            throw std::runtime_error("Could not open file for write: " + collisionMapFile);
+        }
+        fixedMaze::writeCollisionMap(outStream, parameters, collisionMap);
+
+        std::cout << collisionMapFile << ": " << width << "x" << width << " samples, finish hole at ("
+                  << collisionMap.holeColumn << ", " << collisionMap.holeRow << ")" << std::endl;
+    }
+}
+
+void usage(char const *progName) {
+    std::cerr << "Usage : " << progName << " [args] filename [filenames]" << std::endl
+              << " -d <output Directory>" << std::endl
+              << " -w <number of samples in a row (default " << defaultWidth << ")>" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> filenames;
+    std::string outputDir;
+    uint32_t width = defaultWidth;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-') {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+                return 1;
+            }
+            switch(argv[i][1]) {
+            case 'd':
+                outputDir = argv[++i];
+                continue;
+            case 'w':
+                width = static_cast<uint32_t>(std::stoul(argv[++i]));
+                continue;
+            default:
+                usage(argv[0]);
+                return 1;
+            }
+        }
+
+        filenames.emplace_back(argv[i]);
+    }
+
+    auto gameRequester = std::make_shared<FileGameRequester>();
+    for (auto const &filename : filenames) {
+        try {
+            makeCollisionMap(gameRequester, filename, outputDir, width);
+        } catch (std::exception &e) {
+            std::cerr << filename << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
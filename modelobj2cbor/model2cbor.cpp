@@ -33,6 +33,7 @@
 #include <cbor.h>
 
 #include <modelLoader.hpp>
+#include <modelBinary.hpp>
 
 void loadModelFromObj(
     std::ifstream &modelStream,
@@ -238,6 +239,32 @@ int main(int argc, char *argv[]) {
                 free(buffer);
                 cbor_decref(&cmap);
             }
+            outStream.close();
+
+            // decode the modelcbor file the same way the game does and store the result, so
+            // that the game does not have to decode it.
+            std::filebuf cborBuf;
+            if (cborBuf.open(outfilename, std::ios_base::in | std::ios_base::binary) == nullptr) {
+                std::cerr << "Could not open file for read: " << outfilename << std::endl;
+                return 1;
+            }
+            std::pair<levelDrawer::ModelVertices, levelDrawer::ModelVertices> modelVertices;
+            bool usingDefaultColor;
+            if (!levelDrawer::loadModelCbor(&cborBuf, glm::vec3{0.2f, 0.2f, 0.2f},
+                    &modelVertices.first, &modelVertices.second, usingDefaultColor)) {
+                std::cerr << "Could not decode: " << outfilename << std::endl;
+                return 1;
+            }
+
+            std::string binfilename = levelDrawer::modelBinaryFileName(outfilename);
+            std::ofstream binStream(binfilename, std::ofstream::binary);
+            if (!binStream.good()) {
+                std::cerr << "Could not open file for write: " << binfilename << std::endl;
+                return 1;
+            }
+            levelDrawer::writeModelBinary(binStream, modelVertices, usingDefaultColor);
+            std::cout << "number vertices with face normals: " << modelVertices.first.first.size()
+                      << ", with vertex normals: " << modelVertices.second.first.size() << std::endl;
         } catch (nlohmann::json::exception const &e) {
             std::cerr << "a JSON error occurred while creating file: "
                       << outfilename << " from " << filename << " error: " << e.what() << std::endl;
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2026 Cerulean Quasar. All Rights Reserved.
+ *
+ *  This file is part of AmazingLabyrinth.
+ *
+ *  AmazingLabyrinth is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  AmazingLabyrinth is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with AmazingLabyrinth.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* Writes a texture container (see textureContainer.hpp) with the full mip chain of each texture
+ * PNG next to it, so that the game does not decode PNGs or generate mip levels when it loads a
+ * level.  Only rgba8 images are written: there is no ETC2 or ASTC encoder here.
+ */
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include "levelDrawer/textureTable/textureContainer.hpp"
+
+namespace {
+    void makeTextureContainer(std::string const &imageFile, std::string const &outputDir) {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        stbi_uc *pixels = stbi_load(imageFile.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+        if (pixels == nullptr) {
+            throw std::runtime_error("Could not decode image: " + imageFile);
+        }
+        std::vector<char> data(pixels, pixels + size_t{4} * width * height);
+        stbi_image_free(pixels);
+
+        std::vector<levelDrawer::TextureImage> images;
+        images.push_back(levelDrawer::makeMipChain(data, static_cast<uint32_t>(width),
+                static_cast<uint32_t>(height)));
+
+        std::string containerFile = levelDrawer::textureContainerFileName(imageFile);
+        size_t slashpos = containerFile.find_last_of('/');
+        if (slashpos != std::string::npos) {
+            containerFile = containerFile.substr(slashpos + 1);
+        }
+        containerFile = outputDir + containerFile;
+
+        std::ofstream outStream(containerFile, std::ofstream::binary);
+        if (!outStream.good()) {
+            throw std::runtime_error("Could not open file for write: " + containerFile);
+        }
+        levelDrawer::writeTextureContainer(outStream, images);
+
+        std::cout << containerFile << ": " << width << "x" << height << ", "
+                  << images[0].levels.size() << " mip levels" << std::endl;
+    }
+}
+
+void usage(char const *progName) {
+    std::cerr << "Usage : " << progName << " [args] filename [filenames]" << std::endl
+              << " -d <output Directory>" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> filenames;
+    std::string outputDir;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-') {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+                return 1;
+            }
+            switch(argv[i][1]) {
+            case 'd':
+                outputDir = argv[++i];
+                continue;
+            default:
+                usage(argv[0]);
+                return 1;
+            }
+        }
+
+        filenames.emplace_back(argv[i]);
+    }
+
+    for (auto const &filename : filenames) {
+        try {
+            makeTextureContainer(filename, outputDir);
+        } catch (std::exception &e) {
+            std::cerr << filename << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}